@@ -60,6 +60,8 @@ public:
   void function(const FunctionDomain &domain, FunctionValues &values) const override;
   /// Derivatives of function with respect to active parameters
   void functionDeriv(const FunctionDomain &domain, Jacobian &jacobian) override;
+  /// Values and derivatives of the member functions in one pass
+  void functionWithDeriv(const FunctionDomain &domain, FunctionValues &values, Jacobian &jacobian) override;
 
   /// Set i-th parameter
   void setParameter(size_t, const double &value, bool explicitlySet = true) override;
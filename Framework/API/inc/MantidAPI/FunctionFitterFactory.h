@@ -0,0 +1,40 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidKernel/DynamicFactory.h"
+#include "MantidKernel/SingletonHolder.h"
+
+namespace Mantid {
+namespace API {
+
+class IFunctionFitter;
+
+/** @class FunctionFitterFactoryImpl
+
+    Creates the concrete IFunctionFitter implementations, which live in the
+    fitting library. Algorithms which cannot link to that library get their
+    fitters from here. It is implemented as a singleton class.
+*/
+class MANTID_API_DLL FunctionFitterFactoryImpl : public Kernel::DynamicFactory<IFunctionFitter> {
+private:
+  friend struct Mantid::Kernel::CreateUsingNew<FunctionFitterFactoryImpl>;
+  /// Private Constructor for singleton class
+  FunctionFitterFactoryImpl();
+};
+
+using FunctionFitterFactory = Mantid::Kernel::SingletonHolder<FunctionFitterFactoryImpl>;
+
+} // namespace API
+} // namespace Mantid
+
+namespace Mantid {
+namespace Kernel {
+EXTERN_MANTID_API template class MANTID_API_DLL Mantid::Kernel::SingletonHolder<Mantid::API::FunctionFitterFactoryImpl>;
+}
+} // namespace Mantid
@@ -361,6 +361,9 @@ public:
   virtual void function(const FunctionDomain &domain, FunctionValues &values) const = 0;
   /// Derivatives of function with respect to active parameters.
   virtual void functionDeriv(const FunctionDomain &domain, Jacobian &jacobian);
+  /// Evaluate the function and its derivatives together, e.g. to share the
+  /// intermediate results of the two
+  virtual void functionWithDeriv(const FunctionDomain &domain, FunctionValues &values, Jacobian &jacobian);
 
   /* @name Callbacks to perform work at various points other than in the
    * function */
@@ -0,0 +1,95 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/FunctionFitterFactory.h"
+#include "MantidAPI/IFunction.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidKernel/RegistrationHelper.h"
+
+#include <memory>
+#include <string>
+
+namespace Mantid {
+namespace API {
+
+/** IFunctionFitter : fits a function to a spectrum of a MatrixWorkspace in
+  the same way as the Fit algorithm with CreateOutput=false, but without
+  creating an algorithm for each fit. It is meant for code that runs many
+  small fits, e.g. one per peak of every spectrum, where setting up and
+  validating a Fit algorithm costs more than the minimization itself.
+
+  The fitted function is updated in place, including the parameter errors if
+  Options::calcErrors is set. A fitter keeps the cost function and the data of
+  its last fit for reuse, so it must not be shared between threads.
+*/
+class MANTID_API_DLL IFunctionFitter {
+public:
+  /// The equivalents of the Fit properties of the same names
+  struct Options {
+    std::string minimizer{"Levenberg-Marquardt"};
+    std::string costFunction{"Least squares"};
+    size_t maxIterations{500};
+    bool calcErrors{false};
+    bool ignoreInvalidData{false};
+    /// Peak radius passed to the peak functions. 0 keeps the default.
+    int peakRadius{0};
+  };
+
+  /// The outcome of a fit
+  struct Result {
+    /// "success" or the reason for the failure, as Fit's OutputStatus
+    std::string status;
+    /// The cost function value divided by the degrees of freedom
+    double chi2OverDoF{0.0};
+    /// Number of iterations done by the minimizer
+    size_t iterations{0};
+    bool success() const { return status == "success"; }
+  };
+
+  virtual ~IFunctionFitter() = default;
+
+  /// Set the options of the following fits
+  void setOptions(const Options &options) { m_options = options; }
+  /// The options of the fits
+  const Options &options() const { return m_options; }
+
+  /** Fit a function to a range of a spectrum.
+   * @param function :: The function to fit. It gets the fitted parameters.
+   * @param workspace :: The workspace with the data
+   * @param workspaceIndex :: The spectrum to fit
+   * @param startX :: Start of the fitting range. EMPTY_DBL() with endX
+   * for the whole spectrum.
+   * @param endX :: End of the fitting range.
+   * @param constraints :: Constraints to add to the function, as Fit's
+   * Constraints property
+   * @return the status of the fit and the final chi squared
+   */
+  virtual Result fit(const IFunction_sptr &function, const MatrixWorkspace_sptr &workspace, size_t workspaceIndex,
+                     double startX, double endX, const std::string &constraints = "") = 0;
+
+protected:
+  /// The options of the fits
+  Options m_options;
+};
+
+/// define a shared pointer to a function fitter
+using IFunctionFitter_sptr = std::shared_ptr<IFunctionFitter>;
+
+/**
+ * Macro for declaring a new type of function fitter to be used with the
+ * FunctionFitterFactory
+ */
+#define DECLARE_FUNCTIONFITTER(classname)                                                                              \
+  namespace {                                                                                                          \
+  Mantid::Kernel::RegistrationHelper register_functionfitter_##classname(                                              \
+      ((Mantid::API::FunctionFitterFactory::Instance().subscribe<classname>(#classname)), 0));                         \
+  }
+
+} // namespace API
+} // namespace Mantid
@@ -85,6 +85,9 @@ public:
   void function1D(double *out, const double *xValues, const size_t nData) const override;
   /// General implementation of the method for all peaks.
   void functionDeriv1D(Jacobian *out, const double *xValues, const size_t nData) override;
+  /// Values and derivatives in one pass for the peaks that implement
+  /// functionLocalWithDeriv
+  void functionWithDeriv(const FunctionDomain &domain, FunctionValues &values, Jacobian &jacobian) override;
 
   /// Get the interval on which the peak has all its values above a certain
   /// level
@@ -94,6 +97,9 @@ public:
   virtual void functionLocal(double *out, const double *xValues, const size_t nData) const = 0;
   /// Derivative evaluation method. Default is to calculate numerically
   virtual void functionDerivLocal(Jacobian *jacobian, const double *xValues, const size_t nData);
+  /// Evaluate the values and the derivatives together. Returns false if the
+  /// peak does not implement it.
+  virtual bool functionLocalWithDeriv(double *out, Jacobian *jacobian, const double *xValues, const size_t nData);
 
   /// Get name of parameter that is associated to centre.
   std::string getCentreParameterName() const;
@@ -19,6 +19,7 @@
 #include <boost/lexical_cast.hpp>
 #include <memory>
 #include <sstream>
+#include <typeinfo>
 #include <utility>
 
 namespace Mantid::API {
@@ -204,6 +205,29 @@ void CompositeFunction::functionDeriv(const FunctionDomain &domain, Jacobian &ja
   }
 }
 
+/**
+ * Calculate the values and the derivatives of the member functions together,
+ * each member using its own functionWithDeriv. Classes derived from
+ * CompositeFunction combine their members differently and use the separate
+ * function() and functionDeriv() calls.
+ * @param domain :: Function domain to get the arguments from.
+ * @param values :: Buffer to store the function values.
+ * @param jacobian :: A Jacobian to store the derivatives.
+ */
+void CompositeFunction::functionWithDeriv(const FunctionDomain &domain, FunctionValues &values, Jacobian &jacobian) {
+  if (typeid(*this) != typeid(CompositeFunction) || getAttribute(ATTNUMDERIV).asBool()) {
+    IFunction::functionWithDeriv(domain, values, jacobian);
+    return;
+  }
+  FunctionValues tmp(domain);
+  values.zeroCalculated();
+  for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+    PartialJacobian J(&jacobian, paramOffset(iFun));
+    m_functions[iFun]->functionWithDeriv(domain, tmp, J);
+    values += tmp;
+  }
+}
+
 /** Sets a new value to the i-th parameter.
  *  @param i :: The parameter index
  *  @param value :: The new value
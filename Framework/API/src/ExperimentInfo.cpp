@@ -1105,8 +1105,13 @@ void ExperimentInfo::setInstumentFromXML(const std::string &nxFilename, std::str
       // If it does, just use the one from the one stored there
       instr = InstrumentDataService::Instance().retrieve(instrumentNameMangled);
     } else {
-      // Really create the instrument
-      instr = parser.parseXML(nullptr);
+      // Use the snapshot written when this definition was last parsed, or
+      // really create the instrument and write one
+      instr = parser.loadSnapshot();
+      if (!instr) {
+        instr = parser.parseXML(nullptr);
+        parser.saveSnapshot();
+      }
       // Parse the instrument tree (internally create ComponentInfo and
       // DetectorInfo). This is an optimization that avoids duplicate parsing
       // of the instrument tree when loading multiple workspaces with the same
@@ -0,0 +1,20 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/FunctionFitterFactory.h"
+#include "MantidAPI/IFunctionFitter.h"
+#include "MantidKernel/LibraryManager.h"
+
+namespace Mantid::API {
+
+FunctionFitterFactoryImpl::FunctionFitterFactoryImpl() : Kernel::DynamicFactory<IFunctionFitter>() {
+  // we need to make sure the library manager has been loaded before we
+  // are constructed so that it is destroyed after us and thus does
+  // not close any loaded DLLs with loaded fitters in them
+  Mantid::Kernel::LibraryManager::Instance();
+}
+
+} // namespace Mantid::API
@@ -135,6 +135,19 @@ bool IFunction::cancellationRequestReceived() const {
  */
 void IFunction::functionDeriv(const FunctionDomain &domain, Jacobian &jacobian) { calNumericalDeriv(domain, jacobian); }
 
+/** Calculate the values and the derivatives of the function. The base class
+ * calls function() and then functionDeriv(): override it when the two can be
+ * calculated in one pass over the domain.
+ * @param domain :: The domain of the function
+ * @param values :: A buffer for the function values
+ * @param jacobian :: A Jacobian matrix. It is expected to have dimensions of
+ * domain.size() by nParams().
+ */
+void IFunction::functionWithDeriv(const FunctionDomain &domain, FunctionValues &values, Jacobian &jacobian) {
+  function(domain, values);
+  functionDeriv(domain, jacobian);
+}
+
 /** Check if an active parameter i is actually active
  * @param i :: Index of a parameter.
  */
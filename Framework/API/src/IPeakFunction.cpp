@@ -135,6 +135,49 @@ void IPeakFunction::functionDeriv1D(Jacobian *out, const double *xValues, const
   this->functionDerivLocal(&J, xValues + i0, n);
 }
 
+/**
+ * Calculate the values and the derivatives in the same range as function1D()
+ * and functionDeriv1D(), with one call to functionLocalWithDeriv(). Peaks that
+ * don't implement it, and histogram domains, use function() and
+ * functionDeriv().
+ * @param domain :: The domain of the function
+ * @param values :: A buffer for the function values
+ * @param jacobian :: A Jacobian for the derivatives
+ */
+void IPeakFunction::functionWithDeriv(const FunctionDomain &domain, FunctionValues &values, Jacobian &jacobian) {
+  const auto *d1d = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!d1d || dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    IFunction::functionWithDeriv(domain, values, jacobian);
+    return;
+  }
+  setPeakRadius(d1d->getPeakRadius());
+  const double *xValues = d1d->getPointerAt(0);
+  const size_t nData = d1d->size();
+  double *out = values.getPointerToCalculated(0);
+  double c = this->centre();
+  double dx = fabs(m_peakRadius * this->fwhm());
+  int i0 = -1;
+  int n = 0;
+  for (size_t i = 0; i < nData; ++i) {
+    if (fabs(xValues[i] - c) < dx) {
+      if (i0 < 0)
+        i0 = static_cast<int>(i);
+      ++n;
+    } else {
+      out[i] = 0.0;
+      for (size_t ip = 0; ip < this->nParams(); ++ip) {
+        jacobian.set(i, ip, 0.0);
+      }
+    }
+  }
+  if (i0 < 0 || n == 0)
+    return;
+  PartialJacobian1 J(&jacobian, i0);
+  if (!this->functionLocalWithDeriv(out + i0, &J, xValues + i0, n)) {
+    IFunction::functionWithDeriv(domain, values, jacobian);
+  }
+}
+
 void IPeakFunction::setPeakRadius(int r) const {
   if (r > 0) {
     m_peakRadius = r;
@@ -272,4 +315,24 @@ void IPeakFunction::functionDerivLocal(Jacobian *jacobian, const double *xValues
   this->calcNumericalDerivative1D(jacobian, std::move(evalMethod), xValues, nData);
 }
 
+/**
+ * Calculate the values and the derivatives of the peak together. The default
+ * does nothing and returns false: functionWithDeriv() then calls function()
+ * and functionDeriv() instead. Implementations must return true, also when
+ * nData is 0.
+ * @param out :: An output array for the values
+ * @param jacobian :: An output Jacobian for the derivatives
+ * @param xValues :: An input array of X data
+ * @param nData :: The number of X values provided
+ * @return true if the values and the derivatives were calculated
+ */
+bool IPeakFunction::functionLocalWithDeriv(double *out, Jacobian *jacobian, const double *xValues,
+                                           const size_t nData) {
+  UNUSED_ARG(out);
+  UNUSED_ARG(jacobian);
+  UNUSED_ARG(xValues);
+  UNUSED_ARG(nData);
+  return false;
+}
+
 } // namespace Mantid::API
@@ -256,6 +256,31 @@ public:
     TS_ASSERT_EQUALS(detectorInfo.rotation(4), Quat(1.0, 0.0, 0.0, 0.0));
   }
 
+  void test_diffractometerConstants_follow_changes_to_the_parameters() {
+    WorkspaceTester ws;
+    ws.initialize(3, 2, 1);
+    InstrumentCreationHelper::addFullInstrumentToWorkspace(ws, false, false, "DiffractometerInstrument");
+    auto &pmap = ws.instrumentParameters();
+    const auto &detectorInfo = ws.detectorInfo();
+    std::vector<detid_t> calibrated, uncalibrated;
+
+    pmap.addDouble(&detectorInfo.detector(1), "DIFC", 1000.);
+    auto constants = detectorInfo.diffractometerConstants(1, calibrated, uncalibrated);
+    TS_ASSERT_EQUALS(constants, std::make_tuple(0., 1000., 0.));
+
+    // The lookups kept by the first call must not hide the new parameters
+    pmap.addDouble(&detectorInfo.detector(1), "DIFA", 2.);
+    pmap.addDouble(&detectorInfo.detector(1), "TZERO", 3.);
+    pmap.addDouble(&detectorInfo.detector(1), "DIFC", 2000.);
+    constants = detectorInfo.diffractometerConstants(1, calibrated, uncalibrated);
+    TS_ASSERT_EQUALS(constants, std::make_tuple(2., 2000., 3.));
+
+    constants = detectorInfo.diffractometerConstants(0, calibrated, uncalibrated);
+    TS_ASSERT_EQUALS(constants, std::make_tuple(0., detectorInfo.difcUncalibrated(0), 0.));
+    TS_ASSERT_EQUALS(calibrated, std::vector<detid_t>(2, detectorInfo.detectorIDs()[1]));
+    TS_ASSERT_EQUALS(uncalibrated, std::vector<detid_t>(1, detectorInfo.detectorIDs()[0]));
+  }
+
   void test_setMasked() {
     auto &detectorInfo = m_workspace.mutableDetectorInfo();
     TS_ASSERT_EQUALS(detectorInfo.isMasked(0), true);
@@ -16,6 +16,9 @@
 #include <list>
 
 namespace Mantid {
+namespace Geometry {
+class ParameterLookup;
+}
 namespace Algorithms {
 /**
   Returns efficiency of cylindrical helium gas tube.
@@ -113,6 +116,10 @@ private:
   API::MatrixWorkspace_sptr m_outputWS;
   /// points the map that stores additional properties for detectors in that map
   const Geometry::ParameterMap *m_paraMap;
+  /// gas pressure of each detector, by detector index
+  std::shared_ptr<const Geometry::ParameterLookup> m_pressures;
+  /// wall thickness of each detector, by detector index
+  std::shared_ptr<const Geometry::ParameterLookup> m_wallThicknesses;
 
   /// stores the user selected value for incidient energy of the neutrons
   double m_Ei;
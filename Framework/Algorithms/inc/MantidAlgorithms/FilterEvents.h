@@ -97,6 +97,12 @@ private:
   /// Set up detector calibration parameters from customized values
   void setupCustomizedTOFCorrection();
 
+  /// Lay out the output workspaces densely by target index
+  void buildOutputTargetTable();
+
+  /// Get the event lists of a spectrum in all the output workspaces
+  void getOutputEventLists(size_t wsIndex, DataObjects::EventListSplitOutputs &outputs) const;
+
   /// Filter events by splitters in format of Splitter
   void filterEventsBySplitters(double progressamount);
 
@@ -132,8 +138,10 @@ private:
                          std::vector<Kernel::TimeSeriesProperty<std::string> *> &string_tsp_vector);
 
   template <typename TYPE>
-  void splitTimeSeriesProperty(Kernel::TimeSeriesProperty<TYPE> *tsp,
-                               std::vector<Types::Core::DateAndTime> &split_datetime_vec, const int max_target_index);
+  std::vector<std::unique_ptr<Kernel::Property>>
+  splitTimeSeriesProperty(Kernel::TimeSeriesProperty<TYPE> *tsp,
+                          const std::vector<Types::Core::DateAndTime> &split_datetime_vec,
+                          const int max_target_index) const;
 
   void groupOutputWorkspace();
 
@@ -155,6 +163,10 @@ private:
   int m_maxTargetIndex;
   Kernel::TimeSplitterType m_splitters;
   std::map<int, DataObjects::EventWorkspace_sptr> m_outputWorkspacesMap;
+  /// The smallest target index with an output workspace
+  int m_firstOutputTarget;
+  /// The output workspace of each target from m_firstOutputTarget on, null if none
+  std::vector<DataObjects::EventWorkspace *> m_outputTargetTable;
   std::vector<std::string> m_wsNames;
 
   std::vector<double> m_detTofOffsets;
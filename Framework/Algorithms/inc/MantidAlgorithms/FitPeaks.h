@@ -8,6 +8,7 @@
 
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/IBackgroundFunction.h"
+#include "MantidAPI/IFunctionFitter.h"
 #include "MantidAPI/IPeakFunction.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidAPI/MatrixWorkspace.h"
@@ -118,19 +119,23 @@ private:
   /// fit peaks in a same spectrum
   void fitSpectrumPeaks(size_t wi, const std::vector<double> &expected_peak_centers,
                         const std::shared_ptr<FitPeaksAlgorithm::PeakFitResult> &fit_result,
-                        std::vector<std::vector<double>> &lastGoodPeakParameters);
+                        std::vector<std::vector<double>> &lastGoodPeakParameters,
+                        const API::IFunctionFitter_sptr &peak_fitter);
+
+  /// create the fitter of peak and background used by one thread
+  API::IFunctionFitter_sptr createPeakFitter() const;
 
   /// fit background
   bool fitBackground(const size_t &ws_index, const std::pair<double, double> &fit_window,
                      const double &expected_peak_pos, const API::IBackgroundFunction_sptr &bkgd_func);
 
   // Peak fitting suite
-  double fitIndividualPeak(size_t wi, const API::IAlgorithm_sptr &fitter, const double expected_peak_center,
+  double fitIndividualPeak(size_t wi, const API::IFunctionFitter_sptr &fitter, const double expected_peak_center,
                            const std::pair<double, double> &fitwindow, const bool estimate_peak_width,
                            const API::IPeakFunction_sptr &peakfunction, const API::IBackgroundFunction_sptr &bkgdfunc);
 
   /// Methods to fit functions (general)
-  double fitFunctionSD(const API::IAlgorithm_sptr &fit, const API::IPeakFunction_sptr &peak_function,
+  double fitFunctionSD(const API::IFunctionFitter_sptr &fit, const API::IPeakFunction_sptr &peak_function,
                        const API::IBackgroundFunction_sptr &bkgd_function, const API::MatrixWorkspace_sptr &dataws,
                        size_t wsindex, const std::pair<double, double> &peak_range, const double &expected_peak_center,
                        bool estimate_peak_width, bool estimate_background);
@@ -139,7 +144,7 @@ private:
                        const std::pair<double, double> &vec_xmin, const std::pair<double, double> &vec_xmax);
 
   /// fit a single peak with high background
-  double fitFunctionHighBackground(const API::IAlgorithm_sptr &fit, const std::pair<double, double> &fit_window,
+  double fitFunctionHighBackground(const API::IFunctionFitter_sptr &fit, const std::pair<double, double> &fit_window,
                                    const size_t &ws_index, const double &expected_peak_center, bool observe_peak_shape,
                                    const API::IPeakFunction_sptr &peakfunction,
                                    const API::IBackgroundFunction_sptr &bkgdfunc);
@@ -37,6 +37,11 @@ class MonteCarloAbsorption;
   The error on all points is defined to be \f$\frac{SD}{\sqrt{N}}\f$, where SD
   is the standard deviation of the attenuation factors across the simulated
   tracks and N is the number of events generated.
+
+  When the same tracks are used for every wavelength, the tracks for all of
+  the events are generated first and their path lengths through each object
+  stored. The attenuation at every wavelength is then calculated from the
+  path lengths and attenuation coefficients of the objects.
 */
 class MANTID_ALGORITHMS_DLL MCAbsorptionStrategy : public IMCAbsorptionStrategy {
 public:
@@ -49,6 +54,13 @@ public:
                          MCInteractionStatistics &stats) override;
 
 private:
+  void calculateFromPathLengths(Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &finalPos,
+                                const std::vector<double> &lambdas, const double lambdaFixed,
+                                std::vector<double> &attenuationFactors, std::vector<double> &attFactorErrors,
+                                MCInteractionStatistics &stats);
+  TrackPair generateTracks(Kernel::PseudoRandomNumberGenerator &rng, const Geometry::BoundingBox &scatterBounds,
+                           const Kernel::V3D &finalPos, MCInteractionStatistics &stats) const;
+
   const IBeamProfile &m_beamProfile;
   const IMCInteractionVolume &m_scatterVol;
   const size_t m_nevents;
@@ -453,9 +453,10 @@ MatrixWorkspace_sptr ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUni
     }
     outSpectrumInfo.getDetectorValues(*fromUnit, *outputUnit, emode, signedTheta, i, pmap);
     try {
-      localFromUnit->toTOF(outputWS->dataX(i), emptyVec, l1, emode, pmap);
-      // Convert from time-of-flight to the desired unit
-      localOutputUnit->fromTOF(outputWS->dataX(i), emptyVec, l1, emode, pmap);
+      localFromUnit->initialize(l1, emode, pmap);
+      localOutputUnit->initialize(l1, emode, pmap);
+      // Convert the input unit to the desired unit through time-of-flight
+      Units::convertViaTOF(*localFromUnit, *localOutputUnit, outputWS->dataX(i));
 
       // EventWorkspace part, modifying the EventLists.
       if (m_inputEvents) {
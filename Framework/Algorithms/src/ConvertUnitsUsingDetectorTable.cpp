@@ -209,10 +209,10 @@ MatrixWorkspace_sptr ConvertUnitsUsingDetectorTable::convertViaTOF(Kernel::Unit_
         std::vector<double> values(outputWS->x(wsid).begin(), outputWS->x(wsid).end());
 
         UnitParametersMap pmap{{UnitParams::l2, l2}, {UnitParams::twoTheta, twoTheta}, {UnitParams::efixed, efixed}};
-        // Convert the input unit to time-of-flight
-        localFromUnit->toTOF(values, emptyVec, l1, emode, pmap);
-        // Convert from time-of-flight to the desired unit
-        localOutputUnit->fromTOF(values, emptyVec, l1, emode, pmap);
+        localFromUnit->initialize(l1, emode, pmap);
+        localOutputUnit->initialize(l1, emode, pmap);
+        // Convert the input unit to the desired unit through time-of-flight
+        Units::convertViaTOF(*localFromUnit, *localOutputUnit, values);
 
         outputWS->mutableX(wsid) = values;
 
@@ -161,6 +161,13 @@ void DetectorEfficiencyCor::retrieveProperties() {
   // these first three properties are fully checked by validators
   m_inputWS = getProperty("InputWorkspace");
   m_paraMap = &(m_inputWS->constInstrumentParameters());
+  // The detector parameters by detector index, which is the component index
+  // in the instrument of a workspace
+  m_pressures = m_paraMap->lookup(PRESSURE_PARAM, true);
+  m_wallThicknesses = m_paraMap->lookup(THICKNESS_PARAM, true);
+  if (!m_pressures || !m_wallThicknesses) {
+    throw std::invalid_argument("The instrument of the input workspace has no ComponentInfo");
+  }
 
   m_Ei = getProperty("IncidentEnergy");
   // If we're not given an Ei, see if one has been set.
@@ -215,12 +222,12 @@ void DetectorEfficiencyCor::correctForEfficiency(int64_t spectraIn, const Spectr
   for (const auto &index : spectrumDefinition) {
     const auto detIndex = index.first;
     const auto &det_member = detectorInfo.detector(detIndex);
-    Parameter_sptr par = m_paraMap->getRecursive(det_member.getComponentID(), PRESSURE_PARAM);
+    Parameter *par = m_pressures->get(detIndex);
     if (!par) {
       throw Exception::NotFoundError(PRESSURE_PARAM, spectraIn);
     }
     const double atms = par->value<double>();
-    par = m_paraMap->getRecursive(det_member.getComponentID(), THICKNESS_PARAM);
+    par = m_wallThicknesses->get(detIndex);
     if (!par) {
       throw Exception::NotFoundError(THICKNESS_PARAM, spectraIn);
     }
@@ -61,11 +61,11 @@ DECLARE_ALGORITHM(FilterEvents)
 FilterEvents::FilterEvents()
     : m_eventWS(), m_splittersWorkspace(), m_splitterTableWorkspace(), m_matrixSplitterWS(), m_detCorrectWorkspace(),
       m_useSplittersWorkspace(false), m_useArbTableSplitters(false), m_targetWorkspaceIndexSet(), m_splitters(),
-      m_outputWorkspacesMap(), m_wsNames(), m_detTofOffsets(), m_detTofFactors(), m_filterByPulseTime(false),
-      m_informationWS(), m_hasInfoWS(), m_progress(0.), m_outputWSNameBase(), m_toGroupWS(false), m_vecSplitterTime(),
-      m_vecSplitterGroup(), m_splitSampleLogs(false), m_useDBSpectrum(false), m_dbWSIndex(-1),
-      m_tofCorrType(NoneCorrect), m_specSkipType(), m_vecSkip(), m_isSplittersRelativeTime(false), m_filterStartTime(0),
-      m_runStartTime(0) {}
+      m_outputWorkspacesMap(), m_firstOutputTarget(0), m_outputTargetTable(), m_wsNames(), m_detTofOffsets(),
+      m_detTofFactors(), m_filterByPulseTime(false), m_informationWS(), m_hasInfoWS(), m_progress(0.),
+      m_outputWSNameBase(), m_toGroupWS(false), m_vecSplitterTime(), m_vecSplitterGroup(), m_splitSampleLogs(false),
+      m_useDBSpectrum(false), m_dbWSIndex(-1), m_tofCorrType(NoneCorrect), m_specSkipType(), m_vecSkip(),
+      m_isSplittersRelativeTime(false), m_filterStartTime(0), m_runStartTime(0) {}
 
 /** Declare Inputs
  */
@@ -656,24 +656,46 @@ void FilterEvents::splitTimeSeriesLogs(const std::vector<TimeSeriesProperty<int>
   if (m_useSplittersWorkspace)
     ++max_target_index;
 
-  // deal with integer time series property
-  for (const auto &int_tsp : int_tsp_vector) {
-    splitTimeSeriesProperty(int_tsp, split_datetime_vec, max_target_index);
-  }
-
-  // split double time series property
-  for (const auto &dbl_tsp : dbl_tsp_vector) {
-    splitTimeSeriesProperty(dbl_tsp, split_datetime_vec, max_target_index);
-  }
-
-  // deal with bool time series property
-  for (const auto &bool_tsp : bool_tsp_vector) {
-    splitTimeSeriesProperty(bool_tsp, split_datetime_vec, max_target_index);
+  // split the logs in parallel, each into one new log per target
+  const size_t numIntLogs = int_tsp_vector.size();
+  const size_t numDblLogs = dbl_tsp_vector.size();
+  const size_t numBoolLogs = bool_tsp_vector.size();
+  const size_t numLogs = numIntLogs + numDblLogs + numBoolLogs + string_tsp_vector.size();
+  std::vector<std::vector<std::unique_ptr<Kernel::Property>>> split_logs(numLogs);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t ilog = 0; ilog < static_cast<int64_t>(numLogs); ++ilog) {
+    PARALLEL_START_INTERUPT_REGION
+    auto index = static_cast<size_t>(ilog);
+    auto &split_log = split_logs[index];
+    if (index < numIntLogs) {
+      split_log = splitTimeSeriesProperty(int_tsp_vector[index], split_datetime_vec, max_target_index);
+    } else if ((index -= numIntLogs) < numDblLogs) {
+      split_log = splitTimeSeriesProperty(dbl_tsp_vector[index], split_datetime_vec, max_target_index);
+    } else if ((index -= numDblLogs) < numBoolLogs) {
+      split_log = splitTimeSeriesProperty(bool_tsp_vector[index], split_datetime_vec, max_target_index);
+    } else {
+      index -= numBoolLogs;
+      split_log = splitTimeSeriesProperty(string_tsp_vector[index], split_datetime_vec, max_target_index);
+    }
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 
-  // deal with string time series property
-  for (const auto &string_tsp : string_tsp_vector) {
-    splitTimeSeriesProperty(string_tsp, split_datetime_vec, max_target_index);
+  // assign to output workspaces
+  for (int tindex = 0; tindex <= max_target_index; ++tindex) {
+    // find output workspace
+    auto wsiter = m_outputWorkspacesMap.find(tindex);
+    if (wsiter == m_outputWorkspacesMap.end()) {
+      // unable to find workspace associated with target index
+      g_log.information() << "Workspace target (" << tindex << ") does not have workspace associated."
+                          << "\n";
+      continue;
+    }
+    // add the properties to the associated workspace
+    auto &run = wsiter->second->mutableRun();
+    for (auto &split_log : split_logs) {
+      run.addProperty(std::move(split_log[tindex]), true);
+    }
   }
 
   // integrate proton charge
@@ -700,53 +722,38 @@ void FilterEvents::splitTimeSeriesLogs(const std::vector<TimeSeriesProperty<int>
  * @param tsp :: a time series property instance
  * @param split_datetime_vec :: splitter
  * @param max_target_index :: maximum number of separated time series
+ * @return the split time series property of each target index
  */
 template <typename TYPE>
-void FilterEvents::splitTimeSeriesProperty(Kernel::TimeSeriesProperty<TYPE> *tsp,
-                                           std::vector<Types::Core::DateAndTime> &split_datetime_vec,
-                                           const int max_target_index) {
+std::vector<std::unique_ptr<Kernel::Property>>
+FilterEvents::splitTimeSeriesProperty(Kernel::TimeSeriesProperty<TYPE> *tsp,
+                                      const std::vector<Types::Core::DateAndTime> &split_datetime_vec,
+                                      const int max_target_index) const {
   // skip the sample logs if they are specified
   // get property name and etc
   const std::string &property_name = tsp->name();
   // generate new propertys for the source to split to
-  std::vector<std::unique_ptr<TimeSeriesProperty<TYPE>>> output_vector;
+  std::vector<TimeSeriesProperty<TYPE> *> split_properties;
+  std::vector<std::unique_ptr<Kernel::Property>> output_vector;
   for (int tindex = 0; tindex <= max_target_index; ++tindex) {
     auto new_property = std::make_unique<TimeSeriesProperty<TYPE>>(property_name);
     new_property->setUnits(tsp->units());
+    split_properties.emplace_back(new_property.get());
     output_vector.emplace_back(std::move(new_property));
   }
 
   // duplicate the time series property if the size is just one
   if (tsp->size() == 1) {
     // duplicate
-    for (size_t i_out = 0; i_out < output_vector.size(); ++i_out) {
-      output_vector[i_out]->addValue(tsp->firstTime(), tsp->firstValue());
+    for (auto &split_property : split_properties) {
+      split_property->addValue(tsp->firstTime(), tsp->firstValue());
     }
   } else {
     // split log
-    std::vector<TimeSeriesProperty<TYPE> *> split_properties(output_vector.size());
-    // use vector of raw pointers for splitting
-    std::transform(output_vector.begin(), output_vector.end(), split_properties.begin(),
-                   [](const std::unique_ptr<TimeSeriesProperty<TYPE>> &x) { return x.get(); });
     tsp->splitByTimeVector(split_datetime_vec, m_vecSplitterGroup, split_properties);
   }
 
-  // assign to output workspaces
-  for (int tindex = 0; tindex <= max_target_index; ++tindex) {
-    // find output workspace
-    auto wsiter = m_outputWorkspacesMap.find(tindex);
-    if (wsiter == m_outputWorkspacesMap.end()) {
-      // unable to find workspace associated with target index
-      g_log.information() << "Workspace target (" << tindex << ") does not have workspace associated."
-                          << "\n";
-    } else {
-      // add property to the associated workspace
-      DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
-      ws_i->mutableRun().addProperty(std::move(output_vector[tindex]), true);
-    }
-  }
-
-  return;
+  return output_vector;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1598,6 +1605,34 @@ void FilterEvents::setupCustomizedTOFCorrection() {
   }
 }
 
+/** Lay out the output workspaces by target index, once per execution, so
+ * that the event lists of a spectrum are found without a map
+ */
+void FilterEvents::buildOutputTargetTable() {
+  m_outputTargetTable.clear();
+  m_firstOutputTarget = 0;
+  if (m_outputWorkspacesMap.empty())
+    return;
+  m_firstOutputTarget = m_outputWorkspacesMap.begin()->first;
+  const auto lastTarget = static_cast<int64_t>(m_outputWorkspacesMap.rbegin()->first);
+  m_outputTargetTable.assign(static_cast<size_t>(lastTarget - m_firstOutputTarget + 1), nullptr);
+  for (const auto &ws : m_outputWorkspacesMap)
+    m_outputTargetTable[static_cast<size_t>(static_cast<int64_t>(ws.first) - m_firstOutputTarget)] = ws.second.get();
+}
+
+/** Get the event lists of a spectrum in all the output workspaces. Each
+ * thread asks for a different spectrum, so no lock is needed.
+ * @param wsIndex :: index of the spectrum
+ * @param outputs :: set to the event lists by target index. It is reused from
+ * spectrum to spectrum.
+ */
+void FilterEvents::getOutputEventLists(size_t wsIndex, DataObjects::EventListSplitOutputs &outputs) const {
+  outputs.firstTarget = m_firstOutputTarget;
+  outputs.lists.resize(m_outputTargetTable.size());
+  for (size_t i = 0; i < m_outputTargetTable.size(); ++i)
+    outputs.lists[i] = m_outputTargetTable[i] ? &m_outputTargetTable[i]->getSpectrum(wsIndex) : nullptr;
+}
+
 /** Main filtering method
  * Structure: per spectrum --> per workspace
  */
@@ -1609,21 +1644,19 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   g_log.debug() << "Number of spectra in input/source EventWorkspace = " << numberOfSpectra << ".\n";
 
   // FIXME - Turn on parallel:
+  buildOutputTargetTable();
+  // One table of output event lists per thread, reused from spectrum to spectrum
+  std::vector<DataObjects::EventListSplitOutputs> threadOutputs(PARALLEL_GET_MAX_THREADS);
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      // Get the output event lists (should be empty)
+      auto &outputs = threadOutputs[PARALLEL_THREAD_NUMBER];
+      getOutputEventLists(static_cast<size_t>(iws), outputs);
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
 
@@ -1679,21 +1712,19 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
                     "by pulse time.");
   }
 
+  buildOutputTargetTable();
+  // One table of output event lists per thread, reused from spectrum to spectrum
+  std::vector<DataObjects::EventListSplitOutputs> threadOutputs(PARALLEL_GET_MAX_THREADS);
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      // Get the output event lists (should be empty)
+      auto &outputs = threadOutputs[PARALLEL_THREAD_NUMBER];
+      getOutputEventLists(static_cast<size_t>(iws), outputs);
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
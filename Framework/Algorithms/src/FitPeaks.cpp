@@ -15,6 +15,7 @@
 #include "MantidAPI/FuncMinimizerFactory.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/FunctionProperty.h"
+#include "MantidAPI/IFunctionFitter.h"
 #include "MantidAPI/MultiDomainFunction.h"
 #include "MantidAPI/TableRow.h"
 #include "MantidAPI/WorkspaceProperty.h"
@@ -859,6 +860,8 @@ std::vector<std::shared_ptr<FitPeaksAlgorithm::PeakFitResult>> FitPeaks::fitPeak
     // vector to store fit params for last good fit to each peak
     std::vector<std::vector<double>> lastGoodPeakParameters(m_numPeaksToFit,
                                                             std::vector<double>(m_peakFunction->nParams(), 0.0));
+    // one fitter per thread, which keeps its cost function between the fits
+    const auto peak_fitter = createPeakFitter();
 
     for (auto wi = iws_begin; wi < iws_end; ++wi) {
       // peaks to fit
@@ -869,7 +872,8 @@ std::vector<std::shared_ptr<FitPeaksAlgorithm::PeakFitResult>> FitPeaks::fitPeak
       std::shared_ptr<FitPeaksAlgorithm::PeakFitResult> fit_result =
           std::make_shared<FitPeaksAlgorithm::PeakFitResult>(m_numPeaksToFit, numfuncparams);
 
-      fitSpectrumPeaks(static_cast<size_t>(wi), expected_peak_centers, fit_result, lastGoodPeakParameters);
+      fitSpectrumPeaks(static_cast<size_t>(wi), expected_peak_centers, fit_result, lastGoodPeakParameters,
+                       peak_fitter);
 
       PARALLEL_CRITICAL(FindPeaks_WriteOutput) {
         writeFitResult(static_cast<size_t>(wi), expected_peak_centers, fit_result);
@@ -884,6 +888,32 @@ std::vector<std::shared_ptr<FitPeaksAlgorithm::PeakFitResult>> FitPeaks::fitPeak
   return fit_result_vector;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Create the fitter of the peak and background functions. It does the same
+ * as a child Fit algorithm with the fitting options of this algorithm, without
+ * setting up an algorithm for every peak.
+ */
+API::IFunctionFitter_sptr FitPeaks::createPeakFitter() const {
+  API::IFunctionFitter_sptr fitter;
+  try {
+    fitter = FunctionFitterFactory::Instance().create("FunctionFitter");
+  } catch (Exception::NotFoundError &) {
+    std::stringstream errss;
+    errss << "The FitPeak algorithm requires the CurveFitting library";
+    g_log.error(errss.str());
+    throw std::runtime_error(errss.str());
+  }
+
+  API::IFunctionFitter::Options options;
+  options.minimizer = m_minimizer;
+  options.costFunction = m_costFunction;
+  options.maxIterations = static_cast<size_t>(m_fitIterations);
+  options.calcErrors = true;
+  options.ignoreInvalidData = true;
+  fitter->setOptions(options);
+  return fitter;
+}
+
 namespace {
 /// Supported peak profiles for observation
 std::vector<std::string> supported_peak_profiles{"Gaussian", "Lorentzian", "PseudoVoigt", "Voigt",
@@ -934,7 +964,8 @@ double numberCounts(const Histogram &histogram, const double xmin, const double
  */
 void FitPeaks::fitSpectrumPeaks(size_t wi, const std::vector<double> &expected_peak_centers,
                                 const std::shared_ptr<FitPeaksAlgorithm::PeakFitResult> &fit_result,
-                                std::vector<std::vector<double>> &lastGoodPeakParameters) {
+                                std::vector<std::vector<double>> &lastGoodPeakParameters,
+                                const API::IFunctionFitter_sptr &peak_fitter) {
   // Spectrum contains very weak signal: do not proceed and return
   if (numberCounts(m_inputMatrixWS->histogram(wi)) <= m_minPeakHeight) {
     for (size_t i = 0; i < fit_result->getNumberPeaks(); ++i)
@@ -942,25 +973,9 @@ void FitPeaks::fitSpectrumPeaks(size_t wi, const std::vector<double> &expected_p
     return; // don't do anything
   }
 
-  // Set up sub algorithm Fit for peak and background
-  IAlgorithm_sptr peak_fitter; // both peak and background (combo)
-  try {
-    peak_fitter = createChildAlgorithm("Fit", -1, -1, false);
-  } catch (Exception::NotFoundError &) {
-    std::stringstream errss;
-    errss << "The FitPeak algorithm requires the CurveFitting library";
-    g_log.error(errss.str());
-    throw std::runtime_error(errss.str());
-  }
-
   // Clone background function
   IBackgroundFunction_sptr bkgdfunction = std::dynamic_pointer_cast<API::IBackgroundFunction>(m_bkgdFunction->clone());
 
-  // set up properties of algorithm (reference) 'Fit'
-  peak_fitter->setProperty("Minimizer", m_minimizer);
-  peak_fitter->setProperty("CostFunction", m_costFunction);
-  peak_fitter->setProperty("CalcErrors", true);
-
   const double x0 = m_inputMatrixWS->histogram(wi).x().front();
   const double xf = m_inputMatrixWS->histogram(wi).x().back();
 
@@ -1428,9 +1443,9 @@ bool FitPeaks::fitBackground(const size_t &ws_index, const std::pair<double, dou
 //----------------------------------------------------------------------------------------------
 /** Fit an individual peak
  */
-double FitPeaks::fitIndividualPeak(size_t wi, const API::IAlgorithm_sptr &fitter, const double expected_peak_center,
-                                   const std::pair<double, double> &fitwindow, const bool estimate_peak_width,
-                                   const API::IPeakFunction_sptr &peakfunction,
+double FitPeaks::fitIndividualPeak(size_t wi, const API::IFunctionFitter_sptr &fitter,
+                                   const double expected_peak_center, const std::pair<double, double> &fitwindow,
+                                   const bool estimate_peak_width, const API::IPeakFunction_sptr &peakfunction,
                                    const API::IBackgroundFunction_sptr &bkgdfunc) {
   double cost(DBL_MAX);
 
@@ -1457,7 +1472,7 @@ double FitPeaks::fitIndividualPeak(size_t wi, const API::IAlgorithm_sptr &fitter
  * This is the core fitting algorithm to deal with the simplest situation
  * @exception :: Fit.isExecuted is false (cannot be executed)
  */
-double FitPeaks::fitFunctionSD(const IAlgorithm_sptr &fit, const API::IPeakFunction_sptr &peak_function,
+double FitPeaks::fitFunctionSD(const API::IFunctionFitter_sptr &fit, const API::IPeakFunction_sptr &peak_function,
                                const API::IBackgroundFunction_sptr &bkgd_function,
                                const API::MatrixWorkspace_sptr &dataws, size_t wsindex,
                                const std::pair<double, double> &peak_range, const double &expected_peak_center,
@@ -1503,15 +1518,7 @@ double FitPeaks::fitFunctionSD(const IAlgorithm_sptr &fit, const API::IPeakFunct
   comp_func->addFunction(bkgd_function);
   IFunction_sptr fitfunc = std::dynamic_pointer_cast<IFunction>(comp_func);
 
-  // Set the properties
-  fit->setProperty("Function", fitfunc);
-  fit->setProperty("InputWorkspace", dataws);
-  fit->setProperty("WorkspaceIndex", static_cast<int>(wsindex));
-  fit->setProperty("MaxIterations", m_fitIterations); // magic number
-  fit->setProperty("StartX", peak_range.first);
-  fit->setProperty("EndX", peak_range.second);
-  fit->setProperty("IgnoreInvalidData", true);
-
+  std::string constraints;
   if (m_constrainPeaksPosition) {
     // set up a constraint on peak position
     double peak_center = peak_function->centre();
@@ -1521,31 +1528,27 @@ double FitPeaks::fitFunctionSD(const IAlgorithm_sptr &fit, const API::IPeakFunct
                            << " < " << (peak_center + 0.5 * peak_width);
 
     // set up a constraint on peak height
-    fit->setProperty("Constraints", peak_center_constraint.str());
+    constraints = peak_center_constraint.str();
   }
 
   // Execute fit and get result of fitting background
-  g_log.debug() << "[E1201] FitSingleDomain Before fitting, Fit function: " << fit->asString() << "\n";
-  errorid << " starting function [" << comp_func->asString() << "]";
+  const std::string startFunction = comp_func->asString();
+  g_log.debug() << "[E1201] FitSingleDomain Before fitting, Fit function: " << startFunction << "\n";
+  API::IFunctionFitter::Result fitResult;
   try {
-    fit->execute();
-    g_log.debug() << "[E1202] FitSingleDomain After fitting, Fit function: " << fit->asString() << "\n";
-
-    if (!fit->isExecuted()) {
-      g_log.warning() << "Fitting peak SD (single domain) failed to execute. " + errorid.str();
-      return DBL_MAX;
-    }
+    fitResult = fit->fit(fitfunc, dataws, wsindex, peak_range.first, peak_range.second, constraints);
+    if (g_log.is(Kernel::Logger::Priority::PRIO_DEBUG))
+      g_log.debug() << "[E1202] FitSingleDomain After fitting, Fit function: " << fitfunc->asString() << "\n";
   } catch (std::invalid_argument &e) {
-    errorid << ": " << e.what();
+    errorid << " starting function [" << startFunction << "]: " << e.what();
     g_log.warning() << "While fitting " + errorid.str();
     return DBL_MAX; // probably the wrong thing to do
   }
 
   // Retrieve result
-  std::string fitStatus = fit->getProperty("OutputStatus");
   double chi2{std::numeric_limits<double>::max()};
-  if (fitStatus == "success") {
-    chi2 = fit->getProperty("OutputChi2overDoF");
+  if (fitResult.success()) {
+    chi2 = fitResult.chi2OverDoF;
   }
 
   return chi2;
@@ -1612,9 +1615,10 @@ double FitPeaks::fitFunctionMD(API::IFunction_sptr fit_function, const API::Matr
 
 //----------------------------------------------------------------------------------------------
 /// Fit peak with high background
-double FitPeaks::fitFunctionHighBackground(const IAlgorithm_sptr &fit, const std::pair<double, double> &fit_window,
-                                           const size_t &ws_index, const double &expected_peak_center,
-                                           bool observe_peak_shape, const API::IPeakFunction_sptr &peakfunction,
+double FitPeaks::fitFunctionHighBackground(const API::IFunctionFitter_sptr &fit,
+                                           const std::pair<double, double> &fit_window, const size_t &ws_index,
+                                           const double &expected_peak_center, bool observe_peak_shape,
+                                           const API::IPeakFunction_sptr &peakfunction,
                                            const API::IBackgroundFunction_sptr &bkgdfunc) {
   // high background to reduce
   API::IBackgroundFunction_sptr high_bkgd_function(nullptr);
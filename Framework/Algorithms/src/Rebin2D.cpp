@@ -113,11 +113,15 @@ void Rebin2D::exec() {
   const auto nreports(static_cast<size_t>(numYBins));
   m_progress = std::make_unique<API::Progress>(this, 0.0, 1.0, nreports);
 
+  // Each thread accumulates into its own partial output, which are added to
+  // the output workspace after the loop
+  auto partials = FractionalRebinning::createPartialOutputs(*outputWS);
   PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
   for (int64_t i = 0; i < static_cast<int64_t>(numYBins); ++i) {
     PARALLEL_START_INTERUPT_REGION
 
     m_progress->report("Computing polygon intersections");
+    auto &partial = partials[PARALLEL_THREAD_NUMBER];
     const double vlo = oldYEdges[i];
     const double vhi = oldYEdges[i + 1];
     for (size_t j = 0; j < numXBins; ++j) {
@@ -127,15 +131,16 @@ void Rebin2D::exec() {
       const double x_jp1 = oldXEdges[j + 1];
       Quadrilateral inputQ(x_j, x_jp1, vlo, vhi);
       if (!useFractionalArea) {
-        FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, *outputWS, newYBins.rawData());
+        FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, partial, newYBins.rawData());
       } else {
-        FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, i, j, *outputRB, newYBins.rawData(), inputHasFA);
+        FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, i, j, partial, newYBins.rawData(), inputHasFA);
       }
     }
 
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
+  FractionalRebinning::addPartialOutputs(partials, *outputWS);
   if (useFractionalArea) {
     FractionalRebinning::finalizeFractionalRebin(*outputRB);
     outputRB->finalize(true);
@@ -11,6 +11,10 @@
 
 #include "MantidAlgorithms/SampleCorrections/RectangularBeamProfile.h"
 #include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/Track.h"
+#include "MantidKernel/Material.h"
+
+#include <algorithm>
 
 namespace Mantid {
 using Kernel::DeltaEMode;
@@ -71,6 +75,10 @@ void MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng, c
                                      const std::vector<double> &lambdas, const double lambdaFixed,
                                      std::vector<double> &attenuationFactors, std::vector<double> &attFactorErrors,
                                      MCInteractionStatistics &stats) {
+  if (!m_regenerateTracksForEachLambda) {
+    calculateFromPathLengths(rng, finalPos, lambdas, lambdaFixed, attenuationFactors, attFactorErrors, stats);
+    return;
+  }
   const auto scatterBounds = m_scatterVol.getFullBoundingBox();
   const auto nbins = static_cast<int>(lambdas.size());
 
@@ -135,5 +143,134 @@ void MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng, c
                  [this](double v) -> double { return v / sqrt(static_cast<double>(m_nevents)); });
 }
 
+/**
+ * Compute the correction using the same tracks for every wavelength. The
+ * tracks for all of the events are generated first, in the same order as
+ * calculate, and the length of each link stored with the index of a column of
+ * attenuation coefficients for its object and direction. The attenuation at
+ * every wavelength is then calculated for each event from the stored lengths.
+ * @param rng A reference to a PseudoRandomNumberGenerator
+ * @param finalPos Defines the final position of the neutron, assumed to be
+ * where it is detected
+ * @param lambdas Set of wavelength values from the input workspace
+ * @param lambdaFixed Efixed value for a detector ID converted to wavelength, in
+ * \f$\\A^-1\f$
+ * @param attenuationFactors A vector containing the calculated correction
+ * factors
+ * @param attFactorErrors A vector containing the calculated correction factor
+ * errors
+ * @param stats A statistics class to hold the statistics on the generated
+ * tracks
+ */
+void MCAbsorptionStrategy::calculateFromPathLengths(Kernel::PseudoRandomNumberGenerator &rng,
+                                                    const Kernel::V3D &finalPos, const std::vector<double> &lambdas,
+                                                    const double lambdaFixed, std::vector<double> &attenuationFactors,
+                                                    std::vector<double> &attFactorErrors,
+                                                    MCInteractionStatistics &stats) {
+  const auto scatterBounds = m_scatterVol.getFullBoundingBox();
+  const size_t nbins = lambdas.size();
+
+  // The objects crossed by the tracks. Column 2 * i holds the lengths before
+  // scattering in objects[i] and column 2 * i + 1 those after scattering
+  std::vector<const Geometry::IObject *> objects;
+  auto columnIndex = [&objects](const Geometry::IObject *object, const size_t direction) {
+    auto iter = std::find(objects.cbegin(), objects.cend(), object);
+    if (iter == objects.cend()) {
+      objects.emplace_back(object);
+      iter = std::prev(objects.cend());
+    }
+    return 2 * static_cast<size_t>(std::distance(objects.cbegin(), iter)) + direction;
+  };
+  // The links of event i are linkColumns/linkLengths[eventStart[i]:eventStart[i + 1]]
+  std::vector<size_t> eventStart{0}, linkColumns;
+  std::vector<double> linkLengths;
+  eventStart.reserve(m_nevents + 1);
+  for (size_t i = 0; i < m_nevents; ++i) {
+    const auto tracks = generateTracks(rng, scatterBounds, finalPos, stats);
+    size_t direction(0);
+    for (const auto &track : {std::get<1>(tracks), std::get<2>(tracks)}) {
+      for (const auto &link : *track) {
+        linkColumns.emplace_back(columnIndex(link.object, direction));
+        linkLengths.emplace_back(link.distInsideObject);
+      }
+      ++direction;
+    }
+    eventStart.emplace_back(linkColumns.size());
+  }
+
+  // Attenuation coefficients of each column at each wavelength
+  std::vector<double> coefficients(2 * objects.size() * nbins);
+  for (size_t column = 0; column < 2 * objects.size(); ++column) {
+    const auto &material = objects[column / 2]->material();
+    const bool afterScatter = column % 2 == 1;
+    const bool fixed =
+        (m_EMode == DeltaEMode::Direct && !afterScatter) || (m_EMode == DeltaEMode::Indirect && afterScatter);
+    auto *columnCoefficients = coefficients.data() + column * nbins;
+    if (fixed) {
+      std::fill_n(columnCoefficients, nbins, material.attenuationCoefficient(lambdaFixed));
+    } else {
+      std::transform(lambdas.cbegin(), lambdas.cend(), columnCoefficients,
+                     [&material](const double lambda) { return material.attenuationCoefficient(lambda); });
+    }
+  }
+
+  std::vector<double> wgtMean(nbins), wgtM2(nbins), exponent(nbins);
+  for (size_t i = 0; i < m_nevents; ++i) {
+    std::fill(exponent.begin(), exponent.end(), 0.0);
+    for (size_t link = eventStart[i]; link < eventStart[i + 1]; ++link) {
+      const double length = linkLengths[link];
+      const auto *columnCoefficients = coefficients.data() + linkColumns[link] * nbins;
+      for (size_t j = 0; j < nbins; ++j) {
+        exponent[j] += columnCoefficients[j] * length;
+      }
+    }
+    const double count = static_cast<double>(i + 1);
+    for (size_t j = 0; j < nbins; ++j) {
+      const double wgt = exp(-exponent[j]);
+      attenuationFactors[j] += wgt;
+      // increment standard deviation using Welford algorithm
+      const double delta = wgt - wgtMean[j];
+      wgtMean[j] += delta / count;
+      wgtM2[j] += delta * (wgt - wgtMean[j]);
+    }
+  }
+
+  const auto nevents = static_cast<double>(m_nevents);
+  for (size_t j = 0; j < nbins; ++j) {
+    attenuationFactors[j] /= nevents;
+    // sample SD (M2/n-1) gives NaN for m_nevents=1, but that's correct. The
+    // error is the standard deviation of the mean
+    attFactorErrors[j] = sqrt(wgtM2[j] / (nevents - 1)) / sqrt(nevents);
+  }
+}
+
+/**
+ * Generate a pair of tracks before and after scattering, trying again if the
+ * interaction volume fails to produce them
+ * @param rng A reference to a PseudoRandomNumberGenerator
+ * @param scatterBounds The bounding box of the interaction volume
+ * @param finalPos Defines the final position of the neutron
+ * @param stats A statistics class to hold the statistics on the generated
+ * tracks
+ * @return The successful tuple from IMCInteractionVolume::calculateBeforeAfterTrack
+ */
+TrackPair MCAbsorptionStrategy::generateTracks(Kernel::PseudoRandomNumberGenerator &rng,
+                                               const Geometry::BoundingBox &scatterBounds, const Kernel::V3D &finalPos,
+                                               MCInteractionStatistics &stats) const {
+  for (size_t attempts = 0; attempts < m_maxScatterAttempts; ++attempts) {
+    const auto neutron = m_beamProfile.generatePoint(rng, scatterBounds);
+    auto tracks = m_scatterVol.calculateBeforeAfterTrack(rng, neutron.startPos, finalPos, stats);
+    if (std::get<0>(tracks)) {
+      return tracks;
+    }
+  }
+  throw std::runtime_error("Unable to generate valid track through "
+                           "sample interaction volume after " +
+                           std::to_string(m_maxScatterAttempts) +
+                           " attempts. Try increasing the maximum "
+                           "threshold or if this does not help then "
+                           "please check the defined shape.");
+}
+
 } // namespace Algorithms
 } // namespace Mantid
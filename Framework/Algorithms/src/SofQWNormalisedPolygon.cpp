@@ -353,6 +353,9 @@ void SofQWNormalisedPolygon::exec() {
   const auto &inputIndices = inputWS->indexInfo();
   const auto &spectrumInfo = inputWS->spectrumInfo();
 
+  // Each thread accumulates into its own partial output, which are added to
+  // the output workspace after the loop
+  auto partials = FractionalRebinning::createPartialOutputs(*outputWS);
   PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
   for (int64_t i = 0; i < static_cast<int64_t>(nHistos); ++i) {
     PARALLEL_START_INTERUPT_REGION
@@ -360,6 +363,7 @@ void SofQWNormalisedPolygon::exec() {
     if (spectrumInfo.isMasked(i) || spectrumInfo.isMonitor(i)) {
       continue;
     }
+    auto &partial = partials[PARALLEL_THREAD_NUMBER];
     const auto *det = m_EmodeProperties.m_emode == 1 ? nullptr : &spectrumInfo.detector(i);
 
     const double thetaLower = m_twoThetaLowers[i];
@@ -367,6 +371,8 @@ void SofQWNormalisedPolygon::exec() {
 
     const auto specNo = static_cast<specnum_t>(inputIndices.spectrumNumber(i));
     std::stringstream logStream;
+    // The q bins of the polygons of this spectrum
+    std::vector<size_t> qIndices;
     for (size_t j = 0; j < nEnergyBins; ++j) {
       m_progress->report("Computing polygon intersections");
       // For each input polygon test where it intersects with
@@ -387,18 +393,21 @@ void SofQWNormalisedPolygon::exec() {
       }
 
       using FractionalRebinning::rebinToFractionalOutput;
-      rebinToFractionalOutput(Quadrilateral(ll, lr, ur, ul), inputWS, i, j, *outputWS, m_Qout);
+      rebinToFractionalOutput(Quadrilateral(ll, lr, ur, ul), inputWS, i, j, partial, m_Qout);
 
       // Find which q bin this point lies in
       const MantidVec::difference_type qIndex = std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) - m_Qout.begin();
       if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
-        // Add this spectra-detector pair to the mapping
-        PARALLEL_CRITICAL(SofQWNormalisedPolygon_spectramap) {
-          // Could do a more complete merge of spectrum definitions here, but
-          // historically only the ID of the first detector in the spectrum is
-          // used, so I am keeping that for now.
-          detIDMapping[qIndex - 1].add(spectrumInfo.spectrumDefinition(i)[0].first);
-        }
+        qIndices.emplace_back(static_cast<size_t>(qIndex - 1));
+      }
+    }
+    // Add this spectra-detector pair to the mapping
+    PARALLEL_CRITICAL(SofQWNormalisedPolygon_spectramap) {
+      // Could do a more complete merge of spectrum definitions here, but
+      // historically only the ID of the first detector in the spectrum is
+      // used, so I am keeping that for now.
+      for (const auto qIndex : qIndices) {
+        detIDMapping[qIndex].add(spectrumInfo.spectrumDefinition(i)[0].first);
       }
     }
     if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
@@ -408,6 +417,7 @@ void SofQWNormalisedPolygon::exec() {
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
+  FractionalRebinning::addPartialOutputs(partials, *outputWS);
 
   FractionalRebinning::finalizeFractionalRebin(*outputWS);
   outputWS->finalize();
@@ -134,6 +134,64 @@ public:
     TS_ASSERT_DELTA(expectedSD / sqrt(nevents), attenuationFactorErrors[0], 1e-08);
   }
 
+  void test_each_wavelength_is_attenuated_along_the_same_tracks() {
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    // same geometry as test_mean_and_sd_calculation with an absorbing sample
+    Mantid::API::Sample testSampleSphere;
+    auto shape = ComponentCreationHelper::createSphere(0.06);
+    const Mantid::Kernel::Material material(
+        "test", Mantid::PhysicalConstants::NeutronAtom(0, 0, 0, 0, 0, 1 /*total scattering xs*/, 2 /*absorption xs*/),
+        1);
+    shape->setMaterial(material);
+    testSampleSphere.setShape(shape);
+
+    MockBeamProfile testBeamProfile;
+    EXPECT_CALL(testBeamProfile, defineActiveRegion(_)).WillOnce(Return(testSampleSphere.getShape().getBoundingBox()));
+    const size_t nevents(3), maxTries(100);
+    MCInteractionVolume interactionVolume(testSampleSphere);
+    MCAbsorptionStrategy mcabsorb(interactionVolume, testBeamProfile, Mantid::Kernel::DeltaEMode::Type::Elastic,
+                                  nevents, maxTries, false);
+    MockRNG rng;
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(3 * nevents))
+        .WillOnce(Return(0.5)) // one point at origin
+        .WillOnce(Return(0.5))
+        .WillOnce(Return(0.5))
+        .WillOnce(Return(0.5)) // one point up
+        .WillOnce(Return(1))
+        .WillOnce(Return(0.5))
+        .WillOnce(Return(0.5)) // one point down
+        .WillOnce(Return(0))
+        .WillOnce(Return(0.5));
+    const Mantid::Algorithms::IBeamProfile::Ray testRay = {V3D(0, 0, -0.08), V3D(0, 0, 1)};
+    EXPECT_CALL(testBeamProfile, generatePoint(_, _))
+        .Times(Exactly(static_cast<int>(nevents)))
+        .WillRepeatedly(Return(testRay));
+    const V3D endPos(0, 0, 0.08);
+
+    const std::vector<double> lambdas = {1.0, 2.5, 4.0};
+    std::vector<double> attenuationFactors(lambdas.size(), 0.);
+    std::vector<double> attenuationFactorErrors(lambdas.size(), 0.);
+    MCInteractionStatistics trackStatistics(-1, testSampleSphere);
+    mcabsorb.calculate(rng, endPos, lambdas, 0., attenuationFactors, attenuationFactorErrors, trackStatistics);
+
+    // total track lengths in metres, see test_mean_and_sd_calculation
+    const std::vector<double> trackLengths = {2 * 0.072, 2 * 0.06, 2 * 0.072};
+    for (size_t j = 0; j < lambdas.size(); ++j) {
+      double expectedAverage(0.);
+      for (const auto trackLength : trackLengths) {
+        expectedAverage += material.attenuation(trackLength, lambdas[j]);
+      }
+      expectedAverage /= static_cast<double>(nevents);
+      TS_ASSERT_DELTA(expectedAverage, attenuationFactors[j], 1e-08);
+    }
+    // more absorption at longer wavelengths
+    TS_ASSERT_LESS_THAN(attenuationFactors[2], attenuationFactors[0]);
+  }
+
   void test_Calculate() {
     using namespace MonteCarloTesting;
     using namespace ::testing;
@@ -11,6 +11,7 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/IFunction.h"
+#include "MantidAPI/IFunctionFitter.h"
 #include "MantidAPI/IPeakFunction.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidCurveFitting/Algorithms/PlotPeakByLogValueHelper.h"
@@ -69,7 +70,11 @@ private:
   std::shared_ptr<Algorithm> runSingleFit(bool createFitOutput, bool outputCompositeMembers,
                                           bool outputConvolvedMembers, const API::IFunction_sptr &ifun,
                                           const InputSpectraToFit &data, double startX, double endX,
-                                          const std::string &exclude);
+                                          const std::string &exclude, const std::string &minimizer);
+
+  API::IFunctionFitter::Result runSingleFit(API::IFunctionFitter &fitter, const API::IFunction_sptr &ifun,
+                                            const InputSpectraToFit &data, double startX, double endX,
+                                            const std::string &minimizer);
 
   double calculateLogValue(const std::string &logName, const InputSpectraToFit &data);
 
@@ -32,6 +32,20 @@ public:
   /// Get short name of minimizer - useful for say labels in guis
   std::string shortName() const override { return "Chi-sq"; };
 
+  /// The value, derivatives and Hessian of the cost function summed over some
+  /// of the domains, e.g. by one thread.
+  struct PartialSums {
+    PartialSums(size_t nDeriv, size_t nHessian);
+    /// Add another partial sum to this one
+    void add(const PartialSums &other);
+    double value{0.0};
+    GSLVector der;
+    GSLMatrix hessian;
+  };
+  /// Add the value, derivatives and Hessian calculated on a domain to a sum
+  void accumulateValDerivHessian(const API::IFunction_sptr &function, const API::FunctionDomain_sptr &domain,
+                                 const API::FunctionValues_sptr &values, bool evalHessian, PartialSums &sums) const;
+
 protected:
   void calActiveCovarianceMatrix(GSLMatrix &covar, double epsrel = 1e-8) override;
 
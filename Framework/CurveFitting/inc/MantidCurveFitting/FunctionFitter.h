@@ -0,0 +1,57 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidAPI/IFunctionFitter.h"
+#include "MantidCurveFitting/DllConfig.h"
+#include "MantidCurveFitting/FitMW.h"
+
+namespace Mantid {
+namespace CurveFitting {
+namespace CostFunctions {
+class CostFuncFitting;
+}
+
+/** FunctionFitter : the IFunctionFitter of the CurveFitting library. It does
+  what the Fit algorithm does for a single spectrum with the Simple domain
+  type and no output workspaces, using FitMW for the data.
+
+  The cost function is kept between fits with the same cost function option,
+  and the domain and values are kept while the data (workspace, index, range)
+  stay the same, e.g. when refitting a peak with a different starting
+  function. The data in the workspace must not change in between.
+*/
+class MANTID_CURVEFITTING_DLL FunctionFitter : public API::IFunctionFitter {
+public:
+  Result fit(const API::IFunction_sptr &function, const API::MatrixWorkspace_sptr &workspace, size_t workspaceIndex,
+             double startX, double endX, const std::string &constraints = "") override;
+
+private:
+  void setData(const API::MatrixWorkspace_sptr &workspace, size_t workspaceIndex, double startX, double endX);
+  void initializeMinimizer(const API::IFunction_sptr &function, size_t maxIterations);
+
+  /// Creates the domain and values and initializes the functions
+  FitMW m_domainCreator;
+  /// The data of the last fit
+  API::MatrixWorkspace_sptr m_workspace;
+  size_t m_workspaceIndex{0};
+  double m_startX{0.0};
+  double m_endX{0.0};
+  bool m_ignoreInvalidData{false};
+  int m_peakRadius{0};
+  std::shared_ptr<API::FunctionDomain> m_domain;
+  std::shared_ptr<API::FunctionValues> m_values;
+  /// The cost function and the option it was created for
+  std::shared_ptr<CostFunctions::CostFuncFitting> m_costFunction;
+  std::string m_costFunctionName;
+  /// The minimizer of the current fit
+  API::IFuncMinimizer_sptr m_minimizer;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
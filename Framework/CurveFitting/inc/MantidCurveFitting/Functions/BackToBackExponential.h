@@ -57,6 +57,8 @@ public:
   const std::string category() const override { return "Peak"; }
   void function1D(double *out, const double *xValues, const size_t nData) const override;
   void functionDeriv1D(API::Jacobian *jacobian, const double *xValues, const size_t nData) override;
+  void functionWithDeriv(const API::FunctionDomain &domain, API::FunctionValues &values,
+                         API::Jacobian &jacobian) override;
 
 protected:
   /// overwrite IFunction base class method, which declare function parameters
@@ -66,6 +68,8 @@ protected:
   /// Derivative evaluation method to be implemented in the inherited classes
   void functionDerivLocal(API::Jacobian *, const double *, const size_t) override {}
   double expWidth() const;
+  /// Calculate the values and/or the derivatives
+  void evaluate(double *out, API::Jacobian *jacobian, const double *xValues, const size_t nData) const;
 };
 
 using BackToBackExponential_sptr = std::shared_ptr<BackToBackExponential>;
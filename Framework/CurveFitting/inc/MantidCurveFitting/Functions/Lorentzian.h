@@ -54,6 +54,8 @@ public:
 protected:
   void functionLocal(double *out, const double *xValues, const size_t nData) const override;
   void functionDerivLocal(API::Jacobian *out, const double *xValues, const size_t nData) override;
+  bool functionLocalWithDeriv(double *out, API::Jacobian *jacobian, const double *xValues,
+                              const size_t nData) override;
   /// overwrite IFunction base class method, which declare function parameters
   void init() override;
   /// Calculate histogram data.
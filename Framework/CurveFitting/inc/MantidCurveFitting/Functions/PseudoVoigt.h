@@ -59,6 +59,9 @@ protected:
 
   void functionDerivLocal(API::Jacobian *out, const double *xValues, const size_t nData) override;
 
+  bool functionLocalWithDeriv(double *out, API::Jacobian *jacobian, const double *xValues,
+                              const size_t nData) override;
+
   void init() override;
 
 private:
@@ -70,6 +70,8 @@ public:
   }
   /// overwrite base method
   void zero() override { m_data.assign(m_data.size(), 0.0); }
+  /// All the derivatives, row by row: the np derivatives of each data point
+  const std::vector<double> &data() const { return m_data; }
 };
 
 } // namespace CurveFitting
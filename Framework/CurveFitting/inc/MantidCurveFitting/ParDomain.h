@@ -31,6 +31,11 @@ public:
   /// function
   void additiveCostFunctionValDerivHessian(const CostFunctions::CostFuncFitting &costFunction, bool evalDeriv,
                                            bool evalHessian) override;
+
+private:
+  /// Calculate the value, first and second derivatives of a least squares
+  /// cost function with thread-local sums
+  void leastSquaresValDerivHessian(const CostFunctions::CostFuncLeastSquares &costFunction, bool evalHessian);
 };
 
 } // namespace CurveFitting
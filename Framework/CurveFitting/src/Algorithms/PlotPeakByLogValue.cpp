@@ -22,6 +22,7 @@
 #include "MantidAPI/FunctionProperty.h"
 #include "MantidAPI/IFuncMinimizer.h"
 #include "MantidAPI/IFunction.h"
+#include "MantidAPI/IFunctionFitter.h"
 #include "MantidAPI/MultiDomainFunction.h"
 #include "MantidAPI/Progress.h"
 #include "MantidAPI/Run.h"
@@ -29,6 +30,7 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidCurveFitting/Algorithms/PlotPeakByLogValue.h"
+#include "MantidCurveFitting/FunctionFitter.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ListValidator.h"
@@ -191,6 +193,9 @@ void PlotPeakByLogValue::exec() {
   std::vector<double> startX = getProperty("StartX");
   std::vector<double> endX = getProperty("EndX");
   std::vector<std::string> exclude = getExclude(wsNames.size());
+  const bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
+  // Fits without output workspaces reuse one fitter instead of running Fit
+  FunctionFitter fitter;
 
   bool isDataName = false; // if true first output column is of type string and
                            // is the data source name
@@ -248,35 +253,47 @@ void PlotPeakByLogValue::exec() {
 
     IFunction_sptr ifun =
         setupFunction(individual, passWSIndexToFunction, inputFunction, initialParams, isMultiDomainFunction, i, data);
-    std::shared_ptr<Algorithm> fit;
-    if (startX.size() == 0) {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, EMPTY_DBL(),
-                         EMPTY_DBL(), exclude[i]);
-    } else if (startX.size() == 1) {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, startX[0],
-                         endX[0], exclude[i]);
-    } else {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, startX[i],
-                         endX[i], exclude[i]);
+    double fitStartX = EMPTY_DBL();
+    double fitEndX = EMPTY_DBL();
+    if (startX.size() == 1) {
+      fitStartX = startX[0];
+      fitEndX = endX[0];
+    } else if (startX.size() > 1) {
+      fitStartX = startX[i];
+      fitEndX = endX[i];
     }
 
-    ifun = fit->getProperty("Function");
-    double chi2 = fit->getProperty("OutputChi2overDoF");
-
-    if (createFitOutput) {
-      MatrixWorkspace_sptr outputFitWorkspace = fit->getProperty("OutputWorkspace");
-      ITableWorkspace_sptr outputParamWorkspace = fit->getProperty("OutputParameters");
-      ITableWorkspace_sptr outputCovarianceWorkspace = fit->getProperty("OutputNormalisedCovarianceMatrix");
-      fitWorkspaces.emplace_back(outputFitWorkspace);
-      parameterWorkspaces.emplace_back(outputParamWorkspace);
-      covarianceWorkspaces.emplace_back(outputCovarianceWorkspace);
+    const std::string minimizer = getMinimizerString(data.name, std::to_string(data.i));
+
+    double chi2(0.0);
+    std::string status;
+    // Fit is needed for output workspaces, including those of the minimizer
+    if (createFitOutput || histogramFit || !exclude[i].empty() || !m_minimizerWorkspaces.empty()) {
+      auto fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, fitStartX,
+                              fitEndX, exclude[i], minimizer);
+      ifun = fit->getProperty("Function");
+      chi2 = fit->getProperty("OutputChi2overDoF");
+      status = fit->getPropertyValue("OutputStatus");
+
+      if (createFitOutput) {
+        MatrixWorkspace_sptr outputFitWorkspace = fit->getProperty("OutputWorkspace");
+        ITableWorkspace_sptr outputParamWorkspace = fit->getProperty("OutputParameters");
+        ITableWorkspace_sptr outputCovarianceWorkspace = fit->getProperty("OutputNormalisedCovarianceMatrix");
+        fitWorkspaces.emplace_back(outputFitWorkspace);
+        parameterWorkspaces.emplace_back(outputParamWorkspace);
+        covarianceWorkspaces.emplace_back(outputCovarianceWorkspace);
+      }
+    } else {
+      const auto result = runSingleFit(fitter, ifun, data, fitStartX, fitEndX, minimizer);
+      chi2 = result.chi2OverDoF;
+      status = result.status;
     }
     if (outputFitStatus) {
-      fitStatus.push_back(fit->getProperty("OutputStatus"));
+      fitStatus.push_back(status);
       fitChiSquared.push_back(chi2);
     }
 
-    g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus") << ' ' << chi2 << '\n';
+    g_log.debug() << "Fit result " << status << ' ' << chi2 << '\n';
 
     // Find the log value: it is either a log-file value or
     // simply the workspace number
@@ -452,7 +469,7 @@ ITableWorkspace_sptr PlotPeakByLogValue::createResultsTable(const std::string &l
 std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(bool createFitOutput, bool outputCompositeMembers,
                                                             bool outputConvolvedMembers, const IFunction_sptr &ifun,
                                                             const InputSpectraToFit &data, double startX, double endX,
-                                                            const std::string &exclude) {
+                                                            const std::string &exclude, const std::string &minimizer) {
   g_log.debug() << "Fitting " << data.ws->getName() << " index " << data.i << " with \n";
   g_log.debug() << ifun->asString() << '\n';
 
@@ -474,7 +491,7 @@ std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(bool createFitOutput
   fit->setProperty("StartX", startX);
   fit->setProperty("EndX", endX);
   fit->setProperty("IgnoreInvalidData", ignoreInvalidData);
-  fit->setPropertyValue("Minimizer", this->getMinimizerString(data.name, spectrum_index));
+  fit->setPropertyValue("Minimizer", minimizer);
   fit->setPropertyValue("CostFunction", this->getPropertyValue("CostFunction"));
   fit->setPropertyValue("MaxIterations", this->getPropertyValue("MaxIterations"));
   fit->setPropertyValue("PeakRadius", this->getPropertyValue("PeakRadius"));
@@ -491,6 +508,33 @@ std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(bool createFitOutput
   return fit;
 }
 
+/** Fit a spectrum as runSingleFit does when no output workspaces are needed,
+ * without creating a Fit algorithm.
+ * @param fitter :: The fitter, reused for all the spectra
+ * @param ifun :: The function to fit, updated with the fitted parameters
+ * @param data :: The spectrum to fit
+ * @param startX :: Start of the fitting range
+ * @param endX :: End of the fitting range
+ * @param minimizer :: The minimizer string for this spectrum
+ * @return the status of the fit and the final chi squared
+ */
+API::IFunctionFitter::Result PlotPeakByLogValue::runSingleFit(API::IFunctionFitter &fitter, const IFunction_sptr &ifun,
+                                                              const InputSpectraToFit &data, double startX, double endX,
+                                                              const std::string &minimizer) {
+  g_log.debug() << "Fitting " << data.ws->getName() << " index " << data.i << " with \n";
+  g_log.debug() << ifun->asString() << '\n';
+
+  API::IFunctionFitter::Options options;
+  options.minimizer = minimizer;
+  options.costFunction = this->getPropertyValue("CostFunction");
+  options.maxIterations = static_cast<size_t>(static_cast<int>(this->getProperty("MaxIterations")));
+  options.calcErrors = true;
+  options.ignoreInvalidData = this->getProperty("IgnoreInvalidData");
+  options.peakRadius = this->getProperty("PeakRadius");
+  fitter.setOptions(options);
+  return fitter.fit(ifun, data.ws, static_cast<size_t>(data.i), startX, endX);
+}
+
 double PlotPeakByLogValue::calculateLogValue(const std::string &logName, const InputSpectraToFit &data) {
   double logValue = 0;
   if (logName.empty() || logName == "axis-1") {
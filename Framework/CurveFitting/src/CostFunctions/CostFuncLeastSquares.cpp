@@ -16,6 +16,7 @@
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace Mantid::CurveFitting::CostFunctions {
@@ -65,82 +66,118 @@ void CostFuncLeastSquares::addVal(API::FunctionDomain_sptr domain, API::Function
 void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function, API::FunctionDomain_sptr domain,
                                               API::FunctionValues_sptr values, bool evalDeriv, bool evalHessian) const {
   UNUSED_ARG(evalDeriv);
-  function->function(*domain, *values);
-  size_t np = function->nParams(); // number of parameters
-  size_t ny = values->size();      // number of data points
+  PartialSums sums(m_der.size(), evalHessian ? m_hessian.size1() : 0);
+  accumulateValDerivHessian(function, domain, values, evalHessian, sums);
+  // One lock per domain: ParDomain sums the domains of each thread first
+  PARALLEL_CRITICAL(cost_func_ls_sums) {
+    m_value += sums.value;
+    if (sums.der.size() > 0)
+      m_der += sums.der;
+    if (evalHessian && sums.hessian.size1() > 0)
+      m_hessian += sums.hessian;
+  }
+}
+
+/**
+ * Add the value, the derivatives and the Hessian of the cost function
+ * calculated on a domain to a partial sum. With the weighted residuals r and
+ * the weighted Jacobian J of the active parameters the derivatives are J^T r
+ * and the Hessian is J^T J, each computed by a single BLAS call.
+ * @param function :: Function to use to calculate the value and the derivatives
+ * @param domain :: The domain.
+ * @param values :: The fit function values
+ * @param evalHessian :: Flag to evaluate the Hessian
+ * @param sums :: The sums to add to
+ */
+void CostFuncLeastSquares::accumulateValDerivHessian(const API::IFunction_sptr &function,
+                                                     const API::FunctionDomain_sptr &domain,
+                                                     const API::FunctionValues_sptr &values, bool evalHessian,
+                                                     PartialSums &sums) const {
+  const size_t np = function->nParams(); // number of parameters
+  const size_t ny = values->size();      // number of data points
   Jacobian jacobian(ny, np);
-  function->functionDeriv(*domain, jacobian);
+  function->functionWithDeriv(*domain, *values, jacobian);
 
-  size_t iActiveP = 0;
+  const std::vector<double> weights = getFitWeights(values);
+  std::vector<double> residuals(ny);
   double fVal = 0.0;
-  std::vector<double> weights = getFitWeights(values);
+  for (size_t i = 0; i < ny; ++i) {
+    residuals[i] = (values->getCalculated(i) - values->getFitData(i)) * weights[i];
+    fVal += residuals[i] * residuals[i];
+  }
+  sums.value += 0.5 * fVal;
+
+  // Indices of the active parameters in the function
+  std::vector<size_t> active;
+  active.reserve(sums.der.size());
+  for (size_t ip = 0; ip < np && active.size() < sums.der.size(); ++ip) {
+    if (function->isActive(ip))
+      active.emplace_back(ip);
+  }
+  const size_t nActive = active.size();
+  if (ny == 0 || nActive == 0)
+    return;
 
-  for (size_t ip = 0; ip < np; ++ip) {
-    if (!function->isActive(ip))
-      continue;
-
-    double d = 0.0;
-    for (size_t i = 0; i < ny; ++i) {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w = weights[i];
-      double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0) {
-        fVal += y * y;
-      }
+  // Weighted Jacobian of the active parameters
+  GSLMatrix weightedJ(ny, nActive);
+  const auto &derivatives = jacobian.data();
+  for (size_t i = 0; i < ny; ++i) {
+    const double *row = derivatives.data() + i * np;
+    for (size_t j = 0; j < nActive; ++j) {
+      weightedJ(i, j) = row[active[j]] * weights[i];
     }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
-    }
-    ++iActiveP;
-
-    if (iActiveP >= m_der.size())
-      break;
   }
 
-  PARALLEL_ATOMIC
-  m_value += 0.5 * fVal;
+  GSLVector r(std::move(residuals));
+  GSLVector der(nActive);
+  gsl_blas_dgemv(CblasTrans, 1.0, weightedJ.gsl(), r.gsl(), 0.0, der.gsl());
+  for (size_t j = 0; j < nActive; ++j) {
+    sums.der[j] += der[j];
+  }
 
-  if (!evalHessian)
+  const size_t nHessian = std::min(nActive, sums.hessian.size1());
+  if (!evalHessian || nHessian == 0)
     return;
-
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
-      continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
-      double d = 0.0;
-      for (size_t k = 0; k < ny; ++k) // over fitting data
-      {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
-      }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
-        if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
-        }
-      }
-      ++i2;
-
-      if (i2 >= m_hessian.size2())
-        break;
+  GSLMatrix hessian(nActive, nActive);
+  gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, weightedJ.gsl(), 0.0, hessian.gsl());
+  for (size_t i = 0; i < nHessian; ++i) {
+    for (size_t j = 0; j < i; ++j) {
+      const double h = hessian(i, j);
+      sums.hessian(i, j) += h;
+      sums.hessian(j, i) += h;
     }
-    ++i1;
+    sums.hessian(i, i) += hessian(i, i);
+  }
+}
 
-    if (i1 >= m_hessian.size1())
-      break;
+/**
+ * Constructor
+ * @param nDeriv :: Number of derivatives, i.e. of active parameters
+ * @param nHessian :: Size of the Hessian, 0 if it is not needed
+ */
+CostFuncLeastSquares::PartialSums::PartialSums(size_t nDeriv, size_t nHessian) {
+  if (nDeriv > 0) {
+    der.resize(nDeriv);
+    der.zero();
+  }
+  if (nHessian > 0) {
+    hessian.resize(nHessian, nHessian);
+    hessian.zero();
   }
 }
 
+/**
+ * Add another partial sum to this one
+ * @param other :: A sum of the same sizes
+ */
+void CostFuncLeastSquares::PartialSums::add(const PartialSums &other) {
+  value += other.value;
+  if (der.size() > 0)
+    der += other.der;
+  if (hessian.size1() > 0)
+    hessian += other.hessian;
+}
+
 std::vector<double> CostFuncLeastSquares::getFitWeights(API::FunctionValues_sptr values) const {
   std::vector<double> weights(values->size());
   for (size_t i = 0; i < weights.size(); ++i) {
@@ -0,0 +1,146 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/FunctionFitter.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncFitting.h"
+
+#include "MantidAPI/CompositeFunction.h"
+#include "MantidAPI/CostFunctionFactory.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidKernel/Exception.h"
+
+namespace Mantid::CurveFitting {
+
+DECLARE_FUNCTIONFITTER(FunctionFitter)
+
+/** Fit a function to a range of a spectrum. The steps and the status are the
+ * same as those of the Fit algorithm.
+ * @param function :: The function to fit
+ * @param workspace :: The workspace with the data
+ * @param workspaceIndex :: The spectrum to fit
+ * @param startX :: Start of the fitting range
+ * @param endX :: End of the fitting range
+ * @param constraints :: Constraints to add to the function
+ * @return the status of the fit and the final chi squared
+ */
+API::IFunctionFitter::Result FunctionFitter::fit(const API::IFunction_sptr &function,
+                                                 const API::MatrixWorkspace_sptr &workspace, size_t workspaceIndex,
+                                                 double startX, double endX, const std::string &constraints) {
+  if (!function)
+    throw std::invalid_argument("FunctionFitter: no function to fit");
+  if (!constraints.empty())
+    function->addConstraints(constraints);
+
+  setData(workspace, workspaceIndex, startX, endX);
+  const size_t maxIterations = m_options.maxIterations;
+  initializeMinimizer(function, maxIterations);
+
+  Result result;
+  size_t iter = 0;
+  while (iter < maxIterations) {
+    bool isFinished = false;
+    try {
+      function->iterationStarting();
+      isFinished = !m_minimizer->iterate(iter);
+      function->iterationFinished();
+    } catch (Kernel::Exception::FitSizeWarning &) {
+      // The function changed its number of parameters or ties: start again
+      // from the current parameters, as Fit does.
+      if (auto cf = dynamic_cast<API::CompositeFunction *>(function.get())) {
+        cf->checkFunction();
+      }
+      initializeMinimizer(function, maxIterations - iter);
+    }
+    ++iter;
+    if (isFinished)
+      break;
+  }
+  result.iterations = iter;
+
+  m_minimizer->finalize();
+  result.status = m_minimizer->getError();
+  if (iter >= maxIterations) {
+    if (!result.status.empty()) {
+      result.status += '\n';
+    }
+    result.status += "Failed to converge after " + std::to_string(maxIterations) + " iterations.";
+  }
+  if (result.status.empty()) {
+    result.status = "success";
+  }
+
+  size_t dof = m_costFunction->getDomain()->size() - m_costFunction->nParams();
+  if (dof == 0)
+    dof = 1;
+  const double rawCostFuncVal = m_minimizer->costFunctionVal();
+  result.chi2OverDoF = rawCostFuncVal / double(dof);
+
+  if (m_options.calcErrors && m_costFunction->nParams() > 0) {
+    GSLMatrix covar;
+    m_costFunction->calCovarianceMatrix(covar);
+    m_costFunction->calFittingErrors(covar, rawCostFuncVal);
+  }
+  return result;
+}
+
+/** Set the data to fit, creating the domain and the values unless they are the
+ * same as in the last fit.
+ * @param workspace :: The workspace with the data
+ * @param workspaceIndex :: The spectrum to fit
+ * @param startX :: Start of the fitting range
+ * @param endX :: End of the fitting range
+ */
+void FunctionFitter::setData(const API::MatrixWorkspace_sptr &workspace, size_t workspaceIndex, double startX,
+                             double endX) {
+  if (!workspace)
+    throw std::invalid_argument("FunctionFitter: no workspace to fit");
+  // The domain creator keeps the range it found in the data for initFunction
+  if (m_domain && workspace == m_workspace && workspaceIndex == m_workspaceIndex && startX == m_startX &&
+      endX == m_endX && m_options.ignoreInvalidData == m_ignoreInvalidData && m_options.peakRadius == m_peakRadius)
+    return;
+
+  m_domainCreator.setWorkspace(workspace);
+  m_domainCreator.setWorkspaceIndex(workspaceIndex);
+  m_domainCreator.setRange(startX, endX);
+  m_domainCreator.ignoreInvalidData(m_options.ignoreInvalidData);
+  m_domainCreator.createDomain(m_domain, m_values);
+  if (m_options.peakRadius != 0) {
+    if (auto d1d = dynamic_cast<API::FunctionDomain1D *>(m_domain.get()))
+      d1d->setPeakRadius(m_options.peakRadius);
+  }
+  m_workspace = workspace;
+  m_workspaceIndex = workspaceIndex;
+  m_startX = startX;
+  m_endX = endX;
+  m_ignoreInvalidData = m_options.ignoreInvalidData;
+  m_peakRadius = m_options.peakRadius;
+}
+
+/** Prepare the function, the cost function and a new minimizer for a fit.
+ * @param function :: The function to fit
+ * @param maxIterations :: Maximum number of iterations.
+ */
+void FunctionFitter::initializeMinimizer(const API::IFunction_sptr &function, size_t maxIterations) {
+  function->sortTies();
+  function->setUpForFit();
+  m_domainCreator.initFunction(function);
+
+  if (!m_costFunction || m_costFunctionName != m_options.costFunction) {
+    m_costFunction = std::dynamic_pointer_cast<CostFunctions::CostFuncFitting>(
+        API::CostFunctionFactory::Instance().create(m_options.costFunction));
+    if (!m_costFunction)
+      throw std::invalid_argument("FunctionFitter: " + m_options.costFunction + " cannot be used for fitting");
+    m_costFunctionName = m_options.costFunction;
+  }
+  m_costFunction->setFittingFunction(function, m_domain, m_values);
+
+  m_minimizer = API::FuncMinimizerFactory::Instance().createMinimizer(m_options.minimizer);
+  m_minimizer->initialize(m_costFunction, maxIterations);
+}
+
+} // namespace Mantid::CurveFitting
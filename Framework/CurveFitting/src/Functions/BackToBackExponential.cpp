@@ -8,7 +8,10 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/Jacobian.h"
 
 #include <cmath>
 #include <gsl/gsl_multifit_nlin.h>
@@ -104,6 +107,45 @@ void BackToBackExponential::setFwhm(const double w) {
 }
 
 void BackToBackExponential::function1D(double *out, const double *xValues, const size_t nData) const {
+  evaluate(out, nullptr, xValues, nData);
+}
+
+/**
+ * Evaluate function derivatives analytically.
+ */
+void BackToBackExponential::functionDeriv1D(Jacobian *jacobian, const double *xValues, const size_t nData) {
+  evaluate(nullptr, jacobian, xValues, nData);
+}
+
+/**
+ * Evaluate the function and its derivatives in one pass over the x values.
+ * @param domain :: The domain of the function
+ * @param values :: A buffer for the function values
+ * @param jacobian :: A Jacobian for the derivatives
+ */
+void BackToBackExponential::functionWithDeriv(const FunctionDomain &domain, FunctionValues &values,
+                                              Jacobian &jacobian) {
+  const auto *d1d = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!d1d || dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    IFunction::functionWithDeriv(domain, values, jacobian);
+    return;
+  }
+  evaluate(values.getPointerToCalculated(0), &jacobian, d1d->getPointerAt(0), d1d->size());
+}
+
+/**
+ * Calculate the values and/or the derivatives of the function.
+ *
+ * Both exponential terms E = exp(arg) * erfc(u) have
+ * exp(arg) * exp(-u^2) = exp(-(x-X0)^2/(2*S^2)) = G, so that their
+ * derivatives are E * d(arg) - 2/sqrt(pi) * G * d(u).
+ * @param out :: The values, or nullptr if not needed
+ * @param jacobian :: The derivatives, or nullptr if not needed
+ * @param xValues :: The x values
+ * @param nData :: The number of x values
+ */
+void BackToBackExponential::evaluate(double *out, Jacobian *jacobian, const double *xValues,
+                                     const size_t nData) const {
   /*
     const double& I = getParameter("I");
     const double& a = getParameter("A");
@@ -126,31 +168,52 @@ void BackToBackExponential::function1D(double *out, const double *xValues, const
 
   double s2 = s * s;
   double normFactor = a * b / (a + b) / 2;
+  // derivatives of normFactor with respect to A and B
+  double normDerivA = b * b / (a + b) / (a + b) / 2;
+  double normDerivB = a * a / (a + b) / (a + b) / 2;
   // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
-  if (normFactor == 0.0)
+  if (normFactor == 0.0) {
     normFactor = 1.0;
+    normDerivA = 0.0;
+    normDerivB = 0.0;
+  }
+  const double sigma = sqrt(s2);
+  const double sqrt2Sigma = sqrt(2 * s2);
+  const double signS = s < 0.0 ? -1.0 : 1.0;
+  const double twoDivSqrtPi = M_2_SQRTPI;
   for (size_t i = 0; i < nData; i++) {
     double diff = xValues[i] - x0;
     if (fabs(diff) < extent) {
-      double val = 0.0;
       double arg1 = a / 2 * (a * s2 + 2 * diff);
-      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) / sqrt(2 * s2))); // prevent overflow
+      const double e1 = exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) / sqrt2Sigma)); // prevent overflow
       double arg2 = b / 2 * (b * s2 - 2 * diff);
-      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) / sqrt(2 * s2))); // prevent overflow
-      out[i] = I * val * normFactor;
-    } else
-      out[i] = 0.0;
+      const double e2 = exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) / sqrt2Sigma)); // prevent overflow
+      const double val = e1 + e2;
+      if (out)
+        out[i] = I * val * normFactor;
+      if (jacobian) {
+        const double g = twoDivSqrtPi * exp(-0.5 * diff * diff / s2);
+        const double de1da = e1 * (a * s2 + diff) - g * sigma / M_SQRT2;
+        const double de2db = e2 * (b * s2 - diff) - g * sigma / M_SQRT2;
+        const double dvaldx0 = -a * e1 + b * e2;
+        const double dvalds = sigma * (a * a * e1 + b * b * e2) - g * (a + b) / M_SQRT2;
+        jacobian->set(i, 0, val * normFactor);
+        jacobian->set(i, 1, I * (normDerivA * val + normFactor * de1da));
+        jacobian->set(i, 2, I * (normDerivB * val + normFactor * de2db));
+        jacobian->set(i, 3, I * normFactor * dvaldx0);
+        jacobian->set(i, 4, I * normFactor * dvalds * signS);
+      }
+    } else {
+      if (out)
+        out[i] = 0.0;
+      if (jacobian) {
+        for (size_t ip = 0; ip < 5; ++ip)
+          jacobian->set(i, ip, 0.0);
+      }
+    }
   }
 }
 
-/**
- * Evaluate function derivatives numerically.
- */
-void BackToBackExponential::functionDeriv1D(Jacobian *jacobian, const double *xValues, const size_t nData) {
-  FunctionDomain1DView domain(xValues, nData);
-  this->calNumericalDeriv(domain, *jacobian);
-}
-
 /**
  * Calculate contribution to the width by the exponentials.
  */
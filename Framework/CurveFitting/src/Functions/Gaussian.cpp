@@ -55,6 +55,31 @@ void Gaussian::functionDerivLocal(Jacobian *out, const double *xValues, const si
   }
 }
 
+/**
+ * Calculate the values and the derivatives with one exponential per point.
+ * @param out :: The values
+ * @param jacobian :: The derivatives
+ * @param xValues :: The x values
+ * @param nData :: Number of x values
+ * @return true
+ */
+bool Gaussian::functionLocalWithDeriv(double *out, Jacobian *jacobian, const double *xValues, const size_t nData) {
+  const double height = getParameter("Height");
+  const double peakCentre = getParameter("PeakCentre");
+  const double weight = pow(1 / getParameter("Sigma"), 2);
+
+  for (size_t i = 0; i < nData; i++) {
+    double diff = xValues[i] - peakCentre;
+    double e = exp(-0.5 * diff * diff * weight);
+    out[i] = height * e;
+    jacobian->set(i, 0, e);
+    jacobian->set(i, 1, diff * height * e * weight);
+    jacobian->set(i, 2,
+                  -0.5 * diff * diff * height * e); // derivative with respect to weight not sigma
+  }
+  return true;
+}
+
 void Gaussian::setActiveParameter(size_t i, double value) {
   if (!isActive(i)) {
     throw std::runtime_error("Attempt to use an inactive parameter");
@@ -102,6 +102,33 @@ void Lorentzian::functionDerivLocal(Jacobian *out, const double *xValues, const
   }
 }
 
+/**
+ * Calculate the values and the derivatives, sharing the denominators.
+ * @param out :: The values
+ * @param jacobian :: The derivatives
+ * @param xValues :: The x values
+ * @param nData :: Number of x values
+ * @return true
+ */
+bool Lorentzian::functionLocalWithDeriv(double *out, Jacobian *jacobian, const double *xValues, const size_t nData) {
+  const double amplitude = getParameter("Amplitude");
+  const double peakCentre = getParameter("PeakCentre");
+  const double gamma = getParameter("FWHM");
+  const double halfGamma = 0.5 * gamma;
+
+  const double invPI = 1.0 / M_PI;
+  for (size_t i = 0; i < nData; i++) {
+    double diff = xValues[i] - peakCentre;
+    const double invDen1 = 1.0 / (gamma * gamma + 4.0 * diff * diff);
+    double invDen2 = 1 / (diff * diff + halfGamma * halfGamma);
+    out[i] = amplitude * invPI * halfGamma * invDen2;
+    jacobian->set(i, 0, 2.0 * invPI * gamma * invDen1);
+    jacobian->set(i, 1, amplitude * invPI * gamma * diff * invDen2 * invDen2);
+    jacobian->set(i, 2, -2.0 * amplitude * invPI * (gamma * gamma - 4.0 * diff * diff) * invDen1 * invDen1);
+  }
+  return true;
+}
+
 /// Calculate histogram data for the given bin boundaries.
 /// @param out :: Output bin values (size == nBins) - integrals of the function
 ///    inside each bin.
@@ -173,6 +173,56 @@ void PseudoVoigt::functionDerivLocal(Jacobian *out, const double *xValues, const
   }
 }
 
+/** calculate pseudo voigt and its derivatives with one evaluation of the
+ * Gaussian and the Lorentzian per point
+ * @param out :: array with calculated value
+ * @param jacobian :: calculated derivatives
+ * @param xValues :: input X array
+ * @param nData :: data size
+ * @return false for a negative FWHM, which only functionLocal handles
+ */
+bool PseudoVoigt::functionLocalWithDeriv(double *out, Jacobian *jacobian, const double *xValues,
+                                         const size_t nData) {
+  const double peak_intensity = getParameter("Intensity");
+  const double x0 = getParameter("PeakCentre");
+  const double gamma = getParameter("FWHM");
+  const double gFraction = getParameter("Mixing");
+  if (gamma < 0.0)
+    return false;
+  if (gamma < 1.E-20)
+    throw std::runtime_error("Pseudo-voigt has FWHM as 0. It will generate "
+                             "infinity at center in the Lorentzian part.");
+  const double lFraction = 1.0 - gFraction;
+
+  // calculate constants
+  const double a_g = cal_ag(gamma);
+  const double b_g = cal_bg(gamma);
+  const double gamma_div_2 = 0.5 * gamma;
+  const double gammasq_div_4 = gamma_div_2 * gamma_div_2;
+
+  for (size_t i = 0; i < nData; ++i) {
+    const double xDiff = (xValues[i] - x0);
+    const double xDiffSquared = xDiff * xDiff;
+
+    const double gaussian_term = cal_gaussian(a_g, b_g, xDiffSquared);
+    const double lorentzian_term = cal_lorentzian(gamma_div_2, gammasq_div_4, xDiffSquared);
+    out[i] = peak_intensity * (gFraction * gaussian_term + lFraction * lorentzian_term);
+
+    // mixing, intensity, centre and width as in functionDerivLocal
+    jacobian->set(i, 0, peak_intensity * (gaussian_term - lorentzian_term));
+    jacobian->set(i, 1, gFraction * gaussian_term + lFraction * lorentzian_term);
+    const double derive_g_x0 = 2. * b_g * xDiff * gaussian_term;
+    const double derive_l_x0 = 4. * M_PI * xDiff / gamma * lorentzian_term * lorentzian_term;
+    jacobian->set(i, 2, peak_intensity * (gFraction * derive_g_x0 + lFraction * derive_l_x0));
+    const double t1 = -1. / gamma * gaussian_term;
+    const double t2 = 2. * b_g * xDiffSquared * gaussian_term / gamma;
+    const double t3 = lorentzian_term / gamma;
+    const double t4 = -M_PI * lorentzian_term * lorentzian_term;
+    jacobian->set(i, 3, peak_intensity * (gFraction * (t1 + t2) + lFraction * (t3 + t4)));
+  }
+  return true;
+}
+
 /// override because setParameter(size_t i ...) is overriden
 void PseudoVoigt::setParameter(const std::string &name, const double &value, bool explicitlySet) {
   g_log.debug() << "[PV] Set " << name << " as " << value << "\n";
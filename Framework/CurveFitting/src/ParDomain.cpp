@@ -8,6 +8,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/ParDomain.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
 #include "MantidKernel/MultiThreaded.h"
 
 namespace Mantid::CurveFitting {
@@ -55,6 +56,10 @@ void ParDomain::additiveCostFunctionVal(const CostFunctions::CostFuncFitting &co
  */
 void ParDomain::additiveCostFunctionValDerivHessian(const CostFunctions::CostFuncFitting &costFunction, bool evalDeriv,
                                                     bool evalHessian) {
+  if (auto leastSquares = dynamic_cast<const CostFunctions::CostFuncLeastSquares *>(&costFunction)) {
+    leastSquaresValDerivHessian(*leastSquares, evalHessian);
+    return;
+  }
   const auto n = static_cast<int>(getNDomains());
   PARALLEL_SET_DYNAMIC(0);
   std::vector<API::IFunction_sptr> funs;
@@ -80,4 +85,57 @@ void ParDomain::additiveCostFunctionValDerivHessian(const CostFunctions::CostFun
   }
 }
 
+/**
+ * Calculate the value, first and second derivatives of a least squares cost
+ * function. Each thread sums the domains it evaluates into its own partial
+ * sums, which are then added pairwise in a tree: no lock is taken per domain
+ * or per parameter.
+ * @param costFunction :: The cost func to calculate the value for
+ * @param evalHessian :: Flag to evaluate the Hessian (second derivatives)
+ */
+void ParDomain::leastSquaresValDerivHessian(const CostFunctions::CostFuncLeastSquares &costFunction,
+                                            bool evalHessian) {
+  using PartialSums = CostFunctions::CostFuncLeastSquares::PartialSums;
+  const auto n = static_cast<int>(getNDomains());
+  const size_t nDeriv = costFunction.m_der.size();
+  const size_t nHessian = evalHessian ? costFunction.m_hessian.size1() : 0;
+
+#ifdef _OPENMP
+  // the loops below use the number of threads from the config: size for it
+  PARALLEL_SET_CONFIG_THREADS
+#endif
+  const auto nThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  std::vector<PartialSums> sums(nThreads, PartialSums(nDeriv, nHessian));
+  std::vector<API::IFunction_sptr> funs(nThreads);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < n; ++i) {
+    API::FunctionDomain_sptr domain;
+    API::FunctionValues_sptr values;
+    getDomainAndValues(i, domain, values);
+    if (!values) {
+      throw std::runtime_error("CostFunction: undefined FunctionValues.");
+    }
+    const auto k = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+    if (!funs[k]) {
+      funs[k] = costFunction.getFittingFunction()->clone();
+    }
+    costFunction.accumulateValDerivHessian(funs[k], domain, values, evalHessian, sums[k]);
+  }
+
+  for (size_t stride = 1; stride < nThreads; stride *= 2) {
+    const auto nPairs = static_cast<int>((nThreads - stride + 2 * stride - 1) / (2 * stride));
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int pair = 0; pair < nPairs; ++pair) {
+      const size_t k = 2 * stride * static_cast<size_t>(pair);
+      sums[k].add(sums[k + stride]);
+    }
+  }
+
+  costFunction.m_value += sums.front().value;
+  if (nDeriv > 0)
+    costFunction.m_der += sums.front().der;
+  if (nHessian > 0)
+    costFunction.m_hessian += sums.front().hessian;
+}
+
 } // namespace Mantid::CurveFitting
@@ -13,6 +13,7 @@
 #include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
 #include "MantidCurveFitting/CostFunctions/CostFuncRwp.h"
+#include "MantidCurveFitting/FitMW.h"
 #include "MantidCurveFitting/FuncMinimizers/BFGS_Minimizer.h"
 #include "MantidCurveFitting/FuncMinimizers/LevenbergMarquardtMDMinimizer.h"
 #include "MantidCurveFitting/FuncMinimizers/SimplexMinimizer.h"
@@ -20,6 +21,8 @@
 #include "MantidCurveFitting/Functions/Gaussian.h"
 #include "MantidCurveFitting/Functions/LinearBackground.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidCurveFitting/ParDomain.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
 
 #include <gsl/gsl_blas.h>
 #include <sstream>
@@ -267,6 +270,59 @@ public:
     TS_ASSERT_EQUALS(s.getError(), "success");
   }
 
+  void test_parallel_domain_gives_same_derivatives_and_hessian() {
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceFromFunction(
+        [](double x, int) { return 3.0 * std::exp(-0.5 * std::pow((x - 4.0) / 0.7, 2)) + 0.5 + 0.2 * x; }, 1, 0.0,
+        10.0, 0.05, false, [](double x, int) { return 0.1 + 0.01 * x; });
+
+    auto createFunction = []() {
+      auto fun = std::make_shared<CompositeFunction>();
+      auto bk = std::make_shared<LinearBackground>();
+      bk->initialize();
+      bk->setParameter("A0", 0.3);
+      bk->setParameter("A1", 0.1);
+      auto peak = std::make_shared<Gaussian>();
+      peak->initialize();
+      peak->setParameter("PeakCentre", 4.2);
+      peak->setParameter("Height", 2.5);
+      peak->setParameter("Sigma", 0.9);
+      peak->fix(peak->parameterIndex("Sigma"));
+      fun->addFunction(bk);
+      fun->addFunction(peak);
+      return fun;
+    };
+    auto costFunction = [&ws](FitMW::DomainType type, const IFunction_sptr &fun) {
+      FitMW fitmw(type);
+      fitmw.setWorkspace(ws);
+      fitmw.setWorkspaceIndex(0);
+      fitmw.setMaxSize(7);
+      FunctionDomain_sptr domain;
+      FunctionValues_sptr values;
+      fitmw.createDomain(domain, values);
+      auto costFun = std::make_shared<CostFuncLeastSquares>();
+      costFun->setFittingFunction(fun, domain, values);
+      return costFun;
+    };
+
+    auto simple = costFunction(FitMW::Simple, createFunction());
+    auto parallel = costFunction(FitMW::Parallel, createFunction());
+    TS_ASSERT(std::dynamic_pointer_cast<ParDomain>(parallel->getDomain()));
+    TS_ASSERT_EQUALS(parallel->nParams(), 4);
+
+    TS_ASSERT_DELTA(parallel->valDerivHessian(), simple->valDerivHessian(), 1e-8);
+    const GSLVector &der = parallel->getDeriv();
+    const GSLVector &expectedDer = simple->getDeriv();
+    const GSLMatrix &hessian = parallel->getHessian();
+    const GSLMatrix &expectedHessian = simple->getHessian();
+    for (size_t i = 0; i < 4; ++i) {
+      TS_ASSERT_DELTA(der.get(i), expectedDer.get(i), 1e-8);
+      for (size_t j = 0; j < 4; ++j) {
+        TS_ASSERT_DELTA(hessian.get(i, j), expectedHessian.get(i, j), 1e-8);
+        TS_ASSERT_EQUALS(hessian.get(i, j), hessian.get(j, i));
+      }
+    }
+  }
+
   void testDerivatives() {
     API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(79300., 79600., 41));
     API::FunctionValues_sptr data(new API::FunctionValues(*domain));
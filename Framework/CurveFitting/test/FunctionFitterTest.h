@@ -0,0 +1,161 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/IFunctionFitter.h"
+#include "MantidCurveFitting/Algorithms/Fit.h"
+#include "MantidCurveFitting/FunctionFitter.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cmath>
+
+using Mantid::API::FunctionFactory;
+using Mantid::API::FunctionFitterFactory;
+using Mantid::API::IFunction_sptr;
+using Mantid::API::IFunctionFitter;
+using Mantid::API::MatrixWorkspace_sptr;
+using Mantid::CurveFitting::FunctionFitter;
+using Mantid::CurveFitting::Algorithms::Fit;
+
+namespace {
+/// A peak on a sloping background, different in each spectrum
+struct PeakData {
+  double operator()(double x, int spec) {
+    const double centre = 5.0 + 0.1 * spec;
+    const double sigma = 0.3 + 0.02 * spec;
+    // deterministic "noise" so that the fit is not exact
+    const double noise = 0.3 * std::sin(7.3 * x + spec);
+    return 10.0 * std::exp(-0.5 * std::pow((x - centre) / sigma, 2)) + 1.0 + 0.1 * x + noise;
+  }
+};
+struct PeakErrors {
+  double operator()(double, int) { return 0.5; }
+};
+
+IFunction_sptr createFunction() {
+  return FunctionFactory::Instance().createInitialized(
+      "name=Gaussian,Height=8,PeakCentre=5.2,Sigma=0.4;name=LinearBackground,A0=0.5,A1=0");
+}
+} // namespace
+
+class FunctionFitterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FunctionFitterTest *createSuite() { return new FunctionFitterTest(); }
+  static void destroySuite(FunctionFitterTest *suite) { delete suite; }
+
+  FunctionFitterTest() {
+    m_ws = WorkspaceCreationHelper::create2DWorkspaceFromFunction(PeakData(), 3, 0.0, 10.0, 0.05, false,
+                                                                  PeakErrors());
+  }
+
+  void test_created_by_factory() {
+    auto fitter = FunctionFitterFactory::Instance().create("FunctionFitter");
+    TS_ASSERT(std::dynamic_pointer_cast<FunctionFitter>(fitter));
+  }
+
+  void test_fit_matches_Fit_algorithm() {
+    FunctionFitter fitter;
+    IFunctionFitter::Options options;
+    options.minimizer = "Levenberg-MarquardtMD";
+    options.calcErrors = true;
+    fitter.setOptions(options);
+
+    for (size_t wi = 0; wi < m_ws->getNumberHistograms(); ++wi) {
+      auto expected = createFunction();
+      double expectedChi2(0.0);
+      std::string expectedStatus;
+      runFit(expected, wi, 3.0, 7.0, "", expectedChi2, expectedStatus);
+
+      auto function = createFunction();
+      const auto result = fitter.fit(function, m_ws, wi, 3.0, 7.0);
+      TS_ASSERT_EQUALS(result.status, expectedStatus);
+      TS_ASSERT(result.success());
+      TS_ASSERT_DELTA(result.chi2OverDoF, expectedChi2, 1e-12);
+      assertSameParameters(*function, *expected);
+    }
+  }
+
+  void test_refit_with_same_data_and_constraints() {
+    FunctionFitter fitter;
+    IFunctionFitter::Options options;
+    options.minimizer = "Levenberg-MarquardtMD";
+    options.calcErrors = true;
+    fitter.setOptions(options);
+    const std::string constraints = "5.0 < f0.PeakCentre < 5.1";
+
+    // the first fit leaves the domain to the second one
+    auto first = createFunction();
+    fitter.fit(first, m_ws, 2, 3.0, 7.0);
+
+    auto expected = createFunction();
+    double expectedChi2(0.0);
+    std::string expectedStatus;
+    runFit(expected, 2, 3.0, 7.0, constraints, expectedChi2, expectedStatus);
+
+    auto function = createFunction();
+    const auto result = fitter.fit(function, m_ws, 2, 3.0, 7.0, constraints);
+    TS_ASSERT_EQUALS(result.status, expectedStatus);
+    TS_ASSERT_DELTA(result.chi2OverDoF, expectedChi2, 1e-12);
+    assertSameParameters(*function, *expected);
+    TS_ASSERT_LESS_THAN_EQUALS(function->getParameter("f0.PeakCentre"), 5.1 + 1e-3);
+  }
+
+  void test_iteration_limit_gives_failed_status() {
+    FunctionFitter fitter;
+    IFunctionFitter::Options options;
+    options.maxIterations = 1;
+    fitter.setOptions(options);
+    const auto result = fitter.fit(createFunction(), m_ws, 0, 3.0, 7.0);
+    TS_ASSERT(!result.success());
+    TS_ASSERT_EQUALS(result.iterations, 1);
+    TS_ASSERT(result.status.find("Failed to converge after 1 iterations.") != std::string::npos);
+  }
+
+  void test_unknown_cost_function_throws() {
+    FunctionFitter fitter;
+    IFunctionFitter::Options options;
+    options.costFunction = "Not a cost function";
+    fitter.setOptions(options);
+    TS_ASSERT_THROWS_ANYTHING(fitter.fit(createFunction(), m_ws, 0, 3.0, 7.0));
+  }
+
+private:
+  void runFit(const IFunction_sptr &function, size_t wi, double startX, double endX, const std::string &constraints,
+              double &chi2, std::string &status) {
+    Fit fit;
+    fit.initialize();
+    fit.setChild(true);
+    fit.setProperty("Function", function);
+    fit.setProperty("InputWorkspace", m_ws);
+    fit.setProperty("WorkspaceIndex", static_cast<int>(wi));
+    fit.setProperty("StartX", startX);
+    fit.setProperty("EndX", endX);
+    fit.setProperty("Minimizer", "Levenberg-MarquardtMD");
+    fit.setProperty("CalcErrors", true);
+    if (!constraints.empty())
+      fit.setProperty("Constraints", constraints);
+    fit.execute();
+    TS_ASSERT(fit.isExecuted());
+    chi2 = fit.getProperty("OutputChi2overDoF");
+    status = fit.getPropertyValue("OutputStatus");
+  }
+
+  void assertSameParameters(const Mantid::API::IFunction &actual, const Mantid::API::IFunction &expected) {
+    TS_ASSERT_EQUALS(actual.nParams(), expected.nParams());
+    for (size_t i = 0; i < expected.nParams(); ++i) {
+      TS_ASSERT_DELTA(actual.getParameter(i), expected.getParameter(i), 1e-12);
+      TS_ASSERT_DELTA(actual.getError(i), expected.getError(i), 1e-12);
+    }
+  }
+
+  MatrixWorkspace_sptr m_ws;
+};
@@ -11,6 +11,7 @@
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <cmath>
 
@@ -204,4 +205,52 @@ public:
     TS_ASSERT_EQUALS(b2bExp.intensity(), 2.1);
     TS_ASSERT_EQUALS(b2bExp.intensityError(), b2bExp.getError("I"));
   }
+
+  void test_derivatives_match_numerical_derivatives() {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 2.1);
+    b2bExp.setParameter("A", 1.5);
+    b2bExp.setParameter("B", 0.3);
+    b2bExp.setParameter("X0", 0.5);
+    b2bExp.setParameter("S", 0.8);
+
+    Mantid::API::FunctionDomain1DVector x(-5, 10, 61);
+    Mantid::CurveFitting::Jacobian analytic(x.size(), 5);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 5);
+    b2bExp.functionDeriv(x, analytic);
+    b2bExp.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t ip = 0; ip < 5; ++ip) {
+        const double expected = numerical.get(i, ip);
+        TS_ASSERT_DELTA(analytic.get(i, ip), expected, 1e-5 * std::max(1.0, fabs(expected)));
+      }
+    }
+  }
+
+  void test_functionWithDeriv_matches_function_and_functionDeriv() {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 2.1);
+    b2bExp.setParameter("A", 1.5);
+    b2bExp.setParameter("B", 0.3);
+    b2bExp.setParameter("X0", 0.5);
+    b2bExp.setParameter("S", -0.8);
+
+    Mantid::API::FunctionDomain1DVector x(-5, 10, 61);
+    Mantid::API::FunctionValues expectedValues(x);
+    Mantid::CurveFitting::Jacobian expectedJacobian(x.size(), 5);
+    b2bExp.function(x, expectedValues);
+    b2bExp.functionDeriv(x, expectedJacobian);
+
+    Mantid::API::FunctionValues values(x);
+    Mantid::CurveFitting::Jacobian jacobian(x.size(), 5);
+    b2bExp.functionWithDeriv(x, values, jacobian);
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_EQUALS(values[i], expectedValues[i]);
+      for (size_t ip = 0; ip < 5; ++ip) {
+        TS_ASSERT_EQUALS(jacobian.get(i, ip), expectedJacobian.get(i, ip));
+      }
+    }
+  }
 };
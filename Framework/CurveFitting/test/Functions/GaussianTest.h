@@ -195,4 +195,34 @@ public:
     TS_ASSERT_DELTA(fn.intensity(), intensity, 1e-6);
     TS_ASSERT_DELTA(fn.getParameter("Height"), 0.398942, 1e-6);
   }
+
+  void test_functionWithDeriv_matches_function_and_functionDeriv() {
+    auto composite = std::dynamic_pointer_cast<CompositeFunction>(FunctionFactory::Instance().createInitialized(
+        "name=LinearBackground,A0=0.3,A1=0.1;name=Gaussian,Height=2.0,PeakCentre=1.0,Sigma=0.5"));
+    TS_ASSERT(composite);
+    FunctionDomain1DVector x(-10, 10, 101);
+    x.setPeakRadius(5);
+    const size_t np = composite->nParams();
+
+    FunctionValues expectedValues(x);
+    TempJacobian expectedJacobian(x.size(), np);
+    composite->function(x, expectedValues);
+    composite->functionDeriv(x, expectedJacobian);
+
+    FunctionValues values(x);
+    TempJacobian jacobian(x.size(), np);
+    // fill with garbage to check that the points outside the peak are zeroed
+    for (size_t i = 0; i < x.size(); ++i) {
+      values.setCalculated(i, -1.0);
+      for (size_t ip = 0; ip < np; ++ip)
+        jacobian.set(i, ip, -1.0);
+    }
+    composite->functionWithDeriv(x, values, jacobian);
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_DELTA(values[i], expectedValues[i], 1e-14);
+      for (size_t ip = 0; ip < np; ++ip) {
+        TS_ASSERT_DELTA(jacobian.get(i, ip), expectedJacobian.get(i, ip), 1e-14);
+      }
+    }
+  }
 };
@@ -9,6 +9,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/PeakFunctionIntegrator.h"
 #include "MantidCurveFitting/Functions/Gaussian.h"
 #include "MantidCurveFitting/Functions/Lorentzian.h"
@@ -430,6 +431,27 @@ public:
     return;
   }
 
+  /// With a zero width no point is near the peak, so nothing is calculated
+  void test_functionWithDeriv_with_zero_fwhm() {
+    auto pv = getInitializedPV(1.0, 2.0, 0.0, 0.5);
+    FunctionDomain1DVector x(-10, 10, 101);
+    const size_t np = pv->nParams();
+    FunctionValues values(x);
+    TempJacobian jacobian(x.size(), np);
+    for (size_t i = 0; i < x.size(); ++i) {
+      values.setCalculated(i, -1.0);
+      for (size_t ip = 0; ip < np; ++ip)
+        jacobian.set(i, ip, -1.0);
+    }
+    TS_ASSERT_THROWS_NOTHING(pv->functionWithDeriv(x, values, jacobian));
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_EQUALS(values[i], 0.0);
+      for (size_t ip = 0; ip < np; ++ip) {
+        TS_ASSERT_EQUALS(jacobian.get(i, ip), 0.0);
+      }
+    }
+  }
+
 private:
   IPeakFunction_sptr getInitializedPV(double center, double intensity, double fwhm, double mixing) {
     IPeakFunction_sptr pv = std::make_shared<PseudoVoigt>();
@@ -0,0 +1,66 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** BankEventBuffers : hands out the arrays that LoadBankFromDiskTask reads the
+  raw events of a bank into, and recycles them once ProcessBankData has
+  dropped the last reference.
+
+  Each bank in flight holds one event id buffer, so counting the event id
+  buffers bounds how far reading can run ahead of processing. A bank is read
+  into its buffers straight away, and waitForRoom() then blocks until fewer
+  than maxBanksInFlight() other banks are waiting for or being processed, so
+  the next bank is read while the previous ones are processed.
+
+  The buffers must not outlive the BankEventBuffers that handed them out.
+*/
+class MANTID_DATAHANDLING_DLL BankEventBuffers {
+public:
+  explicit BankEventBuffers(const size_t maxBanksInFlight);
+
+  std::shared_ptr<std::vector<uint32_t>> eventIds(const size_t size);
+  std::shared_ptr<std::vector<float>> floats(const size_t size);
+  void waitForRoom();
+
+  /// Maximum number of banks whose events are held at once
+  size_t maxBanksInFlight() const { return m_maxBanksInFlight; }
+  size_t banksInFlight() const;
+
+private:
+  template <typename T>
+  static std::unique_ptr<std::vector<T>> takeFree(std::vector<std::unique_ptr<std::vector<T>>> &freeBuffers,
+                                                  const size_t size);
+  void releaseEventIds(std::vector<uint32_t> *buffer);
+  void releaseFloats(std::vector<float> *buffer);
+
+  /// Maximum number of banks waiting for or being processed
+  const size_t m_maxBanksInFlight;
+  /// Number of event id buffers handed out
+  size_t m_banksInFlight{0};
+  /// Event id buffers returned and ready for reuse
+  std::vector<std::unique_ptr<std::vector<uint32_t>>> m_freeEventIds;
+  /// Time-of-flight and weight buffers returned and ready for reuse
+  std::vector<std::unique_ptr<std::vector<float>>> m_freeFloats;
+  /// Protects the counters and the free buffers
+  mutable std::mutex m_mutex;
+  /// Signalled when an event id buffer is returned
+  std::condition_variable m_released;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
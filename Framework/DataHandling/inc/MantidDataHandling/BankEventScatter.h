@@ -0,0 +1,45 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidGeometry/IDTypes.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** BankEventScatter : helpers for ProcessBankData, which sorts the events of
+  a bank by pixel before appending them to the event lists in bulk.
+
+  findEventSlots() checks the detector ID and time-of-flight ranges of blocks
+  of events and gives each event its offset from the smallest detector ID, or
+  NOT_KEPT. An AVX2 implementation is used when the CPU supports it, with a
+  scalar fallback that gives identical results.
+*/
+namespace BankEventScatter {
+
+/// Slot of an event outside the detector ID or time-of-flight ranges
+constexpr uint32_t NOT_KEPT = std::numeric_limits<uint32_t>::max();
+
+MANTID_DATAHANDLING_DLL void findEventSlots(const std::vector<uint32_t> &eventIds, const std::vector<float> &tofs,
+                                            const detid_t minId, const detid_t maxId, const double tofMin,
+                                            const double tofMax, std::vector<uint32_t> &slots);
+
+MANTID_DATAHANDLING_DLL void findEventSlotsScalar(const std::vector<uint32_t> &eventIds,
+                                                  const std::vector<float> &tofs, const detid_t minId,
+                                                  const detid_t maxId, const double tofMin, const double tofMax,
+                                                  std::vector<uint32_t> &slots);
+
+MANTID_DATAHANDLING_DLL bool haveVectorisedSlots();
+
+} // namespace BankEventScatter
+} // namespace DataHandling
+} // namespace Mantid
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidAPI/Axis.h"
+#include "MantidDataHandling/BankEventBuffers.h"
 #include "MantidDataHandling/DllConfig.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 
@@ -30,6 +31,9 @@ public:
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
 
+  /// Flag for storing the events as CompactTofEvent's
+  bool m_compactEvents;
+
   /// True if the event_id is spectrum no not pixel ID
   bool event_id_is_spec;
 
@@ -65,6 +69,10 @@ public:
   /// in the event list.
   std::vector<std::vector<std::vector<Mantid::DataObjects::WeightedEvent> *>> weightedEventVectors;
 
+  /// Vector where index = event_id; value = ptr to std::vector<CompactTofEvent>
+  /// in the event list.
+  std::vector<std::vector<std::vector<Mantid::DataObjects::CompactTofEvent> *>> compactEventVectors;
+
   /// Vector where (index = pixel ID+pixelID_to_wi_offset), value = workspace
   /// index)
   std::vector<size_t> pixelID_to_wi_vector;
@@ -72,6 +80,10 @@ public:
   /// One entry of pulse times for each preprocessor
   std::vector<std::shared_ptr<BankPulseTimes>> m_bankPulseTimes;
 
+  /// Arrays the raw events of each bank are read into, limiting how many
+  /// banks are held in memory at once
+  BankEventBuffers m_bankBuffers;
+
 private:
   DefaultEventLoader(LoadEventNexus *alg, EventWorkspaceCollection &ws, bool haveWeights, bool event_id_is_spec,
                      const size_t numBanks, const bool precount, const int chunk, const int totalChunks);
@@ -56,6 +56,11 @@ private:
   size_t getWorkspaceIndexFromPixelID(const detid_t pixID);
   size_t getFirstEventIndex(const size_t pulseIndex) const;
   size_t getLastEventIndex(const size_t pulseIndex, const size_t numPulses) const;
+  template <typename Callback> void forEachPulse(const Callback &callback) const;
+  template <typename EventType, typename MakeEvent>
+  size_t appendEvents(const std::vector<std::vector<std::vector<EventType> *>> &vectors,
+                      const std::vector<uint32_t> &slots, const std::vector<size_t> &counts,
+                      const MakeEvent &makeEvent);
 
   /// Algorithm being run
   DefaultEventLoader &m_loader;
@@ -0,0 +1,106 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/BankEventBuffers.h"
+
+#include <algorithm>
+
+namespace Mantid::DataHandling {
+
+/** Constructor
+ * @param maxBanksInFlight :: maximum number of banks waiting for or being
+ * processed. At least one is always allowed.
+ */
+BankEventBuffers::BankEventBuffers(const size_t maxBanksInFlight)
+    : m_maxBanksInFlight(std::max(maxBanksInFlight, static_cast<size_t>(1))) {}
+
+/** Get a buffer for the event ids of a bank. This never waits, so that a bank
+ * can be read while the previous ones are processed; call waitForRoom() before
+ * handing it over for processing.
+ * @param size :: number of events in the bank
+ * @return a buffer of the requested size, returned for reuse when released
+ */
+std::shared_ptr<std::vector<uint32_t>> BankEventBuffers::eventIds(const size_t size) {
+  std::unique_ptr<std::vector<uint32_t>> buffer;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_banksInFlight;
+    buffer = takeFree(m_freeEventIds, size);
+  }
+  return std::shared_ptr<std::vector<uint32_t>>(buffer.release(),
+                                                [this](std::vector<uint32_t> *ids) { releaseEventIds(ids); });
+}
+
+/** Get a buffer for the times-of-flight or weights of a bank. This never
+ * waits: the number of banks in flight is limited by waitForRoom().
+ * @param size :: number of events in the bank
+ * @return a buffer of the requested size, returned for reuse when released
+ */
+std::shared_ptr<std::vector<float>> BankEventBuffers::floats(const size_t size) {
+  std::unique_ptr<std::vector<float>> buffer;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer = takeFree(m_freeFloats, size);
+  }
+  return std::shared_ptr<std::vector<float>>(buffer.release(),
+                                             [this](std::vector<float> *values) { releaseFloats(values); });
+}
+
+/** Wait until the event id buffer last handed out leaves no more than
+ * maxBanksInFlight() banks in flight, i.e. until one of the banks read
+ * earlier has been processed. Only the internal mutex is held while waiting.
+ */
+void BankEventBuffers::waitForRoom() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_released.wait(lock, [this] { return m_banksInFlight <= m_maxBanksInFlight; });
+}
+
+/// @return the number of event id buffers currently handed out
+size_t BankEventBuffers::banksInFlight() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_banksInFlight;
+}
+
+/** Take the free buffer with the largest capacity, or make a new one, and
+ * resize it. Must be called with m_mutex held.
+ * @param freeBuffers :: buffers available for reuse
+ * @param size :: size of the buffer wanted
+ * @return the buffer
+ */
+template <typename T>
+std::unique_ptr<std::vector<T>> BankEventBuffers::takeFree(std::vector<std::unique_ptr<std::vector<T>>> &freeBuffers,
+                                                           const size_t size) {
+  std::unique_ptr<std::vector<T>> buffer;
+  if (freeBuffers.empty()) {
+    buffer = std::make_unique<std::vector<T>>();
+  } else {
+    auto largest = std::max_element(
+        freeBuffers.begin(), freeBuffers.end(),
+        [](const auto &lhs, const auto &rhs) { return lhs->capacity() < rhs->capacity(); });
+    buffer = std::move(*largest);
+    freeBuffers.erase(largest);
+  }
+  buffer->resize(size);
+  return buffer;
+}
+
+/// Return an event id buffer for reuse and let a bank waiting for room proceed
+void BankEventBuffers::releaseEventIds(std::vector<uint32_t> *buffer) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_freeEventIds.emplace_back(buffer);
+    --m_banksInFlight;
+  }
+  m_released.notify_one();
+}
+
+/// Return a time-of-flight or weight buffer for reuse
+void BankEventBuffers::releaseFloats(std::vector<float> *buffer) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_freeFloats.emplace_back(buffer);
+}
+
+} // namespace Mantid::DataHandling
@@ -0,0 +1,142 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/BankEventScatter.h"
+
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BANKEVENTSCATTER_AVX2
+#include <immintrin.h>
+#endif
+
+namespace Mantid::DataHandling::BankEventScatter {
+
+namespace {
+/** Check the ranges of events [start, end) one at a time
+ * @param ids :: detector ID of each event
+ * @param times :: time-of-flight of each event
+ * @param minId :: smallest detector ID to keep
+ * @param maxId :: largest detector ID to keep
+ * @param tofMin :: smallest time-of-flight to keep
+ * @param tofMax :: largest time-of-flight to keep
+ * @param slots :: output, slot of each event
+ * @param start :: first event to check
+ * @param end :: one past the last event to check
+ */
+void findSlotsScalar(const uint32_t *ids, const float *times, const detid_t minId, const detid_t maxId,
+                     const double tofMin, const double tofMax, uint32_t *slots, const size_t start, const size_t end) {
+  for (size_t i = start; i < end; ++i) {
+    const auto detId = static_cast<detid_t>(ids[i]);
+    const auto tof = static_cast<double>(times[i]);
+    // this is fancy for check if value is in range
+    const bool keep = (detId >= minId) & (detId <= maxId) & ((tof - tofMin) * (tof - tofMax) <= 0.);
+    slots[i] = keep ? static_cast<uint32_t>(detId - minId) : NOT_KEPT;
+  }
+}
+
+void checkSizes(const std::vector<uint32_t> &eventIds, const std::vector<float> &tofs,
+                const std::vector<uint32_t> &slots) {
+  if (eventIds.size() < slots.size() || tofs.size() < slots.size())
+    throw std::invalid_argument("BankEventScatter::findEventSlots(): fewer event ids or times-of-flight than slots");
+}
+
+#ifdef BANKEVENTSCATTER_AVX2
+/** Check the ranges of eight events at a time with AVX2 and the remainder
+ * one at a time. The times-of-flight are widened to double, as in the scalar
+ * version, so that both give the same result.
+ */
+__attribute__((target("avx2"))) void findSlotsAVX2(const uint32_t *ids, const float *times, const detid_t minId,
+                                                   const detid_t maxId, const double tofMin, const double tofMax,
+                                                   uint32_t *slots, const size_t numEvents) {
+  const __m256i vMinId = _mm256_set1_epi32(minId);
+  const __m256i vMaxId = _mm256_set1_epi32(maxId);
+  const __m256i vNotKept = _mm256_set1_epi32(static_cast<int>(NOT_KEPT));
+  const __m256d vTofMin = _mm256_set1_pd(tofMin);
+  const __m256d vTofMax = _mm256_set1_pd(tofMax);
+  const __m256d vZero = _mm256_setzero_pd();
+  // Gathers the low half of each 64-bit comparison mask into the low 128 bits
+  const __m256i lowHalves = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+  const size_t numBlocks = numEvents / 8;
+  for (size_t block = 0; block < numBlocks; ++block) {
+    const size_t i = block * 8;
+    const __m256i detIds = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ids + i));
+    const __m256i idOutside =
+        _mm256_or_si256(_mm256_cmpgt_epi32(vMinId, detIds), _mm256_cmpgt_epi32(detIds, vMaxId));
+
+    const __m256 tofs = _mm256_loadu_ps(times + i);
+    const __m256d tofLow = _mm256_cvtps_pd(_mm256_castps256_ps128(tofs));
+    const __m256d tofHigh = _mm256_cvtps_pd(_mm256_extractf128_ps(tofs, 1));
+    const __m256d inLow =
+        _mm256_cmp_pd(_mm256_mul_pd(_mm256_sub_pd(tofLow, vTofMin), _mm256_sub_pd(tofLow, vTofMax)), vZero, _CMP_LE_OQ);
+    const __m256d inHigh = _mm256_cmp_pd(
+        _mm256_mul_pd(_mm256_sub_pd(tofHigh, vTofMin), _mm256_sub_pd(tofHigh, vTofMax)), vZero, _CMP_LE_OQ);
+    const __m128i tofInLow =
+        _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(inLow), lowHalves));
+    const __m128i tofInHigh =
+        _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(inHigh), lowHalves));
+    const __m256i tofIn = _mm256_inserti128_si256(_mm256_castsi128_si256(tofInLow), tofInHigh, 1);
+
+    const __m256i keep = _mm256_andnot_si256(idOutside, tofIn);
+    const __m256i slot = _mm256_sub_epi32(detIds, vMinId);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(slots + i), _mm256_blendv_epi8(vNotKept, slot, keep));
+  }
+  findSlotsScalar(ids, times, minId, maxId, tofMin, tofMax, slots, numBlocks * 8, numEvents);
+}
+#endif
+} // namespace
+
+/** Give each event its slot: its detector ID minus minId if the event is
+ * inside the detector ID and time-of-flight ranges, NOT_KEPT otherwise.
+ * Uses AVX2 when the CPU supports it.
+ * @param eventIds :: detector ID of each event
+ * @param tofs :: time-of-flight of each event
+ * @param minId :: smallest detector ID to keep
+ * @param maxId :: largest detector ID to keep
+ * @param tofMin :: smallest time-of-flight to keep
+ * @param tofMax :: largest time-of-flight to keep
+ * @param slots :: set to the slot of each event. Its size is the number of
+ * events to check.
+ */
+void findEventSlots(const std::vector<uint32_t> &eventIds, const std::vector<float> &tofs, const detid_t minId,
+                    const detid_t maxId, const double tofMin, const double tofMax, std::vector<uint32_t> &slots) {
+  checkSizes(eventIds, tofs, slots);
+#ifdef BANKEVENTSCATTER_AVX2
+  if (haveVectorisedSlots()) {
+    findSlotsAVX2(eventIds.data(), tofs.data(), minId, maxId, tofMin, tofMax, slots.data(), slots.size());
+    return;
+  }
+#endif
+  findSlotsScalar(eventIds.data(), tofs.data(), minId, maxId, tofMin, tofMax, slots.data(), 0, slots.size());
+}
+
+/** Same as findEventSlots() but never uses vector instructions
+ * @param eventIds :: detector ID of each event
+ * @param tofs :: time-of-flight of each event
+ * @param minId :: smallest detector ID to keep
+ * @param maxId :: largest detector ID to keep
+ * @param tofMin :: smallest time-of-flight to keep
+ * @param tofMax :: largest time-of-flight to keep
+ * @param slots :: set to the slot of each event
+ */
+void findEventSlotsScalar(const std::vector<uint32_t> &eventIds, const std::vector<float> &tofs, const detid_t minId,
+                          const detid_t maxId, const double tofMin, const double tofMax, std::vector<uint32_t> &slots) {
+  checkSizes(eventIds, tofs, slots);
+  findSlotsScalar(eventIds.data(), tofs.data(), minId, maxId, tofMin, tofMax, slots.data(), 0, slots.size());
+}
+
+/// @return true if findEventSlots() uses AVX2 on this CPU
+bool haveVectorisedSlots() {
+#ifdef BANKEVENTSCATTER_AVX2
+  static const bool haveAVX2 = __builtin_cpu_supports("avx2");
+  return haveAVX2;
+#else
+  return false;
+#endif
+}
+
+} // namespace Mantid::DataHandling::BankEventScatter
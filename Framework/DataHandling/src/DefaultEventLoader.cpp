@@ -8,6 +8,7 @@
 #include "MantidAPI/Progress.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadSchedulerMutexes.h"
 
@@ -15,6 +16,20 @@ using namespace Mantid::Kernel;
 
 namespace Mantid::DataHandling {
 
+namespace {
+/** Get the maximum number of banks that may be read before being processed
+ * from the loadeventnexus.maxbanksinflight setting. If it is not set, allow
+ * one bank being processed per core and one more being read.
+ * @return the maximum number of banks held in memory at once
+ */
+size_t getMaxBanksInFlight() {
+  const auto configValue = ConfigService::Instance().getValue<int>("loadeventnexus.maxbanksinflight");
+  if (configValue.is_initialized() && configValue.get() > 0)
+    return static_cast<size_t>(configValue.get());
+  return ThreadPool::getNumPhysicalCores() + 1;
+}
+} // namespace
+
 void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws, bool haveWeights,
                               bool event_id_is_spec, std::vector<std::string> bankNames,
                               const std::vector<int> &periodLog, const std::string &classType,
@@ -49,16 +64,32 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg, EventWorkspaceCollection &ws, bool haveWeights,
                                        bool event_id_is_spec, const size_t numBanks, const bool precount,
                                        const int chunk, const int totalChunks)
-    : m_haveWeights(haveWeights), event_id_is_spec(event_id_is_spec), precount(precount), chunk(chunk),
-      totalChunks(totalChunks), alg(alg), m_ws(ws) {
+    : m_haveWeights(haveWeights), m_compactEvents(false), event_id_is_spec(event_id_is_spec), precount(precount),
+      chunk(chunk), totalChunks(totalChunks), alg(alg), m_ws(ws), m_bankBuffers(getMaxBanksInFlight()) {
   // This map will be used to find the workspace index
   if (event_id_is_spec)
     pixelID_to_wi_vector = m_ws.getSpectrumToWorkspaceIndexVector(pixelID_to_wi_offset);
   else
     pixelID_to_wi_vector = m_ws.getDetectorIDToWorkspaceIndexVector(pixelID_to_wi_offset, true);
 
+  // Compact events index into the pulse times shared by all banks
+  const auto &allBanksPulseTimes = alg->m_allBanksPulseTimes;
+  m_compactEvents = alg->compactEvents && !haveWeights && alg->compressTolerance < 0 && allBanksPulseTimes &&
+                    !allBanksPulseTimes->pulseTimes.empty();
+
   // Cache a map for speed.
-  if (!haveWeights) {
+  if (m_compactEvents) {
+    std::shared_ptr<const std::vector<Types::Core::DateAndTime>> pulseTimes(allBanksPulseTimes,
+                                                                            &allBanksPulseTimes->pulseTimes);
+    for (size_t period = 0; period < m_ws.nPeriods(); ++period) {
+      for (size_t i = 0; i < m_ws.getNumberHistograms(); i++) {
+        auto &spectrum = m_ws.getSpectrum(i, period);
+        spectrum.setPulseTimeTable(pulseTimes);
+        spectrum.switchTo(DataObjects::EventStorage::Compact);
+      }
+    }
+    makeMapToEventLists(compactEventVectors);
+  } else if (!haveWeights) {
     makeMapToEventLists(eventVectors);
   } else {
     // Convert to weighted events
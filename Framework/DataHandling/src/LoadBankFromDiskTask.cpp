@@ -149,15 +149,15 @@ void LoadBankFromDiskTask::prepareEventId(::NeXus::File &file, int64_t &start_ev
 
 /** Load the event_id field, which has been opened
  * @param file An NeXus::File object opened at the correct group
- * @returns A new array containing the event Ids for this bank
+ * @returns An array containing the event Ids for this bank
  */
-std::unique_ptr<std::vector<uint32_t>> LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
+std::shared_ptr<std::vector<uint32_t>> LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   // This is the data size
   ::NeXus::Info id_info = file.getInfo();
   int64_t dim0 = recalculateDataSize(id_info.dims[0]);
 
-  // Now we allocate the required arrays
-  auto event_id = std::make_unique<std::vector<uint32_t>>(m_loadSize[0]);
+  // Now we get the required arrays
+  auto event_id = m_loader.m_bankBuffers.eventIds(static_cast<size_t>(m_loadSize[0]));
 
   // Check that the required space is there in the file.
   if (dim0 < m_loadSize[0] + m_loadStart[0]) {
@@ -209,11 +209,11 @@ std::unique_ptr<std::vector<uint32_t>> LoadBankFromDiskTask::loadEventId(::NeXus
 
 /** Open and load the times-of-flight data
  * @param file An NeXus::File object opened at the correct group
- * @returns A new array containing the time of flights for this bank
+ * @returns An array containing the time of flights for this bank
  */
-std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
-  // Allocate the array
-  auto event_time_of_flight = std::make_unique<std::vector<float>>(m_loadSize[0]);
+std::shared_ptr<std::vector<float>> LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
+  // Get the array
+  auto event_time_of_flight = m_loader.m_bankBuffers.floats(static_cast<size_t>(m_loadSize[0]));
 
   // Get the list of event_time_of_flight's
   std::string key, tof_unit;
@@ -238,36 +238,35 @@ std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadTof(::NeXus::File
   // We thus have to consider 32-bit or 64-bit options, and we
   // explicitly allow downcasting using the additional AllowDowncasting
   // template argument.
-  auto vec = NeXus::NeXusIOHelper::readNexusSlab<float, NeXus::NeXusIOHelper::AllowNarrowing>(file, key, m_loadStart,
-                                                                                              m_loadSize);
+  NeXus::NeXusIOHelper::readNexusSlab<float, NeXus::NeXusIOHelper::AllowNarrowing>(*event_time_of_flight, file, key,
+                                                                                  m_loadStart, m_loadSize);
   file.getAttr("units", tof_unit);
   file.closeData();
   // Convert Tof to microseconds
-  Kernel::Units::timeConversionVector(vec, tof_unit, "microseconds");
-  std::copy(vec.begin(), vec.end(), event_time_of_flight->data());
+  Kernel::Units::timeConversionVector(*event_time_of_flight, tof_unit, "microseconds");
 
   return event_time_of_flight;
 }
 
 /** Load weight of weigthed events if they exist
  * @param file An NeXus::File object opened at the correct group
- * @returns A new array containing the weights or a nullptr if the weights
+ * @returns An array containing the weights or a nullptr if the weights
  * are not present
  */
-std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
+std::shared_ptr<std::vector<float>> LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   try {
     // First, get info about the event_weight field in this bank
     file.openData("event_weight");
   } catch (::NeXus::Exception &) {
     // Field not found error is most likely.
     m_have_weight = false;
-    return std::unique_ptr<std::vector<float>>();
+    return std::shared_ptr<std::vector<float>>();
   }
   // OK, we've got them
   m_have_weight = true;
 
-  // Allocate the array
-  auto event_weight = std::make_unique<std::vector<float>>(m_loadSize[0]);
+  // Get the array
+  auto event_weight = m_loader.m_bankBuffers.floats(static_cast<size_t>(m_loadSize[0]));
 
   ::NeXus::Info weight_info = file.getInfo();
   int64_t weight_dim0 = recalculateDataSize(weight_info.dims[0]);
@@ -304,9 +303,9 @@ void LoadBankFromDiskTask::run() {
   prog->report(entry_name + ": load from disk");
 
   // arrays to load into
-  std::unique_ptr<std::vector<uint32_t>> event_id;
-  std::unique_ptr<std::vector<float>> event_time_of_flight;
-  std::unique_ptr<std::vector<float>> event_weight;
+  std::shared_ptr<std::vector<uint32_t>> event_id;
+  std::shared_ptr<std::vector<float>> event_time_of_flight;
+  std::shared_ptr<std::vector<float>> event_weight;
   std::vector<uint64_t> event_index;
 
   // Open the file
@@ -424,20 +423,23 @@ void LoadBankFromDiskTask::run() {
   auto numEvents = static_cast<size_t>(m_loadSize[0]);
   auto startAt = static_cast<size_t>(m_loadStart[0]);
 
-  // convert things to shared_arrays to share between tasks
-  std::shared_ptr<std::vector<uint32_t>> event_id_shrd(event_id.release());
-  std::shared_ptr<std::vector<float>> event_time_of_flight_shrd(event_time_of_flight.release());
-  std::shared_ptr<std::vector<float>> event_weight_shrd(event_weight.release());
+  // Wait until an earlier bank has been processed if too many are already in
+  // flight. This task holds the disk IO mutex, so no other bank is read
+  // meanwhile, but the other pool threads stay free to process banks.
+  m_loader.m_bankBuffers.waitForRoom();
+
+  // The event arrays are shared between the tasks and go back to the loader
+  // for the next bank once both have finished
   auto event_index_shrd = std::make_shared<std::vector<uint64_t>>(std::move(event_index));
 
   std::shared_ptr<Task> newTask1 = std::make_shared<ProcessBankData>(
-      m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd, numEvents, startAt, event_index_shrd,
-      thisBankPulseTimes, m_have_weight, event_weight_shrd, m_min_id, mid_id);
+      m_loader, entry_name, prog, event_id, event_time_of_flight, numEvents, startAt, event_index_shrd,
+      thisBankPulseTimes, m_have_weight, event_weight, m_min_id, mid_id);
   scheduler.push(newTask1);
   if (m_loader.splitProcessing && (mid_id < m_max_id)) {
     std::shared_ptr<Task> newTask2 = std::make_shared<ProcessBankData>(
-        m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd, numEvents, startAt, event_index_shrd,
-        thisBankPulseTimes, m_have_weight, event_weight_shrd, (mid_id + 1), m_max_id);
+        m_loader, entry_name, prog, event_id, event_time_of_flight, numEvents, startAt, event_index_shrd,
+        thisBankPulseTimes, m_have_weight, event_weight, (mid_id + 1), m_max_id);
     scheduler.push(newTask2);
   }
 }
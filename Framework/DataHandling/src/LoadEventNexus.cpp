@@ -77,8 +77,8 @@ bool exists(const std::map<std::string, std::string> &entries, const std::string
  */
 LoadEventNexus::LoadEventNexus()
     : filter_tof_min(0), filter_tof_max(0), m_specMin(0), m_specMax(0), longest_tof(0), shortest_tof(0), bad_tofs(0),
-      discarded_events(0), compressTolerance(0), m_instrument_loaded_correctly(false), loadlogs(false),
-      event_id_is_spec(false) {}
+      discarded_events(0), compressTolerance(0), compactEvents(false), m_instrument_loaded_correctly(false),
+      loadlogs(false), event_id_is_spec(false) {}
 
 //----------------------------------------------------------------------------------------------
 /**
@@ -172,6 +172,12 @@ void LoadEventNexus::init() {
                   "This specified the tolerance to use (in microseconds) when "
                   "compressing.");
 
+  declareProperty(std::make_unique<PropertyWithValue<bool>>("CompactEvents", false, Direction::Input),
+                  "Store each event as a single precision time-of-flight and "
+                  "the index of its pulse, halving the memory used by the events "
+                  "(optional, default False). "
+                  "Ignored for weighted events or when CompressTolerance is set.");
+
   auto mustBePositive = std::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
   declareProperty("ChunkNumber", EMPTY_INT(), mustBePositive,
@@ -188,6 +194,7 @@ void LoadEventNexus::init() {
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("CompactEvents", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
 
@@ -391,6 +398,7 @@ void LoadEventNexus::execLoader() {
   m_filename = getPropertyValue("Filename");
 
   compressTolerance = getProperty("CompressTolerance");
+  compactEvents = getProperty("CompactEvents");
 
   loadlogs = getProperty("LoadLogs");
 
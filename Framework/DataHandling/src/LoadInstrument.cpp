@@ -194,9 +194,14 @@ void LoadInstrument::exec() {
     } else {
 
       if (loader_type < LoaderType::Nxs) {
-        // Really create the instrument
-        Progress prog(this, 0.0, 1.0, 100);
-        instrument = parser.parseXML(&prog);
+        // Use the snapshot written when this definition was last parsed, or
+        // really create the instrument and write one
+        instrument = parser.loadSnapshot();
+        if (!instrument) {
+          Progress prog(this, 0.0, 1.0, 100);
+          instrument = parser.parseXML(&prog);
+          parser.saveSnapshot();
+        }
         // Parse the instrument tree (internally create ComponentInfo and
         // DetectorInfo). This is an optimization that avoids duplicate parsing
         // of the instrument tree when loading multiple workspaces with the same
@@ -4,8 +4,10 @@
 //   NScD Oak Ridge National Laboratory, European Spallation Source,
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
+#include <algorithm>
 #include <utility>
 
+#include "MantidDataHandling/BankEventScatter.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
@@ -54,10 +56,115 @@ inline size_t getPulseIndex(const size_t event_index, const size_t last_pulse_in
   }
   return std::distance(event_index_vec->cbegin(), event_index_iter);
 }
+
+/** Find the index of each pulse of a bank in the pulse times shared by all
+ * banks, which is what compact events refer to
+ * @param bankPulseTimes :: pulse times of the bank
+ * @param allPulseTimes :: pulse times shared by all banks
+ * @param entryName :: name of the bank, for the error message
+ * @return the index in allPulseTimes of each bank pulse
+ */
+std::vector<uint32_t> mapPulseIndices(const std::vector<Types::Core::DateAndTime> &bankPulseTimes,
+                                      const std::vector<Types::Core::DateAndTime> &allPulseTimes,
+                                      const std::string &entryName) {
+  const bool sorted = std::is_sorted(allPulseTimes.cbegin(), allPulseTimes.cend());
+  std::vector<uint32_t> indices;
+  indices.reserve(bankPulseTimes.size());
+  for (const auto &pulseTime : bankPulseTimes) {
+    const auto found = sorted ? std::lower_bound(allPulseTimes.cbegin(), allPulseTimes.cend(), pulseTime)
+                              : std::find(allPulseTimes.cbegin(), allPulseTimes.cend(), pulseTime);
+    if (found == allPulseTimes.cend() || *found != pulseTime)
+      throw std::runtime_error(entryName + " has pulse times that are not in the proton_charge log. "
+                                           "Load it with CompactEvents=False.");
+    indices.emplace_back(static_cast<uint32_t>(std::distance(allPulseTimes.cbegin(), found)));
+  }
+  return indices;
+}
+
 } // namespace
 
+/** Call a function with the range of events of each pulse of the chunk
+ * @param callback :: called with the pulse index and the indices of the first
+ * and one past the last event of the pulse. It returns false to stop.
+ */
+template <typename Callback> void ProcessBankData::forEachPulse(const Callback &callback) const {
+  const auto NUM_PULSES = thisBankPulseTimes->pulseTimes.size();
+  for (std::size_t pulseIndex = getPulseIndex(startAt, 0, event_index); pulseIndex < NUM_PULSES; pulseIndex++) {
+    const auto firstEventIndex = getFirstEventIndex(pulseIndex);
+    if (firstEventIndex > numEvents)
+      break;
+
+    const auto lastEventIndex = getLastEventIndex(pulseIndex, NUM_PULSES);
+    if (firstEventIndex == lastEventIndex)
+      continue;
+    else if (firstEventIndex > lastEventIndex) {
+      std::stringstream msg;
+      msg << "Something went really wrong: " << firstEventIndex << " > " << lastEventIndex << "| " << entry_name
+          << " startAt=" << startAt << " numEvents=" << event_index->size() << " RAWINDICES=["
+          << firstEventIndex + startAt << ",?)"
+          << " pulseIndex=" << pulseIndex << " of " << event_index->size();
+      throw std::runtime_error(msg.str());
+    }
+    if (!callback(pulseIndex, firstEventIndex, lastEventIndex))
+      break;
+  }
+}
+
+/** Append the kept events to the event lists of their period and pixel, in
+ * the order of the file. With Precount, each event list is first reserved for
+ * the events of this bank.
+ * @param vectors :: event vector of each period and detector ID, null for
+ * detector IDs without an event list
+ * @param slots :: slot of each event from findEventSlots()
+ * @param counts :: number of events of each period and pixel
+ * @param makeEvent :: makes the event from its index and pulse index
+ * @return the number of events without an event list, which are discarded
+ */
+template <typename EventType, typename MakeEvent>
+size_t ProcessBankData::appendEvents(const std::vector<std::vector<std::vector<EventType> *>> &vectors,
+                                     const std::vector<uint32_t> &slots, const std::vector<size_t> &counts,
+                                     const MakeEvent &makeEvent) {
+  const size_t numPixels = static_cast<size_t>(m_max_id - m_min_id) + 1;
+  const auto &periodNumbers = thisBankPulseTimes->periodNumbers;
+
+  // ---- Find the event list of each period and pixel, and reserve it ----
+  std::vector<std::vector<EventType> *> targets(counts.size(), nullptr);
+  size_t discarded = 0;
+  for (size_t key = 0; key < counts.size(); ++key) {
+    const size_t count = counts[key];
+    if (count == 0)
+      continue;
+    const size_t period = key / numPixels;
+    const auto detId = static_cast<detid_t>(m_min_id + static_cast<detid_t>(key % numPixels));
+    auto *eventVector = vectors[period][detId];
+    // NULL eventVector indicates a bad spectrum lookup
+    if (!eventVector) {
+      discarded += count;
+      continue;
+    }
+    if (m_loader.precount)
+      eventVector->reserve(eventVector->size() + count);
+    targets[key] = eventVector;
+  }
+
+  // ---- Append the events ----
+  forEachPulse([&](const size_t pulseIndex, const size_t firstEventIndex, const size_t lastEventIndex) {
+    const size_t periodOffset = static_cast<size_t>(periodNumbers[pulseIndex] - 1) * numPixels;
+    for (std::size_t eventIndex = firstEventIndex; eventIndex < lastEventIndex; ++eventIndex) {
+      const auto slot = slots[eventIndex];
+      if (slot == BankEventScatter::NOT_KEPT)
+        continue;
+      if (auto *eventVector = targets[periodOffset + slot])
+        eventVector->emplace_back(makeEvent(eventIndex, pulseIndex));
+    }
+    return true;
+  });
+  return discarded;
+}
+
 /** Run the data processing
- * FIXME/TODO - split run() into readable methods
+ * The events of each pixel are counted first, so that the event lists are
+ * looked up and reserved once per bank rather than once per event.
  */
 void ProcessBankData::run() { // override {
   // Local tof limits
@@ -67,137 +174,88 @@ void ProcessBankData::run() { // override {
   size_t badTofs = 0;
   size_t my_discarded_events(0);
 
-  prog->report(entry_name + ": precount");
-  // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
+  const double TOF_MIN = alg->filter_tof_min;
+  const double TOF_MAX = alg->filter_tof_max;
 
-    std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
-    for (size_t i = 0; i < numEvents; i++) {
-      const auto thisId = detid_t((*event_id)[i]);
-      if (thisId >= m_min_id && thisId <= m_max_id)
-        counts[thisId - m_min_id]++;
-    }
+  // Default pulse time (if none are found)
+  const bool pulsetimesincreasing =
+      std::is_sorted(thisBankPulseTimes->pulseTimes.cbegin(), thisBankPulseTimes->pulseTimes.cend());
+  if (!std::is_sorted(event_index->cbegin(), event_index->cend()))
+    throw std::runtime_error("Event index is not sorted");
+
+  // ---- Find the events inside the detector ID and time-of-flight ranges ----
+  std::vector<uint32_t> slots(numEvents);
+  BankEventScatter::findEventSlots(*event_id, *event_time_of_flight, m_min_id, m_max_id, TOF_MIN, TOF_MAX, slots);
 
-    // Now we pre-allocate (reserve) the vectors of events in each pixel
-    // counted
-    const size_t numEventLists = outputWS.getNumberHistograms();
-    for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
-      if (counts[pixID - m_min_id] > 0) {
-        size_t wi = getWorkspaceIndexFromPixelID(pixID);
-        // Find the the workspace index corresponding to that pixel ID
-        // Allocate it
-        if (wi < numEventLists) {
-          outputWS.reserveEventListAt(wi, counts[pixID - m_min_id]);
+  prog->report(entry_name + ": precount");
+  // ---- Pre-counting events per period and pixel ID ----
+  const size_t numPixels = static_cast<size_t>(m_max_id - m_min_id) + 1;
+  const auto &periodNumbers = thisBankPulseTimes->periodNumbers;
+  std::vector<size_t> counts(outputWS.nPeriods() * numPixels, 0);
+  forEachPulse([&](const size_t pulseIndex, const size_t firstEventIndex, const size_t lastEventIndex) {
+    const size_t periodOffset = static_cast<size_t>(periodNumbers[pulseIndex] - 1) * numPixels;
+    for (std::size_t eventIndex = firstEventIndex; eventIndex < lastEventIndex; ++eventIndex) {
+      const auto slot = slots[eventIndex];
+      if (slot == BankEventScatter::NOT_KEPT)
+        continue;
+      ++counts[periodOffset + slot];
+
+      // Skip any events that are the cause of bad DAS data (e.g. a negative
+      // number in uint32 -> 2.4 billion * 100 nanosec = 2.4e8 microsec)
+      const auto tof = static_cast<double>((*event_time_of_flight)[eventIndex]);
+      if (tof < 2e8) {
+        // tof limits from things observed here
+        if (tof > my_longest_tof) {
+          my_longest_tof = tof;
         }
-        if (alg->getCancel())
-          break; // User cancellation
-      }
+        if (tof < my_shortest_tof) {
+          my_shortest_tof = tof;
+        }
+      } else
+        badTofs++;
     }
-  }
+    // check if cancelled after each pulse
+    return !alg->getCancel();
+  });
 
   // Check for canceled algorithm
   if (alg->getCancel()) {
     return;
   }
 
-  // Default pulse time (if none are found)
-  const bool pulsetimesincreasing =
-      std::is_sorted(thisBankPulseTimes->pulseTimes.cbegin(), thisBankPulseTimes->pulseTimes.cend());
-  if (!std::is_sorted(event_index->cbegin(), event_index->cend()))
-    throw std::runtime_error("Event index is not sorted");
-
-  // And there are this many pulses
-  const auto NUM_PULSES = thisBankPulseTimes->pulseTimes.size();
   prog->report(entry_name + ": filling events");
 
   // Will we need to compress?
   const bool compress = (alg->compressTolerance >= 0);
 
-  // Which detector IDs were touched?
-  std::vector<bool> usedDetIds;
-  usedDetIds.assign(m_max_id - m_min_id + 1, false);
-
-  const double TOF_MIN = alg->filter_tof_min;
-  const double TOF_MAX = alg->filter_tof_max;
-
-  for (std::size_t pulseIndex = getPulseIndex(startAt, 0, event_index); pulseIndex < NUM_PULSES; pulseIndex++) {
-    // Save the pulse time at this index for creating those events
-    const auto pulsetime = thisBankPulseTimes->pulseTimes[pulseIndex];
-    const int logPeriodNumber = thisBankPulseTimes->periodNumbers[pulseIndex];
-    const int periodIndex = logPeriodNumber - 1;
-
-    const auto firstEventIndex = getFirstEventIndex(pulseIndex);
-    if (firstEventIndex > numEvents)
-      break;
-
-    const auto lastEventIndex = getLastEventIndex(pulseIndex, NUM_PULSES);
-    if (firstEventIndex == lastEventIndex)
-      continue;
-    else if (firstEventIndex > lastEventIndex) {
-      std::stringstream msg;
-      msg << "Something went really wrong: " << firstEventIndex << " > " << lastEventIndex << "| " << entry_name
-          << " startAt=" << startAt << " numEvents=" << event_index->size() << " RAWINDICES=["
-          << firstEventIndex + startAt << ",?)"
-          << " pulseIndex=" << pulseIndex << " of " << event_index->size();
-      throw std::runtime_error(msg.str());
-    }
-
-    for (std::size_t eventIndex = firstEventIndex; eventIndex < lastEventIndex; ++eventIndex) {
-      // We cached a pointer to the vector<tofEvent> -> so retrieve it and add
-      // the event
-      const detid_t detId = (*event_id)[eventIndex];
-      if (detId >= m_min_id && detId <= m_max_id) {
-        // Create the tofevent
-        const auto tof = static_cast<double>((*event_time_of_flight)[eventIndex]);
-        // this is fancy for check if value is in range
-        if ((tof - TOF_MIN) * (tof - TOF_MAX) <= 0.) {
-          // Handle simulated data if present
-          if (have_weight) {
-            auto *eventVector = m_loader.weightedEventVectors[periodIndex][detId];
-            // NULL eventVector indicates a bad spectrum lookup
-            if (eventVector) {
-              const auto weight = static_cast<double>((*event_weight)[eventIndex]);
-              const double errorSq = weight * weight;
-              eventVector->emplace_back(tof, pulsetime, weight, errorSq);
-            } else {
-              ++my_discarded_events;
-            }
-          } else {
-            // We have cached the vector of events for this detector ID
-            auto *eventVector = m_loader.eventVectors[periodIndex][detId];
-            // NULL eventVector indicates a bad spectrum lookup
-            if (eventVector) {
-              eventVector->emplace_back(tof, pulsetime);
-            } else {
-              ++my_discarded_events;
-            }
-          }
-
-          // Skip any events that are the cause of bad DAS data (e.g. a negative
-          // number in uint32 -> 2.4 billion * 100 nanosec = 2.4e8 microsec)
-          if (tof < 2e8) {
-            // tof limits from things observed here
-            if (tof > my_longest_tof) {
-              my_longest_tof = tof;
-            }
-            if (tof < my_shortest_tof) {
-              my_shortest_tof = tof;
-            }
-          } else
-            badTofs++;
-
-          // Track all the touched wi
-          usedDetIds[detId - m_min_id] = true;
-        } // valid time-of-flight
-
-      } // valid detector IDs
-    }   // for events in pulse
-    // check if cancelled after each pulse
-    if (alg->getCancel())
-      break;
-  } // for pulses
+  const auto &pulseTimes = thisBankPulseTimes->pulseTimes;
+  if (have_weight) {
+    // Handle simulated data if present
+    const auto makeEvent = [&](const size_t eventIndex, const size_t pulseIndex) {
+      const auto tof = static_cast<double>((*event_time_of_flight)[eventIndex]);
+      const auto weight = static_cast<double>((*event_weight)[eventIndex]);
+      return WeightedEvent(tof, pulseTimes[pulseIndex], weight, weight * weight);
+    };
+    my_discarded_events = appendEvents(m_loader.weightedEventVectors, slots, counts, makeEvent);
+  } else if (m_loader.m_compactEvents) {
+    // Compact events refer to the pulse times shared by all banks
+    std::vector<uint32_t> compactPulseIndices;
+    if (thisBankPulseTimes != alg->m_allBanksPulseTimes)
+      compactPulseIndices = mapPulseIndices(pulseTimes, alg->m_allBanksPulseTimes->pulseTimes, entry_name);
+    const auto makeEvent = [&](const size_t eventIndex, const size_t pulseIndex) {
+      const auto compactPulseIndex =
+          compactPulseIndices.empty() ? static_cast<uint32_t>(pulseIndex) : compactPulseIndices[pulseIndex];
+      return CompactTofEvent((*event_time_of_flight)[eventIndex], compactPulseIndex);
+    };
+    my_discarded_events = appendEvents(m_loader.compactEventVectors, slots, counts, makeEvent);
+  } else {
+    const auto makeEvent = [&](const size_t eventIndex, const size_t pulseIndex) {
+      return Types::Event::TofEvent(static_cast<double>((*event_time_of_flight)[eventIndex]), pulseTimes[pulseIndex]);
+    };
+    my_discarded_events = appendEvents(m_loader.eventVectors, slots, counts, makeEvent);
+  }
 
   // Check for canceled algorithm
   if (alg->getCancel()) {
@@ -208,7 +266,11 @@ void ProcessBankData::run() { // override {
   // Do it on all the detector IDs we touched
   const size_t numEventLists = outputWS.getNumberHistograms();
   for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
-    if (usedDetIds[pixID - m_min_id]) {
+    const auto pixel = static_cast<size_t>(pixID - m_min_id);
+    bool used = false;
+    for (size_t key = pixel; key < counts.size() && !used; key += numPixels)
+      used = counts[key] > 0;
+    if (used) {
       // Find the the workspace index corresponding to that pixel ID
       size_t wi = getWorkspaceIndexFromPixelID(pixID);
       if (wi < numEventLists) {
@@ -226,6 +288,11 @@ void ProcessBankData::run() { // override {
   }
   prog->report(entry_name + ": filled events");
 
+  // Hand the event arrays back to the loader for the next bank
+  event_id.reset();
+  event_time_of_flight.reset();
+  event_weight.reset();
+
   alg->getLogger().debug() << entry_name << (pulsetimesincreasing ? " had " : " DID NOT have ")
                            << "monotonically increasing pulse times\n";
 
@@ -0,0 +1,139 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/BankEventBuffers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using Mantid::DataHandling::BankEventBuffers;
+
+class BankEventBuffersTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BankEventBuffersTest *createSuite() { return new BankEventBuffersTest(); }
+  static void destroySuite(BankEventBuffersTest *suite) { delete suite; }
+
+  void test_at_least_one_bank_is_allowed() {
+    BankEventBuffers buffers(0);
+    TS_ASSERT_EQUALS(buffers.maxBanksInFlight(), 1);
+  }
+
+  void test_buffers_have_requested_size() {
+    BankEventBuffers buffers(2);
+    auto ids = buffers.eventIds(10);
+    auto tofs = buffers.floats(10);
+    TS_ASSERT_EQUALS(ids->size(), 10);
+    TS_ASSERT_EQUALS(tofs->size(), 10);
+    TS_ASSERT_EQUALS(buffers.banksInFlight(), 1);
+    ids.reset();
+    TS_ASSERT_EQUALS(buffers.banksInFlight(), 0);
+  }
+
+  void test_released_buffers_are_reused() {
+    BankEventBuffers buffers(2);
+    auto ids = buffers.eventIds(100);
+    const auto *idData = ids->data();
+    auto tofs = buffers.floats(100);
+    const auto *tofData = tofs->data();
+    ids.reset();
+    tofs.reset();
+
+    ids = buffers.eventIds(50);
+    tofs = buffers.floats(80);
+    TS_ASSERT_EQUALS(ids->data(), idData);
+    TS_ASSERT_EQUALS(ids->size(), 50);
+    TS_ASSERT_EQUALS(tofs->data(), tofData);
+    TS_ASSERT_EQUALS(tofs->size(), 80);
+  }
+
+  void test_eventIds_does_not_wait() {
+    BankEventBuffers buffers(1);
+    auto first = buffers.eventIds(1);
+    auto second = buffers.eventIds(1);
+    TS_ASSERT_EQUALS(buffers.banksInFlight(), 2);
+  }
+
+  void test_waitForRoom_waits_for_a_bank_to_be_released() {
+    BankEventBuffers buffers(1);
+    auto first = buffers.eventIds(1);
+    buffers.waitForRoom();
+    std::atomic<bool> gotRoom{false};
+    std::thread reader([&buffers, &gotRoom] {
+      auto second = buffers.eventIds(1);
+      buffers.waitForRoom();
+      gotRoom = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TS_ASSERT(!gotRoom);
+    first.reset();
+    reader.join();
+    TS_ASSERT(gotRoom);
+    TS_ASSERT_EQUALS(buffers.banksInFlight(), 0);
+  }
+
+  void test_next_bank_is_read_while_earlier_banks_are_processed() {
+    constexpr size_t numBanks = 4;
+    constexpr size_t bankSize = 1000;
+    BankEventBuffers buffers(1);
+    std::mutex processMutex;
+    std::condition_variable processCondition;
+    std::deque<std::shared_ptr<std::vector<uint32_t>>> toProcess;
+    std::atomic<size_t> banksRead{0};
+    std::atomic<size_t> banksProcessed{0};
+    std::atomic<bool> readWhileProcessing{false};
+    std::atomic<bool> wrongBank{false};
+
+    std::thread processor([&] {
+      for (size_t bank = 0; bank < numBanks; ++bank) {
+        std::shared_ptr<std::vector<uint32_t>> ids;
+        {
+          std::unique_lock<std::mutex> lock(processMutex);
+          processCondition.wait(lock, [&toProcess] { return !toProcess.empty(); });
+          ids = std::move(toProcess.front());
+          toProcess.pop_front();
+        }
+        // Give the reader time to read the next bank
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (banksRead > banksProcessed + 1)
+          readWhileProcessing = true;
+        if (ids->front() != static_cast<uint32_t>(bank))
+          wrongBank = true;
+        ids.reset();
+        ++banksProcessed;
+      }
+    });
+
+    for (size_t bank = 0; bank < numBanks; ++bank) {
+      auto ids = buffers.eventIds(bankSize);
+      std::fill(ids->begin(), ids->end(), static_cast<uint32_t>(bank));
+      ++banksRead;
+      buffers.waitForRoom();
+      TS_ASSERT_LESS_THAN_EQUALS(buffers.banksInFlight(), buffers.maxBanksInFlight());
+      {
+        std::lock_guard<std::mutex> lock(processMutex);
+        toProcess.emplace_back(std::move(ids));
+      }
+      processCondition.notify_one();
+    }
+    processor.join();
+
+    TS_ASSERT(readWhileProcessing);
+    TS_ASSERT(!wrongBank);
+    TS_ASSERT_EQUALS(banksProcessed.load(), numBanks);
+    TS_ASSERT_EQUALS(buffers.banksInFlight(), 0);
+  }
+};
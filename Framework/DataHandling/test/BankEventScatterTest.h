@@ -0,0 +1,85 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/BankEventScatter.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace Mantid::DataHandling::BankEventScatter;
+
+class BankEventScatterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BankEventScatterTest *createSuite() { return new BankEventScatterTest(); }
+  static void destroySuite(BankEventScatterTest *suite) { delete suite; }
+
+  void test_slots_are_offsets_from_the_smallest_id() {
+    const std::vector<uint32_t> ids{5, 9, 10, 12, 13, 7};
+    const std::vector<float> tofs{100.f, 100.f, 100.f, 100.f, 100.f, 5000.f};
+    std::vector<uint32_t> slots(ids.size());
+    findEventSlots(ids, tofs, 7, 12, 0., 1000., slots);
+    const std::vector<uint32_t> expected{NOT_KEPT, 2, 3, 5, NOT_KEPT, NOT_KEPT};
+    TS_ASSERT_EQUALS(slots, expected);
+  }
+
+  void test_range_limits_are_kept() {
+    const std::vector<uint32_t> ids{7, 12, 8, 8};
+    const std::vector<float> tofs{50.f, 50.f, 10.f, 100.f};
+    std::vector<uint32_t> slots(ids.size());
+    findEventSlots(ids, tofs, 7, 12, 10., 100., slots);
+    const std::vector<uint32_t> expected{0, 5, 1, 1};
+    TS_ASSERT_EQUALS(slots, expected);
+  }
+
+  void test_only_the_requested_events_are_checked() {
+    const std::vector<uint32_t> ids(20, 3);
+    const std::vector<float> tofs(20, 1.f);
+    std::vector<uint32_t> slots(11, 42);
+    findEventSlots(ids, tofs, 0, 10, 0., 10., slots);
+    TS_ASSERT_EQUALS(slots, std::vector<uint32_t>(11, 3));
+  }
+
+  void test_too_few_events_throws() {
+    const std::vector<uint32_t> ids(4, 3);
+    const std::vector<float> tofs(3, 1.f);
+    std::vector<uint32_t> slots(4);
+    TS_ASSERT_THROWS(findEventSlots(ids, tofs, 0, 10, 0., 10., slots), const std::invalid_argument &);
+  }
+
+  void test_vectorised_slots_match_scalar_slots() {
+    // An odd number of events, so that the vectorised version has a remainder
+    const size_t numEvents = 10007;
+    std::mt19937 generator(4);
+    std::uniform_int_distribution<uint32_t> idDistribution(0, 3000);
+    std::uniform_real_distribution<float> tofDistribution(-10.f, 2e5f);
+    std::vector<uint32_t> ids(numEvents);
+    std::vector<float> tofs(numEvents);
+    for (size_t i = 0; i < numEvents; ++i) {
+      ids[i] = idDistribution(generator);
+      tofs[i] = tofDistribution(generator);
+      // IDs that are negative as detid_t, limits and NaN's
+      if (i % 97 == 0)
+        ids[i] = std::numeric_limits<uint32_t>::max() - 5;
+      if (i % 89 == 0)
+        ids[i] = 100;
+      if (i % 7 == 0)
+        tofs[i] = 1000.f;
+      if (i % 101 == 0)
+        tofs[i] = std::nanf("");
+    }
+    std::vector<uint32_t> slots(numEvents), scalarSlots(numEvents);
+    findEventSlots(ids, tofs, 100, 2500, 1000., 1.5e5, slots);
+    findEventSlotsScalar(ids, tofs, 100, 2500, 1000., 1.5e5, scalarSlots);
+    TS_ASSERT_EQUALS(slots, scalarSlots);
+  }
+};
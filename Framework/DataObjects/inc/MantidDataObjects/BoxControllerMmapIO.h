@@ -0,0 +1,114 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/BoxController.h"
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidKernel/MemoryMappedFile.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace Mantid {
+namespace DataObjects {
+
+//===============================================================================================
+/** The class responsible for keeping the events of a file-backed workspace in
+  a memory-mapped file of raw event data, using the generic box controller
+  interface.
+
+  Each event occupies the same columns as in the "event_data" array written by
+  BoxControllerNeXusIO, and block positions are counted in events. Blocks are
+  copied straight in and out of the mapping, so reads and writes from
+  different threads do not wait for each other and the page cache of the
+  operating system does the buffering. Only growing the file takes an
+  exclusive lock.
+
+  The file is not a NeXus file but a scratch store. A file created by
+  openFile() is removed when it is closed, unless setKeepOnClose() is used; a
+  file that already existed is never removed.
+
+  With setSourceFile(), the scratch file only holds the blocks saved to it:
+  blocks never saved are read from the source file, e.g. the NeXus file the
+  workspace was loaded from, which is not copied.
+*/
+class DLLExport BoxControllerMmapIO : public API::IBoxControllerIO {
+public:
+  BoxControllerMmapIO(API::BoxController *const bc);
+  ~BoxControllerMmapIO() override;
+
+  ///@return true if the file to write events is opened and false otherwise
+  bool isOpened() const override { return m_file.get() != nullptr; }
+  /// get the full file name of the file used for IO operations
+  const std::string &getFileName() const override { return m_fileName; }
+  /// Return the number of events read or written at once by the users of this class
+  size_t getDataChunk() const override { return DATA_CHUNK; }
+
+  bool openFile(const std::string &fileName, const std::string &mode) override;
+
+  void saveBlock(const std::vector<float> &DataBlock, const uint64_t blockPosition) const override;
+  void loadBlock(std::vector<float> &Block, const uint64_t blockPosition, const size_t nPoints) const override;
+  void saveBlock(const std::vector<double> &DataBlock, const uint64_t blockPosition) const override;
+  void loadBlock(std::vector<double> &Block, const uint64_t blockPosition, const size_t nPoints) const override;
+
+  void flushData() const override;
+  void closeFile() override;
+
+  void setDataType(const size_t blockSize, const std::string &typeName) override;
+  void getDataType(size_t &CoordSize, std::string &typeName) const override;
+
+  void setSourceFile(const std::shared_ptr<API::IBoxControllerIO> &source);
+
+  /// Keep a file created by openFile() when it is closed instead of removing it
+  void setKeepOnClose(const bool keep) { m_keepOnClose = keep; }
+  /// Number of values stored for each event
+  size_t getNDataColumns() const { return m_nColumns; }
+
+private:
+  /// Default number of events read or written at once
+  enum { DATA_CHUNK = 10000 };
+
+  template <typename Type>
+  void saveGenericBlock(const std::vector<Type> &DataBlock, const uint64_t blockPosition) const;
+  template <typename Type>
+  void loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition, const size_t nPoints) const;
+  void reserveBytes(const uint64_t bytes) const;
+
+  /// full file name of the event file
+  std::string m_fileName;
+  /// the mapped event file
+  std::unique_ptr<Kernel::MemoryMappedFile> m_file;
+  /// the box controller which uses this IO
+  API::BoxController *const m_bc;
+  /// number of bytes in each value stored (4 for float, 8 for double)
+  size_t m_coordSize;
+  /// number of values stored for each event
+  size_t m_nColumns;
+  /// name of the event type stored
+  std::string m_typeName;
+  /// one past the last byte written, the size the file is cut to on close
+  mutable std::atomic<uint64_t> m_bytesUsed{0};
+  /// held shared while copying blocks and exclusively while growing the file
+  mutable std::shared_mutex m_mapMutex;
+  /// protects the file length, in events, seen by the disk buffer
+  mutable std::mutex m_lengthMutex;
+  /// the file read for the blocks never saved to this one, if any
+  std::shared_ptr<API::IBoxControllerIO> m_source;
+  /// positions (in events) of the blocks saved to this file while it has a source
+  mutable std::unordered_set<uint64_t> m_savedBlocks;
+  /// protects the positions of the saved blocks
+  mutable std::mutex m_savedMutex;
+  /// true if openFile() created the file
+  bool m_createdFile{false};
+  /// keep a created file when it is closed
+  bool m_keepOnClose{false};
+};
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,86 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/Events.h"
+#include "MantidKernel/System.h"
+#include "MantidTypes/Core/DateAndTime.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventColumns : structure-of-arrays storage for the events of an EventList.
+
+  The time-of-flight, pulse time, weight and squared error of the events are
+  held in separate contiguous arrays, so kernels that only read or modify the
+  time-of-flight stream 8 bytes per event instead of the full event struct.
+
+  Columns that the stored event type does not carry are left empty: there are
+  no pulse times for WeightedEventNoTime and no weights for TofEvent.
+*/
+class DLLExport EventColumns {
+public:
+  EventColumns() = default;
+
+  void assign(const std::vector<Types::Event::TofEvent> &events);
+  void assign(const std::vector<WeightedEvent> &events);
+  void assign(const std::vector<WeightedEventNoTime> &events);
+
+  void copyTo(std::vector<Types::Event::TofEvent> &events) const;
+  void copyTo(std::vector<WeightedEvent> &events) const;
+  void copyTo(std::vector<WeightedEventNoTime> &events) const;
+
+  void addWeights();
+  void removePulseTimes();
+
+  void clear();
+  void reserve(std::size_t num);
+  void sortByTof();
+  void reverse();
+  void removeIf(const std::vector<bool> &remove);
+
+  /// Number of events held
+  std::size_t size() const { return m_tofs.size(); }
+  /// True if no events are held
+  bool empty() const { return m_tofs.empty(); }
+  /// True if the pulse time column is used
+  bool hasPulseTimes() const { return m_hasPulseTimes; }
+  /// True if the weight and error columns are used
+  bool hasWeights() const { return m_hasWeights; }
+  std::size_t getMemorySize() const;
+
+  /// Time-of-flight (or x value) of each event
+  std::vector<double> &tofs() { return m_tofs; }
+  /// Time-of-flight (or x value) of each event
+  const std::vector<double> &tofs() const { return m_tofs; }
+  /// Pulse time of each event, empty if hasPulseTimes() is false
+  const std::vector<Types::Core::DateAndTime> &pulseTimes() const { return m_pulseTimes; }
+  /// Pulse time of each event, empty if hasPulseTimes() is false
+  std::vector<Types::Core::DateAndTime> &pulseTimes() { return m_pulseTimes; }
+  /// Weight of each event, empty if hasWeights() is false
+  const std::vector<float> &weights() const { return m_weights; }
+  /// Weight of each event, empty if hasWeights() is false
+  std::vector<float> &weights() { return m_weights; }
+  /// Squared error of each event, empty if hasWeights() is false
+  const std::vector<float> &errorSquareds() const { return m_errorSquareds; }
+  /// Squared error of each event, empty if hasWeights() is false
+  std::vector<float> &errorSquareds() { return m_errorSquareds; }
+
+private:
+  std::vector<double> m_tofs;
+  std::vector<Types::Core::DateAndTime> m_pulseTimes;
+  std::vector<float> m_weights;
+  std::vector<float> m_errorSquareds;
+  bool m_hasPulseTimes{true};
+  bool m_hasWeights{false};
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -7,11 +7,15 @@
 #pragma once
 
 #include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/EventColumns.h"
 #include "MantidDataObjects/Events.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
+#include <atomic>
 #include <iosfwd>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -26,8 +30,28 @@ using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
+class EventList;
 class EventWorkspaceMRU;
 
+/** The output event lists of a split, indexed by target minus the smallest
+  target. Targets without an output have a null entry. The table can be
+  reused from spectrum to spectrum by only resetting the lists.
+*/
+struct DLLExport EventListSplitOutputs {
+  EventListSplitOutputs() = default;
+  explicit EventListSplitOutputs(const std::map<int, EventList *> &outputs);
+  /// @return the output of a target, nullptr if it has none
+  EventList *find(const int target) const {
+    const int64_t offset = static_cast<int64_t>(target) - firstTarget;
+    return (offset < 0 || offset >= static_cast<int64_t>(lists.size())) ? nullptr
+                                                                         : lists[static_cast<size_t>(offset)];
+  }
+  /// The smallest target
+  int firstTarget{0};
+  /// The output of each target from firstTarget on
+  std::vector<EventList *> lists;
+};
+
 /// How the event list is sorted.
 enum EventSortType {
   UNSORTED,
@@ -38,6 +62,16 @@ enum EventSortType {
   TIMEATSAMPLE_SORT
 };
 
+/// How the events of an EventList are laid out in memory.
+enum class EventStorage {
+  /// One vector of event structs (TofEvent, WeightedEvent, ...)
+  Rows,
+  /// Separate contiguous arrays of TOF, pulse time, weight and error
+  Columns,
+  /// CompactTofEvent's: float TOF and an index into a shared pulse time table
+  Compact
+};
+
 //==========================================================================================
 /** @class Mantid::DataObjects::EventList
 
@@ -50,6 +84,18 @@ enum EventSortType {
     or WeightedEvent (where each neutron can have a non-1 weight).
     This is done transparently.
 
+    The events can also be held column by column (see EventColumns) after
+    calling switchTo(EventStorage::Columns). TOF kernels such as histogramming,
+    masking and unit conversion then work on the columns directly. Any
+    operation without a columnar implementation, including access to the event
+    vectors, converts the list back to rows first.
+
+    Lists of TofEvent's can also be packed into CompactTofEvent's with
+    switchTo(EventStorage::Compact), which needs the table of pulse times the
+    events refer to (setPulseTimeTable()). This halves the memory used by the
+    events at the cost of storing the TOF as a float. The absolute pulse times
+    are only rebuilt when an operation needs them.
+
     @author Janik Zikovsky, SNS ORNL
     @date 4/02/2010
 */
@@ -103,6 +149,8 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
+    if (m_storage.load(std::memory_order_acquire) != EventStorage::Rows)
+      switchToRowStorage();
     this->events.emplace_back(event);
     this->order = UNSORTED;
   }
@@ -113,6 +161,8 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
+    if (m_storage.load(std::memory_order_acquire) != EventStorage::Rows)
+      switchToRowStorage();
     this->weightedEvents.emplace_back(event);
     this->order = UNSORTED;
   }
@@ -123,14 +173,36 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
+    if (m_storage.load(std::memory_order_acquire) != EventStorage::Rows)
+      switchToRowStorage();
     this->weightedEventsNoTime.emplace_back(event);
     this->order = UNSORTED;
   }
 
+  // --------------------------------------------------------------------------
+  /** Append an event to the histogram, without clearing the cache, to make it
+   * faster.
+   * NOTE: Only call this on an event list with EventStorage::Compact!
+   *
+   * @param event :: CompactTofEvent to add at the end of the list.
+   * */
+  inline void addEventQuickly(const CompactTofEvent &event) {
+    this->compactEvents.emplace_back(event);
+    this->order = UNSORTED;
+  }
+
   Mantid::API::EventType getEventType() const override;
 
   void switchTo(Mantid::API::EventType newType) override;
 
+  void switchTo(EventStorage newStorage);
+
+  EventStorage getStorage() const;
+
+  void setPulseTimeTable(std::shared_ptr<const std::vector<Types::Core::DateAndTime>> pulseTimes);
+
+  const std::shared_ptr<const std::vector<Types::Core::DateAndTime>> &getPulseTimeTable() const;
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<Types::Event::TofEvent> &getEvents();
@@ -142,6 +214,9 @@ public:
   std::vector<WeightedEventNoTime> &getWeightedEventsNoTime();
   const std::vector<WeightedEventNoTime> &getWeightedEventsNoTime() const;
 
+  std::vector<CompactTofEvent> &getCompactEvents();
+  const std::vector<CompactTofEvent> &getCompactEvents() const;
+
   void clear(const bool removeDetIDs = true) override;
   void clearUnused();
 
@@ -267,21 +342,30 @@ public:
 
   void splitByTime(Kernel::TimeSplitterType &splitter, std::vector<EventList *> outputs) const;
 
-  void splitByFullTime(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs, bool docorrection,
+  void splitByFullTime(Kernel::TimeSplitterType &splitter, const std::map<int, EventList *> &outputs, bool docorrection,
+                       double toffactor, double tofshift) const;
+  void splitByFullTime(Kernel::TimeSplitterType &splitter, const EventListSplitOutputs &outputs, bool docorrection,
                        double toffactor, double tofshift) const;
 
   /// Split ...
   std::string splitByFullTimeMatrixSplitter(const std::vector<int64_t> &vec_splitters_time,
                                             const std::vector<int> &vecgroups,
-                                            std::map<int, EventList *> vec_outputEventList, bool docorrection,
+                                            const std::map<int, EventList *> &vec_outputEventList, bool docorrection,
+                                            double toffactor, double tofshift) const;
+  std::string splitByFullTimeMatrixSplitter(const std::vector<int64_t> &vec_splitters_time,
+                                            const std::vector<int> &vecgroups,
+                                            const EventListSplitOutputs &vec_outputEventList, bool docorrection,
                                             double toffactor, double tofshift) const;
 
   /// Split events by pulse time
-  void splitByPulseTime(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs) const;
+  void splitByPulseTime(Kernel::TimeSplitterType &splitter, const std::map<int, EventList *> &outputs) const;
+  void splitByPulseTime(Kernel::TimeSplitterType &splitter, const EventListSplitOutputs &outputs) const;
 
   /// Split events by pulse time with Matrix splitters
   void splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
-                                  std::map<int, EventList *> outputs) const;
+                                  const std::map<int, EventList *> &outputs) const;
+  void splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
+                                  const EventListSplitOutputs &outputs) const;
 
   void multiply(const double value, const double error = 0.0) override;
   EventList &operator*=(const double value);
@@ -339,6 +423,22 @@ private:
   /// List of WeightedEvent's
   mutable std::vector<WeightedEventNoTime> weightedEventsNoTime;
 
+  /// Columnar events, used instead of the vectors above with
+  /// EventStorage::Columns
+  mutable std::unique_ptr<EventColumns> m_columns;
+
+  /// List of CompactTofEvent's, used instead of events with
+  /// EventStorage::Compact
+  mutable std::vector<CompactTofEvent> compactEvents;
+
+  /// Where the events are held. Atomic because a const list is switched back
+  /// to rows lazily, possibly while other threads read it.
+  mutable std::atomic<EventStorage> m_storage{EventStorage::Rows};
+
+  /// Pulse times referred to by the CompactTofEvent's. Usually shared by all
+  /// the event lists of a workspace.
+  std::shared_ptr<const std::vector<Types::Core::DateAndTime>> m_pulseTimeTable;
+
   /// What type of event is in our list.
   Mantid::API::EventType eventType;
 
@@ -371,6 +471,13 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  void switchToRowStorage() const;
+  void switchToRowStorage();
+  void switchToCompactStorage();
+  /// True if the events are held in m_columns
+  bool hasColumns() const { return m_storage.load(std::memory_order_acquire) == EventStorage::Columns; }
+  /// True if the events are held in compactEvents
+  bool hasCompactEvents() const { return m_storage.load(std::memory_order_acquire) == EventStorage::Compact; }
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start, const double seconds) const;
 
@@ -419,31 +526,33 @@ private:
   template <class T>
   void splitByTimeHelper(Kernel::TimeSplitterType &splitter, std::vector<EventList *> outputs,
                          typename std::vector<T> &events) const;
+  void prepareSplitOutputs(const EventListSplitOutputs &outputs) const;
   template <class T>
-  void splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
+  void splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, const EventListSplitOutputs &outputs,
                              typename std::vector<T> &events, bool docorrection, double toffactor,
                              double tofshift) const;
   /// Split events by pulse time
   template <class T>
-  void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
+  void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, const EventListSplitOutputs &outputs,
                               typename std::vector<T> &events) const;
 
   /// Split events (template) by pulse time with matrix splitters
   template <class T>
   void splitByPulseTimeWithMatrixHelper(const std::vector<int64_t> &vec_split_times,
-                                        const std::vector<int> &vec_split_target, std::map<int, EventList *> outputs,
+                                        const std::vector<int> &vec_split_target, const EventListSplitOutputs &outputs,
                                         typename std::vector<T> &events) const;
 
   template <class T>
   std::string splitByFullTimeVectorSplitterHelper(const std::vector<int64_t> &vectimes,
-                                                  const std::vector<int> &vecgroups, std::map<int, EventList *> outputs,
+                                                  const std::vector<int> &vecgroups,
+                                                  const EventListSplitOutputs &outputs,
                                                   typename std::vector<T> &vecEvents, bool docorrection,
                                                   double toffactor, double tofshift) const;
 
   template <class T>
   std::string
   splitByFullTimeSparseVectorSplitterHelper(const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-                                            std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+                                            const EventListSplitOutputs &outputs, typename std::vector<T> &vecEvents,
                                             bool docorrection, double toffactor, double tofshift) const;
 
   template <class T> static void multiplyHelper(std::vector<T> &events, const double value, const double error = 0.0);
@@ -466,6 +575,8 @@ DLLExport void getEventsFrom(EventList &el, std::vector<WeightedEvent> *&events)
 DLLExport void getEventsFrom(const EventList &el, std::vector<WeightedEvent> const *&events);
 DLLExport void getEventsFrom(EventList &el, std::vector<WeightedEventNoTime> *&events);
 DLLExport void getEventsFrom(const EventList &el, std::vector<WeightedEventNoTime> const *&events);
+DLLExport void getEventsFrom(EventList &el, std::vector<CompactTofEvent> *&events);
+DLLExport void getEventsFrom(const EventList &el, std::vector<CompactTofEvent> const *&events);
 
 } // namespace DataObjects
 } // namespace Mantid
\ No newline at end of file
@@ -130,6 +130,12 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Change the memory layout of the events
+  void switchEventStorage(const EventStorage storage);
+
+  // Share a table of pulse times between all the event lists
+  void setPulseTimeTable(const std::shared_ptr<const std::vector<Types::Core::DateAndTime>> &pulseTimes);
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
@@ -15,6 +15,7 @@
 #include "MantidKernel/cow_ptr.h"
 #include "MantidTypes/Event/TofEvent.h"
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <set>
 #include <vector>
@@ -154,6 +155,54 @@ public:
 };
 #pragma pack(pop)
 
+//==========================================================================================
+/** Info about a single neutron detection event, packed into 8 bytes:
+ *
+ *  - the time of flight of the neutron, stored as a float
+ *  - the index of the pulse at which it was produced, in the pulse time table
+ *    shared by the EventList (see EventList::setPulseTimeTable())
+ *
+ * The weight is implicitly 1.0, as for TofEvent.
+ */
+class DLLExport CompactTofEvent {
+
+  /// EventList has the right to mess with this
+  friend class EventList;
+
+protected:
+  /// The 'x value' (e.g. time-of-flight) of this neutron
+  float m_tof;
+
+  /// Index of the pulse time in the pulse time table of the EventList
+  uint32_t m_pulseIndex;
+
+public:
+  /// Constructor, full
+  CompactTofEvent(float tof, uint32_t pulseIndex);
+
+  CompactTofEvent();
+
+  bool operator==(const CompactTofEvent &rhs) const;
+
+  /** < comparison operator, using the TOF to do the comparison.
+   * @param rhs: the other CompactTofEvent to compare.
+   * @return true if this->m_tof < rhs.m_tof
+   */
+  bool operator<(const CompactTofEvent &rhs) const { return (this->m_tof < rhs.m_tof); }
+
+  /** < comparison operator, using the TOF to do the comparison.
+   * @param rhs_tof: the other time of flight to compare.
+   * @return true if this->m_tof < rhs.m_tof
+   */
+  bool operator<(const double rhs_tof) const { return (this->m_tof < rhs_tof); }
+
+  double operator()() const;
+  double tof() const;
+  uint32_t pulseIndex() const;
+  double weight() const;
+  double errorSquared() const;
+};
+
 //==========================================================================================
 // WeightedEvent inlined member function definitions
 //==========================================================================================
@@ -196,5 +245,23 @@ inline double WeightedEventNoTime::error() const { return std::sqrt(double(m_err
 /// Return the squared error of the neutron, as a double
 inline double WeightedEventNoTime::errorSquared() const { return m_errorSquared; }
 
+//==========================================================================================
+// CompactTofEvent inlined member function definitions
+//==========================================================================================
+
+inline double CompactTofEvent::operator()() const { return m_tof; }
+
+/// Return the time-of-flight of the neutron, as a double (it is saved as a float).
+inline double CompactTofEvent::tof() const { return m_tof; }
+
+/// Return the index of the pulse time in the pulse time table
+inline uint32_t CompactTofEvent::pulseIndex() const { return m_pulseIndex; }
+
+/// Return the weight of the neutron, which is always 1.0
+inline double CompactTofEvent::weight() const { return 1.0; }
+
+/// Return the squared error of the neutron, which is always 1.0
+inline double CompactTofEvent::errorSquared() const { return 1.0; }
+
 } // namespace DataObjects
 } // namespace Mantid
\ No newline at end of file
@@ -38,6 +38,8 @@ private:
   template <typename MDE, size_t nd>
   void addFakeRegularData(const std::vector<double> &params, typename MDEventWorkspace<MDE, nd>::sptr ws);
 
+  template <typename MDE, size_t nd> void splitBoxes(typename MDEventWorkspace<MDE, nd>::sptr ws);
+
   detid_t pickDetectorID();
 
   //------------------ Member variables ------------------------------------
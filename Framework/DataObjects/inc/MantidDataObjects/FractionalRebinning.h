@@ -13,6 +13,8 @@
 #include "MantidDataObjects/RebinnedOutput.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
 
+#include <vector>
+
 namespace Mantid {
 //------------------------------------------------------------------------------
 // Forward declarations
@@ -33,6 +35,43 @@ namespace DataObjects {
 
 namespace FractionalRebinning {
 
+/**
+ * The contributions of input quadrilaterals to the output grid, held apart
+ * from the output workspace so that each thread of a rebinning loop can add
+ * to its own PartialOutput without locking. The grid is split into tiles of
+ * consecutive bins of a spectrum, which are allocated when the first
+ * contribution falls into them. The partial outputs are added to the output
+ * workspace by addPartialOutputs, one after the other in the order of the
+ * threads.
+ */
+class MANTID_DATAOBJECTS_DLL PartialOutput {
+public:
+  explicit PartialOutput(const API::MatrixWorkspace &outputWS);
+  /// The horizontal bin edges of the output grid
+  const std::vector<double> &xAxis() const { return m_xAxis; }
+  /// Add a contribution to a bin of the output grid
+  void add(const size_t wsIndex, const size_t binIndex, const double signal, const double variance,
+           const double fraction = 0.);
+  /// Add the contributions to a spectrum of the output workspace
+  void addTo(API::MatrixWorkspace &outputWS, const size_t wsIndex) const;
+
+private:
+  /// Number of bins in a tile
+  static constexpr size_t TILE_SIZE = 64;
+  std::vector<double> m_xAxis;
+  size_t m_nBins;
+  size_t m_tilesPerSpectrum;
+  /// The signal, variance and fraction of each bin of a tile, empty until used
+  std::vector<std::vector<double>> m_tiles;
+};
+
+/// Create a partial output for each thread of a rebinning loop
+MANTID_DATAOBJECTS_DLL std::vector<PartialOutput> createPartialOutputs(const API::MatrixWorkspace &outputWS);
+
+/// Add the partial outputs to the output workspace, in the order they are given
+MANTID_DATAOBJECTS_DLL void addPartialOutputs(const std::vector<PartialOutput> &partials,
+                                              API::MatrixWorkspace &outputWS);
+
 /// Find the intersect region on the output grid
 MANTID_DATAOBJECTS_DLL bool getIntersectionRegion(const std::vector<double> &xAxis,
                                                   const std::vector<double> &verticalAxis,
@@ -50,6 +89,12 @@ MANTID_DATAOBJECTS_DLL void rebinToOutput(const Geometry::Quadrilateral &inputQ,
                                           const size_t j, API::MatrixWorkspace &outputWS,
                                           const std::vector<double> &verticalAxis);
 
+/// Rebin the input quadrilateral to a partial output of the grid
+MANTID_DATAOBJECTS_DLL void rebinToOutput(const Geometry::Quadrilateral &inputQ,
+                                          const API::MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                                          const size_t j, PartialOutput &partial,
+                                          const std::vector<double> &verticalAxis);
+
 /// Rebin the input quadrilateral to to output grid
 MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
                                                     const API::MatrixWorkspace_const_sptr &inputWS, const size_t i,
@@ -57,6 +102,13 @@ MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(const Geometry::Quadrilatera
                                                     const std::vector<double> &verticalAxis,
                                                     const DataObjects::RebinnedOutput_const_sptr &inputRB = nullptr);
 
+/// Rebin the input quadrilateral to a partial output of the grid
+MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
+                                                    const API::MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                                                    const size_t j, PartialOutput &partial,
+                                                    const std::vector<double> &verticalAxis,
+                                                    const DataObjects::RebinnedOutput_const_sptr &inputRB = nullptr);
+
 /// Set finalize flag after fractional rebinning loop
 MANTID_DATAOBJECTS_DLL void finalizeFractionalRebin(DataObjects::RebinnedOutput &outputWS);
 
@@ -0,0 +1,731 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDGridBox.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
+#include <thread>
+
+namespace Mantid {
+namespace DataObjects {
+
+/**
+ * Class to create the box structure of MDWorkspace. The algorithm:
+ * The MASTER thread starting to build tree structure recursively,
+ * if it finds the subtask to distribute N events N < threshold, the
+ * it delegates this independent subtask to other tread, syncronisation
+ * is implemented with queue and mutex.
+ * @tparam ND :: number of Dimensions
+ * @tparam MDEventType :: Type of created MDEvent [MDLeanEvent, MDEvent]
+ * @tparam EventIterator :: Iterator of sorted collection storing the converted
+ * events
+ */
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator> class MDEventTreeBuilder {
+  using MDEvent = MDEventType<ND>;
+  using IntT = typename MDEvent::IntT;
+  using MortonT = typename MDEvent::MortonT;
+  using BoxBase = MDBoxBase<MDEvent, ND>;
+  using Box = MDBox<MDEvent, ND>;
+  using GridBox = MDGridBox<MDEvent, ND>;
+  using EventDistributor = MDEventTreeBuilder<ND, MDEventType, EventIterator>;
+
+public:
+  using EventAccessType = EventAccessor;
+  using IndexCoordinateSwitcher = typename MDEvent::template AccessFor<EventDistributor>;
+  enum WORKER_TYPE { MASTER, SLAVE };
+  /**
+   * Structure to store the subtask of creating subtree from the
+   * range of events
+   */
+  struct Task {
+    BoxBase *root;
+    const EventIterator begin;
+    const EventIterator end;
+    const typename MDEventType<ND>::MortonT lowerBound;
+    const typename MDEventType<ND>::MortonT upperBound;
+    size_t maxDepth;
+    unsigned level;
+  };
+
+public:
+  MDEventTreeBuilder(const int numWorkers, const size_t threshold, const API::BoxController_sptr &bc,
+                     const morton_index::MDSpaceBounds<ND> &space);
+  struct TreeWithIndexError {
+    BoxBase *root;
+    morton_index::MDCoordinate<ND> err;
+  };
+  /**
+   *
+   * @param mdEvents :: events to distribute around the tree
+   * @return :: pointer to the root node and error
+   */
+  TreeWithIndexError distribute(std::vector<MDEventType<ND>> &mdEvents);
+
+private:
+  morton_index::MDCoordinate<ND> convertToIndex(std::vector<MDEventType<ND>> &mdEvents,
+                                                const morton_index::MDSpaceBounds<ND> &space);
+  void sortEvents(std::vector<MDEventType<ND>> &mdEvents);
+  BoxBase *doDistributeEvents(std::vector<MDEventType<ND>> &mdEvents);
+  void distributeEvents(Task &tsk, const WORKER_TYPE &wtp);
+  void pushTask(Task &&tsk);
+  std::unique_ptr<Task> popTask();
+  void waitAndLaunchSlave();
+
+private:
+  const int m_numWorkers;
+  const size_t m_eventsThreshold;
+  std::queue<Task> m_tasks;
+  std::mutex m_mutex;
+  std::atomic<bool> m_masterFinished;
+
+  const morton_index::MDSpaceBounds<ND> &m_space;
+  std::vector<Mantid::Geometry::MDDimensionExtents<coord_t>> m_extents;
+  const API::BoxController_sptr &m_bc;
+
+  const MortonT m_mortonMin;
+  const MortonT m_mortonMax;
+};
+
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+MDEventTreeBuilder<ND, MDEventType, EventIterator>::MDEventTreeBuilder(const int numWorkers, const size_t threshold,
+                                                                       const API::BoxController_sptr &bc,
+                                                                       const morton_index::MDSpaceBounds<ND> &space)
+    : m_numWorkers(numWorkers), m_eventsThreshold(threshold), m_masterFinished{false}, m_space{space}, m_bc{bc},
+      m_mortonMin{morton_index::calculateDefaultBound<ND, IntT, MortonT>(std::numeric_limits<IntT>::min())},
+      m_mortonMax{morton_index::calculateDefaultBound<ND, IntT, MortonT>(std::numeric_limits<IntT>::max())} {
+  for (size_t ax = 0; ax < ND; ++ax) {
+    m_extents.emplace_back();
+    m_extents.back().setExtents(space(ax, 0), space(ax, 1));
+  }
+}
+
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+typename MDEventTreeBuilder<ND, MDEventType, EventIterator>::TreeWithIndexError
+MDEventTreeBuilder<ND, MDEventType, EventIterator>::distribute(std::vector<MDEvent> &mdEvents) {
+  auto err = convertToIndex(mdEvents, m_space);
+  sortEvents(mdEvents);
+  auto root = doDistributeEvents(mdEvents);
+  return {root, err};
+}
+
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+MDBoxBase<MDEventType<ND>, ND> *
+MDEventTreeBuilder<ND, MDEventType, EventIterator>::doDistributeEvents(std::vector<MDEventType<ND>> &mdEvents) {
+  if (mdEvents.size() <= m_bc->getSplitThreshold()) {
+    for (auto &event : mdEvents)
+      IndexCoordinateSwitcher::convertToCoordinates(event, m_space);
+    m_bc->incBoxesCounter(0);
+    return new MDBox<MDEvent, ND>(m_bc.get(), 0, m_extents, mdEvents.begin(), mdEvents.end());
+  } else {
+    auto root = new MDGridBox<MDEvent, ND>(m_bc.get(), 0, m_extents);
+    Task tsk{root, mdEvents.begin(), mdEvents.end(), m_mortonMin, m_mortonMax, m_bc->getMaxDepth() + 1, 1};
+
+    if (m_numWorkers == 1)
+      distributeEvents(tsk, SLAVE);
+    else {
+      std::vector<std::thread> workers;
+      workers.emplace_back([this, &tsk]() {
+        distributeEvents(tsk, MASTER);
+        m_masterFinished = true;
+        waitAndLaunchSlave();
+      });
+      for (auto i = 1; i < m_numWorkers; ++i)
+        workers.emplace_back(&MDEventTreeBuilder::waitAndLaunchSlave, this);
+      for (auto &worker : workers)
+        worker.join();
+    }
+    return root;
+  }
+}
+
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+morton_index::MDCoordinate<ND>
+MDEventTreeBuilder<ND, MDEventType, EventIterator>::convertToIndex(std::vector<MDEventType<ND>> &mdEvents,
+                                                                   const morton_index::MDSpaceBounds<ND> &space) {
+  std::vector<morton_index::MDCoordinate<ND>> perThread(m_numWorkers, morton_index::MDCoordinate<ND>(0));
+#pragma omp parallel for num_threads(m_numWorkers)
+  for (int64_t i = 0; i < static_cast<int64_t>(mdEvents.size()); ++i) {
+    morton_index::MDCoordinate<ND> oldCoord{mdEvents[i].getCenter()};
+    IndexCoordinateSwitcher::convertToIndex(mdEvents[i], space);
+    morton_index::MDCoordinate<ND> newCoord =
+        morton_index::indexToCoordinates<ND, IntT, MortonT>(IndexCoordinateSwitcher::getIndex(mdEvents[i]), space);
+    newCoord -= oldCoord;
+    morton_index::MDCoordinate<ND> &threadErr{perThread[PARALLEL_THREAD_NUMBER]};
+    for (size_t d = 0; d < ND; ++d)
+      threadErr[d] = std::max(threadErr[d], std::abs(newCoord[d]));
+  }
+  morton_index::MDCoordinate<ND> maxErr(0);
+  for (const auto &err : perThread)
+    for (size_t d = 0; d < ND; ++d)
+      maxErr[d] = std::max(maxErr[d], err[d]);
+  return maxErr;
+}
+
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+void MDEventTreeBuilder<ND, MDEventType, EventIterator>::sortEvents(std::vector<MDEventType<ND>> &mdEvents) {
+
+  tbb::task_arena limited_arena(m_numWorkers);
+  limited_arena.execute([&]() {
+    tbb::parallel_sort(mdEvents.begin(), mdEvents.end(), [](const MDEventType<ND> &a, const MDEventType<ND> &b) {
+      return IndexCoordinateSwitcher::getIndex(a) < IndexCoordinateSwitcher::getIndex(b);
+    });
+  });
+}
+
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+void MDEventTreeBuilder<ND, MDEventType, EventIterator>::pushTask(
+    MDEventTreeBuilder<ND, MDEventType, EventIterator>::Task &&tsk) {
+  std::lock_guard<std::mutex> g(m_mutex);
+  m_tasks.emplace(tsk);
+}
+
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+std::unique_ptr<typename MDEventTreeBuilder<ND, MDEventType, EventIterator>::Task>
+MDEventTreeBuilder<ND, MDEventType, EventIterator>::popTask() {
+  std::lock_guard<std::mutex> g(m_mutex);
+  if (m_tasks.empty())
+    return {nullptr};
+  else {
+    auto task = std::make_unique<Task>(m_tasks.front());
+    m_tasks.pop();
+    return task;
+  }
+}
+
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+void MDEventTreeBuilder<ND, MDEventType, EventIterator>::waitAndLaunchSlave() {
+  while (true) {
+    auto pTsk = popTask();
+    if (pTsk)
+      distributeEvents(*pTsk.get(), SLAVE);
+    else if (m_masterFinished)
+      break;
+    else
+      std::this_thread::sleep_for(std::chrono::nanoseconds(100));
+  }
+}
+
+/**
+ * Does actual work on creating tasks in MASTER mode and
+ * executing tasks in SLAVE mode
+ */
+template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
+void MDEventTreeBuilder<ND, MDEventType, EventIterator>::distributeEvents(Task &tsk, const WORKER_TYPE &wtp) {
+  const size_t childBoxCount = m_bc->getNumSplit();
+  const size_t splitThreshold = m_bc->getSplitThreshold();
+
+  if (tsk.maxDepth-- == 1 || std::distance(tsk.begin, tsk.end) <= static_cast<int>(splitThreshold)) {
+    return;
+  }
+
+  /* Determine the "width" of this box in Morton number */
+  const MortonT thisBoxWidth = tsk.upperBound - tsk.lowerBound;
+
+  /* Determine the "width" of the child boxes in Morton number */
+  const MortonT childBoxWidth = thisBoxWidth / childBoxCount;
+
+  auto eventIt = tsk.begin;
+
+  struct RecursionHelper {
+    std::pair<EventIterator, EventIterator> eventRange;
+    std::pair<MortonT, MortonT> mortonBounds;
+    BoxBase *box;
+  };
+  std::vector<RecursionHelper> children;
+  children.reserve(childBoxCount);
+
+  /* For each new child box */
+  for (size_t i = 0; i < childBoxCount; ++i) {
+    /* Lower child box bound is parent box lower bound plus for each previous
+     * child box; box width plus offset by one (such that lower bound of box
+     * i+1 is one grater than upper bound of box i) */
+    const auto boxLower = tsk.lowerBound + ((childBoxWidth + 1) * i);
+
+    /* Upper child box bound is lower plus child box width */
+    const auto boxUpper = childBoxWidth + boxLower;
+
+    const auto boxEventStart = eventIt;
+
+    if (eventIt < tsk.end) {
+      if (morton_index::morton_contains<MortonT>(boxLower, boxUpper, IndexCoordinateSwitcher::getIndex(*eventIt)))
+        eventIt = std::upper_bound(
+            boxEventStart, tsk.end, boxUpper,
+            [](const MortonT &m, const typename std::iterator_traits<EventIterator>::value_type &event) {
+              return m < IndexCoordinateSwitcher::getIndex(event);
+            });
+    }
+
+    /* Add new child box. */
+    /* As we are adding as we iterate over Morton numbers and parent events
+     * child boxes are inserted in the correct sorted order. */
+    std::vector<Mantid::Geometry::MDDimensionExtents<coord_t>> extents(ND);
+    auto minCoord = morton_index::indexToCoordinates<ND, IntT, MortonT>(boxLower, m_space);
+    auto maxCoord = morton_index::indexToCoordinates<ND, IntT, MortonT>(boxUpper, m_space);
+    for (unsigned ax = 0; ax < ND; ++ax) {
+      extents[ax].setExtents(minCoord[ax], maxCoord[ax]);
+    }
+
+    BoxBase *newBox;
+    if (std::distance(boxEventStart, eventIt) <= static_cast<int64_t>(splitThreshold) || tsk.maxDepth == 1) {
+      for (auto it = boxEventStart; it < eventIt; ++it)
+        IndexCoordinateSwitcher::convertToCoordinates(*it, m_space);
+      m_bc->incBoxesCounter(tsk.level);
+      newBox = new Box(m_bc.get(), tsk.level, extents, boxEventStart, eventIt);
+    } else {
+      m_bc->incGridBoxesCounter(tsk.level);
+      newBox = new GridBox(m_bc.get(), tsk.level, extents);
+    }
+
+    children.emplace_back(RecursionHelper{{boxEventStart, eventIt}, {boxLower, boxUpper}, newBox});
+  }
+  // sorting is needed due to fast finding the proper box for given coordinate,
+  // during drawing, for splitInto != 2 Z-curve gives wrong order
+  std::sort(children.begin(), children.end(), [](RecursionHelper &a, RecursionHelper &b) {
+    unsigned i = ND;
+    while (i-- > 0) {
+      const auto &ac = a.box->getExtents(i).getMin();
+      const auto &bc = b.box->getExtents(i).getMin();
+      if (ac < bc)
+        return true;
+      if (ac > bc)
+        return false;
+    }
+    return true;
+  });
+  std::vector<API::IMDNode *> boxes;
+  boxes.reserve(childBoxCount);
+  for (auto &ch : children)
+    boxes.emplace_back(ch.box);
+  tsk.root->setChildren(boxes, 0, boxes.size());
+
+  ++tsk.level;
+  for (auto &ch : children) {
+    Task newTask{ch.box,
+                 ch.eventRange.first,
+                 ch.eventRange.second,
+                 ch.mortonBounds.first,
+                 ch.mortonBounds.second,
+                 tsk.maxDepth,
+                 tsk.level};
+    if (wtp == MASTER && (size_t)std::distance(newTask.begin, newTask.end) < m_eventsThreshold)
+      pushTask(std::move(newTask));
+    else
+      distributeEvents(newTask, wtp);
+  }
+}
+
+/// True if the Morton index of an event with ND dimensions is wide enough for
+/// the tree to be built from it
+template <size_t ND> constexpr bool isMDEventTreeBuildable() { return ND >= 2 && ND <= 8; }
+
+/**
+ * Check that the boxes of a workspace are split in the way the Morton ordered
+ * tree build needs: into the same power of 2 along every dimension, with no
+ * different splitting of the top level box.
+ * @param bc :: box controller of the workspace
+ * @return true if buildMDEventTree can be used for the workspace
+ */
+inline bool canBuildMDEventTree(const API::BoxController &bc) {
+  const auto &splitInto = bc.getSplitIntoAll();
+  if (splitInto.empty() || bc.getSplitTopInto())
+    return false;
+  const size_t n = splitInto.front();
+  return n > 1 && (n & (n - 1)) == 0 &&
+         std::all_of(splitInto.cbegin(), splitInto.cend(), [n](const size_t split) { return split == n; });
+}
+
+/**
+ * Replace the box structure of an in-memory workspace by a tree built in one
+ * pass from the given events: they are sorted in parallel by Morton index and
+ * the boxes are cut from contiguous ranges of the sorted events.
+ * @param ws :: the workspace. canBuildMDEventTree must be true for its box
+ * controller and all events must lie within its dimensions.
+ * @param mdEvents :: all the events of the workspace. They are reordered and
+ * their coordinates are rounded to the resolution of the Morton index.
+ * @param numWorkers :: number of threads to use
+ * @return the largest rounding error of the coordinates along each dimension
+ */
+template <size_t ND, template <size_t> class MDEventType>
+morton_index::MDCoordinate<ND> buildMDEventTree(MDEventWorkspace<MDEventType<ND>, ND> &ws,
+                                                std::vector<MDEventType<ND>> &mdEvents, const int numWorkers) {
+  const API::BoxController_sptr bc = ws.getBoxController();
+  morton_index::MDSpaceBounds<ND> space;
+  for (size_t ax = 0; ax < ND; ++ax) {
+    space(ax, 0) = ws.getDimension(ax)->getMinimum();
+    space(ax, 1) = ws.getDimension(ax)->getMaximum();
+  }
+
+  // The builder counts every box it creates apart from a root grid box
+  bc->resetNumBoxes();
+  bc->clearBoxesCounter(0);
+  for (size_t depth = 0; depth <= bc->getMaxDepth(); ++depth)
+    bc->clearGridBoxesCounter(depth);
+
+  const int nThreads = std::max(1, numWorkers);
+  using EventDistributor = MDEventTreeBuilder<ND, MDEventType, typename std::vector<MDEventType<ND>>::iterator>;
+  EventDistributor distributor(nThreads, mdEvents.size() / nThreads / 10, bc, space);
+  auto rootAndErr = distributor.distribute(mdEvents);
+  if (!rootAndErr.root->isLeaf())
+    bc->incGridBoxesCounter(0);
+  ws.setBox(rootAndErr.root);
+  rootAndErr.root->calculateGridCaches();
+  return rootAndErr.err;
+}
+
+/**
+ * Class to rebuild the box structure of an in-memory workspace from the events
+ * it already holds, in place of splitting its boxes one by one.
+ *
+ * The tree is rebuilt one top-level box at a time, so at most the events of one
+ * top-level box are held outside the boxes. Its events are sorted into Morton
+ * order by a most significant digit first radix sort done in place, where the
+ * digit at each depth is the index of the child box. The child index is found
+ * from the box extents with the same arithmetic as MDGridBox::addEvent, and the
+ * child extents are laid out as MDGridBox does, so an event lies in the same
+ * box as if it was added to the workspace and split incrementally, including
+ * events exactly on a box boundary. Coordinates are not changed.
+ * @tparam MDE :: type of the events
+ * @tparam ND :: number of dimensions
+ */
+template <typename MDE, size_t ND> class MDEventTreeRebuilder {
+  using BoxBase = MDBoxBase<MDE, ND>;
+  using Box = MDBox<MDE, ND>;
+  using GridBox = MDGridBox<MDE, ND>;
+  using Extents = std::vector<Mantid::Geometry::MDDimensionExtents<coord_t>>;
+  using EventIterator = typename std::vector<MDE>::iterator;
+
+public:
+  MDEventTreeRebuilder(MDEventWorkspace<MDE, ND> &ws, const int numWorkers);
+  void rebuild();
+
+private:
+  void moveStrayEvents(GridBox &root, const Extents &rootExtents) const;
+  std::vector<MDE> takeEvents(BoxBase &box) const;
+  BoxBase *buildBox(EventIterator begin, EventIterator end, const Extents &extents, const uint32_t depth,
+                    const bool parallel) const;
+  std::vector<size_t> sortByChild(EventIterator begin, EventIterator end, const Extents &extents) const;
+  size_t childIndex(const MDE &event, const Extents &extents, const std::array<double, ND> &childSize) const;
+  void renumberBoxes() const;
+
+  MDEventWorkspace<MDE, ND> &m_ws;
+  API::BoxController *const m_bc;
+  const int m_numWorkers;
+  /// Number of children of a grid box along each dimension
+  const size_t m_splitInto;
+  /// Number of children of a grid box
+  const size_t m_numChildren;
+  /// The workspace limits; events outside are dropped
+  std::array<std::pair<coord_t, coord_t>, ND> m_bounds;
+};
+
+/**
+ * @param ws :: the workspace. canBuildMDEventTree must be true for its box
+ * controller.
+ * @param numWorkers :: number of threads to use
+ */
+template <typename MDE, size_t ND>
+MDEventTreeRebuilder<MDE, ND>::MDEventTreeRebuilder(MDEventWorkspace<MDE, ND> &ws, const int numWorkers)
+    : m_ws(ws), m_bc(ws.getBoxController().get()), m_numWorkers(std::max(1, numWorkers)),
+      m_splitInto(m_bc->getSplitInto(0)), m_numChildren(m_bc->getNumSplit()) {
+  for (size_t ax = 0; ax < ND; ++ax)
+    m_bounds[ax] = std::make_pair(ws.getDimension(ax)->getMinimum(), ws.getDimension(ax)->getMaximum());
+}
+
+/**
+ * Rebuild the tree. A workspace with no more events than the split threshold
+ * becomes a single box. Otherwise a gridded root keeps its top-level boxes and
+ * the subtree of each is rebuilt in turn; a single box root is rebuilt whole.
+ */
+template <typename MDE, size_t ND> void MDEventTreeRebuilder<MDE, ND>::rebuild() {
+  BoxBase *root = m_ws.getBox();
+  Extents rootExtents(ND);
+  for (size_t ax = 0; ax < ND; ++ax)
+    rootExtents[ax] = root->getExtents(ax);
+
+  // The cached number of events of a grid box is out of date while events are
+  // being added, so count the events of the leaves
+  std::vector<API::IMDNode *> leaves;
+  root->getBoxes(leaves, 1000, true);
+  size_t numEvents = 0;
+  for (const auto *leaf : leaves)
+    numEvents += static_cast<const Box *>(leaf)->getDataInMemorySize();
+
+  if (root->isLeaf() || !m_bc->willSplit(numEvents, 0)) {
+    std::vector<MDE> events = takeEvents(*root);
+    m_ws.setBox(buildBox(events.begin(), events.end(), rootExtents, 0, true));
+    renumberBoxes();
+    return;
+  }
+
+  moveStrayEvents(*static_cast<GridBox *>(root), rootExtents);
+  auto &children = static_cast<GridBox *>(root)->getBoxes();
+  for (auto &child : children) {
+    Extents extents(ND);
+    for (size_t ax = 0; ax < ND; ++ax)
+      extents[ax] = child->getExtents(ax);
+    std::vector<MDE> events = takeEvents(*child);
+    delete child;
+    child = buildBox(events.begin(), events.end(), extents, 1, true);
+    child->setParent(root);
+  }
+  renumberBoxes();
+}
+
+/**
+ * Move the events that MDGridBox::addEvent put in the wrong top-level box,
+ * which it does for some events on the upper limit of the workspace, to the
+ * top-level box they lie in.
+ * @param root :: the gridded root box
+ * @param rootExtents :: extents of the root box
+ */
+template <typename MDE, size_t ND>
+void MDEventTreeRebuilder<MDE, ND>::moveStrayEvents(GridBox &root, const Extents &rootExtents) const {
+  std::array<double, ND> childSize;
+  for (size_t ax = 0; ax < ND; ++ax)
+    childSize[ax] = static_cast<double>(rootExtents[ax].getSize()) / static_cast<double>(m_splitInto);
+
+  auto &children = root.getBoxes();
+  std::vector<std::vector<MDE>> strays(children.size());
+  for (size_t child = 0; child < children.size(); ++child) {
+    std::vector<API::IMDNode *> leaves;
+    children[child]->getBoxes(leaves, 1000, true);
+    for (auto *leaf : leaves) {
+      auto &events = static_cast<Box *>(leaf)->getEvents();
+      const auto firstStray = std::partition(events.begin(), events.end(), [&](const MDE &event) {
+        return childIndex(event, rootExtents, childSize) == child;
+      });
+      for (auto it = firstStray; it != events.end(); ++it)
+        strays[childIndex(*it, rootExtents, childSize)].emplace_back(*it);
+      events.erase(firstStray, events.end());
+      static_cast<Box *>(leaf)->releaseEvents();
+    }
+  }
+
+  for (size_t child = 0; child < children.size(); ++child) {
+    if (strays[child].empty())
+      continue;
+    std::vector<API::IMDNode *> leaves;
+    children[child]->getBoxes(leaves, 1000, true);
+    auto *leaf = static_cast<Box *>(leaves.front());
+    auto &events = leaf->getEvents();
+    events.insert(events.end(), strays[child].cbegin(), strays[child].cend());
+    leaf->releaseEvents();
+  }
+}
+
+/**
+ * Move the events of a box and its children out of the boxes, dropping the
+ * ones outside the workspace. The largest box hands over its storage, the
+ * others are emptied one by one as they are copied.
+ * @param box :: the box. It is left without events.
+ * @return the events
+ */
+template <typename MDE, size_t ND> std::vector<MDE> MDEventTreeRebuilder<MDE, ND>::takeEvents(BoxBase &box) const {
+  std::vector<API::IMDNode *> leaves;
+  box.getBoxes(leaves, 1000, true);
+  size_t numEvents = 0;
+  Box *largest = nullptr;
+  for (auto *leaf : leaves) {
+    auto *leafBox = static_cast<Box *>(leaf);
+    const size_t leafEvents = leafBox->getDataInMemorySize();
+    numEvents += leafEvents;
+    if (!largest || leafEvents > largest->getDataInMemorySize())
+      largest = leafBox;
+  }
+
+  std::vector<MDE> events;
+  if (largest) {
+    events.swap(largest->getEvents());
+    largest->releaseEvents();
+    largest->clear();
+  }
+  events.reserve(numEvents);
+  for (auto *leaf : leaves) {
+    auto *leafBox = static_cast<Box *>(leaf);
+    if (leafBox == largest)
+      continue;
+    const auto &leafEvents = leafBox->getConstEvents();
+    events.insert(events.end(), leafEvents.cbegin(), leafEvents.cend());
+    leafBox->releaseEvents();
+    leafBox->clear();
+  }
+
+  events.erase(std::remove_if(events.begin(), events.end(),
+                              [this](const MDE &event) {
+                                for (size_t ax = 0; ax < ND; ++ax) {
+                                  const coord_t coord = event.getCenter(ax);
+                                  if (coord < m_bounds[ax].first || coord > m_bounds[ax].second)
+                                    return true;
+                                }
+                                return false;
+                              }),
+               events.end());
+  return events;
+}
+
+/**
+ * Build the box holding a range of events and, if it must be split, its
+ * children.
+ * @param begin :: first event of the box
+ * @param end :: one past the last event of the box
+ * @param extents :: extents of the box
+ * @param depth :: depth of the box
+ * @param parallel :: build the children in parallel
+ * @return the new box
+ */
+template <typename MDE, size_t ND>
+MDBoxBase<MDE, ND> *MDEventTreeRebuilder<MDE, ND>::buildBox(EventIterator begin, EventIterator end,
+                                                            const Extents &extents, const uint32_t depth,
+                                                            const bool parallel) const {
+  const auto numEvents = static_cast<size_t>(std::distance(begin, end));
+  if (!m_bc->willSplit(numEvents, depth))
+    return new Box(m_bc, depth, extents, begin, end);
+
+  auto *grid = new GridBox(m_bc, depth, extents);
+  const std::vector<size_t> starts = sortByChild(begin, end, extents);
+
+  // Lay out the children as MDGridBox does
+  std::vector<Extents> childExtents(m_numChildren, Extents(ND));
+  std::array<size_t, ND> indices;
+  indices.fill(0);
+  for (size_t i = 0; i < m_numChildren; ++i) {
+    for (size_t ax = 0; ax < ND; ++ax) {
+      const double childSize = static_cast<double>(extents[ax].getSize()) / static_cast<double>(m_splitInto);
+      const double min = static_cast<double>(extents[ax].getMin()) + static_cast<double>(indices[ax]) * childSize;
+      childExtents[i][ax].setExtents(min, min + childSize);
+    }
+    for (size_t ax = 0; ax < ND; ++ax) {
+      if (++indices[ax] < m_splitInto)
+        break;
+      indices[ax] = 0;
+    }
+  }
+
+  std::vector<API::IMDNode *> children(m_numChildren);
+  const auto numChildren = static_cast<int64_t>(m_numChildren);
+#pragma omp parallel for schedule(dynamic) num_threads(m_numWorkers) if (parallel)
+  for (int64_t i = 0; i < numChildren; ++i)
+    children[i] = buildBox(begin + starts[i], begin + starts[i + 1], childExtents[i], depth + 1, false);
+  grid->setChildren(children, 0, children.size());
+  return grid;
+}
+
+/**
+ * Sort a range of events in place by the index of the child box they belong
+ * to (American flag sort).
+ * @param begin :: first event
+ * @param end :: one past the last event
+ * @param extents :: extents of the box holding the events
+ * @return the offset of the first event of each child from begin, and the
+ * number of events at the end
+ */
+template <typename MDE, size_t ND>
+std::vector<size_t> MDEventTreeRebuilder<MDE, ND>::sortByChild(EventIterator begin, EventIterator end,
+                                                               const Extents &extents) const {
+  std::array<double, ND> childSize;
+  for (size_t ax = 0; ax < ND; ++ax)
+    childSize[ax] = static_cast<double>(extents[ax].getSize()) / static_cast<double>(m_splitInto);
+
+  std::vector<size_t> starts(m_numChildren + 1, 0);
+  for (auto it = begin; it != end; ++it)
+    ++starts[childIndex(*it, extents, childSize) + 1];
+  std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+  std::vector<size_t> next(starts.cbegin(), starts.cend() - 1);
+  for (size_t child = 0; child < m_numChildren; ++child) {
+    while (next[child] < starts[child + 1]) {
+      auto &event = *(begin + next[child]);
+      const size_t target = childIndex(event, extents, childSize);
+      if (target == child)
+        ++next[child];
+      else
+        std::swap(event, *(begin + next[target]++));
+    }
+  }
+  return starts;
+}
+
+/**
+ * Find the child box of an event as MDGridBox::addEvent does, but keeping the
+ * index along each dimension within the box, so that events on the upper
+ * limit go to the last child.
+ * @param event :: the event
+ * @param extents :: extents of the box holding the event
+ * @param childSize :: size of the children along each dimension
+ * @return the index of the child
+ */
+template <typename MDE, size_t ND>
+size_t MDEventTreeRebuilder<MDE, ND>::childIndex(const MDE &event, const Extents &extents,
+                                                 const std::array<double, ND> &childSize) const {
+  size_t index = 0;
+  size_t stride = 1;
+  for (size_t ax = 0; ax < ND; ++ax) {
+    const auto offset = event.getCenter(ax) - extents[ax].getMin();
+    const auto i = static_cast<int>(offset / childSize[ax]);
+    index += static_cast<size_t>(std::clamp(i, 0, static_cast<int>(m_splitInto) - 1)) * stride;
+    stride *= m_splitInto;
+  }
+  return index;
+}
+
+/**
+ * Give the boxes IDs breadth first, so that the children of each grid box have
+ * consecutive IDs as SaveMD expects, and count the boxes at each depth.
+ */
+template <typename MDE, size_t ND> void MDEventTreeRebuilder<MDE, ND>::renumberBoxes() const {
+  m_bc->resetNumBoxes();
+  m_bc->clearBoxesCounter(0);
+  for (size_t depth = 0; depth <= m_bc->getMaxDepth(); ++depth)
+    m_bc->clearGridBoxesCounter(depth);
+
+  size_t nextId = 0;
+  std::queue<API::IMDNode *> boxes;
+  boxes.push(m_ws.getBox());
+  m_ws.getBox()->setID(nextId++);
+  while (!boxes.empty()) {
+    API::IMDNode *box = boxes.front();
+    boxes.pop();
+    const size_t numChildren = box->getNumChildren();
+    if (numChildren == 0) {
+      m_bc->incBoxesCounter(box->getDepth());
+      continue;
+    }
+    m_bc->incGridBoxesCounter(box->getDepth());
+    for (size_t i = 0; i < numChildren; ++i) {
+      API::IMDNode *child = box->getChild(i);
+      child->setID(nextId++);
+      boxes.push(child);
+    }
+  }
+  m_bc->setMaxId(nextId);
+}
+
+/**
+ * Rebuild the box structure of an in-memory workspace from all of its events
+ * with MDEventTreeRebuilder, in place of splitting its boxes one by one.
+ * Events lying outside the dimensions of the workspace are dropped.
+ * @param ws :: the workspace. canBuildMDEventTree must be true for its box
+ * controller.
+ * @param numWorkers :: number of threads to use
+ */
+template <size_t ND, template <size_t> class MDEventType>
+void rebuildMDEventTree(MDEventWorkspace<MDEventType<ND>, ND> &ws, const int numWorkers) {
+  MDEventTreeRebuilder<MDEventType<ND>, ND>(ws, numWorkers).rebuild();
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,381 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDBoxBase.h"
+#include "MantidDataObjects/MDGridBox.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/**
+ * Class to integrate the signal of an MDEventWorkspace in many spheres, or
+ * spherical shells, with one traversal of its box tree. Each sphere gets the
+ * same signal, up to rounding, as MDBoxBase::integrateSphere with a
+ * CoordTransformDistance about its centre.
+ *
+ * At each grid box, the spheres are sorted into the child boxes that their
+ * bounding boxes overlap, so that a sphere is only tested against the boxes
+ * near it. The vertices of these child boxes are tested as in
+ * MDGridBox::integrateSphere: a child with all its vertices inside a sphere
+ * adds its cached signal, and the others that may hold events of the sphere
+ * are searched further. The events of the leaf boxes are then tested against
+ * all the spheres that reach them, with the leaf boxes shared out between
+ * threads. The contributions are added to each sphere in the order of the
+ * tree, so the result does not depend on the number of threads.
+ * @tparam MDE :: MDLeanEvent or MDEvent
+ * @tparam nd :: number of dimensions
+ */
+template <typename MDE, size_t nd> class MDSphereIntegrator {
+public:
+  /**
+   * Add a sphere to integrate
+   * @param center :: the centre of the sphere, nd values
+   * @param radius :: the radius below which to integrate
+   * @param innerRadius :: the radius above which to integrate, to integrate a
+   * shell
+   * @param useOnePercentBackgroundCorrection :: remove the top 1% of the
+   * signal of each box in a shell
+   * @return the index of the sphere
+   */
+  size_t addSphere(const coord_t *center, const double radius, const double innerRadius = 0.,
+                   const bool useOnePercentBackgroundCorrection = true) {
+    Sphere sphere;
+    std::copy(center, center + nd, sphere.center.begin());
+    sphere.radius = radius;
+    sphere.radiusSquared = static_cast<coord_t>(radius * radius);
+    sphere.innerRadiusSquared = static_cast<coord_t>(innerRadius * innerRadius);
+    sphere.useOnePercentBackgroundCorrection = useOnePercentBackgroundCorrection;
+    m_spheres.emplace_back(sphere);
+    return m_spheres.size() - 1;
+  }
+
+  /// @return the number of spheres
+  size_t size() const { return m_spheres.size(); }
+  /// @return the integrated signal of a sphere
+  signal_t signal(const size_t index) const { return m_spheres[index].signal; }
+  /// @return the integrated squared error of a sphere
+  signal_t errorSquared(const size_t index) const { return m_spheres[index].errorSquared; }
+
+  void integrate(MDBoxBase<MDE, nd> &box);
+
+private:
+  struct Sphere {
+    std::array<coord_t, nd> center;
+    double radius;
+    coord_t radiusSquared;
+    coord_t innerRadiusSquared;
+    bool useOnePercentBackgroundCorrection;
+    signal_t signal{0};
+    signal_t errorSquared{0};
+  };
+  /// The spheres to test the events of a leaf box against
+  struct LeafTask {
+    MDBox<MDE, nd> *box;
+    std::vector<size_t> spheres;
+    /// Signal and squared error of each sphere
+    std::vector<std::pair<signal_t, signal_t>> sums;
+  };
+  /// A contribution to a sphere, from a box inside it or from a leaf task
+  struct Contribution {
+    size_t sphere;
+    const MDBoxBase<MDE, nd> *fullBox;
+    size_t task;
+    size_t slot;
+  };
+  /// A sphere that reaches a child box of a grid box
+  struct ChildSphere {
+    size_t sphere;
+    bool contained;
+  };
+
+  void visit(MDBoxBase<MDE, nd> &box, std::vector<size_t> spheres);
+  void visitGrid(MDGridBox<MDE, nd> &grid, const std::vector<size_t> &spheres);
+  void integrateLeaf(LeafTask &task) const;
+
+  /// Squared distance of a point from the centre of a sphere, as calculated by
+  /// CoordTransformDistance
+  static coord_t distanceSquared(const Sphere &sphere, const coord_t *point) {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t dist = point[d] - sphere.center[d];
+      distanceSquared += dist * dist;
+    }
+    return distanceSquared;
+  }
+  /// Is a point inside a sphere, and outside its inner radius
+  static bool contains(const Sphere &sphere, const coord_t distanceSquared) {
+    return distanceSquared < sphere.radiusSquared && distanceSquared > sphere.innerRadiusSquared;
+  }
+
+  std::vector<Sphere> m_spheres;
+  std::vector<LeafTask> m_tasks;
+  std::vector<Contribution> m_contributions;
+};
+
+/**
+ * Integrate the signal in all the spheres
+ * @param box :: the top box of the workspace
+ */
+template <typename MDE, size_t nd> void MDSphereIntegrator<MDE, nd>::integrate(MDBoxBase<MDE, nd> &box) {
+  m_tasks.clear();
+  m_contributions.clear();
+  std::vector<size_t> spheres(m_spheres.size());
+  std::iota(spheres.begin(), spheres.end(), 0);
+  visit(box, std::move(spheres));
+
+  // Loading the events of a file backed workspace is not thread safe
+  const auto *bc = box.getBoxController();
+  const bool fileBacked = bc && bc->isFileBacked();
+  PARALLEL_FOR_IF(!fileBacked)
+  for (int64_t i = 0; i < static_cast<int64_t>(m_tasks.size()); ++i) {
+    integrateLeaf(m_tasks[i]);
+  }
+
+  for (auto &sphere : m_spheres) {
+    sphere.signal = 0;
+    sphere.errorSquared = 0;
+  }
+  for (const auto &contribution : m_contributions) {
+    auto &sphere = m_spheres[contribution.sphere];
+    if (contribution.fullBox) {
+      sphere.signal += contribution.fullBox->getSignal();
+      sphere.errorSquared += contribution.fullBox->getErrorSquared();
+    } else {
+      const auto &sum = m_tasks[contribution.task].sums[contribution.slot];
+      sphere.signal += sum.first;
+      sphere.errorSquared += sum.second;
+    }
+  }
+  m_tasks.clear();
+  m_contributions.clear();
+}
+
+/**
+ * Find the contributions of a box and its children to some spheres
+ * @param box :: the box to search
+ * @param spheres :: the indices of the spheres that may hold events of the box
+ */
+template <typename MDE, size_t nd>
+void MDSphereIntegrator<MDE, nd>::visit(MDBoxBase<MDE, nd> &box, std::vector<size_t> spheres) {
+  if (spheres.empty())
+    return;
+  if (box.isBox()) {
+    const size_t taskIndex = m_tasks.size();
+    for (size_t slot = 0; slot < spheres.size(); ++slot)
+      m_contributions.emplace_back(Contribution{spheres[slot], nullptr, taskIndex, slot});
+    LeafTask task{static_cast<MDBox<MDE, nd> *>(&box), std::move(spheres), {}};
+    task.sums.resize(task.spheres.size(), std::make_pair(0., 0.));
+    m_tasks.emplace_back(std::move(task));
+  } else {
+    visitGrid(static_cast<MDGridBox<MDE, nd> &>(box), spheres);
+  }
+}
+
+/**
+ * Sort the spheres into the child boxes of a grid box, testing the vertices of
+ * the children near each sphere, and search the children in order
+ * @param grid :: the grid box
+ * @param spheres :: the indices of the spheres that may hold events of the box
+ */
+template <typename MDE, size_t nd>
+void MDSphereIntegrator<MDE, nd>::visitGrid(MDGridBox<MDE, nd> &grid, const std::vector<size_t> &spheres) {
+  const size_t numBoxes = grid.getNumChildren();
+  if (numBoxes == 0)
+    return;
+  // The children are split evenly, with the first dimension changing fastest
+  auto *firstChild = static_cast<MDBoxBase<MDE, nd> *>(grid.getChild(0));
+  size_t split[nd];
+  size_t indexMaker[nd];
+  coord_t boxSize[nd];
+  coord_t minBoxVal[nd];
+  double diagSum(0);
+  size_t cumulative(1);
+  for (size_t d = 0; d < nd; ++d) {
+    const double size = static_cast<double>(grid.getExtents(d).getSize());
+    const double childSize = static_cast<double>(firstChild->getExtents(d).getSize());
+    split[d] = std::max(static_cast<size_t>(1), static_cast<size_t>(std::lround(size / childSize)));
+    const double subBoxSize = size / static_cast<double>(split[d]);
+    boxSize[d] = static_cast<coord_t>(subBoxSize);
+    minBoxVal[d] = static_cast<coord_t>(grid.getExtents(d).getMin());
+    diagSum += subBoxSize * subBoxSize;
+    indexMaker[d] = cumulative;
+    cumulative *= split[d];
+  }
+  const double boxRadius = std::sqrt(static_cast<coord_t>(diagSum));
+  const size_t maxVertices = static_cast<size_t>(1) << nd;
+
+  std::vector<std::vector<ChildSphere>> childSpheres(numBoxes);
+  // The number of vertices inside the sphere of each child in the range
+  std::vector<size_t> verticesContained;
+  for (const size_t sphereIndex : spheres) {
+    const auto &sphere = m_spheres[sphereIndex];
+    // The range of children overlapping the bounding box of the sphere
+    size_t lo[nd], hi[nd];
+    bool outside = false;
+    for (size_t d = 0; d < nd; ++d) {
+      const double lower = (sphere.center[d] - sphere.radius - minBoxVal[d]) / boxSize[d];
+      const double upper = (sphere.center[d] + sphere.radius - minBoxVal[d]) / boxSize[d];
+      if (upper < 0. || lower >= static_cast<double>(split[d])) {
+        outside = true;
+        break;
+      }
+      lo[d] = lower < 0. ? 0 : static_cast<size_t>(lower);
+      hi[d] = std::min(static_cast<size_t>(upper), split[d] - 1);
+    }
+    if (outside)
+      continue;
+
+    // Test the vertices of the children in the range
+    size_t rangeSize[nd];
+    size_t rangeMaker[nd];
+    size_t numRange(1);
+    for (size_t d = 0; d < nd; ++d) {
+      rangeSize[d] = hi[d] - lo[d] + 1;
+      rangeMaker[d] = numRange;
+      numRange *= rangeSize[d];
+    }
+    verticesContained.assign(numRange, 0);
+    size_t vertexIndex[nd];
+    std::fill_n(vertexIndex, nd, 0);
+    bool allDone = false;
+    while (!allDone) {
+      coord_t vertexCoord[nd];
+      for (size_t d = 0; d < nd; ++d)
+        vertexCoord[d] = static_cast<coord_t>(vertexIndex[d] + lo[d]) * boxSize[d] + minBoxVal[d];
+      if (contains(sphere, distanceSquared(sphere, vertexCoord))) {
+        // This vertex is shared by up to 2^nd children in the range
+        for (size_t neighb = 0; neighb < maxVertices; ++neighb) {
+          size_t linearIndex(0);
+          bool badIndex = false;
+          for (size_t d = 0; d < nd; ++d) {
+            const size_t boxIndex = vertexIndex[d] - ((neighb >> d) & 1);
+            if (boxIndex >= rangeSize[d]) {
+              badIndex = true;
+              break;
+            }
+            linearIndex += boxIndex * rangeMaker[d];
+          }
+          if (!badIndex)
+            ++verticesContained[linearIndex];
+        }
+      }
+      // Increment the vertex index, which runs to rangeSize inclusive
+      allDone = true;
+      for (size_t d = 0; d < nd; ++d) {
+        if (++vertexIndex[d] <= rangeSize[d]) {
+          allDone = false;
+          break;
+        }
+        vertexIndex[d] = 0;
+      }
+    }
+
+    // Decide which children in the range to search for this sphere
+    const double peakRadius = std::sqrt(sphere.radiusSquared);
+    const double peakInnerRadius = std::sqrt(sphere.innerRadiusSquared);
+    size_t rangeIndex[nd];
+    std::fill_n(rangeIndex, nd, 0);
+    for (size_t r = 0; r < numRange; ++r) {
+      size_t childIndex(0);
+      for (size_t d = 0; d < nd; ++d)
+        childIndex += (rangeIndex[d] + lo[d]) * indexMaker[d];
+      for (size_t d = 0; d < nd; ++d) {
+        if (++rangeIndex[d] < rangeSize[d])
+          break;
+        rangeIndex[d] = 0;
+      }
+      if (verticesContained[r] >= maxVertices) {
+        childSpheres[childIndex].emplace_back(ChildSphere{sphereIndex, true});
+        continue;
+      }
+      if (verticesContained[r] > 0) {
+        childSpheres[childIndex].emplace_back(ChildSphere{sphereIndex, false});
+        continue;
+      }
+      // Skip the children that are isolated from the sphere or inside its
+      // inner radius, as MDGridBox::integrateSphere does
+      coord_t boxCenter[nd];
+      grid.getChild(childIndex)->getCenter(boxCenter);
+      double distPeakCenterToBoxCenter = 0.0;
+      for (size_t d = 0; d < nd; ++d)
+        distPeakCenterToBoxCenter += (boxCenter[d] - sphere.center[d]) * (boxCenter[d] - sphere.center[d]);
+      distPeakCenterToBoxCenter = std::sqrt(distPeakCenterToBoxCenter);
+      if (distPeakCenterToBoxCenter - peakRadius > boxRadius)
+        continue;
+      if (peakInnerRadius > 0 && distPeakCenterToBoxCenter + boxRadius < peakInnerRadius)
+        continue;
+      childSpheres[childIndex].emplace_back(ChildSphere{sphereIndex, false});
+    }
+  }
+
+  for (size_t childIndex = 0; childIndex < numBoxes; ++childIndex) {
+    const auto &entries = childSpheres[childIndex];
+    if (entries.empty())
+      continue;
+    auto *child = static_cast<MDBoxBase<MDE, nd> *>(grid.getChild(childIndex));
+    std::vector<size_t> searched;
+    for (const auto &entry : entries) {
+      if (entry.contained)
+        m_contributions.emplace_back(Contribution{entry.sphere, child, 0, 0});
+      else
+        searched.emplace_back(entry.sphere);
+    }
+    visit(*child, std::move(searched));
+  }
+}
+
+/**
+ * Integrate the events of a leaf box in its spheres, as
+ * MDBox::integrateSphere does
+ * @param task :: the box, its spheres and the sums to set
+ */
+template <typename MDE, size_t nd> void MDSphereIntegrator<MDE, nd>::integrateLeaf(LeafTask &task) const {
+  const std::vector<MDE> &events = task.box->getConstEvents();
+  std::vector<std::pair<signal_t, signal_t>> vals;
+  for (size_t slot = 0; slot < task.spheres.size(); ++slot) {
+    const auto &sphere = m_spheres[task.spheres[slot]];
+    auto &sum = task.sums[slot];
+    if (sphere.innerRadiusSquared == 0.0) {
+      for (const auto &event : events) {
+        if (distanceSquared(sphere, event.getCenter()) < sphere.radiusSquared) {
+          sum.first += static_cast<signal_t>(event.getSignal());
+          sum.second += static_cast<signal_t>(event.getErrorSquared());
+        }
+      }
+    } else {
+      vals.clear();
+      for (const auto &event : events) {
+        if (contains(sphere, distanceSquared(sphere, event.getCenter())))
+          vals.emplace_back(static_cast<signal_t>(event.getSignal()), static_cast<signal_t>(event.getErrorSquared()));
+      }
+      // Sort based on signal values
+      std::sort(vals.begin(), vals.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+      // Remove top 1% of background
+      const size_t endIndex = sphere.useOnePercentBackgroundCorrection
+                                  ? static_cast<size_t>(0.99 * static_cast<double>(vals.size()))
+                                  : vals.size();
+      for (size_t k = 0; k < endIndex; k++) {
+        sum.first += vals[k].first;
+        sum.second += vals[k].second;
+      }
+    }
+  }
+  task.box->releaseEvents();
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,252 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/BoxControllerMmapIO.h"
+#include "MantidDataObjects/MDEvent.h"
+
+#include <Poco/File.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace Mantid::DataObjects {
+
+namespace {
+/// Copy values between arrays, converting them to the destination type
+template <typename To, typename From> void convertValues(const From *from, const size_t count, To *to) {
+  std::transform(from, from + count, to, [](const From value) { return static_cast<To>(value); });
+}
+} // namespace
+
+/**Constructor
+ @param bc pointer to the box controller which uses this IO operations
+*/
+BoxControllerMmapIO::BoxControllerMmapIO(API::BoxController *const bc)
+    : m_bc(bc), m_coordSize(sizeof(coord_t)), m_nColumns(5 + bc->getNDims()),
+      m_typeName(MDEvent<1>::getTypeName()) {}
+
+/// Destructor. Closes the file, removing it if this class created it.
+BoxControllerMmapIO::~BoxControllerMmapIO() { this->closeFile(); }
+
+/** Set the size of the stored values and the event type, which together
+ * define the layout of an event in the file
+ * @param blockSize :: size (in bytes) of each stored value. 4 (float) and 8
+ * (double) are supported.
+ * @param typeName :: name of the event type, MDLeanEvent or MDEvent
+ */
+void BoxControllerMmapIO::setDataType(const size_t blockSize, const std::string &typeName) {
+  if (blockSize != 4 && blockSize != 8)
+    throw std::invalid_argument("The class currently supports 4(float) and "
+                                "8(double) event coordinates only");
+  if (typeName == MDLeanEvent<1>::getTypeName())
+    m_nColumns = 2 + m_bc->getNDims();
+  else if (typeName == MDEvent<1>::getTypeName())
+    m_nColumns = 5 + m_bc->getNDims();
+  else
+    throw std::invalid_argument("Unsupported event type: " + typeName + " provided ");
+  m_coordSize = blockSize;
+  m_typeName = typeName;
+}
+
+/** Get the size of the stored values and the event type
+ * @param CoordSize :: size (in bytes) of each stored value
+ * @param typeName :: name of the event type
+ */
+void BoxControllerMmapIO::getDataType(size_t &CoordSize, std::string &typeName) const {
+  CoordSize = m_coordSize;
+  typeName = m_typeName;
+}
+
+/** Open (or create) and map the event file
+ * @param fileName :: name of the file
+ * @param mode :: if it contains w or W the file is opened for reading and
+ * writing, and created if needed. Otherwise it is opened for reading only.
+ * Only a file created here is removed when it is closed.
+ * @return false if a file was already open
+ */
+bool BoxControllerMmapIO::openFile(const std::string &fileName, const std::string &mode) {
+  if (m_file)
+    return false;
+  const bool readOnly = mode.find_first_of("wW") == std::string::npos;
+  const bool created = !readOnly && !Poco::File(fileName).exists();
+  m_file = std::make_unique<Kernel::MemoryMappedFile>(fileName, readOnly);
+  m_fileName = fileName;
+  m_bytesUsed = m_file->size();
+  m_createdFile = created;
+  // the disk buffer places new blocks after the events already in the file
+  this->setFileLength(m_file->size() / (m_nColumns * m_coordSize));
+  return true;
+}
+
+/** Read the blocks never saved to this file from another one, which must hold
+ * the same events at the same positions. Blocks saved afterwards are read
+ * back from this file, so the source is only ever read. The file length seen
+ * by the disk buffer becomes that of the source, so that new blocks are placed
+ * after its events.
+ * @param source :: the open IO of the source file. It is released when this
+ * file is closed.
+ */
+void BoxControllerMmapIO::setSourceFile(const std::shared_ptr<API::IBoxControllerIO> &source) {
+  if (!m_file)
+    throw std::runtime_error("The event file must be open before its source is set");
+  if (!source || !source->isOpened())
+    throw std::invalid_argument("The source of the event file " + m_fileName + " is not open");
+  m_source = source;
+  std::lock_guard<std::mutex> lock(m_lengthMutex);
+  this->setFileLength(std::max(this->getFileLength(), m_source->getFileLength()));
+}
+
+/** Make sure the file holds at least the given number of bytes, growing it
+ * geometrically so that appending blocks remaps it rarely
+ * @param bytes :: size the file needs
+ */
+void BoxControllerMmapIO::reserveBytes(const uint64_t bytes) const {
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mapMutex);
+    if (m_file->size() >= bytes)
+      return;
+  }
+  std::unique_lock<std::shared_mutex> lock(m_mapMutex);
+  const auto minimumSize = static_cast<uint64_t>(DATA_CHUNK * m_nColumns * m_coordSize);
+  if (m_file->size() < bytes)
+    m_file->resize(std::max({bytes, 2 * m_file->size(), minimumSize}));
+}
+
+/** Copy a block of events into the file
+ * @param DataBlock :: serialized events, getNDataColumns() values per event
+ * @param blockPosition :: index of the first event in the file
+ */
+template <typename Type>
+void BoxControllerMmapIO::saveGenericBlock(const std::vector<Type> &DataBlock, const uint64_t blockPosition) const {
+  if (!m_file)
+    throw std::runtime_error("The event file is not open");
+  if (m_file->isReadOnly())
+    throw std::runtime_error("The event file " + m_fileName + " is open for reading only");
+  const uint64_t begin = blockPosition * m_nColumns * m_coordSize;
+  const uint64_t end = begin + DataBlock.size() * m_coordSize;
+  reserveBytes(end);
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mapMutex);
+    char *destination = m_file->data() + begin;
+    if (m_coordSize == sizeof(float))
+      convertValues(DataBlock.data(), DataBlock.size(), reinterpret_cast<float *>(destination));
+    else
+      convertValues(DataBlock.data(), DataBlock.size(), reinterpret_cast<double *>(destination));
+  }
+  auto used = m_bytesUsed.load();
+  while (used < end && !m_bytesUsed.compare_exchange_weak(used, end)) {
+  }
+  if (m_source) {
+    std::lock_guard<std::mutex> lock(m_savedMutex);
+    m_savedBlocks.insert(blockPosition);
+  }
+  const uint64_t endEvent = blockPosition + DataBlock.size() / m_nColumns;
+  std::lock_guard<std::mutex> lock(m_lengthMutex);
+  if (endEvent > this->getFileLength())
+    this->setFileLength(endEvent);
+}
+
+/** Copy a block of events out of the file
+ * @param Block :: resized to the serialized events read
+ * @param blockPosition :: index of the first event in the file
+ * @param nPoints :: number of events to read
+ */
+template <typename Type>
+void BoxControllerMmapIO::loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition,
+                                           const size_t nPoints) const {
+  if (!m_file)
+    throw std::runtime_error("The event file is not open");
+  if (m_source) {
+    // The disk buffer never places a block over the events of a box that is
+    // still in use, so a block starting at a position never saved to is
+    // unchanged in the source
+    std::unique_lock<std::mutex> savedLock(m_savedMutex);
+    if (m_savedBlocks.find(blockPosition) == m_savedBlocks.end()) {
+      savedLock.unlock();
+      m_source->loadBlock(Block, blockPosition, nPoints);
+      return;
+    }
+  }
+  const size_t nValues = nPoints * m_nColumns;
+  const uint64_t begin = blockPosition * m_nColumns * m_coordSize;
+  std::shared_lock<std::shared_mutex> lock(m_mapMutex);
+  if (begin + nValues * m_coordSize > m_file->size())
+    throw std::invalid_argument("Attempt to read events beyond the end of the event file " + m_fileName);
+  Block.resize(nValues);
+  const char *source = m_file->data() + begin;
+  if (m_coordSize == sizeof(float))
+    convertValues(reinterpret_cast<const float *>(source), nValues, Block.data());
+  else
+    convertValues(reinterpret_cast<const double *>(source), nValues, Block.data());
+}
+
+/** Save float data block in the specified file position
+ * @param DataBlock :: the array of float data to save
+ * @param blockPosition :: the position (in events) to place the data
+ */
+void BoxControllerMmapIO::saveBlock(const std::vector<float> &DataBlock, const uint64_t blockPosition) const {
+  this->saveGenericBlock(DataBlock, blockPosition);
+}
+
+/** Save double data block in the specified file position
+ * @param DataBlock :: the array of double data to save
+ * @param blockPosition :: the position (in events) to place the data
+ */
+void BoxControllerMmapIO::saveBlock(const std::vector<double> &DataBlock, const uint64_t blockPosition) const {
+  this->saveGenericBlock(DataBlock, blockPosition);
+}
+
+/** Load float data block from the specified file position
+ * @param Block :: the storage vector to place data into
+ * @param blockPosition :: the position (in events) to read data from
+ * @param nPoints :: number of events to read
+ */
+void BoxControllerMmapIO::loadBlock(std::vector<float> &Block, const uint64_t blockPosition,
+                                    const size_t nPoints) const {
+  this->loadGenericBlock(Block, blockPosition, nPoints);
+}
+
+/** Load double data block from the specified file position
+ * @param Block :: the storage vector to place data into
+ * @param blockPosition :: the position (in events) to read data from
+ * @param nPoints :: number of events to read
+ */
+void BoxControllerMmapIO::loadBlock(std::vector<double> &Block, const uint64_t blockPosition,
+                                    const size_t nPoints) const {
+  this->loadGenericBlock(Block, blockPosition, nPoints);
+}
+
+/// Start writing the modified pages to disk, without waiting for them
+void BoxControllerMmapIO::flushData() const {
+  if (!m_file)
+    return;
+  std::shared_lock<std::shared_mutex> lock(m_mapMutex);
+  m_file->flush();
+}
+
+/** Cut the file to the data written and unmap it. The file is removed if
+ * openFile() created it and setKeepOnClose() was not used. A file opened for
+ * reading only is never changed. The source file, if any, is released.
+ */
+void BoxControllerMmapIO::closeFile() {
+  if (!m_file)
+    return;
+  {
+    std::unique_lock<std::shared_mutex> lock(m_mapMutex);
+    if (!m_file->isReadOnly())
+      m_file->resize(m_bytesUsed);
+    m_file.reset();
+  }
+  m_source.reset();
+  m_savedBlocks.clear();
+  if (m_createdFile && !m_keepOnClose) {
+    Poco::File file(m_fileName);
+    if (file.exists())
+      file.remove();
+  }
+}
+
+} // namespace Mantid::DataObjects
@@ -0,0 +1,208 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/EventColumns.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Mantid::DataObjects {
+using Types::Core::DateAndTime;
+using Types::Event::TofEvent;
+
+namespace {
+/// Reorder a column so that element i becomes the element at order[i]
+template <typename T> void applyOrder(std::vector<T> &column, const std::vector<std::size_t> &order) {
+  if (column.empty())
+    return;
+  std::vector<T> sorted;
+  sorted.reserve(column.size());
+  for (const auto index : order)
+    sorted.emplace_back(column[index]);
+  column.swap(sorted);
+}
+
+/// Remove the elements of a column flagged in remove
+template <typename T> void removeFlagged(std::vector<T> &column, const std::vector<bool> &remove) {
+  if (column.empty())
+    return;
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < column.size(); ++i) {
+    if (!remove[i])
+      column[kept++] = column[i];
+  }
+  column.resize(kept);
+}
+} // namespace
+
+/** Fill the columns from a vector of TofEvent, replacing existing contents
+ * @param events :: events to copy
+ */
+void EventColumns::assign(const std::vector<TofEvent> &events) {
+  clear();
+  m_hasPulseTimes = true;
+  m_hasWeights = false;
+  m_tofs.reserve(events.size());
+  m_pulseTimes.reserve(events.size());
+  for (const auto &event : events) {
+    m_tofs.emplace_back(event.tof());
+    m_pulseTimes.emplace_back(event.pulseTime());
+  }
+}
+
+/** Fill the columns from a vector of WeightedEvent, replacing existing contents
+ * @param events :: events to copy
+ */
+void EventColumns::assign(const std::vector<WeightedEvent> &events) {
+  clear();
+  m_hasPulseTimes = true;
+  m_hasWeights = true;
+  m_tofs.reserve(events.size());
+  m_pulseTimes.reserve(events.size());
+  m_weights.reserve(events.size());
+  m_errorSquareds.reserve(events.size());
+  for (const auto &event : events) {
+    m_tofs.emplace_back(event.tof());
+    m_pulseTimes.emplace_back(event.pulseTime());
+    m_weights.emplace_back(event.m_weight);
+    m_errorSquareds.emplace_back(event.m_errorSquared);
+  }
+}
+
+/** Fill the columns from a vector of WeightedEventNoTime, replacing existing
+ * contents
+ * @param events :: events to copy
+ */
+void EventColumns::assign(const std::vector<WeightedEventNoTime> &events) {
+  clear();
+  m_hasPulseTimes = false;
+  m_hasWeights = true;
+  m_tofs.reserve(events.size());
+  m_weights.reserve(events.size());
+  m_errorSquareds.reserve(events.size());
+  for (const auto &event : events) {
+    m_tofs.emplace_back(event.tof());
+    m_weights.emplace_back(event.m_weight);
+    m_errorSquareds.emplace_back(event.m_errorSquared);
+  }
+}
+
+/** Rebuild a vector of TofEvent from the columns. Weights are dropped.
+ * @param events :: replaced by the events held here
+ */
+void EventColumns::copyTo(std::vector<TofEvent> &events) const {
+  events.clear();
+  events.reserve(size());
+  for (std::size_t i = 0; i < size(); ++i)
+    events.emplace_back(m_tofs[i], m_hasPulseTimes ? m_pulseTimes[i] : DateAndTime(0));
+}
+
+/** Rebuild a vector of WeightedEvent from the columns
+ * @param events :: replaced by the events held here
+ */
+void EventColumns::copyTo(std::vector<WeightedEvent> &events) const {
+  events.clear();
+  events.reserve(size());
+  for (std::size_t i = 0; i < size(); ++i) {
+    const DateAndTime pulseTime = m_hasPulseTimes ? m_pulseTimes[i] : DateAndTime(0);
+    if (m_hasWeights)
+      events.emplace_back(m_tofs[i], pulseTime, m_weights[i], m_errorSquareds[i]);
+    else
+      events.emplace_back(TofEvent(m_tofs[i], pulseTime));
+  }
+}
+
+/** Rebuild a vector of WeightedEventNoTime from the columns
+ * @param events :: replaced by the events held here
+ */
+void EventColumns::copyTo(std::vector<WeightedEventNoTime> &events) const {
+  events.clear();
+  events.reserve(size());
+  for (std::size_t i = 0; i < size(); ++i) {
+    if (m_hasWeights)
+      events.emplace_back(m_tofs[i], m_weights[i], m_errorSquareds[i]);
+    else
+      events.emplace_back(m_tofs[i], 1.0f, 1.0f);
+  }
+}
+
+/// Start carrying weights, giving every event a weight and error of 1
+void EventColumns::addWeights() {
+  if (m_hasWeights)
+    return;
+  m_weights.assign(size(), 1.0f);
+  m_errorSquareds.assign(size(), 1.0f);
+  m_hasWeights = true;
+}
+
+/// Stop carrying pulse times and release their memory
+void EventColumns::removePulseTimes() {
+  std::vector<DateAndTime>().swap(m_pulseTimes);
+  m_hasPulseTimes = false;
+}
+
+/// Remove all events, keeping the set of columns in use
+void EventColumns::clear() {
+  std::vector<double>().swap(m_tofs);
+  std::vector<DateAndTime>().swap(m_pulseTimes);
+  std::vector<float>().swap(m_weights);
+  std::vector<float>().swap(m_errorSquareds);
+}
+
+/** Pre-allocate the columns in use
+ * @param num :: number of events expected
+ */
+void EventColumns::reserve(std::size_t num) {
+  m_tofs.reserve(num);
+  if (m_hasPulseTimes)
+    m_pulseTimes.reserve(num);
+  if (m_hasWeights) {
+    m_weights.reserve(num);
+    m_errorSquareds.reserve(num);
+  }
+}
+
+/** Sort all columns by time-of-flight. Events with equal TOF keep their
+ * relative order.
+ */
+void EventColumns::sortByTof() {
+  if (std::is_sorted(m_tofs.cbegin(), m_tofs.cend()))
+    return;
+  std::vector<std::size_t> order(size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](const std::size_t lhs, const std::size_t rhs) { return m_tofs[lhs] < m_tofs[rhs]; });
+  applyOrder(m_tofs, order);
+  applyOrder(m_pulseTimes, order);
+  applyOrder(m_weights, order);
+  applyOrder(m_errorSquareds, order);
+}
+
+/// Reverse the order of the events
+void EventColumns::reverse() {
+  std::reverse(m_tofs.begin(), m_tofs.end());
+  std::reverse(m_pulseTimes.begin(), m_pulseTimes.end());
+  std::reverse(m_weights.begin(), m_weights.end());
+  std::reverse(m_errorSquareds.begin(), m_errorSquareds.end());
+}
+
+/** Remove the events flagged for removal, keeping the order of the others
+ * @param remove :: one flag per event, true to remove it
+ */
+void EventColumns::removeIf(const std::vector<bool> &remove) {
+  removeFlagged(m_tofs, remove);
+  removeFlagged(m_pulseTimes, remove);
+  removeFlagged(m_weights, remove);
+  removeFlagged(m_errorSquareds, remove);
+}
+
+/// @return the memory used by the columns, in bytes
+std::size_t EventColumns::getMemorySize() const {
+  return m_tofs.capacity() * sizeof(double) + m_pulseTimes.capacity() * sizeof(DateAndTime) +
+         (m_weights.capacity() + m_errorSquareds.capacity()) * sizeof(float) + sizeof(EventColumns);
+}
+
+} // namespace Mantid::DataObjects
@@ -23,11 +23,16 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cfloat>
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <map>
+#include <set>
 #include <stdexcept>
+#include <utility>
 
 using std::ostream;
 using std::runtime_error;
@@ -82,7 +87,253 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/// Fraction of a bin width by which an edge may deviate from the ideal grid
+/// and still be considered part of a linear or logarithmic binning
+constexpr double DIRECT_BINNING_TOLERANCE = 1.e-3;
+
+/**
+ * Description of bin edges whose bin index can be computed arithmetically
+ * from the x value, rather than by walking through the edges. Only the last
+ * edge may deviate from the grid, which is what Rebin produces when the range
+ * is not a whole number of steps.
+ */
+struct DirectBinning {
+  enum class Kind { None, Linear, Logarithmic };
+  Kind kind{Kind::None};
+  /// First bin edge
+  double xMin{0.};
+  /// Inverse of the bin width (linear) or of log(1+step) (logarithmic)
+  double invStep{0.};
+
+  bool isDirect() const { return kind != Kind::None; }
+
+  /**
+   * Find the bin holding x. The arithmetic guess is corrected against the
+   * actual edges so rounding can never misplace an event.
+   * @param X :: bin edges the binning was detected from
+   * @param x :: value to find, must lie in [X.front(), X.back())
+   * @return the index of the bin containing x
+   */
+  size_t findBin(const MantidVec &X, const double x) const {
+    const size_t numBins = X.size() - 1;
+    const double guess = (kind == Kind::Linear) ? (x - xMin) * invStep : std::log(x / xMin) * invStep;
+    size_t bin = std::min(static_cast<size_t>(std::max(guess, 0.)), numBins - 1);
+    while (bin > 0 && x < X[bin])
+      --bin;
+    while (x >= X[bin + 1])
+      ++bin;
+    return bin;
+  }
+};
+
+/**
+ * Check whether the bin edges form a linear or logarithmic grid
+ * @param X :: bin edges
+ * @return a description of the binning; its kind is None if neither applies
+ */
+DirectBinning findDirectBinning(const MantidVec &X) {
+  DirectBinning binning;
+  // with fewer than two full bins there is nothing to gain
+  if (X.size() < 3)
+    return binning;
+  const size_t lastRegular = X.size() - 2;
+  const double x0 = X[0];
+  const double linearStep = X[1] - X[0];
+  if (!(linearStep > 0.) || !(X.back() > X[lastRegular]))
+    return binning;
+
+  bool linear = true;
+  for (size_t i = 2; i <= lastRegular && linear; ++i)
+    linear = std::fabs(X[i] - (x0 + static_cast<double>(i) * linearStep)) <= DIRECT_BINNING_TOLERANCE * linearStep;
+  if (linear) {
+    binning.kind = DirectBinning::Kind::Linear;
+    binning.xMin = x0;
+    binning.invStep = 1. / linearStep;
+    return binning;
+  }
+
+  if (!(x0 > 0.))
+    return binning;
+  const double ratio = X[1] / x0;
+  bool logarithmic = true;
+  double expected = X[1];
+  for (size_t i = 2; i <= lastRegular && logarithmic; ++i) {
+    expected *= ratio;
+    logarithmic = std::fabs(X[i] - expected) <= DIRECT_BINNING_TOLERANCE * (expected - expected / ratio);
+  }
+  if (logarithmic) {
+    binning.kind = DirectBinning::Kind::Logarithmic;
+    binning.xMin = x0;
+    binning.invStep = 1. / std::log(ratio);
+  }
+  return binning;
+}
+
+/**
+ * Histogram events in any order using a direct bin index calculation.
+ * Y and E must already be sized to the number of bins and zeroed.
+ * @param events :: events to histogram, not necessarily sorted
+ * @param X :: bin edges
+ * @param binning :: linear or logarithmic description of X
+ * @param Y :: summed weights
+ * @param E :: summed squared errors, or nullptr to skip them
+ */
+template <class T>
+void histogramDirectHelper(const std::vector<T> &events, const MantidVec &X, const DirectBinning &binning, MantidVec &Y,
+                           MantidVec *E) {
+  const double xMin = X.front();
+  const double xMax = X.back();
+  for (const auto &event : events) {
+    const double tof = event.tof();
+    if (!(tof >= xMin && tof < xMax))
+      continue;
+    const size_t bin = binning.findBin(X, tof);
+    Y[bin] += event.weight();
+    if (E)
+      (*E)[bin] += event.errorSquared();
+  }
+}
+
+/**
+ * Histogram columnar events in any order. The bin is found directly for
+ * linear and logarithmic edges and by bisection otherwise, so no sort is
+ * needed. Y and E must already be sized to the number of bins and zeroed.
+ * @param columns :: events to histogram
+ * @param X :: bin edges
+ * @param Y :: summed weights
+ * @param E :: summed squared errors, or nullptr to skip them
+ */
+void histogramColumnsHelper(const EventColumns &columns, const MantidVec &X, MantidVec &Y, MantidVec *E) {
+  const auto binning = findDirectBinning(X);
+  const auto &tofs = columns.tofs();
+  const bool weighted = columns.hasWeights();
+  const double xMin = X.front();
+  const double xMax = X.back();
+  for (size_t i = 0; i < tofs.size(); ++i) {
+    const double tof = tofs[i];
+    if (!(tof >= xMin && tof < xMax))
+      continue;
+    const size_t bin = binning.isDirect()
+                           ? binning.findBin(X, tof)
+                           : static_cast<size_t>(std::upper_bound(X.cbegin(), X.cend(), tof) - X.cbegin()) - 1;
+    if (weighted) {
+      Y[bin] += columns.weights()[i];
+      if (E)
+        (*E)[bin] += columns.errorSquareds()[i];
+    } else {
+      Y[bin] += 1.0;
+      if (E)
+        (*E)[bin] += 1.0;
+    }
+  }
+}
+
+/**
+ * Count compact events in any order. As for columnar events the bin is found
+ * directly or by bisection, so no sort is needed. Y must already be sized to
+ * the number of bins and zeroed.
+ * @param events :: events to histogram
+ * @param X :: bin edges
+ * @param Y :: counts
+ */
+void histogramCompactHelper(const std::vector<CompactTofEvent> &events, const MantidVec &X, MantidVec &Y) {
+  const auto binning = findDirectBinning(X);
+  if (binning.isDirect()) {
+    histogramDirectHelper(events, X, binning, Y, nullptr);
+    return;
+  }
+  const double xMin = X.front();
+  const double xMax = X.back();
+  for (const auto &event : events) {
+    const double tof = event.tof();
+    if (!(tof >= xMin && tof < xMax))
+      continue;
+    Y[static_cast<size_t>(std::upper_bound(X.cbegin(), X.cend(), tof) - X.cbegin()) - 1] += 1.0;
+  }
+}
+
+/// Target of the events that are not copied to any output when splitting
+constexpr int NO_TARGET = std::numeric_limits<int>::min();
+
+/**
+ * Copy the events to the output event lists of their targets. The events of
+ * each output are counted first, so that every output is allocated once.
+ * @param events :: the events
+ * @param targets :: the target of each event, NO_TARGET if it is not copied
+ * @param outputs :: the output event lists by target
+ * @return the targets with events but without an output event list
+ */
+template <class T>
+std::set<int> copyEventsToTargets(const std::vector<T> &events, const std::vector<int> &targets,
+                                  const EventListSplitOutputs &outputs) {
+  std::set<int> missing;
+  const auto &lists = outputs.lists;
+  const int64_t first = outputs.firstTarget;
+  const int64_t last = first + static_cast<int64_t>(lists.size()) - 1;
+
+  std::vector<size_t> counts(lists.size(), 0);
+  for (const int target : targets) {
+    if (target == NO_TARGET)
+      continue;
+    if (target < first || target > last || !lists[static_cast<size_t>(target - first)]) {
+      missing.insert(target);
+      continue;
+    }
+    ++counts[static_cast<size_t>(target - first)];
+  }
+  for (size_t i = 0; i < lists.size(); ++i) {
+    if (counts[i] > 0)
+      lists[i]->reserve(lists[i]->getNumberEvents() + counts[i]);
+  }
+
+  for (size_t i = 0; i < events.size(); ++i) {
+    const int target = targets[i];
+    if (target == NO_TARGET || target < first || target > last)
+      continue;
+    if (EventList *output = lists[static_cast<size_t>(target - first)])
+      output->addEventQuickly(events[i]);
+  }
+  return missing;
+}
+
+/**
+ * Get the output of the events that are not split, as std::map::at() would.
+ * @param outputs :: the output event lists by target
+ * @return the output of target -1
+ */
+EventList &unfilteredOutput(const EventListSplitOutputs &outputs) {
+  EventList *output = outputs.find(-1);
+  if (!output)
+    throw std::out_of_range("No output event list for the unfiltered events (target -1)");
+  return *output;
+}
+
+/**
+ * Throw if events were split to targets without an output event list.
+ * @param missing :: the targets without an output event list
+ */
+void throwIfNoOutput(const std::set<int> &missing) {
+  if (missing.empty())
+    return;
+  std::stringstream errss;
+  errss << "Group " << *missing.begin() << " has a NULL output EventList. ";
+  throw std::runtime_error(errss.str());
+}
 } // namespace
+/**
+ * Lay out the output event lists of a map densely by target
+ * @param outputs :: the output event lists by target
+ */
+EventListSplitOutputs::EventListSplitOutputs(const std::map<int, EventList *> &outputs) {
+  if (outputs.empty())
+    return;
+  firstTarget = outputs.begin()->first;
+  lists.assign(static_cast<size_t>(static_cast<int64_t>(outputs.rbegin()->first) - firstTarget + 1), nullptr);
+  for (const auto &output : outputs)
+    lists[static_cast<size_t>(static_cast<int64_t>(output.first) - firstTarget)] = output.second;
+}
+
 //==========================================================================
 /// --------------------- TofEvent Comparators
 /// ----------------------------------
@@ -206,6 +457,11 @@ void EventList::copyDataInto(EventList &sink) const {
   sink.events = events;
   sink.weightedEvents = weightedEvents;
   sink.weightedEventsNoTime = weightedEventsNoTime;
+  const auto storage = getStorage();
+  sink.m_columns = storage == EventStorage::Columns ? std::make_unique<EventColumns>(*m_columns) : nullptr;
+  sink.compactEvents = storage == EventStorage::Compact ? compactEvents : std::vector<CompactTofEvent>();
+  sink.m_storage.store(storage, std::memory_order_release);
+  sink.m_pulseTimeTable = m_pulseTimeTable;
   sink.eventType = eventType;
   sink.order = order;
 }
@@ -313,6 +569,11 @@ EventList &EventList::operator=(const EventList &rhs) {
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
+  const auto storage = rhs.getStorage();
+  m_columns = storage == EventStorage::Columns ? std::make_unique<EventColumns>(*rhs.m_columns) : nullptr;
+  compactEvents = storage == EventStorage::Compact ? rhs.compactEvents : std::vector<CompactTofEvent>();
+  m_storage.store(storage, std::memory_order_release);
+  m_pulseTimeTable = rhs.m_pulseTimeTable;
   eventType = rhs.eventType;
   order = rhs.order;
   return *this;
@@ -324,6 +585,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  this->switchToRowStorage();
 
   switch (this->eventType) {
   case TOF:
@@ -352,6 +614,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  this->switchToRowStorage();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -389,6 +652,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  this->switchToRowStorage();
   this->switchTo(WEIGHTED);
   this->weightedEvents.emplace_back(event);
   this->order = UNSORTED;
@@ -404,6 +668,7 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<WeightedEvent> &more_events) {
+  this->switchToRowStorage();
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -438,6 +703,7 @@ EventList &EventList::operator+=(const std::vector<WeightedEvent> &more_events)
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  this->switchToRowStorage();
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -466,6 +732,7 @@ EventList &EventList::operator+=(const std::vector<WeightedEventNoTime> &more_ev
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
   // We'll let the += operator for the given vector of event lists handle it
+  more_events.switchToRowStorage();
   switch (more_events.getEventType()) {
   case TOF:
     this->operator+=(more_events.events);
@@ -531,6 +798,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
   }
 
   // We'll let the -= operator for the given vector of event lists handle it
+  this->switchToRowStorage();
+  more_events.switchToRowStorage();
   switch (this->getEventType()) {
   case TOF:
     this->switchTo(WEIGHTED);
@@ -583,6 +852,8 @@ bool EventList::operator==(const EventList &rhs) const {
     return false;
   if (this->eventType != rhs.eventType)
     return false;
+  this->switchToRowStorage();
+  rhs.switchToRowStorage();
   // Check all event lists; The empty ones will compare equal
   if (events != rhs.events)
     return false;
@@ -606,6 +877,8 @@ bool EventList::equals(const EventList &rhs, const double tolTof, const double t
     return false;
   if (this->eventType != rhs.eventType)
     return false;
+  this->switchToRowStorage();
+  rhs.switchToRowStorage();
 
   // loop over the events
   size_t numEvents = this->getNumberEvents();
@@ -647,6 +920,28 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  if (hasColumns()) {
+    if (newType == TOF && eventType != TOF)
+      throw std::runtime_error("EventList::switchTo() called on an EventList "
+                               "with weights to go down to TofEvent's. This "
+                               "would remove weight information and therefore "
+                               "is not possible.");
+    if (newType == WEIGHTED && eventType == WEIGHTED_NOTIME)
+      throw std::runtime_error("EventList::switchToWeightedEvents() called on an "
+                               "EventList with WeightedEventNoTime's. It has "
+                               "lost the pulse time information and can't go "
+                               "back to WeightedEvent's.");
+    if (newType != TOF)
+      m_columns->addWeights();
+    if (newType == WEIGHTED_NOTIME)
+      m_columns->removePulseTimes();
+    eventType = newType;
+    return;
+  }
+  // Compact storage only holds unweighted events
+  if (hasCompactEvents() && newType != TOF)
+    this->switchToRowStorage();
+
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -726,6 +1021,166 @@ void EventList::switchToWeightedEventsNoTime() {
   }
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Switch the EventList between holding a vector of event structs and holding
+ * the events column by column. The event type is unchanged.
+ * @param newStorage :: the layout to switch to
+ */
+void EventList::switchTo(EventStorage newStorage) {
+  if (newStorage == getStorage())
+    return;
+  this->switchToRowStorage();
+  if (newStorage == EventStorage::Rows)
+    return;
+  if (newStorage == EventStorage::Compact) {
+    this->switchToCompactStorage();
+    return;
+  }
+
+  m_columns = std::make_unique<EventColumns>();
+  switch (eventType) {
+  case TOF:
+    m_columns->assign(events);
+    break;
+  case WEIGHTED:
+    m_columns->assign(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns->assign(weightedEventsNoTime);
+    break;
+  }
+  // The vectors are no longer used
+  std::vector<TofEvent>().swap(this->events);
+  std::vector<WeightedEvent>().swap(this->weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+  std::vector<CompactTofEvent>().swap(this->compactEvents);
+  m_storage.store(EventStorage::Columns, std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Return how the events are laid out in memory
+ * @return :: the current EventStorage
+ */
+EventStorage EventList::getStorage() const { return m_storage.load(std::memory_order_acquire); }
+
+// -----------------------------------------------------------------------------------------------
+/** Set the table of pulse times that CompactTofEvent's refer to by index.
+ * Compact events already held are expanded first, as their indices refer to
+ * the previous table.
+ * @param pulseTimes :: the pulse times, usually shared with the other event
+ * lists of the workspace
+ */
+void EventList::setPulseTimeTable(std::shared_ptr<const std::vector<DateAndTime>> pulseTimes) {
+  if (pulseTimes == m_pulseTimeTable)
+    return;
+  this->switchToRowStorage();
+  m_pulseTimeTable = std::move(pulseTimes);
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Return the table of pulse times that CompactTofEvent's refer to by index
+ * @return :: the pulse time table, null if none was set
+ */
+const std::shared_ptr<const std::vector<DateAndTime>> &EventList::getPulseTimeTable() const {
+  return m_pulseTimeTable;
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Copy columnar or compact events back into the vector of the current event
+ * type. This is const because any operation without a columnar or compact
+ * implementation, const or not, has to call it before touching the event
+ * vectors.
+ *
+ * Other threads may be reading the columns or compact events of a const list
+ * at the same time, so they are left in place: the storage flag is only
+ * switched, with release ordering, once the rows are complete. The stale copy
+ * is freed by the next non-const call to switchToRowStorage().
+ */
+void EventList::switchToRowStorage() const {
+  if (m_storage.load(std::memory_order_acquire) == EventStorage::Rows)
+    return;
+
+  // Avoid converting from multiple threads
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  // If another thread converted while waiting for the lock, return.
+  const auto storage = m_storage.load(std::memory_order_acquire);
+  if (storage == EventStorage::Rows)
+    return;
+
+  if (storage == EventStorage::Compact) {
+    const auto &pulseTimes = *m_pulseTimeTable;
+    events.clear();
+    events.reserve(compactEvents.size());
+    for (const auto &event : compactEvents)
+      events.emplace_back(event.tof(), pulseTimes[event.pulseIndex()]);
+  } else {
+    switch (eventType) {
+    case TOF:
+      m_columns->copyTo(events);
+      break;
+    case WEIGHTED:
+      m_columns->copyTo(weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_columns->copyTo(weightedEventsNoTime);
+      break;
+    }
+  }
+  m_storage.store(EventStorage::Rows, std::memory_order_release);
+}
+
+/** Move columnar or compact events back into the vector of the current event
+ * type and free them. The caller has exclusive access to the list, so no
+ * other thread can still be reading them.
+ */
+void EventList::switchToRowStorage() {
+  std::as_const(*this).switchToRowStorage();
+  m_columns.reset();
+  std::vector<CompactTofEvent>().swap(this->compactEvents);
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Pack the TofEvent's of the list into CompactTofEvent's. Each pulse time
+ * is replaced by its index in the pulse time table, so that table must be
+ * set and contain every pulse time of the list.
+ */
+void EventList::switchToCompactStorage() {
+  if (eventType != TOF)
+    throw std::runtime_error("EventList::switchTo() called on an EventList "
+                             "with weights to go to compact storage. This "
+                             "would remove weight information and therefore "
+                             "is not possible.");
+  if (!m_pulseTimeTable)
+    throw std::runtime_error("EventList::switchTo() needs a pulse time table "
+                             "(setPulseTimeTable()) to go to compact storage.");
+  const auto &pulseTimes = *m_pulseTimeTable;
+  if (pulseTimes.size() > std::numeric_limits<uint32_t>::max())
+    throw std::runtime_error("EventList::switchTo(): too many pulse times for compact storage.");
+
+  // Consecutive events usually share a pulse, so check the previous match
+  // before searching the table
+  const bool sortedTable = std::is_sorted(pulseTimes.cbegin(), pulseTimes.cend());
+  size_t index = 0;
+  std::vector<CompactTofEvent> packed;
+  packed.reserve(events.size());
+  for (const auto &event : events) {
+    const auto pulseTime = event.pulseTime();
+    if (index >= pulseTimes.size() || pulseTimes[index] != pulseTime) {
+      const auto found = sortedTable ? std::lower_bound(pulseTimes.cbegin(), pulseTimes.cend(), pulseTime)
+                                     : std::find(pulseTimes.cbegin(), pulseTimes.cend(), pulseTime);
+      if (found == pulseTimes.cend() || *found != pulseTime)
+        throw std::runtime_error("EventList::switchTo(): the pulse time of an "
+                                 "event is not in the pulse time table.");
+      index = static_cast<size_t>(std::distance(pulseTimes.cbegin(), found));
+    }
+    packed.emplace_back(static_cast<float>(event.tof()), static_cast<uint32_t>(index));
+  }
+  compactEvents.swap(packed);
+  std::vector<TofEvent>().swap(this->events);
+  m_columns.reset();
+  m_storage.store(EventStorage::Compact, std::memory_order_release);
+}
+
 // ==============================================================================================
 // --- Testing functions (mostly)
 // ---------------------------------------------------------------
@@ -738,6 +1193,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -763,6 +1219,7 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * @return a const reference to the list of non-weighted events
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
+  this->switchToRowStorage();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -778,6 +1235,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  this->switchToRowStorage();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -793,6 +1251,7 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  this->switchToRowStorage();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -808,6 +1267,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
+  this->switchToRowStorage();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -821,6 +1281,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  this->switchToRowStorage();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -834,6 +1295,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() const {
+  this->switchToRowStorage();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
@@ -841,8 +1303,36 @@ const std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() con
   return this->weightedEventsNoTime;
 }
 
+/** Return the list of CompactTofEvent contained.
+ * NOTE! This should be used for testing purposes only, as much as possible.
+ * The EventList may contain weighted events, requiring use of
+ * getWeightedEvents() instead.
+ *
+ * @return a reference to the list of compact events
+ * */
+std::vector<CompactTofEvent> &EventList::getCompactEvents() {
+  if (!hasCompactEvents())
+    throw std::runtime_error("EventList::getCompactEvents() called for an "
+                             "EventList without compact storage.");
+  return this->compactEvents;
+}
+
+/** Return the list of CompactTofEvent contained.
+ * NOTE! This should be used for testing purposes only, as much as possible.
+ * The EventList may contain weighted events, requiring use of
+ * getWeightedEvents() instead.
+ *
+ * @return a const reference to the list of compact events
+ * */
+const std::vector<CompactTofEvent> &EventList::getCompactEvents() const {
+  if (!hasCompactEvents())
+    throw std::runtime_error("EventList::getCompactEvents() called for an "
+                             "EventList without compact storage.");
+  return this->compactEvents;
+}
+
 /** Clear the list of events and any
- * associated detector ID's.
+ * associated detector ID's. The list goes back to row storage.
  * */
 void EventList::clear(const bool removeDetIDs) {
   if (mru)
@@ -853,6 +1343,9 @@ void EventList::clear(const bool removeDetIDs) {
   std::vector<WeightedEvent>().swap(this->weightedEvents); // STL Trick to release memory
   this->weightedEventsNoTime.clear();
   std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime); // STL Trick to release memory
+  this->m_columns.reset();
+  std::vector<CompactTofEvent>().swap(this->compactEvents); // STL Trick to release memory
+  m_storage.store(EventStorage::Rows, std::memory_order_release);
   if (removeDetIDs)
     this->clearDetectorIDs();
 }
@@ -874,6 +1367,12 @@ void EventList::clearUnused() {
     this->weightedEventsNoTime.clear();
     std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime); // STL Trick to release memory
   }
+  if (!hasCompactEvents()) {
+    this->compactEvents.clear();
+    std::vector<CompactTofEvent>().swap(this->compactEvents); // STL Trick to release memory
+  }
+  if (!hasColumns())
+    this->m_columns.reset();
 }
 
 /// Mask the spectrum to this value. Removes all events.
@@ -893,6 +1392,14 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  * @param num :: number of events that will be in this EventList
  */
 void EventList::reserve(size_t num) {
+  if (hasColumns()) {
+    m_columns->reserve(num);
+    return;
+  }
+  if (hasCompactEvents()) {
+    this->compactEvents.reserve(num);
+    return;
+  }
   switch (this->eventType) {
   case TOF:
     this->events.reserve(num);
@@ -955,6 +1462,17 @@ void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return;
 
+  if (hasColumns()) {
+    m_columns->sortByTof();
+    this->order = TOF_SORT;
+    return;
+  }
+  if (hasCompactEvents()) {
+    tbb::parallel_sort(compactEvents.begin(), compactEvents.end());
+    this->order = TOF_SORT;
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     tbb::parallel_sort(events.begin(), events.end());
@@ -981,6 +1499,7 @@ void EventList::sortTof() const {
  */
 void EventList::sortTimeAtSample(const double &tofFactor, const double &tofShift, bool forceResort) const {
   // Check pre-cached sort flag.
+  this->switchToRowStorage();
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
 
@@ -1012,6 +1531,7 @@ void EventList::sortTimeAtSample(const double &tofFactor, const double &tofShift
 // --------------------------------------------------------------------------
 /** Sort events by Frame */
 void EventList::sortPulseTime() const {
+  this->switchToRowStorage();
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
 
@@ -1042,6 +1562,7 @@ void EventList::sortPulseTime() const {
  * (the absolute time)
  */
 void EventList::sortPulseTimeTOF() const {
+  this->switchToRowStorage();
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered
 
@@ -1075,6 +1596,7 @@ void EventList::sortPulseTimeTOF() const {
  * @param seconds The tolerance of pulse time in seconds.
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start, const double seconds) const {
+  this->switchToRowStorage();
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
 
@@ -1115,7 +1637,11 @@ void EventList::reverse() {
   std::reverse(x.begin(), x.end());
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (this->isSortedByTof() && hasColumns()) {
+    m_columns->reverse();
+  } else if (this->isSortedByTof() && hasCompactEvents()) {
+    std::reverse(this->compactEvents.begin(), this->compactEvents.end());
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1141,6 +1667,10 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  if (hasColumns())
+    return m_columns->size();
+  if (hasCompactEvents())
+    return this->compactEvents.size();
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1156,6 +1686,10 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  if (hasColumns())
+    return m_columns->empty();
+  if (hasCompactEvents())
+    return this->compactEvents.empty();
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1175,6 +1709,10 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  if (hasColumns())
+    return m_columns->getMemorySize() + sizeof(EventList);
+  if (hasCompactEvents())
+    return this->compactEvents.capacity() * sizeof(CompactTofEvent) + sizeof(EventList);
   switch (eventType) {
   case TOF:
     return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
@@ -1674,6 +2212,8 @@ inline void EventList::compressFatEventsHelper(const std::vector<T> &events, std
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  this->switchToRowStorage();
+  destination->switchToRowStorage();
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1726,6 +2266,8 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 
 void EventList::compressFatEvents(const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
                                   const double seconds, EventList *destination) {
+  this->switchToRowStorage();
+  destination->switchToRowStorage();
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -2000,6 +2542,9 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
 // --------------------------------------------------------------------------
 /** Generates both the Y and E (error) histograms w.r.t TOF
  * for an EventList with or without WeightedEvents.
+ * Unsorted lists are binned without sorting them if the bin edges are linear
+ * or logarithmic; otherwise the events are sorted by TOF first. Columnar
+ * lists are never sorted.
  *
  * @param X: x-bins supplied
  * @param Y: counts returned
@@ -2008,8 +2553,63 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  *        events; you can just ignore the returned E vector.
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  if (hasColumns()) {
+    if (X.size() <= 1) {
+      // X was not set. Return an empty array.
+      Y.resize(0, 0);
+      return;
+    }
+    Y.assign(X.size() - 1, 0.0);
+    const bool withErrors = !skipError || eventType != TOF;
+    if (withErrors)
+      E.assign(X.size() - 1, 0.0);
+    histogramColumnsHelper(*m_columns, X, Y, withErrors ? &E : nullptr);
+    if (withErrors)
+      std::transform(E.begin(), E.end(), E.begin(), static_cast<double (*)(double)>(sqrt));
+    return;
+  }
+
+  if (hasCompactEvents()) {
+    if (X.size() <= 1) {
+      // X was not set. Return an empty array.
+      Y.resize(0, 0);
+      return;
+    }
+    Y.assign(X.size() - 1, 0.0);
+    histogramCompactHelper(this->compactEvents, X, Y);
+    if (!skipError)
+      this->generateErrorsHistogram(Y, E);
+    return;
+  }
+
+  // Linear and logarithmic bins can be found directly from the TOF, so an
+  // unsorted list does not have to pay for (and is left without) a sort
+  if (this->order != TOF_SORT) {
+    const auto binning = findDirectBinning(X);
+    if (binning.isDirect()) {
+      Y.assign(X.size() - 1, 0.0);
+      switch (eventType) {
+      case TOF:
+        histogramDirectHelper(this->events, X, binning, Y, nullptr);
+        if (!skipError)
+          this->generateErrorsHistogram(Y, E);
+        break;
+      case WEIGHTED:
+        E.assign(X.size() - 1, 0.0);
+        histogramDirectHelper(this->weightedEvents, X, binning, Y, &E);
+        std::transform(E.begin(), E.end(), E.begin(), static_cast<double (*)(double)>(sqrt));
+        break;
+      case WEIGHTED_NOTIME:
+        E.assign(X.size() - 1, 0.0);
+        histogramDirectHelper(this->weightedEventsNoTime, X, binning, Y, &E);
+        std::transform(E.begin(), E.end(), E.begin(), static_cast<double (*)(double)>(sqrt));
+        break;
+      }
+      return;
+    }
+  }
 
+  // All types of weights need to be sorted by TOF
   this->sortTof();
 
   switch (eventType) {
@@ -2113,7 +2713,7 @@ void EventList::generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &
  */
 void EventList::generateCountsHistogramPulseTime(const double &xMin, const double &xMax, MantidVec &Y,
                                                  const double TOF_min, const double TOF_max) const {
-
+  this->switchToRowStorage();
   if (this->events.empty())
     return;
 
@@ -2355,6 +2955,29 @@ void EventList::integrate(const double minX, const double maxX, const bool entir
                           double &error) const {
   sum = 0;
   error = 0;
+  if (hasColumns()) {
+    // No need to sort, the range check is done on every event
+    const auto &tofs = m_columns->tofs();
+    const bool weighted = m_columns->hasWeights();
+    for (size_t i = 0; i < tofs.size(); ++i) {
+      if (!entireRange && (tofs[i] < minX || tofs[i] > maxX))
+        continue;
+      sum += weighted ? m_columns->weights()[i] : 1.0;
+      error += weighted ? m_columns->errorSquareds()[i] : 1.0;
+    }
+    error = std::sqrt(error);
+    return;
+  }
+  if (hasCompactEvents()) {
+    // Every event has a weight and squared error of 1
+    for (const auto &event : compactEvents) {
+      if (!entireRange && (event.tof() < minX || event.tof() > maxX))
+        continue;
+      sum += 1.0;
+    }
+    error = std::sqrt(sum);
+    return;
+  }
   if (!entireRange) {
     // The event list must be sorted by TOF!
     this->sortTof();
@@ -2402,6 +3025,14 @@ void EventList::convertTof(std::function<double(double)> func, const int sorting
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (hasColumns()) {
+    auto &tofs = m_columns->tofs();
+    std::transform(tofs.begin(), tofs.end(), tofs.begin(), func);
+    return;
+  }
+  // Compact events only hold single precision times-of-flight
+  this->switchToRowStorage();
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2444,6 +3075,14 @@ void EventList::convertTof(const double factor, const double offset) {
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (hasColumns()) {
+    for (auto &tof : m_columns->tofs())
+      tof = tof * factor + offset;
+    return;
+  }
+  // Compact events only hold single precision times-of-flight
+  this->switchToRowStorage();
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2525,6 +3164,7 @@ template <class T> void EventList::addPulsetimesHelper(std::vector<T> &events, c
 void EventList::addPulsetime(const double seconds) {
   if (this->getNumberEvents() <= 0)
     return;
+  this->switchToRowStorage();
 
   // Convert the list
   switch (eventType) {
@@ -2553,6 +3193,7 @@ void EventList::addPulsetimes(const std::vector<double> &seconds) {
   if (this->getNumberEvents() != seconds.size()) {
     throw std::runtime_error("");
   }
+  this->switchToRowStorage();
 
   // Convert the list
   switch (eventType) {
@@ -2624,6 +3265,26 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   if (this->getNumberEvents() == 0)
     return;
 
+  if (hasColumns()) {
+    // Remove in place, keeping the current order, without sorting
+    const auto &tofs = m_columns->tofs();
+    std::vector<bool> remove(tofs.size());
+    std::transform(tofs.cbegin(), tofs.cend(), remove.begin(),
+                   [tofMin, tofMax](const double tof) { return tof >= tofMin && tof <= tofMax; });
+    m_columns->removeIf(remove);
+    return;
+  }
+  if (hasCompactEvents()) {
+    // Remove in place, keeping the current order, without sorting
+    auto &compact = this->compactEvents;
+    compact.erase(std::remove_if(compact.begin(), compact.end(),
+                                 [tofMin, tofMax](const CompactTofEvent &event) {
+                                   return event.tof() >= tofMin && event.tof() <= tofMax;
+                                 }),
+                  compact.end());
+    return;
+  }
+
   // Start by sorting by tof
   this->sortTof();
 
@@ -2694,6 +3355,15 @@ void EventList::maskCondition(const std::vector<bool> &mask) {
   if (this->getNumberEvents() == 0)
     return;
 
+  if (hasColumns()) {
+    std::vector<bool> remove(mask.size());
+    std::transform(mask.cbegin(), mask.cend(), remove.begin(), [](const bool keep) { return !keep; });
+    m_columns->removeIf(remove);
+    return;
+  }
+  // Compact events are masked as TofEvent's
+  this->switchToRowStorage();
+
   // Convert the list
   size_t numOrig = 0;
   size_t numDel = 0;
@@ -2732,6 +3402,15 @@ template <class T> void EventList::getTofsHelper(const std::vector<T> &events, s
  *  @param tofs :: A reference to the vector to be filled
  */
 void EventList::getTofs(std::vector<double> &tofs) const {
+  if (hasColumns()) {
+    tofs = m_columns->tofs();
+    return;
+  }
+  if (hasCompactEvents()) {
+    this->getTofsHelper(this->compactEvents, tofs);
+    return;
+  }
+
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
@@ -2776,6 +3455,14 @@ template <class T> void EventList::getWeightsHelper(const std::vector<T> &events
  *  @param weights :: A reference to the vector to be filled
  */
 void EventList::getWeights(std::vector<double> &weights) const {
+  if (hasColumns()) {
+    if (m_columns->hasWeights())
+      weights.assign(m_columns->weights().cbegin(), m_columns->weights().cend());
+    else
+      weights.assign(m_columns->size(), 1.0);
+    return;
+  }
+
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
@@ -2822,6 +3509,18 @@ void EventList::getWeightErrorsHelper(const std::vector<T> &events, std::vector<
  *  @param weightErrors :: A reference to the vector to be filled
  */
 void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
+  if (hasColumns()) {
+    if (m_columns->hasWeights()) {
+      const auto &errorSquareds = m_columns->errorSquareds();
+      weightErrors.resize(errorSquareds.size());
+      std::transform(errorSquareds.cbegin(), errorSquareds.cend(), weightErrors.begin(),
+                     [](const float errorSquared) { return std::sqrt(static_cast<double>(errorSquared)); });
+    } else {
+      weightErrors.assign(m_columns->size(), 1.0);
+    }
+    return;
+  }
+
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
@@ -2870,10 +3569,24 @@ void EventList::getPulseTimesHelper(const std::vector<T> &events,
  * @return by copy a vector of DateAndTime times
  */
 std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
+  if (hasColumns()) {
+    if (m_columns->hasPulseTimes())
+      return m_columns->pulseTimes();
+    return std::vector<Mantid::Types::Core::DateAndTime>(m_columns->size(), Mantid::Types::Core::DateAndTime(0));
+  }
+
   std::vector<Mantid::Types::Core::DateAndTime> times;
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
 
+  if (hasCompactEvents()) {
+    // Look the pulse times up without expanding the events
+    const auto &pulseTimes = *m_pulseTimeTable;
+    std::transform(compactEvents.cbegin(), compactEvents.cend(), std::back_inserter(times),
+                   [&pulseTimes](const CompactTofEvent &event) { return pulseTimes[event.pulseIndex()]; });
+    return times;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2901,6 +3614,15 @@ double EventList::getTofMin() const {
   if (this->empty())
     return tMin;
 
+  if (hasColumns()) {
+    const auto &tofs = m_columns->tofs();
+    return (this->order == TOF_SORT) ? tofs.front() : *std::min_element(tofs.cbegin(), tofs.cend());
+  }
+  if (hasCompactEvents()) {
+    return (this->order == TOF_SORT) ? compactEvents.front().tof()
+                                     : std::min_element(compactEvents.cbegin(), compactEvents.cend())->tof();
+  }
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2945,6 +3667,15 @@ double EventList::getTofMax() const {
   if (this->empty())
     return tMax;
 
+  if (hasColumns()) {
+    const auto &tofs = m_columns->tofs();
+    return (this->order == TOF_SORT) ? tofs.back() : *std::max_element(tofs.cbegin(), tofs.cend());
+  }
+  if (hasCompactEvents()) {
+    return (this->order == TOF_SORT) ? compactEvents.back().tof()
+                                     : std::max_element(compactEvents.cbegin(), compactEvents.cend())->tof();
+  }
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2989,6 +3720,7 @@ DateAndTime EventList::getPulseTimeMin() const {
   // no events is a soft error
   if (this->empty())
     return tMin;
+  this->switchToRowStorage();
 
   // when events are ordered by pulse time just need the first value
   if (this->order == PULSETIME_SORT) {
@@ -3033,6 +3765,7 @@ DateAndTime EventList::getPulseTimeMax() const {
   // no events is a soft error
   if (this->empty())
     return tMax;
+  this->switchToRowStorage();
 
   // when events are ordered by pulse time just need the first value
   if (this->order == PULSETIME_SORT) {
@@ -3076,6 +3809,7 @@ void EventList::getPulseTimeMinMax(Mantid::Types::Core::DateAndTime &tMin,
   // no events is a soft error
   if (this->empty())
     return;
+  this->switchToRowStorage();
 
   // when events are ordered by pulse time just need the first/last values
   if (this->order == PULSETIME_SORT) {
@@ -3124,6 +3858,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor, const double
   // no events is a soft error
   if (this->empty())
     return tMax;
+  this->switchToRowStorage();
 
   // when events are ordered by time at sample just need the first value
   if (this->order == TIMEATSAMPLE_SORT) {
@@ -3165,6 +3900,7 @@ DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor, const double
   // no events is a soft error
   if (this->empty())
     return tMin;
+  this->switchToRowStorage();
 
   // when events are ordered by time at sample just need the first value
   if (this->order == TIMEATSAMPLE_SORT) {
@@ -3211,7 +3947,8 @@ template <class T> void EventList::setTofsHelper(std::vector<T> &events, const s
 
   size_t x_size = tofs.size();
   if (events.size() != x_size)
-    return; // should this throw an exception?
+    throw std::invalid_argument("EventList::setTofs() called with " + std::to_string(x_size) +
+                                " times-of-flight for " + std::to_string(events.size()) + " events.");
 
   for (size_t i = 0; i < x_size; ++i)
     events[i].m_tof = tofs[i];
@@ -3222,10 +3959,24 @@ template <class T> void EventList::setTofsHelper(std::vector<T> &events, const s
  * Set a list of TOFs to the current event list. Modify the units if necessary.
  *
  * @param tofs :: The vector of doubles to set the tofs to.
+ * @throws std::invalid_argument if tofs is not empty and its size differs
+ * from the number of events
  */
 void EventList::setTofs(const MantidVec &tofs) {
   this->order = UNSORTED;
 
+  if (hasColumns()) {
+    if (tofs.empty())
+      return;
+    if (tofs.size() != m_columns->size())
+      throw std::invalid_argument("EventList::setTofs() called with " + std::to_string(tofs.size()) +
+                                  " times-of-flight for " + std::to_string(m_columns->size()) + " events.");
+    m_columns->tofs() = tofs;
+    return;
+  }
+  // Compact events only hold single precision times-of-flight
+  this->switchToRowStorage();
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -3326,6 +4077,23 @@ void EventList::multiply(const double value, const double error) {
   if ((value == 1.0) && (error == 0.0))
     return;
 
+  if (hasColumns()) {
+    if (eventType == TOF)
+      this->switchTo(WEIGHTED);
+    const double errorSquared = error * error;
+    const double valueSquared = value * value;
+    auto &weights = m_columns->weights();
+    auto &errorSquareds = m_columns->errorSquareds();
+    for (size_t i = 0; i < weights.size(); ++i) {
+      errorSquareds[i] =
+          static_cast<float>(errorSquareds[i] * valueSquared + errorSquared * weights[i] * weights[i]);
+      weights[i] *= static_cast<float>(value);
+    }
+    return;
+  }
+  // Compact storage has no per-event weights
+  this->switchToRowStorage();
+
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3447,6 +4215,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events, const MantidVec
  * @throw invalid_argument if the sizes of X, Y, E are not consistent.
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y, const MantidVec &E) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3584,6 +4353,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events, const MantidVec &X
  * @throw invalid_argument if the sizes of X, Y, E are not consistent.
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y, const MantidVec &E) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3972,6 +4742,23 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter, std::vector<Even
   }
 }
 
+//------------------------------------------------------------------------------------------------
+/** Empty the outputs of a split and give them the detector IDs, histogram and
+ * event type of this list
+ * @param outputs :: the output event lists by target
+ */
+void EventList::prepareSplitOutputs(const EventListSplitOutputs &outputs) const {
+  for (EventList *opeventlist : outputs.lists) {
+    if (!opeventlist)
+      continue;
+    opeventlist->clear();
+    opeventlist->setDetectorIDs(this->getDetectorIDs());
+    opeventlist->setHistogram(m_histogram);
+    // Match the output event type.
+    opeventlist->switchTo(eventType);
+  }
+}
+
 //------------------------------------------------------------------------------------------------
 /** Split the event list into n outputs, operating on a vector of either
  *TofEvent's or WeightedEvent's
@@ -3989,16 +4776,18 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter, std::vector<Even
  *toffactor*tof+tofshift
  */
 template <class T>
-void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
+void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, const EventListSplitOutputs &outputs,
                                       typename std::vector<T> &events, bool docorrection, double toffactor,
                                       double tofshift) const {
   // 1. Prepare to Iterate through the splitter at the same time
   auto itspl = splitter.begin();
   auto itspl_end = splitter.end();
 
-  // 2. Prepare to Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
+  // 2. Prepare to Iterate through all events (sorted by tof), finding the
+  // target of each one
+  const size_t numEvents = events.size();
+  std::vector<int> targets(numEvents, NO_TARGET);
+  size_t iev = 0;
 
   // 3. This is the time of the first section. Anything before is thrown out.
   while (itspl != itspl_end) {
@@ -4008,36 +4797,33 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, std::m
     const int index = itspl->index();
 
     // a) Skip the events before the start of the time
-    // TODO This step can be
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
+    while (iev < numEvents) {
       int64_t fulltime;
       if (docorrection)
-        fulltime = calculateCorrectedFullTime(*itev, toffactor, tofshift);
+        fulltime = calculateCorrectedFullTime(events[iev], toffactor, tofshift);
       else
-        fulltime = itev->m_pulsetime.totalNanoseconds() + static_cast<int64_t>(itev->m_tof * 1000);
+        fulltime = events[iev].m_pulsetime.totalNanoseconds() + static_cast<int64_t>(events[iev].m_tof * 1000);
       if (fulltime < start) {
         // a1) Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        itev++;
+        targets[iev] = -1;
+        ++iev;
       } else {
         break;
       }
     }
 
     // b) Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
+    while (iev < numEvents) {
       int64_t fulltime;
       if (docorrection)
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(toffactor * itev->m_tof * 1000 + tofshift * 1.0E9);
+        fulltime = events[iev].m_pulsetime.totalNanoseconds() +
+                   static_cast<int64_t>(toffactor * events[iev].m_tof * 1000 + tofshift * 1.0E9);
       else
-        fulltime = itev->m_pulsetime.totalNanoseconds() + static_cast<int64_t>(itev->m_tof * 1000);
+        fulltime = events[iev].m_pulsetime.totalNanoseconds() + static_cast<int64_t>(events[iev].m_tof * 1000);
       if (fulltime < stop) {
-        // b1) Add a copy to the output
-        outputs[index]->addEventQuickly(*itev);
-        ++itev;
+        // b1) The event goes to the output of this interval
+        targets[iev] = index;
+        ++iev;
       } else {
         break;
       }
@@ -4050,9 +4836,12 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, std::m
       break;
 
     // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
+    if (iev == numEvents)
       break;
   } // END-WHILE Splitter
+
+  // 4. Copy the events to their outputs
+  throwIfNoOutput(copyEventsToTargets(events, targets, outputs));
 }
 
 //------------------------------------------------------------------------------------------------
@@ -4067,7 +4856,22 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, std::m
  * @param toffactor:  a correction factor for each TOF to multiply with
  * @param tofshift:  a correction shift for each TOF to add with
  */
-void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
+void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter, const std::map<int, EventList *> &outputs,
+                                bool docorrection, double toffactor, double tofshift) const {
+  splitByFullTime(splitter, EventListSplitOutputs(outputs), docorrection, toffactor, tofshift);
+}
+
+/** Split the event list into n outputs by event's full time (tof + pulse time)
+ *
+ * @param splitter :: a TimeSplitterType giving where to split
+ * @param outputs :: the output event lists by target, which can be reused
+ * from spectrum to spectrum
+ * @param docorrection :: a boolean to indiciate whether it is need to do
+ *correction
+ * @param toffactor:  a correction factor for each TOF to multiply with
+ * @param tofshift:  a correction shift for each TOF to add with
+ */
+void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter, const EventListSplitOutputs &outputs,
                                 bool docorrection, double toffactor, double tofshift) const {
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4077,20 +4881,12 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter, std::map<int
   this->sortPulseTimeTOF();
 
   // 2. Initialize all the outputs
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
-    EventList *opeventlist = outiter->second;
-    opeventlist->clear();
-    opeventlist->setDetectorIDs(this->getDetectorIDs());
-    opeventlist->setHistogram(m_histogram);
-    // Match the output event type.
-    opeventlist->switchTo(eventType);
-  }
+  prepareSplitOutputs(outputs);
 
   // Do nothing if there are no entries
   if (splitter.empty()) {
     // 3A. Copy all events to group workspace = -1
-    (*outputs[-1]) = (*this);
+    unfilteredOutput(outputs) = (*this);
     // this->duplicate(outputs[-1]);
   } else {
     // 3B. Split
@@ -4130,46 +4926,39 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter, std::map<int
 template <class T>
 std::string
 EventList::splitByFullTimeVectorSplitterHelper(const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-                                               std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+                                               const EventListSplitOutputs &outputs, typename std::vector<T> &vecEvents,
                                                bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  typename std::vector<T>::iterator eviter;
   std::stringstream msgss;
 
-  // Loop through events
-  for (eviter = vecEvents.begin(); eviter != vecEvents.end(); ++eviter) {
+  // Find the target of each event
+  const size_t numEvents = vecEvents.size();
+  std::vector<int> targets(numEvents);
+  for (size_t iev = 0; iev < numEvents; ++iev) {
+    const T &event = vecEvents[iev];
     // Obtain time of event
     int64_t evabstimens;
     if (docorrection)
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(toffactor * eviter->m_tof * 1000 + tofshift * 1.0E9);
+      evabstimens = event.m_pulsetime.totalNanoseconds() +
+                    static_cast<int64_t>(toffactor * event.m_tof * 1000 + tofshift * 1.0E9);
     else
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() + static_cast<int64_t>(eviter->m_tof * 1000);
+      evabstimens = event.m_pulsetime.totalNanoseconds() + static_cast<int64_t>(event.m_tof * 1000);
 
     // Search in vector
     int index = static_cast<int>(lower_bound(vectimes.begin(), vectimes.end(), evabstimens) - vectimes.begin());
-    int group;
     // FIXME - whether lower_bound() equal to vectimes.size()-1 should be
     // filtered out?
     if (index == 0 || index > static_cast<int>(vectimes.size() - 1)) {
       // Event is before first splitter or after last splitter.  Put to -1
-      group = -1;
+      targets[iev] = -1;
     } else {
-      group = vecgroups[index - 1];
+      targets[iev] = vecgroups[index - 1];
     }
+  }
 
-    // Copy event to the proper group
-    EventList *myOutput = outputs[group];
-    if (!myOutput) {
-      std::stringstream errss;
-      errss << "Group " << group << " has a NULL output EventList. "
-            << "\n";
-      msgss << errss.str();
-    } else {
-      const T eventCopy(*eviter);
-      myOutput->addEventQuickly(eventCopy);
-    }
+  // Copy the events to the proper groups
+  for (const int group : copyEventsToTargets(vecEvents, targets, outputs)) {
+    msgss << "Group " << group << " has a NULL output EventList. "
+          << "\n";
   }
 
   return (msgss.str());
@@ -4198,65 +4987,43 @@ EventList::splitByFullTimeVectorSplitterHelper(const std::vector<int64_t> &vecti
 template <class T>
 std::string EventList::splitByFullTimeSparseVectorSplitterHelper(const std::vector<int64_t> &vectimes,
                                                                  const std::vector<int> &vecgroups,
-                                                                 std::map<int, EventList *> outputs,
+                                                                 const EventListSplitOutputs &outputs,
                                                                  typename std::vector<T> &vecEvents, bool docorrection,
                                                                  double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  // typename std::vector<T>::iterator eviter;
-  std::stringstream msgss;
-
   size_t num_splitters = vecgroups.size();
-  // prepare to Iterate through all events (sorted by tof)
-  auto iter_events = vecEvents.begin();
-  auto iter_events_end = vecEvents.end();
-
-  // std::stringstream debug_ss;
-  // debug_ss << "\nFilter events...:\n";
+  // prepare to Iterate through all events (sorted by tof), finding the target
+  // of each one
+  const size_t numEvents = vecEvents.size();
+  std::vector<int> targets(numEvents, NO_TARGET);
+  size_t iev = 0;
 
   for (size_t i = 0; i < num_splitters; ++i) {
     // get one splitter
     int64_t start_i64 = vectimes[i];
     int64_t stop_i64 = vectimes[i + 1];
     int group = vecgroups[i];
-    // debug_ss << "working on splitter: " << i << " from " << start_i64 << " to
-    // " << stop_i64 << "\n";
 
     // go over events
-    while (iter_events != iter_events_end) {
+    while (iev < numEvents) {
+      const T &event = vecEvents[iev];
       int64_t absolute_time;
       if (docorrection)
-        absolute_time = iter_events->m_pulsetime.totalNanoseconds() +
-                        static_cast<int64_t>(toffactor * iter_events->m_tof * 1000 + tofshift * 1.0E9);
+        absolute_time = event.m_pulsetime.totalNanoseconds() +
+                        static_cast<int64_t>(toffactor * event.m_tof * 1000 + tofshift * 1.0E9);
       else
-        absolute_time = iter_events->m_pulsetime.totalNanoseconds() + static_cast<int64_t>(iter_events->m_tof * 1000);
-
-      // debug_ss << "  event " << iter_events - vecEvents.begin() << " abs.time
-      // = " << absolute_time << "\n";
+        absolute_time = event.m_pulsetime.totalNanoseconds() + static_cast<int64_t>(event.m_tof * 1000);
 
       if (absolute_time < start_i64) {
         // event occurs before the splitter. only can happen with first
         // splitter. Then ignore and move to next
-        ++iter_events;
+        ++iev;
         continue;
       }
 
       if (absolute_time < stop_i64) {
-        // in the splitter, then copy the event into another
-        const T eventCopy(*iter_events);
-        // Copy event to the proper group
-        EventList *myOutput = outputs[group];
-        if (!myOutput) {
-          // there is no such group defined. quit for this group
-          std::stringstream errss;
-          errss << "Group " << group << " has a NULL output EventList. "
-                << "\n";
-          msgss << errss.str();
-          throw std::runtime_error(errss.str());
-        }
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++iter_events;
+        // in the splitter: the event goes to its group
+        targets[iev] = group;
+        ++iev;
       } else {
         // event occurs after the stop time, it should belonged to the next
         // splitter
@@ -4265,13 +5032,14 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(const std::vect
     } // while
 
     // quit the loop if there is no more event left
-    if (iter_events == iter_events_end)
+    if (iev == numEvents)
       break;
   } // for splitter
 
-  // std::cout << debug_ss.str();
+  // Copy the events to their groups
+  throwIfNoOutput(copyEventsToTargets(vecEvents, targets, outputs));
 
-  return (msgss.str());
+  return "";
 }
 
 //----------------------------------------------------------------------------------------------
@@ -4289,8 +5057,27 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(const std::vect
 // have an option to ignore the un-filtered events!
 std::string EventList::splitByFullTimeMatrixSplitter(const std::vector<int64_t> &vec_splitters_time,
                                                      const std::vector<int> &vecgroups,
-                                                     std::map<int, EventList *> vec_outputEventList, bool docorrection,
-                                                     double toffactor, double tofshift) const {
+                                                     const std::map<int, EventList *> &vec_outputEventList,
+                                                     bool docorrection, double toffactor, double tofshift) const {
+  return splitByFullTimeMatrixSplitter(vec_splitters_time, vecgroups, EventListSplitOutputs(vec_outputEventList),
+                                       docorrection, toffactor, tofshift);
+}
+
+/**
+ * @brief EventList::splitByFullTimeMatrixSplitter
+ * @param vec_splitters_time  :: vector of splitting times
+ * @param vecgroups :: vector of index group for splitters
+ * @param vec_outputEventList :: the output event lists by target, which can
+ * be reused from spectrum to spectrum
+ * @param docorrection :: flag to do TOF correction from detector to sample
+ * @param toffactor :: factor multiplied to TOF for correction
+ * @param tofshift :: shift to TOF in unit of SECOND for correction
+ * @return
+ */
+std::string EventList::splitByFullTimeMatrixSplitter(const std::vector<int64_t> &vec_splitters_time,
+                                                     const std::vector<int> &vecgroups,
+                                                     const EventListSplitOutputs &vec_outputEventList,
+                                                     bool docorrection, double toffactor, double tofshift) const {
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4301,22 +5088,14 @@ std::string EventList::splitByFullTimeMatrixSplitter(const std::vector<int64_t>
   sortPulseTimeTOF();
 
   // Initialize all the output event list
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = vec_outputEventList.begin(); outiter != vec_outputEventList.end(); ++outiter) {
-    EventList *opeventlist = outiter->second;
-    opeventlist->clear();
-    opeventlist->setDetectorIDs(this->getDetectorIDs());
-    opeventlist->setHistogram(m_histogram);
-    // Match the output event type.
-    opeventlist->switchTo(eventType);
-  }
+  prepareSplitOutputs(vec_outputEventList);
 
   std::string debugmessage;
 
   // Do nothing if there are no entries
   if (vecgroups.empty()) {
     // Copy all events to group workspace = -1
-    (*vec_outputEventList[-1]) = (*this);
+    unfilteredOutput(vec_outputEventList) = (*this);
     // this->duplicate(outputs[-1]);
   } else {
     // Split
@@ -4357,7 +5136,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(const std::vector<int64_t>
 /** Split the event list into n outputs by each event's pulse time only
  */
 template <class T>
-void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
+void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, const EventListSplitOutputs &outputs,
                                        typename std::vector<T> &events) const {
   // Prepare to TimeSplitter Iterate through the splitter at the same time
   auto itspl = splitter.begin();
@@ -4365,8 +5144,9 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, std::
   Types::Core::DateAndTime start, stop;
 
   // Prepare to Events Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
+  const size_t numEvents = events.size();
+  std::vector<int> targets(numEvents, NO_TARGET);
+  size_t iev = 0;
 
   // Iterate (loop) on all splitters
   while (itspl != itspl_end) {
@@ -4377,29 +5157,15 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, std::
 
     // Skip the events before the start of the time and put to 'unfiltered'
     // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
+    while (iev < numEvents && events[iev].m_pulsetime < start) {
+      targets[iev] = -1;
+      ++iev;
     }
 
     // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-
-      if (itev->m_pulsetime < stop) {
-        outputs[index]->addEventQuickly(*itev);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
+    while (iev < numEvents && events[iev].m_pulsetime < stop) {
+      targets[iev] = index;
+      ++iev;
     }
 
     // Go to the next interval
@@ -4409,15 +5175,24 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, std::
       break;
 
     // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
+    if (iev == numEvents)
       break;
   } // END-WHILE Splitter
+
+  throwIfNoOutput(copyEventsToTargets(events, targets, outputs));
 }
 
 //----------------------------------------------------------------------------------------------
 /** Split the event list by pulse time
  */
-void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs) const {
+void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter, const std::map<int, EventList *> &outputs) const {
+  splitByPulseTime(splitter, EventListSplitOutputs(outputs));
+}
+
+/** Split the event list by pulse time into outputs that can be reused from
+ * spectrum to spectrum
+ */
+void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter, const EventListSplitOutputs &outputs) const {
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4427,20 +5202,12 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter, std::map<in
   this->sortPulseTimeTOF();
 
   // Initialize all the output event lists
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
-    EventList *opeventlist = outiter->second;
-    opeventlist->clear();
-    opeventlist->setDetectorIDs(this->getDetectorIDs());
-    opeventlist->setHistogram(m_histogram);
-    // Match the output event type.
-    opeventlist->switchTo(eventType);
-  }
+  prepareSplitOutputs(outputs);
 
   // Split
   if (splitter.empty()) {
     // No splitter: copy all events to group workspace = -1
-    (*outputs[-1]) = (*this);
+    unfilteredOutput(outputs) = (*this);
   } else {
     // Split
     switch (eventType) {
@@ -4461,7 +5228,15 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter, std::map<in
  */
 // TODO/NOW - TEST
 void EventList::splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
-                                           std::map<int, EventList *> outputs) const {
+                                           const std::map<int, EventList *> &outputs) const {
+  splitByPulseTimeWithMatrix(vec_times, vec_target, EventListSplitOutputs(outputs));
+}
+
+/** Split the event list by pulse time into outputs that can be reused from
+ * spectrum to spectrum
+ */
+void EventList::splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
+                                           const EventListSplitOutputs &outputs) const {
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4471,20 +5246,12 @@ void EventList::splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times
   this->sortPulseTimeTOF();
 
   // Initialize all the output event lists
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
-    EventList *opeventlist = outiter->second;
-    opeventlist->clear();
-    opeventlist->setDetectorIDs(this->getDetectorIDs());
-    opeventlist->setHistogram(m_histogram);
-    // Match the output event type.
-    opeventlist->switchTo(eventType);
-  }
+  prepareSplitOutputs(outputs);
 
   // Split
   if (vec_target.empty()) {
     // No splitter: copy all events to group workspace = -1
-    (*outputs[-1]) = (*this);
+    unfilteredOutput(outputs) = (*this);
   } else {
     // Split
     switch (eventType) {
@@ -4503,7 +5270,7 @@ void EventList::splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times
 template <class T>
 void EventList::splitByPulseTimeWithMatrixHelper(const std::vector<int64_t> &vec_split_times,
                                                  const std::vector<int> &vec_split_target,
-                                                 std::map<int, EventList *> outputs,
+                                                 const EventListSplitOutputs &outputs,
                                                  typename std::vector<T> &events) const {
   // Prepare to TimeSplitter Iterate through the splitter at the same time
   if (vec_split_times.size() != vec_split_target.size() + 1)
@@ -4511,8 +5278,9 @@ void EventList::splitByPulseTimeWithMatrixHelper(const std::vector<int64_t> &vec
                              "vector size are not correct.");
 
   // Prepare to Events Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
+  const size_t numEvents = events.size();
+  std::vector<int> targets(numEvents, NO_TARGET);
+  size_t iev = 0;
 
   // Iterate (loop) on all splitters
   for (size_t i_target = 0; i_target < vec_split_target.size(); ++i_target) {
@@ -4523,35 +5291,23 @@ void EventList::splitByPulseTimeWithMatrixHelper(const std::vector<int64_t> &vec
 
     // Skip the events before the start of the time and put to 'unfiltered'
     // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
+    while (iev < numEvents && events[iev].m_pulsetime < start) {
+      targets[iev] = -1;
+      ++iev;
     }
 
     // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-
-      if (itev->m_pulsetime < stop) {
-        outputs[index]->addEventQuickly(*itev);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
+    while (iev < numEvents && events[iev].m_pulsetime < stop) {
+      targets[iev] = index;
+      ++iev;
     }
 
     // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
+    if (iev == numEvents)
       break;
   } // END-WHILE Splitter
+
+  throwIfNoOutput(copyEventsToTargets(events, targets, outputs));
 }
 
 //--------------------------------------------------------------------------
@@ -4595,6 +5351,21 @@ void getEventsFrom(const EventList &el, std::vector<WeightedEventNoTime> const *
   events = &el.getWeightedEventsNoTime();
 }
 
+//--------------------------------------------------------------------------
+/** Get the vector of events contained in an EventList;
+ * this is overloaded by event type.
+ *
+ * @param el :: The EventList to retrieve
+ * @param[out] events :: reference to a pointer to a vector of this type of
+ *event.
+ *             The pointer will be set to point to the vector.
+ * @throw runtime_error if the EventList does not use compact storage.
+ */
+void getEventsFrom(EventList &el, std::vector<CompactTofEvent> *&events) { events = &el.getCompactEvents(); }
+void getEventsFrom(const EventList &el, std::vector<CompactTofEvent> const *&events) {
+  events = &el.getCompactEvents();
+}
+
 //--------------------------------------------------------------------------
 /** Helper function for the conversion to TOF. This handles the different
  *  event types.
@@ -4606,13 +5377,17 @@ void getEventsFrom(const EventList &el, std::vector<WeightedEventNoTime> const *
 template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events, Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+  // Gather the times-of-flight in blocks that stay in cache and convert each
+  // block in one pass
+  constexpr size_t blockSize = 1024;
+  std::array<double, blockSize> tofs;
+  for (size_t start = 0; start < events.size(); start += blockSize) {
+    const size_t numEvents = std::min(blockSize, events.size() - start);
+    T *block = events.data() + start;
+    std::transform(block, block + numEvents, tofs.begin(), [](const T &event) { return event.m_tof; });
+    Kernel::Units::convertViaTOF(*fromUnit, *toUnit, tofs.data(), tofs.data() + numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      block[i].m_tof = tofs[i];
   }
 }
 
@@ -4633,6 +5408,13 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit, Mantid::Kerne
   if (!toUnit->isInitialized())
     throw std::runtime_error("EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  if (hasColumns()) {
+    Kernel::Units::convertViaTOF(*fromUnit, *toUnit, m_columns->tofs());
+    return;
+  }
+  // Compact events only hold single precision times-of-flight
+  this->switchToRowStorage();
+
   switch (eventType) {
   case TOF:
     convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
@@ -4668,6 +5450,14 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events, const
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  if (hasColumns()) {
+    for (auto &x : m_columns->tofs())
+      x = factor * std::pow(x, power);
+    return;
+  }
+  // Compact events only hold single precision times-of-flight
+  this->switchToRowStorage();
+
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
@@ -468,6 +468,27 @@ void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
     eventList->switchTo(type);
 }
 
+/** Switch all event lists to the given memory layout
+ *
+ * @param storage :: EventStorage to switch to
+ */
+void EventWorkspace::switchEventStorage(const EventStorage storage) {
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < static_cast<int>(this->data.size()); ++i)
+    this->data[i]->switchTo(storage);
+}
+
+/** Give every event list the same table of pulse times, which compact
+ * storage (EventStorage::Compact) refers to by index
+ *
+ * @param pulseTimes :: the pulse times of the workspace
+ */
+void EventWorkspace::setPulseTimeTable(const std::shared_ptr<const std::vector<Types::Core::DateAndTime>> &pulseTimes) {
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < static_cast<int>(this->data.size()); ++i)
+    this->data[i]->setPulseTimeTable(pulseTimes);
+}
+
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
 /// @returns If the data is a histogram - always true for an eventWorkspace
@@ -223,4 +223,25 @@ bool WeightedEventNoTime::equals(const WeightedEventNoTime &rhs, const double to
   return true;
 }
 
+//==========================================================================================
+// CompactTofEvent
+//==========================================================================================
+
+/** Constructor, full
+ * @param tof :: time-of-flight of the event
+ * @param pulseIndex :: index of the pulse time in the pulse time table
+ */
+CompactTofEvent::CompactTofEvent(float tof, uint32_t pulseIndex) : m_tof(tof), m_pulseIndex(pulseIndex) {}
+
+/// Empty constructor
+CompactTofEvent::CompactTofEvent() : m_tof(0.0f), m_pulseIndex(0) {}
+
+/** Comparison operator.
+ * @param rhs :: event to which we are comparing.
+ * @return true if all elements of this event are identical
+ *  */
+bool CompactTofEvent::operator==(const CompactTofEvent &rhs) const {
+  return (this->m_tof == rhs.m_tof) && (this->m_pulseIndex == rhs.m_pulseIndex);
+}
+
 } // namespace Mantid::DataObjects
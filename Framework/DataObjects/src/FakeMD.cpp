@@ -12,6 +12,7 @@
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventInserter.h"
+#include "MantidDataObjects/MDEventTreeBuilder.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadScheduler.h"
@@ -55,6 +56,8 @@ void FakeMD::fill(const API::IMDEventWorkspace_sptr &workspace) {
   CALL_MDEVENT_FUNCTION(this->addFakePeak, workspace)
   CALL_MDEVENT_FUNCTION(this->addFakeEllipsoid, workspace)
   CALL_MDEVENT_FUNCTION(this->addFakeUniformData, workspace)
+  // Split the boxes once, after all the events are added
+  CALL_MDEVENT_FUNCTION(this->splitBoxes, workspace)
 
   // Mark that events were added, so the file back end (if any) needs updating
   workspace->setFileNeedsUpdating(true);
@@ -138,13 +141,6 @@ template <typename MDE, size_t nd> void FakeMD::addFakePeak(typename MDEventWork
     eventHelper.insertMDEvent(signal, errorSquared, 0, 0, pickDetectorID(),
                               centers); // 0 = associated experiment-info index
   }
-
-  ws->splitBox();
-  auto *ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-  ws->splitAllIfNeeded(ts);
-  tp.joinAll();
-  ws->refreshCache();
 }
 
 /**
@@ -247,13 +243,6 @@ template <typename MDE, size_t nd> void FakeMD::addFakeEllipsoid(typename MDEven
     eventHelper.insertMDEvent(signal, errorSquared, 0, 0, pickDetectorID(),
                               eventCenter); // 0 = associated experiment-info index
   }
-
-  ws->splitBox();
-  auto *ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-  ws->splitAllIfNeeded(ts);
-  tp.joinAll();
-  ws->refreshCache();
 }
 
 /**
@@ -306,7 +295,22 @@ template <typename MDE, size_t nd> void FakeMD::addFakeUniformData(typename MDEv
     addFakeRandomData<MDE, nd>(m_uniformParams, ws);
   else
     addFakeRegularData<MDE, nd>(m_uniformParams, ws);
+}
 
+/**
+ * Split the boxes of the workspace after all events were added to it. In-memory
+ * workspaces with a regular power of 2 splitting get their whole box tree
+ * rebuilt from Morton ordered events, others are split box by box.
+ * @param ws The workspace holding the events
+ */
+template <typename MDE, size_t nd> void FakeMD::splitBoxes(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  if constexpr (isMDEventTreeBuildable<nd>()) {
+    if (!ws->isFileBacked() && canBuildMDEventTree(*ws->getBoxController())) {
+      rebuildMDEventTree(*ws, PARALLEL_GET_MAX_THREADS);
+      ws->refreshCache();
+      return;
+    }
+  }
   ws->splitBox();
   auto *ts = new ThreadSchedulerFIFO();
   ThreadPool tp(ts);
@@ -10,8 +10,10 @@
 #include "MantidGeometry/Math/ConvexPolygon.h"
 #include "MantidGeometry/Math/PolygonIntersection.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/V2D.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -130,15 +132,16 @@ void calcRectangleIntersections(const std::vector<double> &xAxis, const std::vec
                                 const size_t x_start, const size_t x_end, std::vector<AreaInfo> &areaInfos) {
   std::vector<double> width;
   width.reserve(x_end - x_start);
+  // The input quad may extend beyond the first or last bin of the grid
   for (size_t xi = x_start; xi < x_end; ++xi) {
-    const double x0 = (xi == x_start) ? inputQ.minX() : xAxis[xi];
-    const double x1 = (xi == x_end - 1) ? inputQ.maxX() : xAxis[xi + 1];
+    const double x0 = std::max(xAxis[xi], inputQ.minX());
+    const double x1 = std::min(xAxis[xi + 1], inputQ.maxX());
     width.emplace_back(x1 - x0);
   }
   areaInfos.reserve((y_end - y_start) * (x_end - x_start));
   for (size_t yi = y_start; yi < y_end; ++yi) {
-    const double y0 = (yi == y_start) ? inputQ.minY() : yAxis[yi];
-    const double y1 = (yi == y_end - 1) ? inputQ.maxY() : yAxis[yi + 1];
+    const double y0 = std::max(yAxis[yi], inputQ.minY());
+    const double y1 = std::min(yAxis[yi + 1], inputQ.maxY());
     const double height = y1 - y0;
     auto width_it = width.begin();
     for (size_t xi = x_start; xi < x_end; ++xi) {
@@ -458,6 +461,65 @@ void calcGeneralIntersections(const std::vector<double> &xAxis, const std::vecto
   }
 }
 
+/**
+ * Computes the output grid bins which intersect the input quad and their
+ * overlapping areas assuming input quad is a x-axis aligned trapezoid. The
+ * axes are swapped so that the quad becomes a y-axis aligned trapezoid.
+ * @param xAxis A vector containing the output horizontal axis edges
+ * @param yAxis The output data vertical axis
+ * @param inputQ The input quadrilateral
+ * @param y_start The starting y-axis index
+ * @param y_end The ending y-axis index
+ * @param x_start The starting x-axis index
+ * @param x_end The ending x-axis index
+ * @param areaInfos Output vector of indices and areas of overlapping bins
+ */
+void calcTrapezoidXIntersections(const std::vector<double> &xAxis, const std::vector<double> &yAxis,
+                                 const Quadrilateral &inputQ, const size_t y_start, const size_t y_end,
+                                 const size_t x_start, const size_t x_end, std::vector<AreaInfo> &areaInfos) {
+  const auto swapped = [](const V2D &v) { return V2D(v.Y(), v.X()); };
+  // The lower edge becomes the left edge and the upper edge the right edge
+  const Quadrilateral swappedQ(swapped(inputQ[0]), swapped(inputQ[1]), swapped(inputQ[2]), swapped(inputQ[3]));
+  std::vector<AreaInfo> swappedInfos;
+  calcTrapezoidYIntersections(yAxis, xAxis, swappedQ, x_start, x_end, y_start, y_end, swappedInfos);
+  areaInfos.reserve(areaInfos.size() + swappedInfos.size());
+  for (const auto &ai : swappedInfos) {
+    areaInfos.emplace_back(ai.wsIndex, ai.binIndex, ai.weight);
+  }
+}
+
+/**
+ * Computes the output grid bins which intersect the input quad and their
+ * overlapping areas, with the method for the shape of the quad
+ * @param xAxis A vector containing the output horizontal axis edges
+ * @param yAxis The output data vertical axis
+ * @param inputQ The input quadrilateral
+ * @param inputQType The shape of the input quadrilateral
+ * @param y_start The starting y-axis index
+ * @param y_end The ending y-axis index
+ * @param x_start The starting x-axis index
+ * @param x_end The ending x-axis index
+ * @param areaInfos Output vector of indices and areas of overlapping bins
+ */
+void calcIntersections(const std::vector<double> &xAxis, const std::vector<double> &yAxis, const Quadrilateral &inputQ,
+                       const QuadrilateralType inputQType, const size_t y_start, const size_t y_end,
+                       const size_t x_start, const size_t x_end, std::vector<AreaInfo> &areaInfos) {
+  switch (inputQType) {
+  case QuadrilateralType::Rectangle:
+    calcRectangleIntersections(xAxis, yAxis, inputQ, y_start, y_end, x_start, x_end, areaInfos);
+    break;
+  case QuadrilateralType::TrapezoidX:
+    calcTrapezoidXIntersections(xAxis, yAxis, inputQ, y_start, y_end, x_start, x_end, areaInfos);
+    break;
+  case QuadrilateralType::TrapezoidY:
+    calcTrapezoidYIntersections(xAxis, yAxis, inputQ, y_start, y_end, x_start, x_end, areaInfos);
+    break;
+  case QuadrilateralType::General:
+    calcGeneralIntersections(xAxis, yAxis, inputQ, y_start, y_end, x_start, x_end, areaInfos);
+    break;
+  }
+}
+
 /**
  * Computes the square root of the errors and if the input was a distribution
  * this divides by the new bin-width
@@ -491,30 +553,61 @@ void normaliseOutput(const MatrixWorkspace_sptr &outputWS, const MatrixWorkspace
 }
 
 /**
- * Rebin the input quadrilateral to the output grid.
+ * Rebin the input quadrilateral to the output grid, passing the contribution
+ * to each output bin to a function that adds it to the output.
  * The quadrilateral must have a CLOCKWISE winding.
  * @param inputQ The input polygon (Polygon winding must be Clockwise)
  * @param inputWS The input workspace containing the input intensity values
  * @param i The index in the vertical axis direction that inputQ references
  * @param j The index in the horizontal axis direction that inputQ references
- * @param outputWS A pointer to the output workspace that accumulates the data
+ * @param X A vector containing the output horizontal axis bin boundaries
  * @param verticalAxis A vector containing the output vertical axis bin
  * boundaries
+ * @param addToBin Called with the spectrum and bin index, the signal and the
+ * variance of each contribution
  */
-void rebinToOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
-                   const size_t j, MatrixWorkspace &outputWS, const std::vector<double> &verticalAxis) {
-  const auto &inY = inputWS->y(i);
+template <typename AddToBin>
+void rebinQuadrilateral(const Quadrilateral &inputQ, const MatrixWorkspace &inputWS, const size_t i, const size_t j,
+                        const std::vector<double> &X, const std::vector<double> &verticalAxis, AddToBin &&addToBin) {
+  const auto &inY = inputWS.y(i);
   // Check once whether the signal
   if (std::isnan(inY[j])) {
     return;
   }
 
-  const auto &X = outputWS.x(0).rawData();
   size_t qstart(0), qend(verticalAxis.size() - 1), x_start(0), x_end(X.size() - 1);
   if (!getIntersectionRegion(X, verticalAxis, inputQ, qstart, qend, x_start, x_end))
     return;
 
-  const auto &inE = inputWS->e(i);
+  const auto &inE = inputWS.e(i);
+  const bool isDistribution = inputWS.isDistribution();
+  // The overlap areas of rectangles and trapezoids are calculated without
+  // constructing the intersection polygons. The width of an overlap, which
+  // is needed for distributions, is then only known for rectangles.
+  const QuadrilateralType inputQType = getQuadrilateralType(inputQ);
+  if (inputQType == QuadrilateralType::Rectangle ||
+      (inputQType != QuadrilateralType::General && !isDistribution)) {
+    std::vector<AreaInfo> areaInfos;
+    calcIntersections(X, verticalAxis, inputQ, inputQType, qstart, qend, x_start, x_end, areaInfos);
+    const double inputQArea = inputQ.area();
+    for (const auto &ai : areaInfos) {
+      if (ai.weight == 0.) {
+        continue;
+      }
+      const double weight = ai.weight / inputQArea;
+      double yValue = inY[j] * weight;
+      double eValue = inE[j];
+      if (isDistribution) {
+        const double overlapWidth =
+            std::min(X[ai.binIndex + 1], inputQ.maxX()) - std::max(X[ai.binIndex], inputQ.minX());
+        yValue *= overlapWidth;
+        eValue *= overlapWidth;
+      }
+      addToBin(ai.wsIndex, ai.binIndex, yValue, eValue * eValue * weight);
+    }
+    return;
+  }
+
   // It seems to be more efficient to construct this once and clear it before
   // each calculation in the loop
   ConvexPolygon intersectOverlap;
@@ -533,52 +626,95 @@ void rebinToOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr
         double yValue = inY[j];
         yValue *= weight;
         double eValue = inE[j];
-        if (inputWS->isDistribution()) {
+        if (isDistribution) {
           const double overlapWidth = intersectOverlap.maxX() - intersectOverlap.minX();
           yValue *= overlapWidth;
           eValue *= overlapWidth;
         }
         eValue = eValue * eValue * weight;
-        PARALLEL_CRITICAL(overlap_sum) {
-          // The mutable calls must be in the critical section
-          // so that any calls from omp sections can write to the
-          // output workspace safely
-          outputWS.mutableY(y)[xi] += yValue;
-          outputWS.mutableE(y)[xi] += eValue;
-        }
+        addToBin(y, xi, yValue, eValue);
       }
     }
   }
 }
 
 /**
- * Rebin the input quadrilateral to the output grid
+ * Rebin the input quadrilateral to the output grid.
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be Clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The index in the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param outputWS A pointer to the output workspace that accumulates the data
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ */
+void rebinToOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                   const size_t j, MatrixWorkspace &outputWS, const std::vector<double> &verticalAxis) {
+  rebinQuadrilateral(inputQ, *inputWS, i, j, outputWS.x(0).rawData(), verticalAxis,
+                     [&outputWS](const size_t wsIndex, const size_t binIndex, const double signal,
+                                 const double variance) {
+                       PARALLEL_CRITICAL(overlap_sum) {
+                         // The mutable calls must be in the critical section
+                         // so that any calls from omp sections can write to the
+                         // output workspace safely
+                         outputWS.mutableY(wsIndex)[binIndex] += signal;
+                         outputWS.mutableE(wsIndex)[binIndex] += variance;
+                       }
+                     });
+}
+
+/**
+ * Rebin the input quadrilateral to a partial output of the grid, which is
+ * owned by the calling thread so that no locking is needed.
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be Clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The index in the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param partial The partial output that accumulates the data
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ */
+void rebinToOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                   const size_t j, PartialOutput &partial, const std::vector<double> &verticalAxis) {
+  rebinQuadrilateral(
+      inputQ, *inputWS, i, j, partial.xAxis(), verticalAxis,
+      [&partial](const size_t wsIndex, const size_t binIndex, const double signal, const double variance) {
+        partial.add(wsIndex, binIndex, signal, variance);
+      });
+}
+
+/**
+ * Rebin the input quadrilateral to the output grid, passing the contribution
+ * to each output bin to a function that adds it to the output.
  * The quadrilateral must have a CLOCKWISE winding.
  * @param inputQ The input polygon (Polygon winding must be clockwise)
  * @param inputWS The input workspace containing the input intensity values
  * @param i The indexiin the vertical axis direction that inputQ references
  * @param j The index in the horizontal axis direction that inputQ references
- * @param outputWS A pointer to the output workspace that accumulates the data
- *        Note that the error array of the output workspace contains the
- *        **variance** and not the errors (standard deviations).
+ * @param X A vector containing the output horizontal axis bin boundaries
  * @param verticalAxis A vector containing the output vertical axis bin
  * boundaries
  * @param inputRB A pointer, of RebinnedOutput type, to the input workspace.
  * It is used to take into account the input area fractions when calcuting
  * the final output fractions.
  * This can be null to indicate that the input was a standard 2D workspace.
+ * @param addToBin Called with the spectrum and bin index, the signal, the
+ * variance and the fraction of each contribution
  */
-void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
-                             const size_t j, RebinnedOutput &outputWS, const std::vector<double> &verticalAxis,
-                             const RebinnedOutput_const_sptr &inputRB) {
-  const auto &inX = inputWS->binEdges(i);
-  const auto &inY = inputWS->y(i);
-  const auto &inE = inputWS->e(i);
+template <typename AddToBin>
+void rebinQuadrilateralFractional(const Quadrilateral &inputQ, const MatrixWorkspace &inputWS, const size_t i,
+                                  const size_t j, const std::vector<double> &X,
+                                  const std::vector<double> &verticalAxis, const RebinnedOutput_const_sptr &inputRB,
+                                  AddToBin &&addToBin) {
+  const auto &inX = inputWS.binEdges(i);
+  const auto &inY = inputWS.y(i);
+  const auto &inE = inputWS.e(i);
   double signal = inY[j];
   if (std::isnan(signal))
     return;
 
-  const auto &X = outputWS.x(0).rawData();
   size_t qstart(0), qend(verticalAxis.size() - 1), x_start(0), x_end(X.size() - 1);
   if (!getIntersectionRegion(X, verticalAxis, inputQ, qstart, qend, x_start, x_end))
     return;
@@ -589,7 +725,7 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_
   // This wreaks havoc on the data.
   double error = inE[j];
   double inputWeight = 1.;
-  if (inputWS->isDistribution() && !inputRB) {
+  if (inputWS.isDistribution() && !inputRB) {
     const double overlapWidth = inX[j + 1] - inX[j];
     signal *= overlapWidth;
     error *= overlapWidth;
@@ -602,14 +738,7 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_
   // of all or some bins can be used.
   std::vector<AreaInfo> areaInfos;
   const double inputQArea = inputQ.area();
-  const QuadrilateralType inputQType = getQuadrilateralType(inputQ);
-  if (inputQType == QuadrilateralType::Rectangle) {
-    calcRectangleIntersections(X, verticalAxis, inputQ, qstart, qend, x_start, x_end, areaInfos);
-  } else if (inputQType == QuadrilateralType::TrapezoidY) {
-    calcTrapezoidYIntersections(X, verticalAxis, inputQ, qstart, qend, x_start, x_end, areaInfos);
-  } else {
-    calcGeneralIntersections(X, verticalAxis, inputQ, qstart, qend, x_start, x_end, areaInfos);
-  }
+  calcIntersections(X, verticalAxis, inputQ, getQuadrilateralType(inputQ), qstart, qend, x_start, x_end, areaInfos);
 
   // If the input is a RebinnedOutput workspace with frac. area we need
   // to account for the weight of the input bin in the output bin weights
@@ -633,13 +762,159 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_
       continue;
     }
     const double weight = ai.weight / inputQArea;
-    PARALLEL_CRITICAL(overlap) {
-      // The mutable calls must be in the critical section
-      // so that any calls from omp sections can write to the
-      // output workspace safely
-      outputWS.mutableY(ai.wsIndex)[ai.binIndex] += signal * weight;
-      outputWS.mutableE(ai.wsIndex)[ai.binIndex] += variance * weight;
-      outputWS.dataF(ai.wsIndex)[ai.binIndex] += weight * inputWeight;
+    addToBin(ai.wsIndex, ai.binIndex, signal * weight, variance * weight, weight * inputWeight);
+  }
+}
+
+/**
+ * Rebin the input quadrilateral to the output grid
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The indexiin the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param outputWS A pointer to the output workspace that accumulates the data
+ *        Note that the error array of the output workspace contains the
+ *        **variance** and not the errors (standard deviations).
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ * @param inputRB A pointer, of RebinnedOutput type, to the input workspace.
+ * It is used to take into account the input area fractions when calcuting
+ * the final output fractions.
+ * This can be null to indicate that the input was a standard 2D workspace.
+ */
+void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                             const size_t j, RebinnedOutput &outputWS, const std::vector<double> &verticalAxis,
+                             const RebinnedOutput_const_sptr &inputRB) {
+  rebinQuadrilateralFractional(inputQ, *inputWS, i, j, outputWS.x(0).rawData(), verticalAxis, inputRB,
+                               [&outputWS](const size_t wsIndex, const size_t binIndex, const double signal,
+                                           const double variance, const double fraction) {
+                                 PARALLEL_CRITICAL(overlap) {
+                                   // The mutable calls must be in the critical section
+                                   // so that any calls from omp sections can write to the
+                                   // output workspace safely
+                                   outputWS.mutableY(wsIndex)[binIndex] += signal;
+                                   outputWS.mutableE(wsIndex)[binIndex] += variance;
+                                   outputWS.dataF(wsIndex)[binIndex] += fraction;
+                                 }
+                               });
+}
+
+/**
+ * Rebin the input quadrilateral to a partial output of the grid, which is
+ * owned by the calling thread so that no locking is needed.
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The index in the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param partial The partial output that accumulates the data. Like the
+ *        output workspace, it holds the **variance** and not the errors.
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ * @param inputRB A pointer, of RebinnedOutput type, to the input workspace,
+ * or null if the input was a standard 2D workspace.
+ */
+void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                             const size_t j, PartialOutput &partial, const std::vector<double> &verticalAxis,
+                             const RebinnedOutput_const_sptr &inputRB) {
+  rebinQuadrilateralFractional(inputQ, *inputWS, i, j, partial.xAxis(), verticalAxis, inputRB,
+                               [&partial](const size_t wsIndex, const size_t binIndex, const double signal,
+                                          const double variance, const double fraction) {
+                                 partial.add(wsIndex, binIndex, signal, variance, fraction);
+                               });
+}
+
+/**
+ * Create an empty partial output of the grid of an output workspace
+ * @param outputWS The output workspace, which must have common bin edges
+ */
+PartialOutput::PartialOutput(const MatrixWorkspace &outputWS)
+    : m_xAxis(outputWS.x(0).rawData()), m_nBins(outputWS.blocksize()),
+      m_tilesPerSpectrum((m_nBins + TILE_SIZE - 1) / TILE_SIZE),
+      m_tiles(outputWS.getNumberHistograms() * m_tilesPerSpectrum) {}
+
+/**
+ * Add a contribution to a bin of the output grid
+ * @param wsIndex The spectrum index of the output bin
+ * @param binIndex The index of the output bin in the spectrum
+ * @param signal The signal to add
+ * @param variance The variance to add
+ * @param fraction The fractional area to add, ignored unless the output is a
+ * RebinnedOutput workspace
+ */
+void PartialOutput::add(const size_t wsIndex, const size_t binIndex, const double signal, const double variance,
+                        const double fraction) {
+  auto &tile = m_tiles[wsIndex * m_tilesPerSpectrum + binIndex / TILE_SIZE];
+  if (tile.empty()) {
+    tile.resize(3 * TILE_SIZE, 0.);
+  }
+  const size_t offset = 3 * (binIndex % TILE_SIZE);
+  tile[offset] += signal;
+  tile[offset + 1] += variance;
+  tile[offset + 2] += fraction;
+}
+
+/**
+ * Add the contributions to one spectrum of the output workspace
+ * @param outputWS The output workspace the partial output was created for
+ * @param wsIndex The spectrum index
+ */
+void PartialOutput::addTo(MatrixWorkspace &outputWS, const size_t wsIndex) const {
+  auto *outputRB = dynamic_cast<RebinnedOutput *>(&outputWS);
+  for (size_t tileIndex = 0; tileIndex < m_tilesPerSpectrum; ++tileIndex) {
+    const auto &tile = m_tiles[wsIndex * m_tilesPerSpectrum + tileIndex];
+    if (tile.empty()) {
+      continue;
+    }
+    auto &outputY = outputWS.mutableY(wsIndex);
+    auto &outputE = outputWS.mutableE(wsIndex);
+    const size_t binStart = tileIndex * TILE_SIZE;
+    const size_t binEnd = std::min(binStart + TILE_SIZE, m_nBins);
+    for (size_t binIndex = binStart; binIndex < binEnd; ++binIndex) {
+      const size_t offset = 3 * (binIndex - binStart);
+      outputY[binIndex] += tile[offset];
+      outputE[binIndex] += tile[offset + 1];
+    }
+    if (outputRB) {
+      auto &outputF = outputRB->dataF(wsIndex);
+      for (size_t binIndex = binStart; binIndex < binEnd; ++binIndex) {
+        outputF[binIndex] += tile[3 * (binIndex - binStart) + 2];
+      }
+    }
+  }
+}
+
+/**
+ * Create a partial output for each thread that a PARALLEL_FOR_IF loop may
+ * run on. The loop should add to the partial output of PARALLEL_THREAD_NUMBER.
+ * @param outputWS The output workspace of the rebinning
+ * @return One empty partial output per thread
+ */
+std::vector<PartialOutput> createPartialOutputs(const MatrixWorkspace &outputWS) {
+  auto nThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  // PARALLEL_FOR_IF sets the number of threads to MultiThreaded.MaxCores
+  const auto maxCores = ConfigService::Instance().getValue<int>("MultiThreaded.MaxCores");
+  if (maxCores.get_value_or(0) > 0) {
+    nThreads = std::max(nThreads, static_cast<size_t>(maxCores.get()));
+  }
+  return std::vector<PartialOutput>(nThreads, PartialOutput(outputWS));
+}
+
+/**
+ * Add partial outputs to the output workspace. The contributions to each
+ * bin are summed in the order of the partial outputs. Which input spectra a
+ * partial output holds depends on the number of threads and on how the loop
+ * shared the spectra out between them, so the sums may differ in their last
+ * bits from one number of threads to another.
+ * @param partials The partial outputs of the threads of a rebinning loop
+ * @param outputWS The output workspace the partial outputs were created for
+ */
+void addPartialOutputs(const std::vector<PartialOutput> &partials, MatrixWorkspace &outputWS) {
+  PARALLEL_FOR_IF(Kernel::threadSafe(outputWS))
+  for (int64_t wsIndex = 0; wsIndex < static_cast<int64_t>(outputWS.getNumberHistograms()); ++wsIndex) {
+    for (const auto &partial : partials) {
+      partial.addTo(outputWS, static_cast<size_t>(wsIndex));
     }
   }
 }
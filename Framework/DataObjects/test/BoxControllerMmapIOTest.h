@@ -0,0 +1,200 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/BoxControllerMmapIO.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <Poco/File.h>
+
+#include <thread>
+
+using Mantid::DataObjects::BoxControllerMmapIO;
+
+class BoxControllerMmapIOTest : public CxxTest::TestSuite {
+public:
+  static BoxControllerMmapIOTest *createSuite() { return new BoxControllerMmapIOTest(); }
+  static void destroySuite(BoxControllerMmapIOTest *suite) { delete suite; }
+
+  Mantid::API::BoxController_sptr bc;
+  std::string fileName;
+
+  BoxControllerMmapIOTest() {
+    bc = std::make_shared<Mantid::API::BoxController>(4);
+    fileName = "BoxCntrlMmapIOFile.events";
+  }
+
+  void tearDown() override {
+    Poco::File file(fileName);
+    if (file.exists())
+      file.remove();
+  }
+
+  void test_data_type() {
+    BoxControllerMmapIO io(bc.get());
+    size_t coordSize;
+    std::string typeName;
+    io.getDataType(coordSize, typeName);
+    TS_ASSERT_EQUALS(coordSize, 4);
+    TS_ASSERT_EQUALS(typeName, "MDEvent");
+    TS_ASSERT_EQUALS(io.getNDataColumns(), 9);
+
+    TS_ASSERT_THROWS(io.setDataType(9, "MDEvent"), const std::invalid_argument &);
+    TS_ASSERT_THROWS(io.setDataType(4, "UnknownEvent"), const std::invalid_argument &);
+    TS_ASSERT_THROWS_NOTHING(io.setDataType(8, "MDLeanEvent"));
+    io.getDataType(coordSize, typeName);
+    TS_ASSERT_EQUALS(coordSize, 8);
+    TS_ASSERT_EQUALS(typeName, "MDLeanEvent");
+    TS_ASSERT_EQUALS(io.getNDataColumns(), 6);
+  }
+
+  void test_save_and_load_blocks() {
+    BoxControllerMmapIO io(bc.get());
+    io.setDataType(4, "MDLeanEvent");
+    TS_ASSERT(io.openFile(fileName, "w"));
+    TS_ASSERT(io.isOpened());
+    TS_ASSERT(!io.openFile(fileName, "w"));
+
+    const std::vector<float> second{7, 8, 9, 10, 11, 12};
+    const std::vector<float> first{1, 2, 3, 4, 5, 6};
+    io.saveBlock(second, 1);
+    io.saveBlock(first, 0);
+
+    TS_ASSERT_EQUALS(io.getFileLength(), 2);
+
+    std::vector<float> loaded;
+    io.loadBlock(loaded, 1, 1);
+    TS_ASSERT_EQUALS(loaded, second);
+    std::vector<double> loadedAsDouble;
+    io.loadBlock(loadedAsDouble, 0, 2);
+    TS_ASSERT_EQUALS(loadedAsDouble.size(), 12);
+    TS_ASSERT_EQUALS(loadedAsDouble[0], 1.0);
+    TS_ASSERT_EQUALS(loadedAsDouble[11], 12.0);
+  }
+
+  void test_file_is_cut_to_the_data_and_kept_when_asked_or_read_only() {
+    {
+      BoxControllerMmapIO io(bc.get());
+      io.setDataType(8, "MDLeanEvent");
+      io.setKeepOnClose(true);
+      io.openFile(fileName, "w");
+      io.saveBlock(std::vector<double>{1, 2, 3, 4, 5, 6}, 2);
+    }
+    TS_ASSERT_EQUALS(Poco::File(fileName).getSize(), 3 * 6 * sizeof(double));
+
+    BoxControllerMmapIO io(bc.get());
+    io.setDataType(8, "MDLeanEvent");
+    io.openFile(fileName, "r");
+    TS_ASSERT_EQUALS(io.getFileLength(), 3);
+    std::vector<double> loaded;
+    io.loadBlock(loaded, 2, 1);
+    TS_ASSERT_EQUALS(loaded, std::vector<double>({1, 2, 3, 4, 5, 6}));
+    TS_ASSERT_THROWS(io.loadBlock(loaded, 3, 1), const std::invalid_argument &);
+    TS_ASSERT_THROWS(io.saveBlock(loaded, 0), const std::runtime_error &);
+    io.closeFile();
+    TS_ASSERT(Poco::File(fileName).exists());
+    TS_ASSERT_EQUALS(Poco::File(fileName).getSize(), 3 * 6 * sizeof(double));
+  }
+
+  void test_created_file_is_removed_on_close() {
+    BoxControllerMmapIO io(bc.get());
+    io.setDataType(4, "MDLeanEvent");
+    io.openFile(fileName, "w");
+    io.saveBlock(std::vector<float>{1, 2, 3, 4, 5, 6}, 0);
+    TS_ASSERT(Poco::File(fileName).exists());
+    io.closeFile();
+    TS_ASSERT(!Poco::File(fileName).exists());
+  }
+
+  void test_existing_file_opened_for_writing_is_kept_on_close() {
+    {
+      BoxControllerMmapIO io(bc.get());
+      io.setDataType(4, "MDLeanEvent");
+      io.setKeepOnClose(true);
+      io.openFile(fileName, "w");
+      io.saveBlock(std::vector<float>{1, 2, 3, 4, 5, 6}, 0);
+    }
+    {
+      BoxControllerMmapIO io(bc.get());
+      io.setDataType(4, "MDLeanEvent");
+      io.openFile(fileName, "w");
+      io.saveBlock(std::vector<float>{7, 8, 9, 10, 11, 12}, 1);
+    }
+    TS_ASSERT(Poco::File(fileName).exists());
+    BoxControllerMmapIO io(bc.get());
+    io.setDataType(4, "MDLeanEvent");
+    io.openFile(fileName, "r");
+    std::vector<float> loaded;
+    io.loadBlock(loaded, 0, 2);
+    TS_ASSERT_EQUALS(loaded, std::vector<float>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}));
+  }
+
+  void test_blocks_never_saved_are_read_from_the_source() {
+    const std::string scratchName("BoxCntrlMmapIOScratch.events");
+    {
+      BoxControllerMmapIO io(bc.get());
+      io.setDataType(4, "MDLeanEvent");
+      io.setKeepOnClose(true);
+      io.openFile(fileName, "w");
+      io.saveBlock(std::vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}, 0);
+    }
+    auto source = std::make_shared<BoxControllerMmapIO>(bc.get());
+    source->setDataType(4, "MDLeanEvent");
+    source->openFile(fileName, "r");
+
+    BoxControllerMmapIO io(bc.get());
+    io.setDataType(4, "MDLeanEvent");
+    io.openFile(scratchName, "w");
+    io.setSourceFile(source);
+    // new blocks go after the events of the source
+    TS_ASSERT_EQUALS(io.getFileLength(), 2);
+
+    std::vector<float> loaded;
+    io.loadBlock(loaded, 0, 2);
+    TS_ASSERT_EQUALS(loaded, std::vector<float>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}));
+
+    io.saveBlock(std::vector<float>{13, 14, 15, 16, 17, 18}, 1);
+    io.loadBlock(loaded, 1, 1);
+    TS_ASSERT_EQUALS(loaded, std::vector<float>({13, 14, 15, 16, 17, 18}));
+    io.loadBlock(loaded, 0, 1);
+    TS_ASSERT_EQUALS(loaded, std::vector<float>({1, 2, 3, 4, 5, 6}));
+
+    // the source is only read
+    source->loadBlock(loaded, 1, 1);
+    TS_ASSERT_EQUALS(loaded, std::vector<float>({7, 8, 9, 10, 11, 12}));
+    io.closeFile();
+    TS_ASSERT(!Poco::File(scratchName).exists());
+  }
+
+  void test_concurrent_saves() {
+    BoxControllerMmapIO io(bc.get());
+    io.setDataType(4, "MDLeanEvent");
+    io.openFile(fileName, "w");
+    const size_t nBlocks = 64;
+    const size_t eventsPerBlock = 1000;
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < 4; ++thread) {
+      threads.emplace_back([&io, thread] {
+        for (size_t block = thread; block < nBlocks; block += 4) {
+          std::vector<float> values(eventsPerBlock * 6, static_cast<float>(block));
+          io.saveBlock(values, block * eventsPerBlock);
+        }
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+
+    std::vector<float> loaded;
+    for (size_t block = 0; block < nBlocks; ++block) {
+      io.loadBlock(loaded, block * eventsPerBlock, eventsPerBlock);
+      TS_ASSERT_EQUALS(loaded.front(), static_cast<float>(block));
+      TS_ASSERT_EQUALS(loaded.back(), static_cast<float>(block));
+    }
+  }
+};
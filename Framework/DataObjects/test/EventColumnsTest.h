@@ -0,0 +1,117 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventColumns.h"
+
+using namespace Mantid::DataObjects;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class EventColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventColumnsTest *createSuite() { return new EventColumnsTest(); }
+  static void destroySuite(EventColumnsTest *suite) { delete suite; }
+
+  void test_assign_and_copy_tof_events() {
+    std::vector<TofEvent> events{TofEvent(300, 2), TofEvent(100, 1), TofEvent(200, 3)};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT_EQUALS(columns.size(), 3);
+    TS_ASSERT(columns.hasPulseTimes());
+    TS_ASSERT(!columns.hasWeights());
+    TS_ASSERT(columns.weights().empty());
+    TS_ASSERT_EQUALS(columns.tofs()[1], 100);
+
+    std::vector<TofEvent> copied;
+    columns.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_assign_and_copy_weighted_events() {
+    std::vector<WeightedEvent> events{WeightedEvent(300, 2, 2.0, 4.0), WeightedEvent(100, 1, 3.0, 9.0)};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT(columns.hasPulseTimes());
+    TS_ASSERT(columns.hasWeights());
+
+    std::vector<WeightedEvent> copied;
+    columns.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_assign_and_copy_weighted_events_no_time() {
+    std::vector<WeightedEventNoTime> events{WeightedEventNoTime(300, 2.0, 4.0), WeightedEventNoTime(100, 3.0, 9.0)};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT(!columns.hasPulseTimes());
+    TS_ASSERT(columns.pulseTimes().empty());
+
+    std::vector<WeightedEventNoTime> copied;
+    columns.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_addWeights_and_removePulseTimes() {
+    EventColumns columns;
+    columns.assign(std::vector<TofEvent>{TofEvent(300, 2), TofEvent(100, 1)});
+    columns.addWeights();
+    TS_ASSERT(columns.hasWeights());
+    TS_ASSERT_EQUALS(columns.weights(), std::vector<float>(2, 1.0f));
+    TS_ASSERT_EQUALS(columns.errorSquareds(), std::vector<float>(2, 1.0f));
+
+    columns.removePulseTimes();
+    TS_ASSERT(!columns.hasPulseTimes());
+    std::vector<WeightedEventNoTime> copied;
+    columns.copyTo(copied);
+    TS_ASSERT_EQUALS(copied[0], WeightedEventNoTime(300, 1.0, 1.0));
+  }
+
+  void test_sortByTof_keeps_columns_together() {
+    EventColumns columns;
+    columns.assign(std::vector<WeightedEvent>{WeightedEvent(300, 3, 3.0, 9.0), WeightedEvent(100, 1, 1.0, 1.0),
+                                              WeightedEvent(200, 2, 2.0, 4.0)});
+    columns.sortByTof();
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({100, 200, 300}));
+    TS_ASSERT_EQUALS(columns.pulseTimes()[0], DateAndTime(1));
+    TS_ASSERT_EQUALS(columns.pulseTimes()[2], DateAndTime(3));
+    TS_ASSERT_EQUALS(columns.weights(), std::vector<float>({1.0f, 2.0f, 3.0f}));
+    TS_ASSERT_EQUALS(columns.errorSquareds(), std::vector<float>({1.0f, 4.0f, 9.0f}));
+  }
+
+  void test_reverse() {
+    EventColumns columns;
+    columns.assign(std::vector<TofEvent>{TofEvent(100, 1), TofEvent(200, 2)});
+    columns.reverse();
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({200, 100}));
+    TS_ASSERT_EQUALS(columns.pulseTimes()[0], DateAndTime(2));
+  }
+
+  void test_removeIf() {
+    EventColumns columns;
+    columns.assign(std::vector<WeightedEvent>{WeightedEvent(100, 1, 1.0, 1.0), WeightedEvent(200, 2, 2.0, 4.0),
+                                              WeightedEvent(300, 3, 3.0, 9.0)});
+    columns.removeIf({false, true, false});
+    TS_ASSERT_EQUALS(columns.size(), 2);
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({100, 300}));
+    TS_ASSERT_EQUALS(columns.pulseTimes()[1], DateAndTime(3));
+    TS_ASSERT_EQUALS(columns.weights(), std::vector<float>({1.0f, 3.0f}));
+  }
+
+  void test_clear_keeps_columns_in_use() {
+    EventColumns columns;
+    columns.assign(std::vector<WeightedEventNoTime>{WeightedEventNoTime(100, 1.0, 1.0)});
+    columns.clear();
+    TS_ASSERT(columns.empty());
+    TS_ASSERT(columns.hasWeights());
+    TS_ASSERT(!columns.hasPulseTimes());
+  }
+};
@@ -18,6 +18,7 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <cmath>
+#include <thread>
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -1203,6 +1204,211 @@ public:
     TS_ASSERT_EQUALS(this->el.ptrX()->size(), NUMBINS + 1);
   }
 
+  void test_histogram_unsorted_with_linear_and_log_bins_does_not_sort() {
+    MantidVec linearX, logX, irregularX;
+    for (double tof = 0; tof < MAX_TOF; tof += 3.5 * BIN_DELTA)
+      linearX.emplace_back(tof);
+    linearX.emplace_back(MAX_TOF);
+    for (double tof = 100; tof < MAX_TOF; tof *= 1.01)
+      logX.emplace_back(tof);
+    logX.emplace_back(MAX_TOF);
+    irregularX = {0, 100, 150, 1e5, 1e6, 5e6};
+
+    for (int this_type = 0; this_type < 3; this_type++) {
+      for (const MantidVec *binning : {&linearX, &logX, &irregularX}) {
+        const MantidVec &X = *binning;
+        EventList unsorted = this->fake_data();
+        unsorted.switchTo(static_cast<EventType>(this_type));
+        EventList sorted(unsorted);
+        sorted.sortTof();
+
+        MantidVec Y, E, sortedY, sortedE;
+        unsorted.generateHistogram(X, Y, E);
+        sorted.generateHistogram(X, sortedY, sortedE);
+        TS_ASSERT_EQUALS(Y.size(), X.size() - 1);
+        TS_ASSERT_EQUALS(E.size(), X.size() - 1);
+        for (size_t i = 0; i < Y.size(); ++i) {
+          TS_ASSERT_DELTA(Y[i], sortedY[i], 1e-6);
+          TS_ASSERT_DELTA(E[i], sortedE[i], 1e-6);
+        }
+        // Only the irregular binning needs the events to be sorted
+        const auto expectedOrder = (binning == &irregularX) ? TOF_SORT : UNSORTED;
+        TS_ASSERT_EQUALS(unsorted.getSortType(), expectedOrder);
+      }
+    }
+  }
+
+  void test_column_storage_matches_row_storage() {
+    MantidVec X{0, 1e5, 3e5, 1e6, 5e6, MAX_TOF};
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventList rows = this->fake_data();
+      rows.switchTo(static_cast<EventType>(this_type));
+      EventList columns(rows);
+      columns.switchTo(EventStorage::Columns);
+      TS_ASSERT_EQUALS(columns.getStorage(), EventStorage::Columns);
+      TS_ASSERT_EQUALS(columns.getEventType(), rows.getEventType());
+      TS_ASSERT_EQUALS(columns.getNumberEvents(), rows.getNumberEvents());
+
+      rows.convertTof(2.0, 10.0);
+      columns.convertTof(2.0, 10.0);
+      rows.maskTof(2e6, 4e6);
+      columns.maskTof(2e6, 4e6);
+      TS_ASSERT_EQUALS(columns.getNumberEvents(), rows.getNumberEvents());
+      TS_ASSERT_DELTA(columns.integrate(0, MAX_TOF, false), rows.integrate(0, MAX_TOF, false), 1e-6);
+
+      MantidVec Y, E, rowY, rowE;
+      columns.generateHistogram(X, Y, E);
+      rows.generateHistogram(X, rowY, rowE);
+      for (size_t i = 0; i < Y.size(); ++i) {
+        TS_ASSERT_DELTA(Y[i], rowY[i], 1e-6);
+        TS_ASSERT_DELTA(E[i], rowE[i], 1e-6);
+      }
+      TS_ASSERT_EQUALS(columns.getStorage(), EventStorage::Columns);
+
+      // Asking for a single event goes back to rows
+      rows.sortTof();
+      columns.sortTof();
+      TS_ASSERT_EQUALS(columns.getEvent(0).tof(), rows.getEvent(0).tof());
+      TS_ASSERT_EQUALS(columns.getStorage(), EventStorage::Rows);
+      TS_ASSERT_EQUALS(columns.getTofs(), rows.getTofs());
+    }
+  }
+
+  void test_const_column_storage_goes_back_to_rows_from_several_threads() {
+    // Linear bins, so neither storage sorts the events
+    MantidVec X{0, 2.5e6, 5e6, 7.5e6, MAX_TOF};
+    const EventList rows = this->fake_data();
+    MantidVec rowY, rowE;
+    rows.generateHistogram(X, rowY, rowE);
+    EventList columns(rows);
+    columns.switchTo(EventStorage::Columns);
+    const EventList &constColumns = columns;
+
+    // Some threads histogram the columns while others expand them to rows
+    std::vector<MantidVec> Y(8);
+    std::vector<size_t> numEvents(8, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < Y.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        if (i % 2 == 0) {
+          MantidVec E;
+          constColumns.generateHistogram(X, Y[i], E);
+        } else {
+          numEvents[i] = constColumns.getEvents().size();
+        }
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    TS_ASSERT_EQUALS(columns.getStorage(), EventStorage::Rows);
+    for (size_t i = 0; i < Y.size(); ++i) {
+      if (i % 2 == 0) {
+        TS_ASSERT_EQUALS(Y[i], rowY);
+      } else {
+        TS_ASSERT_EQUALS(numEvents[i], rows.getNumberEvents());
+      }
+    }
+  }
+
+  void test_setTofs_throws_on_size_mismatch() {
+    EventList rows = this->fake_data();
+    EventList columns(rows);
+    columns.switchTo(EventStorage::Columns);
+    const MantidVec tofs(rows.getNumberEvents() + 1, 1.0);
+    TS_ASSERT_THROWS(rows.setTofs(tofs), const std::invalid_argument &);
+    TS_ASSERT_THROWS(columns.setTofs(tofs), const std::invalid_argument &);
+    TS_ASSERT_EQUALS(columns.getTofs(), rows.getTofs());
+  }
+
+  void test_compact_storage() {
+    auto pulseTimes = std::make_shared<std::vector<DateAndTime>>();
+    for (int64_t i = 0; i < 1000; ++i)
+      pulseTimes->emplace_back(i);
+    EventList original = this->fake_data();
+    EventList compact(original);
+
+    // A table is needed to go to compact storage
+    TS_ASSERT_THROWS(compact.switchTo(EventStorage::Compact), const std::runtime_error &);
+    compact.setPulseTimeTable(pulseTimes);
+    compact.switchTo(EventStorage::Compact);
+    TS_ASSERT_EQUALS(compact.getStorage(), EventStorage::Compact);
+    TS_ASSERT_EQUALS(compact.getEventType(), TOF);
+    TS_ASSERT_EQUALS(compact.getNumberEvents(), original.getNumberEvents());
+    TS_ASSERT_LESS_THAN(compact.getMemorySize(), original.getMemorySize());
+    TS_ASSERT_EQUALS(compact.getPulseTimes(), original.getPulseTimes());
+    const auto tofs = compact.getTofs();
+    const auto originalTofs = original.getTofs();
+    for (size_t i = 0; i < tofs.size(); ++i)
+      TS_ASSERT_DELTA(tofs[i], originalTofs[i], 1.0);
+
+    // Histogramming and masking do not expand the events
+    EventList rows(compact);
+    rows.switchTo(EventStorage::Rows);
+    TS_ASSERT_EQUALS(rows.getTofs(), tofs);
+    MantidVec X{0, 1e5, 3e5, 1e6, 5e6, MAX_TOF};
+    MantidVec Y, E, rowY, rowE;
+    compact.maskTof(2e6, 4e6);
+    rows.maskTof(2e6, 4e6);
+    compact.generateHistogram(X, Y, E);
+    rows.generateHistogram(X, rowY, rowE);
+    TS_ASSERT_EQUALS(Y, rowY);
+    TS_ASSERT_EQUALS(E, rowE);
+    TS_ASSERT_EQUALS(compact.integrate(0, 1e6, false), rows.integrate(0, 1e6, false));
+    TS_ASSERT_EQUALS(compact.getStorage(), EventStorage::Compact);
+
+    // Asking for the events expands them again
+    rows.sortTof();
+    compact.sortTof();
+    TS_ASSERT_EQUALS(compact.getEvents(), rows.getEvents());
+    TS_ASSERT_EQUALS(compact.getStorage(), EventStorage::Rows);
+
+    // Weights cannot be stored
+    compact.switchTo(WEIGHTED);
+    TS_ASSERT_THROWS(compact.switchTo(EventStorage::Compact), const std::runtime_error &);
+  }
+
+  void test_const_compact_storage_goes_back_to_rows_from_several_threads() {
+    auto pulseTimes = std::make_shared<std::vector<DateAndTime>>();
+    for (int64_t i = 0; i < 1000; ++i)
+      pulseTimes->emplace_back(i);
+    EventList compact = this->fake_data();
+    compact.setPulseTimeTable(pulseTimes);
+    compact.switchTo(EventStorage::Compact);
+    EventList rows(compact);
+    rows.switchTo(EventStorage::Rows);
+    const EventList &constCompact = compact;
+
+    // Some threads integrate the compact events while others expand them
+    std::vector<double> sums(8, 0.0);
+    std::vector<std::vector<TofEvent>> expanded(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < sums.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        if (i % 2 == 0)
+          sums[i] = constCompact.integrate(0, 0, true);
+        else
+          expanded[i] = constCompact.getEvents();
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    TS_ASSERT_EQUALS(compact.getStorage(), EventStorage::Rows);
+    for (size_t i = 0; i < sums.size(); ++i) {
+      if (i % 2 == 0) {
+        TS_ASSERT_EQUALS(sums[i], static_cast<double>(rows.getNumberEvents()));
+      } else {
+        TS_ASSERT_EQUALS(expanded[i], rows.getEvents());
+      }
+    }
+  }
+
+  void test_compact_storage_needs_pulse_times_in_table() {
+    EventList el = this->fake_data();
+    el.setPulseTimeTable(std::make_shared<std::vector<DateAndTime>>(1, DateAndTime(5000)));
+    TS_ASSERT_THROWS(el.switchTo(EventStorage::Compact), const std::runtime_error &);
+    TS_ASSERT_EQUALS(el.getStorage(), EventStorage::Rows);
+  }
+
   //  void test_histogram_static_function()
   //  {
   //    std::vector<WeightedEvent> events;
@@ -1459,6 +1665,25 @@ public:
     }
   }
 
+  void test_convertUnitsViaTof_matches_single_conversions() {
+    Units::TOF fromUnit;
+    Units::dSpacing toUnit;
+    const UnitParametersMap params{{UnitParams::l2, 2.0}, {UnitParams::twoTheta, 1.2}};
+    fromUnit.initialize(10.0, 0, params);
+    toUnit.initialize(10.0, 0, params);
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      const auto tofs = el.getTofs();
+      // More events than fit in one of the blocks converted at a time
+      TS_ASSERT_LESS_THAN(1024, tofs.size());
+      el.convertUnitsViaTof(&fromUnit, &toUnit);
+      const auto dSpacings = el.getTofs();
+      for (size_t i = 0; i < tofs.size(); ++i)
+        TSM_ASSERT_EQUALS(this_type, dSpacings[i], toUnit.singleFromTOF(fromUnit.singleToTOF(tofs[i])));
+    }
+  }
+
   void test_addPulseTime_allTypes() {
     // Go through each possible EventType as the input
     for (int this_type = 0; this_type < 3; this_type++) {
@@ -1882,6 +2107,80 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** Split with fewer splitters than events: each output is allocated once for
+   * all its events and the groups need not be contiguous
+   */
+  void test_splitByFullTimeSparseVectorSplitter() {
+    EventList events;
+    for (int64_t i = 0; i < 100; ++i)
+      events.addEventQuickly(TofEvent(0.0, DateAndTime(i * 1000)));
+
+    std::map<int, EventList *> outputs;
+    for (const int group : {-1, 3, 7})
+      outputs.emplace(group, new EventList());
+
+    const std::vector<int64_t> vec_splitTimes{0, 30000, 60000, 90000};
+    const std::vector<int> vec_splitGroup{3, 7, 3};
+    events.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup, outputs, false, 1.0, 0.0);
+
+    TS_ASSERT_EQUALS(outputs[3]->getNumberEvents(), 60);
+    TS_ASSERT_EQUALS(outputs[3]->getEvents().capacity(), 60);
+    TS_ASSERT_EQUALS(outputs[7]->getNumberEvents(), 30);
+    // events after the last splitter are not kept
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(outputs[7]->getEvent(0).pulseTime(), DateAndTime(30000));
+    TS_ASSERT_EQUALS(outputs[3]->getEvent(30).pulseTime(), DateAndTime(60000));
+
+    // a group without an output event list
+    const std::vector<int> vec_badGroup{3, 5, 3};
+    TS_ASSERT_THROWS(
+        events.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_badGroup, outputs, false, 1.0, 0.0),
+        const std::runtime_error &);
+
+    for (auto &output : outputs) {
+      delete output.second;
+    }
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  /** One table of outputs, with targets that have no output, reused for two
+   * spectra as FilterEvents does
+   */
+  void test_splitByFullTimeMatrixSplitter_reusing_the_outputs() {
+    EventList first, second;
+    for (int64_t i = 0; i < 100; ++i) {
+      first.addEventQuickly(TofEvent(0.0, DateAndTime(i * 1000)));
+      if (i % 2 == 0)
+        second.addEventQuickly(TofEvent(0.0, DateAndTime(i * 1000)));
+    }
+
+    EventList unfiltered, three, seven;
+    EventListSplitOutputs outputs(std::map<int, EventList *>{{-1, &unfiltered}, {3, &three}, {7, &seven}});
+    TS_ASSERT_EQUALS(outputs.firstTarget, -1);
+    TS_ASSERT_EQUALS(outputs.lists.size(), 9);
+    TS_ASSERT(!outputs.find(0));
+    TS_ASSERT(!outputs.find(8));
+    TS_ASSERT_EQUALS(outputs.find(7), &seven);
+
+    const std::vector<int64_t> vec_splitTimes{0, 30000, 60000, 90000};
+    const std::vector<int> vec_splitGroup{3, 7, 3};
+    first.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup, outputs, false, 1.0, 0.0);
+    TS_ASSERT_EQUALS(three.getNumberEvents(), 60);
+    TS_ASSERT_EQUALS(seven.getNumberEvents(), 30);
+
+    // the outputs are emptied before the next spectrum is split
+    second.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup, outputs, false, 1.0, 0.0);
+    TS_ASSERT_EQUALS(three.getNumberEvents(), 30);
+    TS_ASSERT_EQUALS(seven.getNumberEvents(), 15);
+    TS_ASSERT_EQUALS(unfiltered.getNumberEvents(), 0);
+
+    // a target without an output in the middle of the table
+    const std::vector<int> vec_badGroup{3, 5, 3};
+    TS_ASSERT_THROWS(first.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_badGroup, outputs, false, 1.0, 0.0),
+                     const std::runtime_error &);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
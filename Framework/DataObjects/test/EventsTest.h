@@ -52,4 +52,18 @@ public:
     TS_ASSERT(!(notimeEvent1 == notimeEvent2));
     TS_ASSERT(notimeEvent1.equals(notimeEvent2, .1, .1));
   }
+
+  void test_CompactTofEvent() {
+    TS_ASSERT_EQUALS(sizeof(CompactTofEvent), 8);
+    CompactTofEvent event(20.5f, 42);
+    TS_ASSERT_EQUALS(event.tof(), 20.5);
+    TS_ASSERT_EQUALS(event.pulseIndex(), 42);
+    TS_ASSERT_EQUALS(event.weight(), 1.0);
+    TS_ASSERT_EQUALS(event.errorSquared(), 1.0);
+
+    TS_ASSERT(event == CompactTofEvent(20.5f, 42));
+    TS_ASSERT(!(event == CompactTofEvent(20.5f, 43)));
+    TS_ASSERT(event < CompactTofEvent(21.f, 0));
+    TS_ASSERT(event < 21.);
+  }
 };
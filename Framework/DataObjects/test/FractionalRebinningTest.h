@@ -0,0 +1,137 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/FractionalRebinning.h"
+#include "MantidDataObjects/RebinnedOutput.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+#include "MantidGeometry/Math/ConvexPolygon.h"
+#include "MantidGeometry/Math/PolygonIntersection.h"
+#include "MantidHistogramData/LinearGenerator.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid::DataObjects;
+using namespace Mantid::Geometry;
+using Mantid::API::MatrixWorkspace_const_sptr;
+using Mantid::HistogramData::BinEdges;
+using Mantid::HistogramData::LinearGenerator;
+using Mantid::Kernel::V2D;
+
+class FractionalRebinningTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FractionalRebinningTest *createSuite() { return new FractionalRebinningTest(); }
+  static void destroySuite(FractionalRebinningTest *suite) { delete suite; }
+
+  FractionalRebinningTest() : m_verticalAxis{0., 0.5, 1., 1.5, 2., 2.5, 3.} {}
+
+  void test_fractions_of_trapezoids_match_polygon_intersections() {
+    MatrixWorkspace_const_sptr inputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(1, 1);
+    // Parallel lower and upper edges, and parallel left and right edges
+    const std::vector<Quadrilateral> quads{
+        Quadrilateral(V2D(0.3, 0.2), V2D(3.4, 0.2), V2D(2.9, 2.7), V2D(0.8, 2.7)),
+        Quadrilateral(V2D(0.3, 0.2), V2D(2.4, 0.2), V2D(3.4, 2.7), V2D(1.3, 2.7)),
+        Quadrilateral(V2D(0.2, 0.3), V2D(3.7, 0.8), V2D(3.7, 2.9), V2D(0.2, 2.6)),
+        Quadrilateral(V2D(0.2, 0.3), V2D(3.7, 1.1), V2D(3.7, 2.9), V2D(0.2, 2.1))};
+    for (const auto &inputQ : quads) {
+      auto outputWS = createOutput();
+      FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, 0, 0, *outputWS, m_verticalAxis);
+      double total(0.);
+      for (size_t yi = 0; yi < outputWS->getNumberHistograms(); ++yi) {
+        for (size_t xi = 0; xi < outputWS->blocksize(); ++xi) {
+          const double fraction = outputWS->dataF(yi)[xi];
+          TS_ASSERT_DELTA(fraction, overlapFraction(inputQ, *outputWS, yi, xi), 1e-12);
+          TS_ASSERT_DELTA(outputWS->y(yi)[xi], 2. * fraction, 1e-12);
+          total += fraction;
+        }
+      }
+      TS_ASSERT_DELTA(total, 1., 1e-12);
+    }
+  }
+
+  void test_rebinToOutput_trapezoid_matches_polygon_intersections() {
+    MatrixWorkspace_const_sptr inputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(1, 1);
+    const Quadrilateral inputQ(V2D(0.2, 0.3), V2D(3.7, 0.8), V2D(3.7, 2.9), V2D(0.2, 2.6));
+    auto outputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(6, 8, 0., 0.5);
+    for (size_t yi = 0; yi < outputWS->getNumberHistograms(); ++yi) {
+      outputWS->mutableY(yi) = 0.;
+      outputWS->mutableE(yi) = 0.;
+    }
+    FractionalRebinning::rebinToOutput(inputQ, inputWS, 0, 0, *outputWS, m_verticalAxis);
+    for (size_t yi = 0; yi < outputWS->getNumberHistograms(); ++yi) {
+      for (size_t xi = 0; xi < outputWS->blocksize(); ++xi) {
+        const double fraction = overlapFraction(inputQ, *outputWS, yi, xi);
+        TS_ASSERT_DELTA(outputWS->y(yi)[xi], 2. * fraction, 1e-12);
+        TS_ASSERT_DELTA(outputWS->e(yi)[xi], 2. * fraction, 1e-12);
+      }
+    }
+  }
+
+  void test_rectangle_beyond_the_grid_only_adds_the_overlap() {
+    MatrixWorkspace_const_sptr inputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(1, 1);
+    auto outputWS = createOutput();
+    const Quadrilateral inputQ(-1., 1.5, 0.2, 0.7);
+    FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, 0, 0, *outputWS, m_verticalAxis);
+    for (size_t xi = 0; xi < 3; ++xi) {
+      TS_ASSERT_DELTA(outputWS->dataF(0)[xi] + outputWS->dataF(1)[xi], 0.2, 1e-12);
+    }
+    TS_ASSERT_EQUALS(outputWS->dataF(0)[3], 0.);
+  }
+
+  void test_partial_outputs_add_up_to_the_direct_rebinning() {
+    MatrixWorkspace_const_sptr inputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(1, 4, 0., 1.);
+    const std::vector<Quadrilateral> quads{
+        Quadrilateral(0.1, 1.3, 0.4, 2.2), Quadrilateral(V2D(0.3, 0.2), V2D(3.4, 0.2), V2D(2.9, 2.7), V2D(0.8, 2.7)),
+        Quadrilateral(V2D(0.2, 0.3), V2D(3.7, 0.8), V2D(3.7, 2.9), V2D(0.2, 2.6)),
+        Quadrilateral(V2D(0.2, 0.3), V2D(3.1, 0.6), V2D(3.7, 2.9), V2D(0.6, 2.6))};
+    auto directWS = createOutput();
+    auto partialWS = createOutput();
+    auto partials = FractionalRebinning::createPartialOutputs(*partialWS);
+    TS_ASSERT(!partials.empty());
+    std::vector<FractionalRebinning::PartialOutput> twoPartials(2, partials.front());
+    for (size_t j = 0; j < quads.size(); ++j) {
+      FractionalRebinning::rebinToFractionalOutput(quads[j], inputWS, 0, j, *directWS, m_verticalAxis);
+      FractionalRebinning::rebinToFractionalOutput(quads[j], inputWS, 0, j, twoPartials[j % 2], m_verticalAxis);
+    }
+    FractionalRebinning::addPartialOutputs(twoPartials, *partialWS);
+    for (size_t yi = 0; yi < directWS->getNumberHistograms(); ++yi) {
+      for (size_t xi = 0; xi < directWS->blocksize(); ++xi) {
+        TS_ASSERT_DELTA(partialWS->y(yi)[xi], directWS->y(yi)[xi], 1e-14);
+        TS_ASSERT_DELTA(partialWS->e(yi)[xi], directWS->e(yi)[xi], 1e-14);
+        TS_ASSERT_DELTA(partialWS->dataF(yi)[xi], directWS->dataF(yi)[xi], 1e-14);
+      }
+    }
+  }
+
+private:
+  /// An empty output of 8 x 6 bins of 0.5 x 0.5
+  RebinnedOutput_sptr createOutput() const {
+    auto outputWS = std::make_shared<RebinnedOutput>();
+    const size_t nBins(8);
+    outputWS->initialize(m_verticalAxis.size() - 1, nBins + 1, nBins);
+    const BinEdges edges(nBins + 1, LinearGenerator(0., 0.5));
+    for (size_t i = 0; i < outputWS->getNumberHistograms(); ++i) {
+      outputWS->setBinEdges(i, edges);
+    }
+    return outputWS;
+  }
+
+  /// The fraction of the quad that overlaps an output bin
+  double overlapFraction(const Quadrilateral &inputQ, const Mantid::API::MatrixWorkspace &outputWS, const size_t yi,
+                         const size_t xi) const {
+    const auto &X = outputWS.x(0);
+    const Quadrilateral bin(X[xi], X[xi + 1], m_verticalAxis[yi], m_verticalAxis[yi + 1]);
+    ConvexPolygon overlap;
+    if (!intersection(bin, inputQ, overlap))
+      return 0.;
+    return overlap.area() / inputQ.area();
+  }
+
+  const std::vector<double> m_verticalAxis;
+};
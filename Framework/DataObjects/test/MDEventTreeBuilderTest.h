@@ -0,0 +1,173 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDEventTreeBuilder.h"
+#include "MantidFrameworkTestHelpers/MDEventsTestHelper.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <map>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+
+class MDEventTreeBuilderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDEventTreeBuilderTest *createSuite() { return new MDEventTreeBuilderTest(); }
+  static void destroySuite(MDEventTreeBuilderTest *suite) { delete suite; }
+
+  void test_canBuildMDEventTree() {
+    BoxController bc(3);
+    bc.setSplitInto(4);
+    TS_ASSERT(canBuildMDEventTree(bc));
+    bc.setSplitInto(3);
+    TS_ASSERT(!canBuildMDEventTree(bc));
+    bc.setSplitInto(2);
+    bc.setSplitInto(1, 4);
+    TS_ASSERT(!canBuildMDEventTree(bc));
+  }
+
+  void test_rebuildMDEventTree_keeps_all_events() {
+    // 4x4x4 boxes with 3 events at the centre of each
+    auto ws = MDEventsTestHelper::makeMDEW<3>(4, 0.0, 16.0, 3);
+    ws->getBoxController()->setSplitThreshold(10);
+
+    rebuildMDEventTree(*ws, 2);
+    ws->refreshCache();
+
+    TS_ASSERT_EQUALS(ws->getNPoints(), 192);
+    TS_ASSERT_DELTA(ws->getBox()->getSignal(), 192.0, 1e-5);
+    TS_ASSERT(!ws->getBox()->isLeaf());
+
+    std::vector<IMDNode *> leaves;
+    ws->getBox()->getBoxes(leaves, 1000, true);
+    size_t nEvents = 0;
+    for (const auto *leaf : leaves) {
+      TS_ASSERT_LESS_THAN_EQUALS(leaf->getNPoints(), 10);
+      nEvents += leaf->getNPoints();
+    }
+    TS_ASSERT_EQUALS(nEvents, 192);
+  }
+
+  void test_small_workspace_stays_a_single_box() {
+    auto ws = MDEventsTestHelper::makeMDEW<2>(2, 0.0, 4.0, 1);
+    ws->getBoxController()->setSplitThreshold(100);
+
+    rebuildMDEventTree(*ws, 1);
+    ws->refreshCache();
+
+    TS_ASSERT(ws->getBox()->isLeaf());
+    TS_ASSERT_EQUALS(ws->getNPoints(), 4);
+    // the coordinates are not changed
+    const auto &events = dynamic_cast<MDBox<MDLeanEvent<2>, 2> *>(ws->getBox())->getConstEvents();
+    for (const auto &event : events) {
+      TS_ASSERT_EQUALS(std::fmod(event.getCenter(0), 2.0f), 1.0f);
+      TS_ASSERT_EQUALS(std::fmod(event.getCenter(1), 2.0f), 1.0f);
+    }
+  }
+
+  void test_rebuildMDEventTree_puts_events_on_box_boundaries_in_the_same_box_as_splitting() {
+    // one event at each point of a 16x16 grid lying on the box boundaries
+    auto rebuilt = makeGridOfEvents();
+    auto split = makeGridOfEvents();
+
+    rebuildMDEventTree(*rebuilt, 2);
+    rebuilt->refreshCache();
+    auto ts = new ThreadSchedulerFIFO();
+    ThreadPool tp(ts);
+    split->splitAllIfNeeded(ts);
+    tp.joinAll();
+    split->refreshCache();
+
+    TS_ASSERT_EQUALS(rebuilt->getNPoints(), 16 * 16);
+    const auto rebuiltBoxes = boxOfEachEvent(*rebuilt);
+    TS_ASSERT_EQUALS(rebuiltBoxes.size(), 16 * 16);
+    TS_ASSERT_EQUALS(rebuiltBoxes, boxOfEachEvent(*split));
+    for (const auto &eventAndBox : rebuiltBoxes) {
+      // an event on a boundary is in the box above it
+      const auto &event = eventAndBox.first;
+      const auto &box = eventAndBox.second;
+      TS_ASSERT_EQUALS(box[0], event[0]);
+      TS_ASSERT_EQUALS(box[2], event[1]);
+    }
+  }
+
+  void test_rebuildMDEventTree_moves_events_on_the_upper_limit_to_their_box() {
+    auto ws = makeGridOfEvents();
+    // MDGridBox::addEvent puts these in the top-level box above theirs
+    for (int y = 0; y < 8; ++y) {
+      const coord_t centers[2] = {16.f, static_cast<coord_t>(y)};
+      ws->addEvent(MDLeanEvent<2>(1.0, 1.0, centers));
+    }
+
+    rebuildMDEventTree(*ws, 2);
+    ws->refreshCache();
+
+    TS_ASSERT_EQUALS(ws->getNPoints(), 16 * 16 + 8);
+    const auto boxes = boxOfEachEvent(*ws);
+    for (int y = 0; y < 8; ++y) {
+      const auto &box = boxes.at({16.f, static_cast<coord_t>(y)});
+      TS_ASSERT_EQUALS(box[1], 16.f);
+      TS_ASSERT_EQUALS(box[2], static_cast<coord_t>(y));
+    }
+  }
+
+  void test_rebuildMDEventTree_gives_the_children_consecutive_ids() {
+    auto ws = makeGridOfEvents();
+    rebuildMDEventTree(*ws, 1);
+
+    std::vector<IMDNode *> boxes;
+    ws->getBox()->getBoxes(boxes, 1000, false);
+    TS_ASSERT_EQUALS(ws->getBoxController()->getMaxId(), boxes.size());
+    TS_ASSERT_EQUALS(ws->getBox()->getID(), 0);
+    for (auto *box : boxes) {
+      for (size_t i = 1; i < box->getNumChildren(); ++i)
+        TS_ASSERT_EQUALS(box->getChild(i)->getID(), box->getChild(0)->getID() + i);
+    }
+  }
+
+private:
+  /// A workspace over [0, 16]^2 split into 2x2 boxes, with an event at each
+  /// point of integer coordinates below 16
+  MDEventWorkspace<MDLeanEvent<2>, 2>::sptr makeGridOfEvents() {
+    auto ws = MDEventsTestHelper::makeMDEW<2>(2, 0.0, 16.0, 0);
+    auto bc = ws->getBoxController();
+    bc->setSplitThreshold(1);
+    bc->setMaxDepth(6);
+    ws->splitBox();
+    for (int x = 0; x < 16; ++x) {
+      for (int y = 0; y < 16; ++y) {
+        const coord_t centers[2] = {static_cast<coord_t>(x), static_cast<coord_t>(y)};
+        ws->addEvent(MDLeanEvent<2>(1.0, 1.0, centers));
+      }
+    }
+    return ws;
+  }
+
+  /// The extents (min, max along each dimension) of the box holding each
+  /// event, by event coordinates
+  std::map<std::array<coord_t, 2>, std::array<coord_t, 4>> boxOfEachEvent(MDEventWorkspace<MDLeanEvent<2>, 2> &ws) {
+    std::map<std::array<coord_t, 2>, std::array<coord_t, 4>> boxes;
+    std::vector<IMDNode *> leaves;
+    ws.getBox()->getBoxes(leaves, 1000, true);
+    for (auto *leaf : leaves) {
+      auto *box = dynamic_cast<MDBox<MDLeanEvent<2>, 2> *>(leaf);
+      const std::array<coord_t, 4> extents{box->getExtents(0).getMin(), box->getExtents(0).getMax(),
+                                           box->getExtents(1).getMin(), box->getExtents(1).getMax()};
+      for (const auto &event : box->getConstEvents())
+        boxes.emplace(std::array<coord_t, 2>{event.getCenter(0), event.getCenter(1)}, extents);
+    }
+    return boxes;
+  }
+};
@@ -0,0 +1,139 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/CoordTransformDistance.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDGridBox.h"
+#include "MantidDataObjects/MDLeanEvent.h"
+#include "MantidDataObjects/MDSphereIntegrator.h"
+#include "MantidFrameworkTestHelpers/MDEventsTestHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <array>
+#include <vector>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+class MDSphereIntegratorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDSphereIntegratorTest *createSuite() { return new MDSphereIntegratorTest(); }
+  static void destroySuite(MDSphereIntegratorTest *suite) { delete suite; }
+
+  void test_spheres_match_integrateSphere() {
+    auto *box = makeTree(10, 10);
+    checkSameAsIntegrateSphere(*box, {{4.5, 4.5, 0.5, 0.},
+                                      {5.0, 5.0, 1.0, 0.},
+                                      {1.5, 1.5, 1.95, 0.},
+                                      {-1.0, 0.5, 1.55, 0.},
+                                      {0.0, 0.5, 0.01, 0.},
+                                      {3.3, 7.1, 2.6, 0.},
+                                      {9.9, 9.9, 0.3, 0.},
+                                      {20.0, 20.0, 1.0, 0.},
+                                      {5.0, 5.0, 20.0, 0.}});
+    deleteBox(box);
+  }
+
+  void test_shells_match_integrateSphere() {
+    auto *box = makeTree(10, 10);
+    const std::vector<std::array<double, 4>> shells{
+        {4.5, 4.5, 2.0, 1.0}, {3.3, 7.1, 3.6, 2.6}, {0.2, 0.2, 4.0, 0.5}, {5.0, 5.0, 20.0, 4.0}};
+    checkSameAsIntegrateSphere(*box, shells, true);
+    checkSameAsIntegrateSphere(*box, shells, false);
+    deleteBox(box);
+  }
+
+  void test_uneven_split_matches_integrateSphere() {
+    auto *box = makeTree(3, 7);
+    checkSameAsIntegrateSphere(*box,
+                               {{4.5, 4.5, 0.9, 0.}, {1.5, 1.5, 1.95, 0.}, {6.2, 2.7, 3.1, 1.2}, {9.5, 0.5, 0.9, 0.}});
+    deleteBox(box);
+  }
+
+  void test_spheres_sharing_boxes_are_integrated_separately() {
+    auto *box = makeTree(10, 10);
+    // The same sphere several times, and overlapping spheres
+    checkSameAsIntegrateSphere(*box, {{4.5, 4.5, 1.5, 0.},
+                                      {4.5, 4.5, 1.5, 0.},
+                                      {4.6, 4.5, 1.5, 0.},
+                                      {4.5, 4.5, 2.5, 1.5},
+                                      {4.5, 4.5, 2.5, 1.5}});
+    deleteBox(box);
+  }
+
+  void test_top_box_that_is_not_split() {
+    auto *bc = new BoxController(2);
+    bc->setSplitThreshold(10000);
+    bc->setSplitInto(10);
+    auto *box = new MDBox<MDLeanEvent<2>, 2>(bc);
+    for (size_t d = 0; d < 2; d++)
+      box->setExtents(d, 0.0, 10.0);
+    box->calcVolume();
+    MDEventsTestHelper::feedMDBox<2>(box, 1, 40, 0.125f, 0.25f);
+    checkSameAsIntegrateSphere(*box, {{4.5, 4.5, 1.5, 0.}, {2.5, 2.5, 2.0, 1.0}});
+    delete box;
+    delete bc;
+  }
+
+  void test_no_spheres() {
+    auto *box = makeTree(10, 10);
+    MDSphereIntegrator<MDLeanEvent<2>, 2> integrator;
+    TS_ASSERT_THROWS_NOTHING(integrator.integrate(*box));
+    TS_ASSERT_EQUALS(integrator.size(), 0);
+    deleteBox(box);
+  }
+
+private:
+  /// A grid box of 10x10 with 1600 events, split again where it holds more
+  /// than 5 events
+  MDGridBox<MDLeanEvent<2>, 2> *makeTree(const size_t split0, const size_t split1) {
+    auto *box = MDEventsTestHelper::makeMDGridBox<2>(split0, split1);
+    MDEventsTestHelper::feedMDBox<2>(box, 1, 40, 0.125f, 0.25f);
+    box->splitAllIfNeeded(nullptr);
+    box->refreshCache(nullptr);
+    return box;
+  }
+
+  void deleteBox(MDBoxBase<MDLeanEvent<2>, 2> *box) {
+    BoxController *const bc = box->getBoxController();
+    delete box;
+    delete bc;
+  }
+
+  /// Integrate spheres of x, y, radius and inner radius together, and compare
+  /// them with MDBoxBase::integrateSphere
+  void checkSameAsIntegrateSphere(MDBoxBase<MDLeanEvent<2>, 2> &box,
+                                  const std::vector<std::array<double, 4>> &spheres,
+                                  const bool useOnePercentBackgroundCorrection = true) {
+    MDSphereIntegrator<MDLeanEvent<2>, 2> integrator;
+    for (const auto &sphere : spheres) {
+      const coord_t center[2] = {static_cast<coord_t>(sphere[0]), static_cast<coord_t>(sphere[1])};
+      integrator.addSphere(center, sphere[2], sphere[3], useOnePercentBackgroundCorrection);
+    }
+    integrator.integrate(box);
+    TS_ASSERT_EQUALS(integrator.size(), spheres.size());
+
+    for (size_t i = 0; i < spheres.size(); ++i) {
+      const auto &sphere = spheres[i];
+      bool dimensionsUsed[2] = {true, true};
+      coord_t center[2] = {static_cast<coord_t>(sphere[0]), static_cast<coord_t>(sphere[1])};
+      CoordTransformDistance distance(2, center, dimensionsUsed);
+      signal_t signal = 0;
+      signal_t errorSquared = 0;
+      box.integrateSphere(distance, static_cast<coord_t>(sphere[2] * sphere[2]), signal, errorSquared,
+                          static_cast<coord_t>(sphere[3] * sphere[3]), useOnePercentBackgroundCorrection);
+      TSM_ASSERT_DELTA("Sphere " + std::to_string(i), integrator.signal(i), signal, 1e-9);
+      TSM_ASSERT_DELTA("Sphere " + std::to_string(i), integrator.errorSquared(i), errorSquared, 1e-9);
+    }
+  }
+};
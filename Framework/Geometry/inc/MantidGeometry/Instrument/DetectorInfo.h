@@ -28,6 +28,8 @@ class SpectrumInfo;
 namespace Geometry {
 class IDetector;
 class Instrument;
+class ParameterLookup;
+class ParameterMap;
 
 /** Geometry::DetectorInfo is an intermediate step towards a DetectorInfo that
   is part of Instrument-2.0. The aim is to provide a nearly identical interface
@@ -123,6 +125,16 @@ private:
   std::shared_ptr<const Geometry::IDetector> getDetectorPtr(const size_t index) const;
   void clearPositionDependentParameters(const size_t index);
 
+  /// The DIFC, DIFA and TZERO lookups of a parameter map at one generation
+  struct DiffractometerLookups {
+    const ParameterMap *map;
+    size_t generation;
+    std::shared_ptr<const ParameterLookup> difc;
+    std::shared_ptr<const ParameterLookup> difa;
+    std::shared_ptr<const ParameterLookup> tzero;
+  };
+  std::shared_ptr<const DiffractometerLookups> diffractometerLookups(const ParameterMap &pmap) const;
+
   /// Pointer to the actual DetectorInfo object (non-wrapping part).
   std::unique_ptr<Beamline::DetectorInfo> m_detectorInfo;
 
@@ -132,6 +144,8 @@ private:
 
   mutable std::vector<std::shared_ptr<const Geometry::IDetector>> m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+  /// Lookups for diffractometerConstants, replaced when the map changes
+  mutable std::shared_ptr<const DiffractometerLookups> m_diffractometerLookups;
 };
 
 using DetectorInfoIt = DetectorInfoIterator<DetectorInfo>;
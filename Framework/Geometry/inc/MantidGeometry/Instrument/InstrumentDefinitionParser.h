@@ -77,6 +77,15 @@ public:
   /// creates a vtp filename from a given xml filename
   const std::string createVTPFileName();
 
+  /// creates the filename of the snapshot of the instrument
+  const std::string createSnapshotFileName();
+
+  /// Create the instrument from its snapshot, if there is one
+  std::shared_ptr<Instrument> loadSnapshot();
+
+  /// Write a snapshot of the instrument created by parseXML
+  void saveSnapshot();
+
 private:
   /// shared Constructor logic
   void initialise(const std::string &filename, const std::string &instName, const std::string &xmlText,
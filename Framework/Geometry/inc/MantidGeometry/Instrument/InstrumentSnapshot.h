@@ -0,0 +1,53 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+class Instrument;
+
+/** InstrumentSnapshot : writes an instrument created by the
+  InstrumentDefinitionParser to a binary file and creates it again from the
+  file, without parsing the instrument definition.
+
+  The snapshot holds the component tree with the relative positions and
+  rotations of the components, the XML of their shapes, the detector IDs and
+  monitors, the source and sample, the parameters of the instrument
+  definition held in the logfile cache, which become the defaults of the
+  ParameterMap of a workspace, and the other properties of the instrument.
+  The pixels of rectangular and grid detectors are created again from the
+  parameters of the detector.
+
+  Instruments with components of other types, with shapes that were not
+  created from XML or with a separate physical instrument are not supported.
+  The file starts with a version number of the format and the revision of
+  Mantid that wrote it. A snapshot written by a different version or revision
+  is rejected, so that the instrument is parsed again.
+*/
+class MANTID_GEOMETRY_DLL InstrumentSnapshot {
+public:
+  /// Version of the file format, increased whenever the format changes
+  static constexpr uint32_t VERSION = 1;
+
+  /// The revision of Mantid written in a snapshot and checked on load
+  static std::string revision();
+  /// Can a snapshot of the instrument be written
+  static bool isSupported(const Instrument &instrument);
+  /// Write a snapshot of a base instrument to a file
+  static void save(const Instrument &instrument, const std::string &filename);
+  /// Create an instrument from a snapshot
+  static std::shared_ptr<Instrument> load(const std::string &filename);
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -14,8 +14,13 @@
 
 #include "tbb/concurrent_unordered_map.h"
 
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 namespace Mantid {
@@ -27,6 +32,36 @@ class ComponentInfo;
 class DetectorInfo;
 class Instrument;
 
+/** @class ParameterLookup ParameterMap.h
+
+  The parameters of one name for every component of the instrument a
+  ParameterMap belongs to, indexed by component index, which is also the
+  detector index for detectors. Created by ParameterMap::lookup for loops over
+  many components, where get or getRecursive would search the map by
+  component and compare the names of its parameters every time.
+
+  A lookup is a snapshot of the map when it was created and is not updated if
+  parameters are added or removed later.
+*/
+class MANTID_GEOMETRY_DLL ParameterLookup {
+public:
+  /// The parameter of a component, or nullptr if it has none
+  Parameter *get(const size_t componentIndex) const {
+    const auto index = m_indices[componentIndex];
+    return index == NOT_FOUND ? nullptr : m_parameters[index].get();
+  }
+  /// The number of components
+  size_t size() const { return m_indices.size(); }
+
+private:
+  friend class ParameterMap;
+  static constexpr uint32_t NOT_FOUND = std::numeric_limits<uint32_t>::max();
+  /// The distinct parameters found
+  std::vector<std::shared_ptr<Parameter>> m_parameters;
+  /// Index in m_parameters for each component
+  std::vector<uint32_t> m_indices;
+};
+
 /** @class ParameterMap ParameterMap.h
 
   ParameterMap class. Holds the parameters of modified (parametrized) instrument
@@ -86,12 +121,15 @@ public:
   inline void clear() {
     m_map.clear();
     clearPositionSensitiveCaches();
+    ++m_generation;
   }
   /// method swaps two parameter maps contents  each other. All caches contents
   /// is nullified (TO DO: it can be efficiently swapped too)
   void swap(ParameterMap &other) {
     m_map.swap(other.m_map);
     clearPositionSensitiveCaches();
+    ++m_generation;
+    ++other.m_generation;
   }
   /// Clear any parameters with the given name
   void clearParametersByName(const std::string &name);
@@ -194,6 +232,10 @@ public:
   /// Looks recursively upwards in the component tree for the first instance of
   /// a parameter with a specified type.
   std::shared_ptr<Parameter> getRecursiveByType(const IComponent *comp, const std::string &type) const;
+  /// The parameters with a given name for every component index
+  std::shared_ptr<const ParameterLookup> lookup(const std::string &name, const bool recursive = false) const;
+  /// Changes whenever parameters are added or removed, so that lookups can be kept
+  size_t generation() const { return m_generation; }
 
   /** Get the values of a given parameter of all the components that have the
    * name: compName
@@ -305,6 +347,8 @@ private:
   component_map_cit positionOf(const IComponent *comp, const char *name, const char *type) const;
   /// calculate relative error for use in diff
   bool relErr(double x1, double x2, double errorVal) const;
+  /// Build a ParameterLookup from the current contents of the map
+  std::shared_ptr<ParameterLookup> buildLookup(const std::string &name, const bool recursive) const;
 
   /// internal list of parameter files loaded
   std::vector<std::string> m_parameterFileNames;
@@ -316,6 +360,18 @@ private:
   /// internal cache map instance for cached rotation values
   std::unique_ptr<Kernel::Cache<const ComponentID, Kernel::Quat>> m_cacheRotMap;
 
+  /// Incremented whenever parameters are added or removed, to invalidate the
+  /// lookups
+  std::atomic<size_t> m_generation{0};
+  /// A lookup and the generation of the map it was built from
+  struct CachedLookup {
+    size_t generation;
+    std::shared_ptr<const ParameterLookup> lookup;
+  };
+  /// Lookups by lower case parameter name, with a '/' prefix if recursive
+  mutable std::unordered_map<std::string, CachedLookup> m_lookups;
+  mutable std::mutex m_lookupMutex;
+
   /// Pointer to the DetectorInfo wrapper. NULL unless the instrument is
   /// associated with an ExperimentInfo object.
   std::unique_ptr<Geometry::DetectorInfo> m_detectorInfo;
@@ -36,6 +36,8 @@ public:
   PointingAlong pointingUp() const;
   /// Gets the beam pointing along direction
   PointingAlong pointingAlongBeam() const;
+  /// Gets the axis defining the 2theta sign
+  PointingAlong pointingThetaSign() const;
   /// Gets the pointing horizontal direction, i.e perpendicular to up & along
   /// beam
   PointingAlong pointingHorizontal() const;
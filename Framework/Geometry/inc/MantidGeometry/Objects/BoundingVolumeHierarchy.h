@@ -0,0 +1,70 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/** BoundingVolumeHierarchy : a tree of axis aligned boxes over the triangles
+  of a mesh, used to find the few triangles a ray may cross without testing
+  every one of them.
+
+  Each node holds the box around a contiguous range of the triangles, sorted
+  so that the two children of a node split its range at the median of the
+  triangle centres along the longest side of the node. The boxes are padded
+  slightly, and a ray is taken to start a small distance behind its start
+  point, so that no triangle that MeshObjectCommon::rayIntersectsTriangle
+  reports as crossed is missed.
+
+  The hierarchy refers to the triangles by index and keeps no reference to
+  the mesh: it must be rebuilt if the vertices change.
+*/
+class MANTID_GEOMETRY_DLL BoundingVolumeHierarchy {
+public:
+  BoundingVolumeHierarchy(const std::vector<uint32_t> &triangles, const std::vector<Kernel::V3D> &vertices);
+
+  /// Indices, in increasing order, of the triangles whose boxes the ray crosses
+  void getCandidates(const Kernel::V3D &start, const Kernel::V3D &direction, std::vector<uint32_t> &candidates) const;
+
+  /// Number of nodes in the tree
+  size_t numberOfNodes() const { return m_nodes.size(); }
+
+private:
+  struct Node {
+    Kernel::V3D minPoint;
+    Kernel::V3D maxPoint;
+    /// First entry of m_order in this node
+    uint32_t first;
+    /// Number of triangles in a leaf, 0 for an inner node
+    uint32_t count;
+    /// Index of the second child of an inner node, the first one follows it
+    uint32_t secondChild;
+  };
+
+  uint32_t build(std::vector<Kernel::V3D> &centres, uint32_t first, uint32_t last);
+  bool rayCrossesBox(const Kernel::V3D &minPoint, const Kernel::V3D &maxPoint, const Kernel::V3D &start,
+                     const Kernel::V3D &direction) const;
+
+  /// The triangle boxes, by triangle index
+  std::vector<Kernel::V3D> m_triangleMin;
+  std::vector<Kernel::V3D> m_triangleMax;
+  /// Triangle indices, ordered so that each node covers a contiguous range
+  std::vector<uint32_t> m_order;
+  /// Nodes in depth first order, the root first
+  std::vector<Node> m_nodes;
+  /// Padding of the boxes and how far behind its start a ray is followed
+  double m_tolerance{0.0};
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -33,6 +33,7 @@ namespace Geometry {
 class CompGrp;
 class GeometryHandler;
 class Rule;
+class RuleProgram;
 class Surface;
 class Track;
 class vtkGeometryCacheReader;
@@ -104,6 +105,8 @@ public:
 
   bool isValid(const Kernel::V3D &) const override; ///< Check if a point is valid
   bool isValid(const std::map<int, int> &) const;   ///< Check if a set of surfaces are valid.
+  /// Check a batch of points
+  void isValid(const std::vector<Kernel::V3D> &points, std::vector<uint8_t> &valid) const;
   bool isOnSide(const Kernel::V3D &) const override;
   Mantid::Geometry::TrackDirection calcValidType(const Kernel::V3D &Pt, const Kernel::V3D &uVec) const;
 
@@ -200,6 +203,8 @@ private:
   double singleShotMonteCarloVolume(const int shotSize, const size_t seed) const;
   /// Top rule [ Geometric scope of object]
   std::unique_ptr<Rule> m_topRule;
+  /// The top rule compiled for testing points, null until the surfaces are set
+  std::unique_ptr<RuleProgram> m_program;
   /// Object's bounding box
   BoundingBox m_boundingBox;
   // -- DEPRECATED --
@@ -16,8 +16,10 @@
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "MantidKernel/Material.h"
 #include "MantidKernel/Matrix.h"
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace Mantid {
 //----------------------------------------------------------------------
@@ -29,6 +31,7 @@ class V3D;
 } // namespace Kernel
 
 namespace Geometry {
+class BoundingVolumeHierarchy;
 class CompGrp;
 class GeometryHandler;
 class Track;
@@ -46,6 +49,9 @@ Mesh Object of Triangles assumed to form one or more
 non-intersecting closed surfaces enclosing separate volumes.
 The number of vertices is limited to 2^32 based on index type. For 2D Meshes see
 Mesh2DObject
+
+Rays are only tested against the triangles found by a bounding volume
+hierarchy, built on first use and rebuilt after the mesh is transformed.
 */
 class MANTID_GEOMETRY_DLL MeshObject : public IObject {
 public:
@@ -145,6 +151,11 @@ private:
                         std::vector<Kernel::V3D> &intersectionPoints,
                         std::vector<Mantid::Geometry::TrackDirection> &entryExitFlags) const;
 
+  /// The bounding volume hierarchy of the triangles, built on first use
+  const BoundingVolumeHierarchy &boundingVolumeHierarchy() const;
+  /// Discard the bounding box and hierarchy after the vertices have changed
+  void resetGeometryCaches();
+
   /// Get triangle
   bool getTriangle(const size_t index, Kernel::V3D &v1, Kernel::V3D &v2, Kernel::V3D &v3) const;
   /// Search object for valid point
@@ -153,6 +164,11 @@ private:
   /// Cache for object's bounding box
   mutable BoundingBox m_boundingBox;
 
+  /// Cache for the bounding volume hierarchy, guarded by m_bvhMutex
+  mutable std::shared_ptr<const BoundingVolumeHierarchy> m_bvh;
+  mutable std::atomic<bool> m_bvhBuilt{false};
+  mutable std::mutex m_bvhMutex;
+
   /// Tolerence distance
   const double M_TOLERANCE = 0.000001;
 
@@ -0,0 +1,71 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class Rule;
+class Surface;
+
+/** RuleProgram : a Rule tree compiled into a flat list of instructions, to
+  test if points are inside a CSGObject without walking the tree.
+
+  The instructions are in postfix order: surface tests, constants and, for
+  rules that are not compiled, Rule::isValid push a truth value onto a stack
+  and the boolean operations combine the values on top of it. Every surface
+  is tested, without the short circuits of Rule::isValid, which gives the
+  same result as the tests have no side effects, and the same sequence of
+  instructions runs for every point. A batch of points is tested one
+  instruction at a time. The parameters of planes and spheres are copied into
+  the program and their sides calculated in place rather than through
+  Surface::side, with the normal of a plane flipped for a negative sign so
+  that the test needs no branches.
+
+  The program refers to the rules and surfaces of the tree it was compiled
+  from, and must be compiled again if the tree or its surfaces change.
+*/
+class MANTID_GEOMETRY_DLL RuleProgram {
+public:
+  explicit RuleProgram(const Rule *topRule);
+
+  /// Is the point inside or on the surface of the object
+  bool isValid(const Kernel::V3D &point) const;
+  /// Test a batch of points. valid[i] is set to 1 if points[i] is inside
+  void isValid(const std::vector<Kernel::V3D> &points, std::vector<uint8_t> &valid) const;
+
+  /// Number of instructions
+  size_t size() const { return m_code.size(); }
+
+private:
+  enum class OpCode : uint8_t { Plane, Sphere, Surface, Rule, Constant, Not, And, Or };
+  struct Instruction {
+    OpCode op;
+    /// Sign of a surface, value of a constant
+    int value;
+    /// Normal and distance of a plane, or centre and radius of a sphere
+    std::array<double, 4> shape;
+    const Surface *surface;
+    const Geometry::Rule *rule;
+  };
+
+  void compile(const Geometry::Rule *rule);
+  size_t emit(OpCode op, int value = 0, const Surface *surface = nullptr, const Geometry::Rule *rule = nullptr);
+
+  std::vector<Instruction> m_code;
+  /// The largest number of values on the stack
+  size_t m_stackSize{0};
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -11,6 +11,7 @@
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidGeometry/Instrument/DetectorInfoIterator.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidKernel/EigenConversionHelpers.h"
 #include "MantidKernel/Exception.h"
@@ -271,8 +272,21 @@ double DetectorInfo::azimuthal(const std::pair<size_t, size_t> &index) const {
 std::tuple<double, double, double> DetectorInfo::diffractometerConstants(const size_t index,
                                                                          std::vector<detid_t> &calibratedDets,
                                                                          std::vector<detid_t> &uncalibratedDets) const {
-  auto det = m_instrument->getDetector((*m_detectorIDs)[index]);
   auto pmap = m_instrument->getParameterMap();
+  // Detector indices are component indices in the lookups of the parameter
+  // map holding this DetectorInfo, which avoids creating the detector
+  if (m_instrument->isParametrized() && pmap->hasDetectorInfo(m_instrument->baseInstrument().get())) {
+    const auto lookups = diffractometerLookups(*pmap);
+    if (auto *difc = lookups->difc->get(index)) {
+      calibratedDets.push_back((*m_detectorIDs)[index]);
+      auto *difa = lookups->difa->get(index);
+      auto *tzero = lookups->tzero->get(index);
+      return {difa ? difa->value<double>() : 0., difc->value<double>(), tzero ? tzero->value<double>() : 0.};
+    }
+    uncalibratedDets.push_back((*m_detectorIDs)[index]);
+    return {0., difcUncalibrated(index), 0.};
+  }
+  auto det = m_instrument->getDetector((*m_detectorIDs)[index]);
   auto par = pmap->get(det.get(), "DIFC");
   if (par) {
     double difc = par->value<double>();
@@ -294,6 +308,24 @@ std::tuple<double, double, double> DetectorInfo::diffractometerConstants(const s
   }
 }
 
+/** The DIFC, DIFA and TZERO lookups of the parameter map. They are kept
+ * until parameters are added to or removed from the map, so that a loop over
+ * the detectors fetches them once rather than for every detector.
+ * @param pmap :: the parameter map of the instrument
+ * @return the lookups of the current generation of the map
+ */
+std::shared_ptr<const DetectorInfo::DiffractometerLookups>
+DetectorInfo::diffractometerLookups(const ParameterMap &pmap) const {
+  const size_t generation = pmap.generation();
+  auto lookups = std::atomic_load(&m_diffractometerLookups);
+  if (lookups && lookups->map == &pmap && lookups->generation == generation)
+    return lookups;
+  lookups = std::make_shared<const DiffractometerLookups>(
+      DiffractometerLookups{&pmap, generation, pmap.lookup("DIFC"), pmap.lookup("DIFA"), pmap.lookup("TZERO")});
+  std::atomic_store(&m_diffractometerLookups, lookups);
+  return lookups;
+}
+
 double DetectorInfo::difcUncalibrated(const size_t index) const {
   return 1. / Kernel::Units::tofToDSpacingFactor(l1(), l2(index), twoTheta(index), 0.);
 }
@@ -9,6 +9,7 @@
 
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/InstrumentSnapshot.h"
 #include "MantidGeometry/Instrument/ObjCompAssembly.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
@@ -33,11 +34,15 @@
 #include <Poco/DOM/NodeFilter.h>
 #include <Poco/DOM/NodeIterator.h>
 #include <Poco/DOM/NodeList.h>
+#include <Poco/DirectoryIterator.h>
+#include <Poco/File.h>
 #include <Poco/Path.h>
+#include <Poco/Process.h>
 #include <Poco/SAX/AttributesImpl.h>
 #include <Poco/String.h>
 #include <Poco/XML/XMLWriter.h>
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/regex.hpp>
 #include <memory>
 #include <unordered_set>
@@ -58,6 +63,27 @@ namespace Mantid::Geometry {
 namespace {
 // initialize the static logger
 Kernel::Logger g_log("InstrumentDefinitionParser");
+
+/** Remove the instrument snapshots written by other revisions of Mantid,
+ *which are never loaded again
+ *
+ *  @param directory :: The directory of the snapshots
+ */
+void removeStaleSnapshots(const Poco::Path &directory) {
+  const std::string current = "." + InstrumentSnapshot::revision() + ".instrument";
+  Poco::DirectoryIterator end;
+  for (Poco::DirectoryIterator it(directory); it != end; ++it) {
+    const std::string &name = it.name();
+    if (!boost::algorithm::ends_with(name, ".instrument") || boost::algorithm::ends_with(name, current))
+      continue;
+    try {
+      Poco::File(it.path()).remove();
+    } catch (std::exception &e) {
+      // another process may have removed it first
+      g_log.debug() << "Unable to remove instrument snapshot " << name << ": " << e.what() << '\n';
+    }
+  }
+}
 } // namespace
 //----------------------------------------------------------------------------------------------
 /** Default Constructor - not very functional in this state
@@ -2952,6 +2978,86 @@ const std::string InstrumentDefinitionParser::createVTPFileName() {
   return retVal;
 }
 
+/** Generates the filename of the snapshot of the instrument, keyed by the
+ *mangled name and the revision of Mantid. The snapshots are written to the
+ *directory given by instrumentDefinition.snapshot.directory, or next to the
+ *vtp files if it is not set.
+ *
+ *  @return The snapshot filename, empty if the instrument has no mangled name
+ */
+const std::string InstrumentDefinitionParser::createSnapshotFileName() {
+  std::string retVal;
+  std::string filename = getMangledName();
+  if (!filename.empty()) {
+    auto &config = ConfigService::Instance();
+    std::string directory = config.getString("instrumentDefinition.snapshot.directory");
+    if (directory.empty())
+      directory = config.getVTPFileDirectory();
+    Poco::Path path(directory);
+    path.makeDirectory();
+    path.append(filename + "." + InstrumentSnapshot::revision() + ".instrument");
+    retVal = path.toString();
+  }
+  return retVal;
+}
+
+/** Create the instrument from the snapshot written when the same instrument
+ *definition was last parsed, in this or another process
+ *
+ *  @return The instrument, or a null pointer if there is no snapshot or it
+ *cannot be used
+ */
+Instrument_sptr InstrumentDefinitionParser::loadSnapshot() {
+  const std::string snapshotFile = createSnapshotFileName();
+  if (snapshotFile.empty() || !Poco::File(snapshotFile).exists())
+    return nullptr;
+  try {
+    auto instrument = InstrumentSnapshot::load(snapshotFile);
+    instrument->setFilename(m_instrument->getFilename());
+    instrument->setXmlText(m_instrument->getXmlText());
+    m_instrument = instrument;
+    return instrument;
+  } catch (std::exception &e) {
+    g_log.information() << "Instrument snapshot " << snapshotFile << " cannot be used: " << e.what() << '\n';
+  }
+  return nullptr;
+}
+
+/** Write a snapshot of the instrument created by parseXML for loadSnapshot.
+ *The file is written under a temporary name and renamed, so that other
+ *processes never read a partly written snapshot. Nothing is written for
+ *instruments the snapshot does not support. The snapshots written by other
+ *revisions of Mantid are removed.
+ */
+void InstrumentDefinitionParser::saveSnapshot() {
+  const std::string snapshotFile = createSnapshotFileName();
+  if (snapshotFile.empty())
+    return;
+  if (!InstrumentSnapshot::isSupported(*m_instrument)) {
+    g_log.debug() << "No snapshot of instrument " << m_instName << " is written as it is not supported\n";
+    return;
+  }
+  const Poco::Path directory = Poco::Path(snapshotFile).parent();
+  const std::string tempFile = snapshotFile + "." + std::to_string(Poco::Process::id());
+  try {
+    Poco::File(directory).createDirectories();
+    InstrumentSnapshot::save(*m_instrument, tempFile);
+    Poco::File(tempFile).renameTo(snapshotFile);
+  } catch (std::exception &e) {
+    g_log.information() << "Unable to write instrument snapshot " << snapshotFile << ": " << e.what() << '\n';
+    try {
+      Poco::File(tempFile).remove();
+    } catch (std::exception &) {
+    }
+    return;
+  }
+  try {
+    removeStaleSnapshots(directory);
+  } catch (std::exception &e) {
+    g_log.debug() << "Unable to look for stale instrument snapshots: " << e.what() << '\n';
+  }
+}
+
 /** Return a subelement of an XML element, but also checks that there exist
  *exactly one entry
  *  of this subelement.
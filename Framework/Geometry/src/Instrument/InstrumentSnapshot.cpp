@@ -0,0 +1,821 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Instrument/InstrumentSnapshot.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/CompAssembly.h"
+#include "MantidGeometry/Instrument/Component.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/GridDetector.h"
+#include "MantidGeometry/Instrument/ObjCompAssembly.h"
+#include "MantidGeometry/Instrument/ObjComponent.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/Interpolation.h"
+#include "MantidKernel/MantidVersion.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Mantid::Geometry {
+
+using Kernel::Quat;
+using Kernel::V3D;
+
+namespace {
+/// Identifies a snapshot file
+const std::string MAGIC("MantidInstrumentSnapshot");
+
+/// The types of component held in a snapshot
+enum class ComponentKind : uint8_t {
+  Component,
+  ObjComponent,
+  Detector,
+  CompAssembly,
+  ObjCompAssembly,
+  RectangularDetector,
+  GridDetector
+};
+
+/// How a detector is marked in the instrument
+enum class DetectorMark : uint8_t { None, Detector, Monitor };
+
+/// Appends values to a buffer
+class Writer {
+public:
+  template <typename T> void write(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written");
+    const auto *bytes = reinterpret_cast<const char *>(&value);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+  }
+  void writeString(const std::string &value) {
+    write<uint64_t>(value.size());
+    m_buffer.insert(m_buffer.end(), value.begin(), value.end());
+  }
+  void writeV3D(const V3D &value) {
+    write(value.X());
+    write(value.Y());
+    write(value.Z());
+  }
+  void writeQuat(const Quat &value) {
+    write(value.real());
+    write(value.imagI());
+    write(value.imagJ());
+    write(value.imagK());
+  }
+  void append(const Writer &other) { m_buffer.insert(m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end()); }
+  const std::vector<char> &buffer() const { return m_buffer; }
+
+private:
+  std::vector<char> m_buffer;
+};
+
+/// Reads values back from a buffer filled by a Writer
+class Reader {
+public:
+  explicit Reader(const std::vector<char> &buffer) : m_pos(buffer.data()), m_end(buffer.data() + buffer.size()) {}
+  template <typename T> T read() {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read");
+    checkAvailable(sizeof(T));
+    T value;
+    std::memcpy(&value, m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+  std::string readString() {
+    const auto size = read<uint64_t>();
+    checkAvailable(size);
+    std::string value(m_pos, size);
+    m_pos += size;
+    return value;
+  }
+  V3D readV3D() {
+    const auto x = read<double>();
+    const auto y = read<double>();
+    const auto z = read<double>();
+    return V3D(x, y, z);
+  }
+  Quat readQuat() {
+    const auto w = read<double>();
+    const auto a = read<double>();
+    const auto b = read<double>();
+    const auto c = read<double>();
+    return Quat(w, a, b, c);
+  }
+  /// Read an index into a list of the given size, -1 for none
+  int64_t readIndex(const size_t size) {
+    const auto index = read<int64_t>();
+    if (index < -1 || index >= static_cast<int64_t>(size))
+      throw std::runtime_error("Instrument snapshot refers to an item that does not exist");
+    return index;
+  }
+  bool atEnd() const { return m_pos == m_end; }
+
+private:
+  void checkAvailable(const uint64_t size) const {
+    if (size > static_cast<uint64_t>(m_end - m_pos))
+      throw std::runtime_error("Instrument snapshot ends unexpectedly");
+  }
+  const char *m_pos;
+  const char *m_end;
+};
+
+/// The children of an assembly, depth first, as they are stored in a snapshot
+void appendDescendants(const IComponent *component, std::vector<const IComponent *> &out) {
+  if (const auto *assembly = dynamic_cast<const ICompAssembly *>(component)) {
+    for (int i = 0; i < assembly->nelements(); ++i) {
+      const auto child = assembly->getChild(i);
+      out.emplace_back(child.get());
+      appendDescendants(child.get(), out);
+    }
+  }
+}
+
+/// The shape of the pixels of a rectangular or grid detector
+std::shared_ptr<const IObject> pixelShape(const std::vector<const IComponent *> &generated) {
+  for (const auto *component : generated) {
+    if (const auto *detector = dynamic_cast<const Detector *>(component))
+      return detector->shape();
+  }
+  return nullptr;
+}
+
+/// Throws std::invalid_argument unless the instrument is a base instrument
+/// without a separate physical instrument
+void checkBaseInstrument(const Instrument &instrument) {
+  if (instrument.isParametrized())
+    throw std::invalid_argument("Only a base instrument can be written to a snapshot");
+  if (instrument.getPhysicalInstrument())
+    throw std::invalid_argument("Instruments with a separate physical instrument cannot be written to a snapshot");
+}
+
+/// @return the kind of a component, throwing std::invalid_argument if a
+/// snapshot cannot hold it
+ComponentKind componentKind(const IComponent &component) {
+  const auto &type = typeid(component);
+  if (type == typeid(Component))
+    return ComponentKind::Component;
+  if (type == typeid(ObjComponent))
+    return ComponentKind::ObjComponent;
+  if (type == typeid(Detector))
+    return ComponentKind::Detector;
+  if (type == typeid(CompAssembly))
+    return ComponentKind::CompAssembly;
+  if (type == typeid(ObjCompAssembly))
+    return ComponentKind::ObjCompAssembly;
+  if (type == typeid(RectangularDetector))
+    return ComponentKind::RectangularDetector;
+  if (type == typeid(GridDetector))
+    return ComponentKind::GridDetector;
+  throw std::invalid_argument("Components of type " + component.type() + " cannot be written to a snapshot");
+}
+
+/// @return the shape as a CSGObject, throwing std::invalid_argument if a
+/// snapshot cannot hold it
+const CSGObject *checkShape(const IObject &shape) {
+  const auto *csgObject = dynamic_cast<const CSGObject *>(&shape);
+  if (!csgObject)
+    throw std::invalid_argument("Only CSGObject shapes can be written to a snapshot");
+  if (csgObject->getShapeXML().empty() && csgObject->topRule())
+    throw std::invalid_argument("Shapes that were not created from XML cannot be written to a snapshot");
+  return csgObject;
+}
+
+/// Applies the checks of SnapshotWriter to an instrument without writing
+/// anything, visiting each component and shape once
+class SnapshotChecker {
+public:
+  explicit SnapshotChecker(const Instrument &instrument) : m_instrument(instrument) {}
+
+  /// Throws std::invalid_argument if the instrument cannot be written
+  void check() {
+    checkBaseInstrument(m_instrument);
+    m_components.emplace(&m_instrument);
+    for (int i = 0; i < m_instrument.nelements(); ++i)
+      checkComponent(m_instrument.getChild(i).get());
+    detid2det_map detectors;
+    m_instrument.getDetectors(detectors);
+    for (const auto &detector : detectors)
+      checkPartOf(detector.second.get(), "The instrument has detectors that are not part of it");
+    if (m_instrument.hasSource())
+      checkPartOf(m_instrument.getSource().get());
+    if (m_instrument.hasSample())
+      checkPartOf(m_instrument.getSample().get());
+    for (const auto &entry : m_instrument.getLogfileCache()) {
+      checkPartOf(entry.first.second);
+      if (entry.second->m_component)
+        checkPartOf(entry.second->m_component);
+    }
+  }
+
+private:
+  void checkComponent(const IComponent *component) {
+    m_components.emplace(component);
+    const ComponentKind kind = componentKind(*component);
+    switch (kind) {
+    case ComponentKind::ObjComponent:
+    case ComponentKind::ObjCompAssembly:
+      checkShapeOnce(dynamic_cast<const ObjComponent &>(*component).shape());
+      break;
+    case ComponentKind::Detector:
+      checkShapeOnce(dynamic_cast<const Detector &>(*component).shape());
+      break;
+    case ComponentKind::RectangularDetector:
+    case ComponentKind::GridDetector: {
+      std::vector<const IComponent *> generated;
+      appendDescendants(component, generated);
+      checkShapeOnce(pixelShape(generated));
+      m_components.insert(generated.cbegin(), generated.cend());
+      return;
+    }
+    default:
+      break;
+    }
+    if (const auto *assembly = dynamic_cast<const ICompAssembly *>(component)) {
+      for (int i = 0; i < assembly->nelements(); ++i)
+        checkComponent(assembly->getChild(i).get());
+    }
+  }
+
+  void checkShapeOnce(const std::shared_ptr<const IObject> &shape) {
+    if (shape && m_shapes.emplace(shape.get()).second)
+      checkShape(*shape);
+  }
+
+  void checkPartOf(const IComponent *component,
+                   const char *message = "The instrument refers to a component that is not part of it") const {
+    if (m_components.count(component) == 0)
+      throw std::invalid_argument(message);
+  }
+
+  const Instrument &m_instrument;
+  std::unordered_set<const IComponent *> m_components;
+  std::unordered_set<const IObject *> m_shapes;
+};
+
+/// Writes the parts of an instrument in the order they are read back
+class SnapshotWriter {
+public:
+  explicit SnapshotWriter(const Instrument &instrument) : m_instrument(instrument) {
+    checkBaseInstrument(instrument);
+    detid2det_map detectors;
+    instrument.getDetectors(detectors);
+    for (const auto &detector : detectors) {
+      m_marks[detector.second.get()] =
+          instrument.isMonitor(detector.first) ? DetectorMark::Monitor : DetectorMark::Detector;
+    }
+  }
+
+  const std::vector<char> &write() {
+    m_out.writeString(MAGIC);
+    m_out.write(InstrumentSnapshot::VERSION);
+    m_out.writeString(InstrumentSnapshot::revision());
+    writeProperties();
+    // The shapes are collected while the components are written, but are
+    // read before them
+    m_indices[&m_instrument] = 0;
+    size_t nComponents(1);
+    for (int i = 0; i < m_instrument.nelements(); ++i) {
+      nComponents += writeComponent(m_instrument.getChild(i).get(), 0, nComponents);
+    }
+    writeShapes();
+    m_out.write<uint64_t>(nComponents);
+    m_out.writeV3D(m_instrument.getRelativePos());
+    m_out.writeQuat(m_instrument.getRelativeRot());
+    m_out.append(m_components);
+    writeMarkedComponents();
+    writeLogfileCache();
+    return m_out.buffer();
+  }
+
+private:
+  void writeProperties() {
+    m_out.writeString(m_instrument.getName());
+    m_out.write(m_instrument.getValidFromDate().totalNanoseconds());
+    m_out.write(m_instrument.getValidToDate().totalNanoseconds());
+    m_out.writeString(m_instrument.getDefaultView());
+    m_out.writeString(m_instrument.getDefaultAxis());
+    const auto frame = m_instrument.getReferenceFrame();
+    m_out.write<int32_t>(frame->pointingUp());
+    m_out.write<int32_t>(frame->pointingAlongBeam());
+    m_out.write<int32_t>(frame->pointingThetaSign());
+    m_out.write<int32_t>(frame->getHandedness());
+    m_out.writeString(frame->origin());
+    const auto &units = m_instrument.getLogfileUnit();
+    m_out.write<uint64_t>(units.size());
+    for (const auto &unit : units) {
+      m_out.writeString(unit.first);
+      m_out.writeString(unit.second);
+    }
+  }
+
+  /// Add a shape to the list of shapes if it is not there already
+  int64_t shapeIndex(const std::shared_ptr<const IObject> &shape) {
+    if (!shape)
+      return -1;
+    const auto found = m_shapeIndices.find(shape.get());
+    if (found != m_shapeIndices.end())
+      return found->second;
+    const auto *csgObject = checkShape(*shape);
+    const auto index = static_cast<int64_t>(m_shapes.size());
+    m_shapes.emplace_back(csgObject);
+    m_shapeIndices[shape.get()] = index;
+    return index;
+  }
+
+  void writeShapes() {
+    m_out.write<uint64_t>(m_shapes.size());
+    for (const auto *shape : m_shapes) {
+      m_out.writeString(shape->getShapeXML());
+      m_out.write<int32_t>(shape->getName());
+      m_out.writeString(shape->id());
+    }
+  }
+
+  void writeDetector(const Detector &detector) {
+    m_components.write<int32_t>(detector.getID());
+    const auto mark = m_marks.find(&detector);
+    m_components.write(mark == m_marks.end() ? DetectorMark::None : mark->second);
+    if (mark != m_marks.end())
+      m_marked.emplace(&detector);
+  }
+
+  /**
+   * Write a component and its children
+   * @param component :: The component to write
+   * @param parent :: The index of its parent
+   * @param index :: The index of the component
+   * @return the number of components written
+   */
+  size_t writeComponent(const IComponent *component, const size_t parent, const size_t index) {
+    m_indices[component] = index;
+    const ComponentKind kind = componentKind(*component);
+    m_components.write(kind);
+    m_components.write<int64_t>(parent);
+    m_components.writeString(component->getName());
+    m_components.writeV3D(component->getRelativePos());
+    m_components.writeQuat(component->getRelativeRot());
+
+    switch (kind) {
+    case ComponentKind::ObjComponent:
+    case ComponentKind::ObjCompAssembly:
+      m_components.write(shapeIndex(dynamic_cast<const ObjComponent &>(*component).shape()));
+      break;
+    case ComponentKind::Detector:
+      m_components.write(shapeIndex(dynamic_cast<const Detector &>(*component).shape()));
+      writeDetector(dynamic_cast<const Detector &>(*component));
+      break;
+    case ComponentKind::RectangularDetector:
+    case ComponentKind::GridDetector:
+      return writeGridDetector(dynamic_cast<const GridDetector &>(*component), kind, index);
+    default:
+      break;
+    }
+
+    size_t nWritten(1);
+    if (const auto *assembly = dynamic_cast<const ICompAssembly *>(component)) {
+      for (int i = 0; i < assembly->nelements(); ++i) {
+        nWritten += writeComponent(assembly->getChild(i).get(), index, index + nWritten);
+      }
+    }
+    return nWritten;
+  }
+
+  /**
+   * Write the parameters of a rectangular or grid detector, and the rotations
+   * and detector IDs of the components it creates
+   * @param grid :: The detector to write
+   * @param kind :: RectangularDetector or GridDetector
+   * @param index :: The index of the detector
+   * @return the number of components written
+   */
+  size_t writeGridDetector(const GridDetector &grid, const ComponentKind kind, const size_t index) {
+    std::vector<const IComponent *> generated;
+    appendDescendants(&grid, generated);
+    m_components.write(shapeIndex(pixelShape(generated)));
+    m_components.write<int32_t>(grid.xpixels());
+    m_components.write(grid.xstart());
+    m_components.write(grid.xstep());
+    m_components.write<int32_t>(grid.ypixels());
+    m_components.write(grid.ystart());
+    m_components.write(grid.ystep());
+    if (kind == ComponentKind::GridDetector) {
+      m_components.write<int32_t>(grid.zpixels());
+      m_components.write(grid.zstart());
+      m_components.write(grid.zstep());
+      m_components.writeString(grid.idFillOrder());
+    } else {
+      m_components.write<uint8_t>(grid.idfillbyfirst_y());
+    }
+    m_components.write<int32_t>(grid.idstart());
+    m_components.write<int32_t>(grid.idstepbyrow());
+    m_components.write<int32_t>(grid.idstep());
+
+    m_components.write<uint64_t>(generated.size());
+    for (size_t i = 0; i < generated.size(); ++i) {
+      m_indices[generated[i]] = index + 1 + i;
+      m_components.writeQuat(generated[i]->getRelativeRot());
+      const auto *detector = dynamic_cast<const Detector *>(generated[i]);
+      m_components.write<uint8_t>(detector != nullptr);
+      if (detector)
+        writeDetector(*detector);
+    }
+    return 1 + generated.size();
+  }
+
+  size_t indexOf(const IComponent *component) const {
+    const auto found = m_indices.find(component);
+    if (found == m_indices.end())
+      throw std::invalid_argument("The instrument refers to a component that is not part of it");
+    return found->second;
+  }
+
+  void writeMarkedComponents() {
+    if (m_marked.size() != m_marks.size())
+      throw std::invalid_argument("The instrument has detectors that are not part of it");
+    m_out.write<int64_t>(m_instrument.hasSource() ? indexOf(m_instrument.getSource().get()) : -1);
+    m_out.write<int64_t>(m_instrument.hasSample() ? indexOf(m_instrument.getSample().get()) : -1);
+  }
+
+  void writeLogfileCache() {
+    const auto &cache = m_instrument.getLogfileCache();
+    m_out.write<uint64_t>(cache.size());
+    for (const auto &entry : cache) {
+      const auto &param = *entry.second;
+      m_out.writeString(entry.first.first);
+      m_out.write<int64_t>(indexOf(entry.first.second));
+      m_out.writeString(param.m_logfileID);
+      m_out.writeString(param.m_value);
+      m_out.write<uint8_t>(param.m_interpolation != nullptr);
+      if (param.m_interpolation) {
+        std::ostringstream interpolation;
+        interpolation << std::setprecision(std::numeric_limits<double>::max_digits10) << *param.m_interpolation;
+        m_out.writeString(interpolation.str());
+      }
+      m_out.writeString(param.m_formula);
+      m_out.writeString(param.m_formulaUnit);
+      m_out.writeString(param.m_resultUnit);
+      m_out.writeString(param.m_paramName);
+      m_out.writeString(param.m_type);
+      m_out.writeString(param.m_tie);
+      m_out.write<uint64_t>(param.m_constraint.size());
+      for (const auto &constraint : param.m_constraint)
+        m_out.writeString(constraint);
+      m_out.writeString(param.m_penaltyFactor);
+      m_out.writeString(param.m_fittingFunction);
+      m_out.writeString(param.m_extractSingleValueAs);
+      m_out.writeString(param.m_eq);
+      m_out.write<int64_t>(param.m_component ? indexOf(param.m_component) : -1);
+      m_out.write(param.m_angleConvertConst);
+      m_out.writeString(param.m_description);
+      m_out.writeString(param.m_visible);
+    }
+  }
+
+  const Instrument &m_instrument;
+  Writer m_out;
+  /// The component records, written after the shapes
+  Writer m_components;
+  std::unordered_map<const IComponent *, size_t> m_indices;
+  std::vector<const CSGObject *> m_shapes;
+  std::unordered_map<const IObject *, int64_t> m_shapeIndices;
+  std::unordered_map<const IComponent *, DetectorMark> m_marks;
+  std::unordered_set<const IComponent *> m_marked;
+};
+
+/// Creates an instrument from a snapshot
+class SnapshotReader {
+public:
+  explicit SnapshotReader(const std::vector<char> &buffer) : m_in(buffer) {}
+
+  std::shared_ptr<Instrument> read() {
+    if (m_in.readString() != MAGIC)
+      throw std::runtime_error("The file is not an instrument snapshot");
+    if (m_in.read<uint32_t>() != InstrumentSnapshot::VERSION)
+      throw std::runtime_error("The instrument snapshot was written by a different version");
+    if (m_in.readString() != InstrumentSnapshot::revision())
+      throw std::runtime_error("The instrument snapshot was written by a different revision of Mantid");
+    readProperties();
+    readShapes();
+    readComponents();
+    readMarkedComponents();
+    readLogfileCache();
+    if (!m_in.atEnd())
+      throw std::runtime_error("Instrument snapshot has unexpected content at its end");
+    return m_instrument;
+  }
+
+private:
+  void readProperties() {
+    m_instrument = std::make_shared<Instrument>(m_in.readString());
+    m_instrument->setValidFromDate(Types::Core::DateAndTime(m_in.read<int64_t>()));
+    m_instrument->setValidToDate(Types::Core::DateAndTime(m_in.read<int64_t>()));
+    m_instrument->setDefaultView(m_in.readString());
+    m_instrument->setDefaultViewAxis(m_in.readString());
+    const auto up = readAxis();
+    const auto alongBeam = readAxis();
+    const auto thetaSign = readAxis();
+    const auto handedness = m_in.read<int32_t>() == Right ? Right : Left;
+    m_instrument->setReferenceFrame(
+        std::make_shared<ReferenceFrame>(up, alongBeam, thetaSign, handedness, m_in.readString()));
+    auto &units = m_instrument->getLogfileUnit();
+    const auto nUnits = m_in.read<uint64_t>();
+    for (uint64_t i = 0; i < nUnits; ++i) {
+      auto name = m_in.readString();
+      units[name] = m_in.readString();
+    }
+  }
+
+  PointingAlong readAxis() {
+    const auto axis = m_in.read<int32_t>();
+    if (axis < X || axis > Z)
+      throw std::runtime_error("Instrument snapshot has an invalid reference frame");
+    return static_cast<PointingAlong>(axis);
+  }
+
+  void readShapes() {
+    ShapeFactory shapeFactory;
+    const auto nShapes = m_in.read<uint64_t>();
+    for (uint64_t i = 0; i < nShapes; ++i) {
+      const auto xml = m_in.readString();
+      auto shape = xml.empty() ? std::make_shared<CSGObject>() : shapeFactory.createShape(xml, false);
+      shape->setName(m_in.read<int32_t>());
+      shape->setID(m_in.readString());
+      m_shapes.emplace_back(std::move(shape));
+    }
+  }
+
+  std::shared_ptr<CSGObject> readShape() {
+    const auto index = m_in.readIndex(m_shapes.size());
+    return index < 0 ? nullptr : m_shapes[index];
+  }
+
+  void readComponents() {
+    const auto nComponents = m_in.read<uint64_t>();
+    m_instrument->setPos(m_in.readV3D());
+    m_instrument->setRot(m_in.readQuat());
+    m_components.reserve(nComponents);
+    m_components.emplace_back(m_instrument.get());
+    while (m_components.size() < nComponents) {
+      readComponent();
+    }
+  }
+
+  void readComponent() {
+    const auto kind = m_in.read<ComponentKind>();
+    auto *parent = dynamic_cast<ICompAssembly *>(m_components[m_in.readIndex(m_components.size())]);
+    if (!parent)
+      throw std::runtime_error("Instrument snapshot has a component whose parent is not an assembly");
+    const auto name = m_in.readString();
+    const auto pos = m_in.readV3D();
+    const auto rot = m_in.readQuat();
+
+    IComponent *component(nullptr);
+    switch (kind) {
+    case ComponentKind::Component:
+      component = new Component(name, parent);
+      parent->add(component);
+      break;
+    case ComponentKind::ObjComponent:
+      component = new ObjComponent(name, readShape(), parent);
+      parent->add(component);
+      break;
+    case ComponentKind::Detector: {
+      auto shape = readShape();
+      auto *detector = new Detector(name, m_in.read<int32_t>(), shape, parent);
+      parent->add(detector);
+      readDetectorMark(detector);
+      component = detector;
+      break;
+    }
+    case ComponentKind::CompAssembly:
+      component = new CompAssembly(name, parent);
+      break;
+    case ComponentKind::ObjCompAssembly: {
+      auto *assembly = new ObjCompAssembly(name, parent);
+      if (auto outline = readShape())
+        assembly->setOutline(outline);
+      component = assembly;
+      break;
+    }
+    case ComponentKind::RectangularDetector:
+    case ComponentKind::GridDetector:
+      readGridDetector(kind, name, parent, pos, rot);
+      return;
+    default:
+      throw std::runtime_error("Instrument snapshot has a component of an unknown type");
+    }
+    component->setPos(pos);
+    component->setRot(rot);
+    m_components.emplace_back(component);
+  }
+
+  void readGridDetector(const ComponentKind kind, const std::string &name, ICompAssembly *parent, const V3D &pos,
+                        const Quat &rot) {
+    auto shape = readShape();
+    const auto xpixels = m_in.read<int32_t>();
+    const auto xstart = m_in.read<double>();
+    const auto xstep = m_in.read<double>();
+    const auto ypixels = m_in.read<int32_t>();
+    const auto ystart = m_in.read<double>();
+    const auto ystep = m_in.read<double>();
+    GridDetector *grid(nullptr);
+    if (kind == ComponentKind::GridDetector) {
+      const auto zpixels = m_in.read<int32_t>();
+      const auto zstart = m_in.read<double>();
+      const auto zstep = m_in.read<double>();
+      const auto idFillOrder = m_in.readString();
+      const auto idstart = m_in.read<int32_t>();
+      const auto idstepbyrow = m_in.read<int32_t>();
+      const auto idstep = m_in.read<int32_t>();
+      grid = new GridDetector(name, parent);
+      grid->initialize(shape, xpixels, xstart, xstep, ypixels, ystart, ystep, zpixels, zstart, zstep, idstart,
+                       idFillOrder, idstepbyrow, idstep);
+    } else {
+      const bool idfillbyfirst_y = m_in.read<uint8_t>() != 0;
+      const auto idstart = m_in.read<int32_t>();
+      const auto idstepbyrow = m_in.read<int32_t>();
+      const auto idstep = m_in.read<int32_t>();
+      auto *rectangular = new RectangularDetector(name, parent);
+      rectangular->initialize(shape, xpixels, xstart, xstep, ypixels, ystart, ystep, idstart, idfillbyfirst_y,
+                              idstepbyrow, idstep);
+      grid = rectangular;
+    }
+    grid->setPos(pos);
+    grid->setRot(rot);
+    m_components.emplace_back(grid);
+
+    std::vector<const IComponent *> generated;
+    appendDescendants(grid, generated);
+    if (m_in.read<uint64_t>() != generated.size())
+      throw std::runtime_error("Instrument snapshot does not match the pixels of detector " + name);
+    for (const auto *component : generated) {
+      // The pixels are owned by the grid, which is not const
+      auto *pixel = const_cast<IComponent *>(component);
+      pixel->setRot(m_in.readQuat());
+      const bool isDetector = m_in.read<uint8_t>() != 0;
+      auto *detector = dynamic_cast<Detector *>(pixel);
+      if (isDetector != (detector != nullptr) || (detector && m_in.read<int32_t>() != detector->getID()))
+        throw std::runtime_error("Instrument snapshot does not match the pixels of detector " + name);
+      if (detector)
+        readDetectorMark(detector);
+      m_components.emplace_back(pixel);
+    }
+  }
+
+  void readDetectorMark(const Detector *detector) {
+    switch (m_in.read<DetectorMark>()) {
+    case DetectorMark::Detector:
+      m_detectors.emplace_back(detector);
+      break;
+    case DetectorMark::Monitor:
+      m_monitors.emplace_back(detector);
+      break;
+    default:
+      break;
+    }
+  }
+
+  const IComponent *readComponentIndex() {
+    const auto index = m_in.readIndex(m_components.size());
+    return index < 0 ? nullptr : m_components[index];
+  }
+
+  void readMarkedComponents() {
+    // markAsMonitor inserts in order, so the monitors are marked before the
+    // unsorted detectors
+    for (const auto *monitor : m_monitors)
+      m_instrument->markAsMonitor(monitor);
+    for (const auto *detector : m_detectors)
+      m_instrument->markAsDetectorIncomplete(detector);
+    m_instrument->markAsDetectorFinalize();
+    if (const auto *source = readComponentIndex())
+      m_instrument->markAsSource(source);
+    if (const auto *sample = readComponentIndex())
+      m_instrument->markAsSamplePos(sample);
+  }
+
+  void readLogfileCache() {
+    auto &cache = m_instrument->getLogfileCache();
+    const auto nParameters = m_in.read<uint64_t>();
+    for (uint64_t i = 0; i < nParameters; ++i) {
+      auto key = m_in.readString();
+      const auto *keyComponent = readComponentIndex();
+      auto logfileID = m_in.readString();
+      auto value = m_in.readString();
+      std::shared_ptr<Kernel::Interpolation> interpolation;
+      if (m_in.read<uint8_t>() != 0) {
+        interpolation = std::make_shared<Kernel::Interpolation>();
+        std::istringstream in(m_in.readString());
+        in >> *interpolation;
+      }
+      auto formula = m_in.readString();
+      auto formulaUnit = m_in.readString();
+      auto resultUnit = m_in.readString();
+      auto paramName = m_in.readString();
+      auto type = m_in.readString();
+      auto tie = m_in.readString();
+      std::vector<std::string> constraint(m_in.read<uint64_t>());
+      for (auto &bound : constraint)
+        bound = m_in.readString();
+      auto penaltyFactor = m_in.readString();
+      auto fitFunc = m_in.readString();
+      auto extractSingleValueAs = m_in.readString();
+      auto eq = m_in.readString();
+      const auto *component = readComponentIndex();
+      const auto angleConvertConst = m_in.read<double>();
+      const auto description = m_in.readString();
+      auto visible = m_in.readString();
+      auto param = std::make_shared<XMLInstrumentParameter>(
+          std::move(logfileID), std::move(value), std::move(interpolation), std::move(formula),
+          std::move(formulaUnit), std::move(resultUnit), std::move(paramName), std::move(type), std::move(tie),
+          std::move(constraint), penaltyFactor, std::move(fitFunc), std::move(extractSingleValueAs), std::move(eq),
+          component, angleConvertConst, description, std::move(visible));
+      cache.emplace(std::make_pair(std::move(key), keyComponent), std::move(param));
+    }
+  }
+
+  Reader m_in;
+  std::shared_ptr<Instrument> m_instrument;
+  std::vector<std::shared_ptr<CSGObject>> m_shapes;
+  std::vector<IComponent *> m_components;
+  std::vector<const Detector *> m_detectors;
+  std::vector<const Detector *> m_monitors;
+};
+} // namespace
+
+/**
+ * The revision of Mantid written in a snapshot. A snapshot written by another
+ * revision is rejected, as the parser that created the instrument may have
+ * changed even if the file format did not.
+ * @return the abbreviated SHA-1 of the last commit
+ */
+std::string InstrumentSnapshot::revision() { return Kernel::MantidVersion::revision(); }
+
+/**
+ * Check whether a snapshot of an instrument can be written. The components
+ * and shapes are checked as save does, but nothing is written.
+ * @param instrument :: A base instrument
+ * @return true if save will write the instrument
+ */
+bool InstrumentSnapshot::isSupported(const Instrument &instrument) {
+  try {
+    SnapshotChecker(instrument).check();
+  } catch (std::invalid_argument &) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Write a snapshot of an instrument. The file is written in the byte order
+ * of the machine, as the snapshot is a cache for the same machine.
+ * @param instrument :: A base instrument
+ * @param filename :: The file to write
+ * @throws std::invalid_argument if the instrument is not supported
+ * @throws std::runtime_error if the file cannot be written
+ */
+void InstrumentSnapshot::save(const Instrument &instrument, const std::string &filename) {
+  SnapshotWriter writer(instrument);
+  const auto &buffer = writer.write();
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  if (!out)
+    throw std::runtime_error("Unable to write instrument snapshot " + filename);
+}
+
+/**
+ * Create an instrument from a snapshot. The filename and the XML of the
+ * instrument definition are not part of the snapshot.
+ * @param filename :: The snapshot file
+ * @return the instrument
+ * @throws std::runtime_error if the file cannot be read or is not a snapshot
+ * of the current version and revision
+ */
+std::shared_ptr<Instrument> InstrumentSnapshot::load(const std::string &filename) {
+  std::ifstream in(filename, std::ios::binary | std::ios::ate);
+  if (!in)
+    throw std::runtime_error("Unable to open instrument snapshot " + filename);
+  std::vector<char> buffer(static_cast<size_t>(in.tellg()));
+  in.seekg(0);
+  in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  if (!in)
+    throw std::runtime_error("Unable to read instrument snapshot " + filename);
+  return SnapshotReader(buffer).read();
+}
+
+} // namespace Mantid::Geometry
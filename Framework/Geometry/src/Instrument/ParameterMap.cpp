@@ -303,6 +303,7 @@ void ParameterMap::clearParametersByName(const std::string &name) {
       ++itr;
     }
   }
+  ++m_generation;
   // Check if the caches need invalidating
   if (name == pos() || name == rot())
     clearPositionSensitiveCaches();
@@ -325,6 +326,7 @@ void ParameterMap::clearParametersByName(const std::string &name, const ICompone
         ++it;
       }
     }
+    ++m_generation;
 
     // Check if the caches need invalidating
     if (name == pos() || name == rot())
@@ -387,6 +389,7 @@ void ParameterMap::add(const IComponent *comp, const std::shared_ptr<Parameter>
     m_map.insert(std::make_pair(comp->getComponentID(), par));
 #endif
   }
+  ++m_generation;
 }
 
 /** Create or adjust "pos" parameter for a component
@@ -597,6 +600,7 @@ void ParameterMap::forceUnsafeSetMasked(const IComponent *comp, bool value) {
 #else
   m_map.insert(std::make_pair(comp->getComponentID(), param));
 #endif
+  ++m_generation;
 }
 
 /**
@@ -844,6 +848,83 @@ Parameter_sptr ParameterMap::getRecursiveByType(const IComponent *comp, const st
   return Parameter_sptr();
 }
 
+/**
+ * Find the parameters with a given name for every component of the
+ * instrument, as get or getRecursive would for each of them. The lookup is
+ * kept until parameters are added to or removed from the map, so that it is
+ * only built once for a loop over components, e.g. in an algorithm.
+ * @param name :: Parameter name, compared without case
+ * @param recursive :: If true a component without the parameter takes that
+ * of its nearest ancestor, as with getRecursive
+ * @returns the lookup, or a null pointer if the map does not belong to an
+ * instrument with a ComponentInfo
+ */
+std::shared_ptr<const ParameterLookup> ParameterMap::lookup(const std::string &name, const bool recursive) const {
+  checkIsNotMaskingParameter(name);
+  if (!m_componentInfo)
+    return nullptr;
+  const auto key = (recursive ? "/" : "") + boost::algorithm::to_lower_copy(name);
+  const size_t generation = m_generation;
+  {
+    std::lock_guard<std::mutex> lock(m_lookupMutex);
+    const auto cached = m_lookups.find(key);
+    if (cached != m_lookups.end() && cached->second.generation == generation)
+      return cached->second.lookup;
+  }
+  // Parameters added while the lookup is built change the generation, so the
+  // next call builds it again
+  std::shared_ptr<const ParameterLookup> result = buildLookup(name, recursive);
+  std::lock_guard<std::mutex> lock(m_lookupMutex);
+  m_lookups[key] = CachedLookup{generation, result};
+  return result;
+}
+
+/**
+ * Build a lookup of the parameters with a given name for each component index
+ * @param name :: Parameter name, compared without case
+ * @param recursive :: If true use the parameter of the nearest ancestor of a
+ * component without one
+ * @returns the new lookup
+ */
+std::shared_ptr<ParameterLookup> ParameterMap::buildLookup(const std::string &name, const bool recursive) const {
+  auto result = std::make_shared<ParameterLookup>();
+  const size_t nComponents = m_componentInfo->size();
+  auto &indices = result->m_indices;
+  indices.assign(nComponents, ParameterLookup::NOT_FOUND);
+  if (m_map.empty())
+    return result;
+  std::vector<bool> resolved(nComponents, false);
+  for (size_t i = 0; i < nComponents; ++i) {
+    auto itr = positionOf(m_componentInfo->componentID(i), name.c_str(), "");
+    if (itr != m_map.end()) {
+      indices[i] = static_cast<uint32_t>(result->m_parameters.size());
+      result->m_parameters.emplace_back(std::atomic_load(&itr->second));
+      resolved[i] = true;
+    }
+  }
+  if (!recursive)
+    return result;
+
+  // Components take the parameter of the nearest ancestor that has one. Each
+  // component is visited once, on the way up from the first of its
+  // descendants reached.
+  std::vector<size_t> path;
+  for (size_t i = 0; i < nComponents; ++i) {
+    size_t ancestor = i;
+    while (!resolved[ancestor] && m_componentInfo->hasParent(ancestor)) {
+      path.emplace_back(ancestor);
+      ancestor = m_componentInfo->parent(ancestor);
+    }
+    resolved[ancestor] = true;
+    for (const auto component : path) {
+      indices[component] = indices[ancestor];
+      resolved[component] = true;
+    }
+    path.clear();
+  }
+  return result;
+}
+
 /**
  * Find a parameter by name, recursively going up the component tree
  * to higher parents.
@@ -1006,6 +1087,7 @@ void ParameterMap::copyFromParameterMap(const IComponent *oldComp, const ICompon
     m_map.insert(std::make_pair(newComp->getComponentID(), std::move(thisParameter)));
 #endif
   }
+  ++m_generation;
 }
 
 //--------------------------------------------------------------------------------------------
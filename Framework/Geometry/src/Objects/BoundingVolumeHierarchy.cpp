@@ -0,0 +1,171 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace Mantid::Geometry {
+
+namespace {
+/// Maximum number of triangles in a leaf
+constexpr uint32_t LEAF_SIZE = 4;
+/// Tolerance relative to the longest triangle edge
+constexpr double RELATIVE_TOLERANCE = 1e-6;
+
+/// Grow the box [minPoint, maxPoint] to include the box [lower, upper]
+void expand(Kernel::V3D &minPoint, Kernel::V3D &maxPoint, const Kernel::V3D &lower, const Kernel::V3D &upper) {
+  for (size_t axis = 0; axis < 3; ++axis) {
+    minPoint[axis] = std::min(minPoint[axis], lower[axis]);
+    maxPoint[axis] = std::max(maxPoint[axis], upper[axis]);
+  }
+}
+} // namespace
+
+/**
+ * Build the hierarchy over a mesh
+ * @param triangles :: Three vertex indices per triangle
+ * @param vertices :: The vertices of the mesh
+ */
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<uint32_t> &triangles,
+                                                 const std::vector<Kernel::V3D> &vertices) {
+  const auto nTriangles = static_cast<uint32_t>(triangles.size() / 3);
+  m_triangleMin.resize(nTriangles);
+  m_triangleMax.resize(nTriangles);
+  std::vector<Kernel::V3D> centres(nTriangles);
+  double longestEdge(0.0);
+  for (uint32_t i = 0; i < nTriangles; ++i) {
+    const auto &v1 = vertices[triangles[3 * i]];
+    const auto &v2 = vertices[triangles[3 * i + 1]];
+    const auto &v3 = vertices[triangles[3 * i + 2]];
+    m_triangleMin[i] = v1;
+    m_triangleMax[i] = v1;
+    expand(m_triangleMin[i], m_triangleMax[i], v2, v2);
+    expand(m_triangleMin[i], m_triangleMax[i], v3, v3);
+    centres[i] = (m_triangleMin[i] + m_triangleMax[i]) * 0.5;
+    longestEdge = std::max({longestEdge, v1.distance(v2), v2.distance(v3), v3.distance(v1)});
+  }
+  m_tolerance = RELATIVE_TOLERANCE * longestEdge;
+  const Kernel::V3D padding(m_tolerance, m_tolerance, m_tolerance);
+  for (uint32_t i = 0; i < nTriangles; ++i) {
+    m_triangleMin[i] -= padding;
+    m_triangleMax[i] += padding;
+  }
+
+  m_order.resize(nTriangles);
+  std::iota(m_order.begin(), m_order.end(), 0);
+  if (nTriangles > 0) {
+    m_nodes.reserve(2 * (nTriangles / LEAF_SIZE + 1));
+    build(centres, 0, nTriangles);
+  }
+}
+
+/**
+ * Add the node for a range of m_order and, for more than LEAF_SIZE
+ * triangles, its children.
+ * @param centres :: The centres of the triangle boxes
+ * @param first :: Start of the range
+ * @param last :: End of the range
+ * @return the index of the node
+ */
+uint32_t BoundingVolumeHierarchy::build(std::vector<Kernel::V3D> &centres, uint32_t first, uint32_t last) {
+  const auto index = static_cast<uint32_t>(m_nodes.size());
+  m_nodes.emplace_back();
+
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  Kernel::V3D minPoint(inf, inf, inf), maxPoint(-inf, -inf, -inf);
+  Kernel::V3D minCentre(minPoint), maxCentre(maxPoint);
+  for (uint32_t i = first; i < last; ++i) {
+    const auto triangle = m_order[i];
+    expand(minPoint, maxPoint, m_triangleMin[triangle], m_triangleMax[triangle]);
+    expand(minCentre, maxCentre, centres[triangle], centres[triangle]);
+  }
+
+  Node node{minPoint, maxPoint, first, last - first, 0};
+  const auto extent = maxCentre - minCentre;
+  const size_t axis = (extent.X() >= extent.Y() && extent.X() >= extent.Z()) ? 0 : (extent.Y() >= extent.Z() ? 1 : 2);
+  if (node.count > LEAF_SIZE && extent[axis] > 0.0) {
+    const uint32_t middle = first + node.count / 2;
+    std::nth_element(m_order.begin() + first, m_order.begin() + middle, m_order.begin() + last,
+                     [&centres, axis](uint32_t a, uint32_t b) { return centres[a][axis] < centres[b][axis]; });
+    node.count = 0;
+    build(centres, first, middle);
+    node.secondChild = build(centres, middle, last);
+  }
+  m_nodes[index] = node;
+  return index;
+}
+
+/**
+ * Check if a ray crosses a box
+ * @param minPoint :: Lower corner of the box
+ * @param maxPoint :: Upper corner of the box
+ * @param start :: Start point of the ray
+ * @param direction :: Direction of the ray
+ * @return true if the ray crosses the box at or after m_tolerance behind its
+ * start
+ */
+bool BoundingVolumeHierarchy::rayCrossesBox(const Kernel::V3D &minPoint, const Kernel::V3D &maxPoint,
+                                            const Kernel::V3D &start, const Kernel::V3D &direction) const {
+  double tMin = -std::numeric_limits<double>::infinity();
+  double tMax = std::numeric_limits<double>::infinity();
+  for (size_t axis = 0; axis < 3; ++axis) {
+    if (direction[axis] == 0.0) {
+      if (start[axis] < minPoint[axis] || start[axis] > maxPoint[axis])
+        return false;
+      continue;
+    }
+    const double inverse = 1.0 / direction[axis];
+    double t1 = (minPoint[axis] - start[axis]) * inverse;
+    double t2 = (maxPoint[axis] - start[axis]) * inverse;
+    if (t1 > t2)
+      std::swap(t1, t2);
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+    if (tMin > tMax)
+      return false;
+  }
+  return tMax >= -m_tolerance;
+}
+
+/**
+ * Find the triangles that a ray may cross
+ * @param start :: Start point of the ray
+ * @param direction :: Direction of the ray
+ * @param candidates :: Cleared and filled with the indices of the triangles
+ * whose boxes the ray crosses, in increasing order
+ */
+void BoundingVolumeHierarchy::getCandidates(const Kernel::V3D &start, const Kernel::V3D &direction,
+                                            std::vector<uint32_t> &candidates) const {
+  candidates.clear();
+  if (m_nodes.empty())
+    return;
+  // The tree is balanced so its depth is far below this
+  uint32_t stack[64];
+  size_t stackSize(0);
+  stack[stackSize++] = 0;
+  while (stackSize > 0) {
+    const auto nodeIndex = stack[--stackSize];
+    const auto &node = m_nodes[nodeIndex];
+    if (!rayCrossesBox(node.minPoint, node.maxPoint, start, direction))
+      continue;
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        const auto triangle = m_order[i];
+        if (rayCrossesBox(m_triangleMin[triangle], m_triangleMax[triangle], start, direction))
+          candidates.emplace_back(triangle);
+      }
+    } else {
+      stack[stackSize++] = node.secondChild;
+      stack[stackSize++] = nodeIndex + 1;
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+}
+
+} // namespace Mantid::Geometry
@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidGeometry/Objects/CSGObject.h"
 
+#include "MantidGeometry/Objects/RuleProgram.h"
 #include "MantidGeometry/Objects/Rules.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/RandomPoint.h"
@@ -49,6 +50,19 @@ namespace {
 /// A shift to add/subtract to a point to test if it is an entry/exit point
 constexpr double VALID_INTERCEPT_POINT_SHIFT{2.5e-05};
 
+/**
+ * Classify a point on a track from the validity of the points shifted back
+ * and forward along the track
+ * @param flagA :: Whether the point shifted back is valid
+ * @param flagB :: Whether the point shifted forward is valid
+ * @return whether the track enters or leaves the object at the point
+ */
+TrackDirection validType(const bool flagA, const bool flagB) {
+  if (flagA == flagB)
+    return TrackDirection::INVALID;
+  return (flagA) ? TrackDirection::LEAVING : TrackDirection::ENTERING;
+}
+
 /**
  * Find the solid angle of a triangle defined by vectors a,b,c from point
  *"observer"
@@ -430,6 +444,7 @@ CSGObject &CSGObject::operator=(const CSGObject &A) {
     m_id = A.m_id;
     m_material = std::make_unique<Material>(A.material());
 
+    m_program.reset();
     if (m_topRule)
       createSurfaceList();
   }
@@ -787,9 +802,27 @@ int CSGObject::checkSurfaceValid(const Kernel::V3D &point, const Kernel::V3D &di
 bool CSGObject::isValid(const Kernel::V3D &point) const {
   if (!m_topRule)
     return false;
+  if (m_program)
+    return m_program->isValid(point);
   return m_topRule->isValid(point);
 }
 
+/**
+ * Determines which of a batch of points are within the object or on the
+ * surface
+ * @param points :: Points to be tested
+ * @param valid :: Set to 1 for the points that are valid and 0 for the others
+ */
+void CSGObject::isValid(const std::vector<Kernel::V3D> &points, std::vector<uint8_t> &valid) const {
+  if (m_program) {
+    m_program->isValid(points, valid);
+    return;
+  }
+  valid.resize(points.size());
+  std::transform(points.cbegin(), points.cend(), valid.begin(),
+                 [this](const Kernel::V3D &point) { return isValid(point) ? 1 : 0; });
+}
+
 /**
  * Determines is group of surface maps are valid
  * @param SMap :: map of SurfaceNumber : status
@@ -840,6 +873,8 @@ int CSGObject::createSurfaceList(const int outFlag) {
     };
   });
   m_surList.erase(newEnd, m_surList.end());
+  // The surfaces of the rules are set so the rules can be compiled
+  m_program = std::make_unique<RuleProgram>(m_topRule.get());
 
   if (outFlag) {
 
@@ -940,6 +975,8 @@ void CSGObject::print() const {
 void CSGObject::makeComplement() {
   std::unique_ptr<Rule> NCG = procComp(std::move(m_topRule));
   m_topRule = std::move(NCG);
+  if (m_program)
+    m_program = std::make_unique<RuleProgram>(m_topRule.get());
 }
 
 /**
@@ -995,6 +1032,7 @@ void CSGObject::write(std::ostream &outStream) const {
  * @returns 1 on success
  */
 int CSGObject::procString(const std::string &lineStr) {
+  m_program.reset();
   m_topRule = nullptr;
   std::map<int, std::unique_ptr<Rule>> RuleList; // List for the rules
   int Ridx = 0;                                  // Current index (not necessary size of RuleList
@@ -1086,17 +1124,31 @@ int CSGObject::interceptSurface(Geometry::Track &track) const {
   const auto &IPoints(LI.getPoints());
   const auto &dPoints(LI.getDistance());
 
+  // Test the points either side of all the forward going intersections
+  // together, to find the entrance and exit points as calcValidType does
+  const Kernel::V3D shift(track.direction() * VALID_INTERCEPT_POINT_SHIFT);
+  std::vector<Kernel::V3D> forwardPoints;
+  std::vector<Kernel::V3D> testPoints;
+  forwardPoints.reserve(IPoints.size());
+  testPoints.reserve(2 * IPoints.size());
   auto ditr = dPoints.begin();
   auto itrEnd = IPoints.end();
   for (auto iitr = IPoints.begin(); iitr != itrEnd; ++iitr, ++ditr) {
     if (*ditr > 0.0) // only interested in forward going points
     {
-      // Is the point and enterance/exit Point
-      const TrackDirection flag = calcValidType(*iitr, track.direction());
-      if (flag != TrackDirection::INVALID)
-        track.addPoint(flag, *iitr, *this);
+      forwardPoints.emplace_back(*iitr);
+      testPoints.emplace_back(*iitr - shift);
+      testPoints.emplace_back(*iitr + shift);
     }
   }
+  std::vector<uint8_t> valid;
+  isValid(testPoints, valid);
+  for (size_t i = 0; i < forwardPoints.size(); ++i) {
+    // Is the point and enterance/exit Point
+    const TrackDirection flag = validType(valid[2 * i] != 0, valid[2 * i + 1] != 0);
+    if (flag != TrackDirection::INVALID)
+      track.addPoint(flag, forwardPoints[i], *this);
+  }
   track.buildLink();
   // Return number of track segments added
   return (track.count() - originalCount);
@@ -1134,11 +1186,7 @@ double CSGObject::distance(const Geometry::Track &track) const {
  */
 TrackDirection CSGObject::calcValidType(const Kernel::V3D &point, const Kernel::V3D &uVec) const {
   const Kernel::V3D shift(uVec * VALID_INTERCEPT_POINT_SHIFT);
-  const int flagA = isValid(point - shift);
-  const int flagB = isValid(point + shift);
-  if (!(flagA ^ flagB))
-    return Geometry::TrackDirection::INVALID;
-  return (flagA) ? Geometry::TrackDirection::LEAVING : Geometry::TrackDirection::ENTERING;
+  return validType(isValid(point - shift), isValid(point + shift));
 }
 
 /**
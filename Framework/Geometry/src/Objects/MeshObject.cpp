@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidGeometry/Objects/MeshObject.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
 #include "MantidGeometry/Objects/MeshObjectCommon.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/RandomPoint.h"
@@ -175,7 +176,10 @@ int MeshObject::interceptSurface(Geometry::Track &UT) const {
 double MeshObject::distance(const Track &track) const {
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   TrackDirection unused;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  std::vector<uint32_t> candidates;
+  boundingVolumeHierarchy().getCandidates(track.startPoint(), track.direction(), candidates);
+  for (const auto i : candidates) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(track.startPoint(), track.direction(), vertex1, vertex2, vertex3,
                                                 intersection, unused)) {
       return track.startPoint().distance(intersection);
@@ -200,7 +204,11 @@ void MeshObject::getIntersections(const Kernel::V3D &start, const Kernel::V3D &d
 
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   TrackDirection entryExit;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  // Only the triangles whose boxes the ray crosses, in the order of the mesh
+  std::vector<uint32_t> candidates;
+  boundingVolumeHierarchy().getCandidates(start, direction, candidates);
+  for (const auto i : candidates) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(start, direction, vertex1, vertex2, vertex3, intersection, entryExit)) {
       intersectionPoints.emplace_back(intersection);
       entryExitFlags.emplace_back(entryExit);
@@ -209,6 +217,33 @@ void MeshObject::getIntersections(const Kernel::V3D &start, const Kernel::V3D &d
   // still need to deal with edge cases
 }
 
+/**
+ * Get the bounding volume hierarchy of the triangles, building it if the
+ * mesh has not been intersected since it was created or transformed.
+ * @returns the bounding volume hierarchy
+ */
+const BoundingVolumeHierarchy &MeshObject::boundingVolumeHierarchy() const {
+  if (!m_bvhBuilt.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(m_bvhMutex);
+    if (!m_bvh) {
+      m_bvh = std::make_shared<const BoundingVolumeHierarchy>(m_triangles, m_vertices);
+    }
+    m_bvhBuilt.store(true, std::memory_order_release);
+  }
+  return *m_bvh;
+}
+
+/**
+ * Discard the bounding box and the bounding volume hierarchy so that they are
+ * recalculated from the transformed vertices when next needed
+ */
+void MeshObject::resetGeometryCaches() {
+  m_boundingBox = BoundingBox();
+  std::lock_guard<std::mutex> lock(m_bvhMutex);
+  m_bvh.reset();
+  m_bvhBuilt.store(false, std::memory_order_release);
+}
+
 /*
  * Get a triangle - useful for iterating over triangles
  * @param index :: Index of triangle in MeshObject
@@ -479,6 +514,7 @@ void MeshObject::rotate(const Kernel::Matrix<double> &rotationMatrix) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex.rotate(rotationMatrix);
   }
+  resetGeometryCaches();
 }
 
 /**
@@ -489,6 +525,7 @@ void MeshObject::translate(const Kernel::V3D &translationVector) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex += translationVector;
   }
+  resetGeometryCaches();
 }
 
 /**
@@ -499,6 +536,7 @@ void MeshObject::scale(const double scaleFactor) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex *= scaleFactor;
   }
+  resetGeometryCaches();
 }
 
 /**
@@ -524,6 +562,7 @@ void MeshObject::multiply(const Kernel::Matrix<double> &matrix) {
     Kernel::V3D newvertex(vertexout[0], vertexout[1], vertexout[2]);
     vertex = newvertex;
   }
+  resetGeometryCaches();
 }
 
 /**
@@ -0,0 +1,256 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/RuleProgram.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Surfaces/Plane.h"
+#include "MantidGeometry/Surfaces/Sphere.h"
+#include "MantidKernel/Tolerance.h"
+
+#include <boost/container/small_vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+namespace Mantid::Geometry {
+
+namespace {
+/**
+ * Test a point against a plane in the same way as SurfPoint::isValid with
+ * Plane::side, for a positive sign. The normal and distance of a plane with a
+ * negative sign are negated when it is compiled.
+ * @param shape :: The normal and distance of the plane
+ * @param point :: The point to test
+ */
+inline bool planeValid(const std::array<double, 4> &shape, const Kernel::V3D &point) {
+  const double Dp = (shape[0] * point.X() + shape[1] * point.Y() + shape[2] * point.Z()) - shape[3];
+  // Plane::side is 0 within the tolerance, or if Dp is not a number
+  return !(Dp < -Kernel::Tolerance);
+}
+
+/**
+ * Test a point against a sphere in the same way as SurfPoint::isValid with
+ * Sphere::side
+ * @param shape :: The centre and radius of the sphere
+ * @param sign :: The sign of the surface
+ * @param point :: The point to test
+ */
+inline bool sphereValid(const std::array<double, 4> &shape, const int sign, const Kernel::V3D &point) {
+  const double xdiff(point.X() - shape[0]), ydiff(point.Y() - shape[1]), zdiff(point.Z() - shape[2]);
+  const double displace = std::sqrt(xdiff * xdiff + ydiff * ydiff + zdiff * zdiff) - shape[3];
+  // Sphere::side is 0 within the tolerance and -1 if displace is not a number
+  if (sign > 0)
+    return displace > -Kernel::Tolerance;
+  return !(displace >= Kernel::Tolerance);
+}
+} // namespace
+
+/**
+ * Compile a rule tree
+ * @param topRule :: The top rule of the tree, may be null
+ */
+RuleProgram::RuleProgram(const Rule *topRule) {
+  if (topRule)
+    compile(topRule);
+  else
+    emit(OpCode::Constant, 0);
+  // The depth of the value stack
+  size_t depth(0);
+  for (const auto &instruction : m_code) {
+    switch (instruction.op) {
+    case OpCode::Not:
+      break;
+    case OpCode::And:
+    case OpCode::Or:
+      --depth;
+      break;
+    default:
+      m_stackSize = std::max(m_stackSize, ++depth);
+    }
+  }
+}
+
+/**
+ * Add an instruction
+ * @param op :: The operation
+ * @param value :: The sign of a surface or the value of a constant
+ * @param surface :: The surface of a surface operation
+ * @param rule :: The rule of a Rule operation
+ * @return the index of the instruction
+ */
+size_t RuleProgram::emit(OpCode op, int value, const Surface *surface, const Geometry::Rule *rule) {
+  m_code.emplace_back(Instruction{op, value, {}, surface, rule});
+  return m_code.size() - 1;
+}
+
+/**
+ * Add the code of a rule and its leaves, in postfix order, reproducing the
+ * isValid method of each rule type
+ * @param rule :: The rule to compile
+ */
+void RuleProgram::compile(const Geometry::Rule *rule) {
+  if (const auto *surfPoint = dynamic_cast<const SurfPoint *>(rule)) {
+    const Surface *surface = surfPoint->getKey();
+    if (!surface) {
+      emit(OpCode::Constant, 0);
+    } else if (surfPoint->getSign() == 0) {
+      // side * sign is always 0
+      emit(OpCode::Constant, 1);
+    } else if (typeid(*surface) == typeid(Plane)) {
+      const auto &plane = static_cast<const Plane &>(*surface);
+      const double sign = surfPoint->getSign() > 0 ? 1.0 : -1.0;
+      const auto &normal = plane.getNormal();
+      m_code[emit(OpCode::Plane, surfPoint->getSign())].shape = {sign * normal.X(), sign * normal.Y(),
+                                                                 sign * normal.Z(), sign * plane.getDistance()};
+    } else if (typeid(*surface) == typeid(Sphere)) {
+      const auto &sphere = static_cast<const Sphere &>(*surface);
+      const auto centre = sphere.getCentre();
+      m_code[emit(OpCode::Sphere, surfPoint->getSign())].shape = {centre.X(), centre.Y(), centre.Z(),
+                                                                  sphere.getRadius()};
+    } else {
+      emit(OpCode::Surface, surfPoint->getSign(), surface);
+    }
+  } else if (dynamic_cast<const Intersection *>(rule) || dynamic_cast<const Union *>(rule)) {
+    const bool isIntersection = dynamic_cast<const Intersection *>(rule) != nullptr;
+    const Geometry::Rule *first = rule->leaf(0);
+    const Geometry::Rule *second = rule->leaf(1);
+    if (first && second) {
+      compile(first);
+      compile(second);
+      emit(isIntersection ? OpCode::And : OpCode::Or);
+    } else if (!isIntersection && (first || second)) {
+      compile(first ? first : second);
+    } else {
+      emit(OpCode::Constant, 0);
+    }
+  } else if (dynamic_cast<const CompGrp *>(rule)) {
+    if (const Geometry::Rule *group = rule->leaf(0)) {
+      compile(group);
+      emit(OpCode::Not);
+    } else {
+      emit(OpCode::Constant, 1);
+    }
+  } else {
+    // Complements of other objects and boolean values
+    emit(OpCode::Rule, 0, nullptr, rule);
+  }
+}
+
+/**
+ * Determine if a point is valid, with the same result as Rule::isValid for
+ * the top rule
+ * @param point :: Point to test
+ * @return true if the point is inside or on the surface of the object
+ */
+bool RuleProgram::isValid(const Kernel::V3D &point) const {
+  boost::container::small_vector<uint8_t, 16> stack(m_stackSize);
+  size_t top(0);
+  for (const auto &instruction : m_code) {
+    switch (instruction.op) {
+    case OpCode::Plane:
+      stack[top++] = planeValid(instruction.shape, point);
+      break;
+    case OpCode::Sphere:
+      stack[top++] = sphereValid(instruction.shape, instruction.value, point);
+      break;
+    case OpCode::Surface:
+      stack[top++] = instruction.surface->side(point) * instruction.value >= 0;
+      break;
+    case OpCode::Rule:
+      stack[top++] = instruction.rule->isValid(point);
+      break;
+    case OpCode::Constant:
+      stack[top++] = instruction.value != 0;
+      break;
+    case OpCode::Not:
+      stack[top - 1] = !stack[top - 1];
+      break;
+    case OpCode::And:
+      --top;
+      stack[top - 1] = stack[top - 1] & stack[top];
+      break;
+    case OpCode::Or:
+      --top;
+      stack[top - 1] = stack[top - 1] | stack[top];
+      break;
+    }
+  }
+  return stack[0] != 0;
+}
+
+/**
+ * Determine which of a batch of points are valid. Each instruction is
+ * applied to all the points before the next one.
+ * @param points :: Points to test
+ * @param valid :: Resized to the number of points, 1 for each point inside or
+ * on the surface of the object and 0 for the others
+ */
+void RuleProgram::isValid(const std::vector<Kernel::V3D> &points, std::vector<uint8_t> &valid) const {
+  const size_t nPoints = points.size();
+  // One column of values per stack entry, the first one is the result
+  valid.resize(nPoints);
+  std::vector<std::vector<uint8_t>> stack(m_stackSize - 1, std::vector<uint8_t>(nPoints));
+  auto column = [&valid, &stack](size_t index) -> uint8_t * {
+    return index == 0 ? valid.data() : stack[index - 1].data();
+  };
+  size_t top(0);
+  for (const auto &instruction : m_code) {
+    switch (instruction.op) {
+    case OpCode::Plane: {
+      auto *out = column(top++);
+      for (size_t i = 0; i < nPoints; ++i)
+        out[i] = planeValid(instruction.shape, points[i]);
+      break;
+    }
+    case OpCode::Sphere: {
+      auto *out = column(top++);
+      for (size_t i = 0; i < nPoints; ++i)
+        out[i] = sphereValid(instruction.shape, instruction.value, points[i]);
+      break;
+    }
+    case OpCode::Surface: {
+      auto *out = column(top++);
+      for (size_t i = 0; i < nPoints; ++i)
+        out[i] = instruction.surface->side(points[i]) * instruction.value >= 0;
+      break;
+    }
+    case OpCode::Rule: {
+      auto *out = column(top++);
+      for (size_t i = 0; i < nPoints; ++i)
+        out[i] = instruction.rule->isValid(points[i]);
+      break;
+    }
+    case OpCode::Constant:
+      std::fill_n(column(top++), nPoints, static_cast<uint8_t>(instruction.value != 0));
+      break;
+    case OpCode::Not: {
+      auto *out = column(top - 1);
+      for (size_t i = 0; i < nPoints; ++i)
+        out[i] = !out[i];
+      break;
+    }
+    case OpCode::And: {
+      --top;
+      auto *out = column(top - 1);
+      const auto *in = column(top);
+      for (size_t i = 0; i < nPoints; ++i)
+        out[i] &= in[i];
+      break;
+    }
+    case OpCode::Or: {
+      --top;
+      auto *out = column(top - 1);
+      const auto *in = column(top);
+      for (size_t i = 0; i < nPoints; ++i)
+        out[i] |= in[i];
+      break;
+    }
+    }
+  }
+}
+
+} // namespace Mantid::Geometry
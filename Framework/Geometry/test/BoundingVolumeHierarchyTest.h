@@ -0,0 +1,134 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
+#include "MantidGeometry/Objects/MeshObjectCommon.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <cmath>
+
+using Mantid::Geometry::BoundingVolumeHierarchy;
+using Mantid::Geometry::TrackDirection;
+using Mantid::Kernel::V3D;
+
+namespace {
+/// A sphere of triangles with the triangles facing outwards
+void createSphere(const size_t nRings, const size_t nSectors, std::vector<uint32_t> &triangles,
+                  std::vector<V3D> &vertices) {
+  vertices.clear();
+  triangles.clear();
+  for (size_t ring = 0; ring <= nRings; ++ring) {
+    const double theta = M_PI * static_cast<double>(ring) / static_cast<double>(nRings);
+    for (size_t sector = 0; sector < nSectors; ++sector) {
+      const double phi = 2.0 * M_PI * static_cast<double>(sector) / static_cast<double>(nSectors);
+      vertices.emplace_back(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+    }
+  }
+  auto addTriangle = [&](size_t a, size_t b, size_t c) {
+    const auto normal = (vertices[b] - vertices[a]).cross_prod(vertices[c] - vertices[a]);
+    if (normal.norm2() == 0.0)
+      return; // at a pole
+    if (normal.scalar_prod(vertices[a] + vertices[b] + vertices[c]) < 0.0)
+      std::swap(b, c);
+    triangles.insert(triangles.end(), {static_cast<uint32_t>(a), static_cast<uint32_t>(b), static_cast<uint32_t>(c)});
+  };
+  for (size_t ring = 0; ring < nRings; ++ring) {
+    for (size_t sector = 0; sector < nSectors; ++sector) {
+      const size_t next = (sector + 1) % nSectors;
+      const size_t p00 = ring * nSectors + sector, p01 = ring * nSectors + next;
+      const size_t p10 = (ring + 1) * nSectors + sector, p11 = (ring + 1) * nSectors + next;
+      addTriangle(p00, p10, p11);
+      addTriangle(p00, p11, p01);
+    }
+  }
+}
+
+/// Indices of all the triangles that a ray crosses
+std::vector<uint32_t> crossedTriangles(const std::vector<uint32_t> &triangles, const std::vector<V3D> &vertices,
+                                       const V3D &start, const V3D &direction) {
+  std::vector<uint32_t> crossed;
+  V3D intersection;
+  TrackDirection entryExit;
+  for (uint32_t i = 0; i < triangles.size() / 3; ++i) {
+    if (Mantid::Geometry::MeshObjectCommon::rayIntersectsTriangle(start, direction, vertices[triangles[3 * i]],
+                                                                   vertices[triangles[3 * i + 1]],
+                                                                   vertices[triangles[3 * i + 2]], intersection,
+                                                                   entryExit))
+      crossed.emplace_back(i);
+  }
+  return crossed;
+}
+} // namespace
+
+class BoundingVolumeHierarchyTest : public CxxTest::TestSuite {
+public:
+  void test_empty_mesh_has_no_candidates() {
+    BoundingVolumeHierarchy bvh({}, {});
+    std::vector<uint32_t> candidates{1, 2};
+    bvh.getCandidates(V3D(0, 0, 0), V3D(0, 0, 1), candidates);
+    TS_ASSERT(candidates.empty());
+    TS_ASSERT_EQUALS(bvh.numberOfNodes(), 0);
+  }
+
+  void test_candidates_include_every_crossed_triangle() {
+    std::vector<uint32_t> triangles;
+    std::vector<V3D> vertices;
+    createSphere(20, 40, triangles, vertices);
+    BoundingVolumeHierarchy bvh(triangles, vertices);
+    TS_ASSERT_LESS_THAN(1, bvh.numberOfNodes());
+
+    Mantid::Kernel::MersenneTwister rng(1234, -2.0, 2.0);
+    std::vector<uint32_t> candidates;
+    size_t nCandidates(0);
+    const size_t nRays(500);
+    for (size_t i = 0; i < nRays; ++i) {
+      const V3D start(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      V3D direction(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      direction.normalize();
+      bvh.getCandidates(start, direction, candidates);
+      TS_ASSERT(std::is_sorted(candidates.begin(), candidates.end()));
+      for (const auto crossed : crossedTriangles(triangles, vertices, start, direction)) {
+        TS_ASSERT(std::binary_search(candidates.begin(), candidates.end(), crossed));
+      }
+      nCandidates += candidates.size();
+    }
+    // only a small part of the mesh is tested per ray
+    TS_ASSERT_LESS_THAN(nCandidates, nRays * triangles.size() / 30);
+  }
+
+  void test_rays_along_axes_through_vertices_and_edges() {
+    std::vector<uint32_t> triangles;
+    std::vector<V3D> vertices;
+    createSphere(8, 8, triangles, vertices);
+    BoundingVolumeHierarchy bvh(triangles, vertices);
+    std::vector<uint32_t> candidates;
+    for (const auto &direction : {V3D(1, 0, 0), V3D(0, 1, 0), V3D(0, 0, 1), V3D(0, 0, -1)}) {
+      for (const auto &start : {V3D(0, 0, 0), V3D(0, 0, 0.5), V3D(0.5, 0, 0), V3D(-3, 0, 0), V3D(0, 0, -3)}) {
+        bvh.getCandidates(start, direction, candidates);
+        for (const auto crossed : crossedTriangles(triangles, vertices, start, direction)) {
+          TS_ASSERT(std::binary_search(candidates.begin(), candidates.end(), crossed));
+        }
+      }
+    }
+  }
+
+  void test_ray_pointing_away_has_no_candidates() {
+    std::vector<uint32_t> triangles;
+    std::vector<V3D> vertices;
+    createSphere(8, 8, triangles, vertices);
+    BoundingVolumeHierarchy bvh(triangles, vertices);
+    std::vector<uint32_t> candidates;
+    bvh.getCandidates(V3D(3, 0, 0), V3D(1, 0, 0), candidates);
+    TS_ASSERT(candidates.empty());
+    bvh.getCandidates(V3D(3, 0, 0), V3D(0, 1, 0), candidates);
+    TS_ASSERT(candidates.empty());
+  }
+};
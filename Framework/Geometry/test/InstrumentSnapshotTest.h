@@ -0,0 +1,228 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidFrameworkTestHelpers/ScopedFileHelper.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/InstrumentSnapshot.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/StructuredDetector.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Interpolation.h"
+#include "MantidKernel/Strings.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <fstream>
+#include <set>
+
+using namespace Mantid::Geometry;
+using Mantid::detid_t;
+using Mantid::Kernel::ConfigService;
+using ScopedFileHelper::ScopedFile;
+
+class InstrumentSnapshotTest : public CxxTest::TestSuite {
+public:
+  void test_parsed_instrument_is_created_again() {
+    auto parsed = parse("IDF_for_UNIT_TESTING2.xml", "For Unit Testing2");
+    TS_ASSERT(InstrumentSnapshot::isSupported(*parsed));
+    ScopedFile file("", "InstrumentSnapshotTest_parsed.instrument");
+    TS_ASSERT_THROWS_NOTHING(InstrumentSnapshot::save(*parsed, file.getFileName()));
+    std::shared_ptr<Instrument> loaded;
+    TS_ASSERT_THROWS_NOTHING(loaded = InstrumentSnapshot::load(file.getFileName()));
+    checkSameInstrument(*parsed, *loaded);
+
+    // the lookup table of a fitting parameter
+    const auto lookup = findParameter(*loaded, "somefunction:toplevel2");
+    TS_ASSERT(lookup);
+    TS_ASSERT(lookup->m_interpolation->containData());
+    const auto parsedLookup = findParameter(*parsed, "somefunction:toplevel2");
+    TS_ASSERT_EQUALS(lookup->m_interpolation->value(1001.3), parsedLookup->m_interpolation->value(1001.3));
+  }
+
+  void test_rectangular_detectors_are_created_again() {
+    auto parsed = parse("IDF_for_RECTANGULAR_UNIT_TESTING.xml", "RectangularUnitTest");
+    ScopedFile file("", "InstrumentSnapshotTest_rectangular.instrument");
+    InstrumentSnapshot::save(*parsed, file.getFileName());
+    const auto loaded = InstrumentSnapshot::load(file.getFileName());
+    checkSameInstrument(*parsed, *loaded);
+
+    const auto bank = std::dynamic_pointer_cast<const RectangularDetector>(loaded->getComponentByName("bank1"));
+    TS_ASSERT(bank);
+    const auto parsedBank = std::dynamic_pointer_cast<const RectangularDetector>(parsed->getComponentByName("bank1"));
+    TS_ASSERT_EQUALS(bank->xpixels(), parsedBank->xpixels());
+    TS_ASSERT_EQUALS(bank->ypixels(), parsedBank->ypixels());
+    TS_ASSERT_EQUALS(bank->getDetectorIDAtXY(1, 2), parsedBank->getDetectorIDAtXY(1, 2));
+  }
+
+  void test_unsupported_components_are_not_written() {
+    auto instrument = std::make_shared<Instrument>("unsupported");
+    new StructuredDetector("structured", instrument.get());
+    TS_ASSERT(!InstrumentSnapshot::isSupported(*instrument));
+    TS_ASSERT_THROWS(InstrumentSnapshot::save(*instrument, "unused.instrument"), const std::invalid_argument &);
+  }
+
+  void test_snapshot_of_another_version_is_rejected() {
+    auto parsed = parse("IDF_for_UNIT_TESTING2.xml", "For Unit Testing2");
+    ScopedFile file("", "InstrumentSnapshotTest_version.instrument");
+    InstrumentSnapshot::save(*parsed, file.getFileName());
+    // the version follows the length and text of the magic string
+    std::fstream stream(file.getFileName(), std::ios::binary | std::ios::in | std::ios::out);
+    uint64_t magicLength(0);
+    stream.read(reinterpret_cast<char *>(&magicLength), sizeof(magicLength));
+    stream.seekp(static_cast<std::streamoff>(sizeof(magicLength) + magicLength));
+    const uint32_t version = InstrumentSnapshot::VERSION + 1;
+    stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    stream.close();
+    TS_ASSERT_THROWS(InstrumentSnapshot::load(file.getFileName()), const std::runtime_error &);
+  }
+
+  void test_snapshot_of_another_revision_is_rejected() {
+    auto parsed = parse("IDF_for_UNIT_TESTING2.xml", "For Unit Testing2");
+    ScopedFile file("", "InstrumentSnapshotTest_revision.instrument");
+    InstrumentSnapshot::save(*parsed, file.getFileName());
+    // the revision follows the magic string and the version
+    std::fstream stream(file.getFileName(), std::ios::binary | std::ios::in | std::ios::out);
+    uint64_t magicLength(0);
+    stream.read(reinterpret_cast<char *>(&magicLength), sizeof(magicLength));
+    const auto revisionText =
+        static_cast<std::streamoff>(sizeof(magicLength) + magicLength + sizeof(uint32_t) + sizeof(uint64_t));
+    stream.seekg(revisionText);
+    char first(0);
+    stream.read(&first, 1);
+    first = first == 'x' ? 'y' : 'x';
+    stream.seekp(revisionText);
+    stream.write(&first, 1);
+    stream.close();
+    TS_ASSERT_THROWS(InstrumentSnapshot::load(file.getFileName()), const std::runtime_error &);
+  }
+
+  void test_snapshot_file_name_holds_the_revision_and_the_snapshot_directory() {
+    auto &config = ConfigService::Instance();
+    const std::string key("instrumentDefinition.snapshot.directory");
+    const std::string previous = config.getString(key);
+    Poco::Path directory(Poco::Path::temp());
+    directory.pushDirectory("InstrumentSnapshotTest");
+    config.setString(key, directory.toString());
+    const std::string filename = config.getInstrumentDirectory() + "/unit_testing/IDF_for_UNIT_TESTING2.xml";
+    InstrumentDefinitionParser parser(filename, "For Unit Testing2", Mantid::Kernel::Strings::loadFile(filename));
+    const Poco::Path snapshot(parser.createSnapshotFileName());
+    config.setString(key, previous);
+    TS_ASSERT_EQUALS(snapshot.parent().toString(), directory.toString());
+    TS_ASSERT_EQUALS(snapshot.getFileName(),
+                     parser.getMangledName() + "." + InstrumentSnapshot::revision() + ".instrument");
+  }
+
+  void test_saving_a_snapshot_removes_those_of_other_revisions() {
+    auto &config = ConfigService::Instance();
+    const std::string key("instrumentDefinition.snapshot.directory");
+    const std::string previous = config.getString(key);
+    Poco::Path directory(Poco::Path::temp());
+    directory.pushDirectory("InstrumentSnapshotTest_stale");
+    Poco::File(directory).createDirectories();
+    config.setString(key, directory.toString());
+    const auto inDirectory = [&directory](const std::string &name) { return Poco::Path(directory, name).toString(); };
+    std::ofstream(inDirectory("Old.stale.instrument")) << "stale";
+    std::ofstream(inDirectory("other.txt")) << "other";
+
+    const std::string filename = config.getInstrumentDirectory() + "/unit_testing/IDF_for_UNIT_TESTING2.xml";
+    InstrumentDefinitionParser parser(filename, "For Unit Testing2", Mantid::Kernel::Strings::loadFile(filename));
+    parser.parseXML(nullptr);
+    parser.saveSnapshot();
+    const std::string snapshot = parser.createSnapshotFileName();
+    config.setString(key, previous);
+
+    TS_ASSERT(Poco::File(snapshot).exists());
+    TS_ASSERT(!Poco::File(inDirectory("Old.stale.instrument")).exists());
+    TS_ASSERT(Poco::File(inDirectory("other.txt")).exists());
+    Poco::File(directory).remove(true);
+  }
+
+  void test_detectors_outside_the_tree_are_not_supported() {
+    // the instrument does not own the detector, which outlives it
+    const auto detector = std::make_unique<Detector>("pixel", 1, nullptr);
+    auto instrument = std::make_shared<Instrument>("outside");
+    instrument->markAsDetector(detector.get());
+    TS_ASSERT(!InstrumentSnapshot::isSupported(*instrument));
+    TS_ASSERT_THROWS(InstrumentSnapshot::save(*instrument, "unused.instrument"), const std::invalid_argument &);
+  }
+
+  void test_truncated_snapshot_is_rejected() {
+    ScopedFile file("MantidInstrumentSnapshot", "InstrumentSnapshotTest_truncated.instrument");
+    TS_ASSERT_THROWS(InstrumentSnapshot::load(file.getFileName()), const std::runtime_error &);
+  }
+
+private:
+  std::shared_ptr<Instrument> parse(const std::string &idf, const std::string &name) {
+    const std::string filename = ConfigService::Instance().getInstrumentDirectory() + "/unit_testing/" + idf;
+    InstrumentDefinitionParser parser(filename, name, Mantid::Kernel::Strings::loadFile(filename));
+    return parser.parseXML(nullptr);
+  }
+
+  std::shared_ptr<const XMLInstrumentParameter> findParameter(const Instrument &instrument,
+                                                              const std::string &name) {
+    for (const auto &entry : instrument.getLogfileCache()) {
+      if (entry.first.first == name)
+        return entry.second;
+    }
+    return nullptr;
+  }
+
+  /// The parameters of the logfile cache, which is ordered by component address
+  std::multiset<std::string> parameters(const Instrument &instrument) {
+    std::multiset<std::string> out;
+    for (const auto &entry : instrument.getLogfileCache()) {
+      const auto &param = *entry.second;
+      out.emplace(entry.first.first + "|" + entry.first.second->getFullName() + "|" + param.m_paramName + "|" +
+                  param.m_value + "|" + param.m_type + "|" + param.m_formula + "|" + param.m_penaltyFactor + "|" +
+                  param.m_component->getFullName());
+    }
+    return out;
+  }
+
+  void checkSameInstrument(const Instrument &expected, const Instrument &actual) {
+    TS_ASSERT_EQUALS(actual.getName(), expected.getName());
+    TS_ASSERT_EQUALS(actual.getDefaultView(), expected.getDefaultView());
+    TS_ASSERT_EQUALS(actual.getValidFromDate(), expected.getValidFromDate());
+    TS_ASSERT_EQUALS(actual.getReferenceFrame()->pointingUp(), expected.getReferenceFrame()->pointingUp());
+    TS_ASSERT_EQUALS(actual.getReferenceFrame()->pointingAlongBeam(),
+                     expected.getReferenceFrame()->pointingAlongBeam());
+
+    TS_ASSERT_EQUALS(actual.getSource()->getName(), expected.getSource()->getName());
+    TS_ASSERT_EQUALS(actual.getSource()->getPos(), expected.getSource()->getPos());
+    TS_ASSERT_EQUALS(actual.getSample()->getName(), expected.getSample()->getName());
+    TS_ASSERT_EQUALS(actual.getSample()->getPos(), expected.getSample()->getPos());
+
+    const auto detIDs = expected.getDetectorIDs();
+    TS_ASSERT_EQUALS(actual.getDetectorIDs(), detIDs);
+    TS_ASSERT_EQUALS(actual.getMonitors(), expected.getMonitors());
+    for (const detid_t detID : detIDs) {
+      const auto expectedDet = expected.getDetector(detID);
+      const auto actualDet = actual.getDetector(detID);
+      TS_ASSERT_EQUALS(actualDet->getFullName(), expectedDet->getFullName());
+      TS_ASSERT_DELTA(actualDet->getPos().distance(expectedDet->getPos()), 0.0, 1e-12);
+      TS_ASSERT(actualDet->getRotation() == expectedDet->getRotation());
+      const auto *expectedShape = dynamic_cast<const CSGObject *>(expectedDet->shape().get());
+      const auto *actualShape = dynamic_cast<const CSGObject *>(actualDet->shape().get());
+      TS_ASSERT(actualShape);
+      TS_ASSERT_EQUALS(actualShape->getShapeXML(), expectedShape->getShapeXML());
+      TS_ASSERT_EQUALS(actualShape->getName(), expectedShape->getName());
+    }
+
+    TS_ASSERT_EQUALS(actual.getLogfileCache().size(), expected.getLogfileCache().size());
+    TS_ASSERT_EQUALS(parameters(actual), parameters(expected));
+    TS_ASSERT_EQUALS(actual.getLogfileUnit(), expected.getLogfileUnit());
+  }
+};
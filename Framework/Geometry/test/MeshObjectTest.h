@@ -899,6 +899,19 @@ public:
     auto moved = octahedron->getVertices();
     TS_ASSERT_DELTA(moved, checkVector, 1e-8);
   }
+
+  void testInterceptAfterTranslation() {
+    auto octahedron = createOctahedron();
+    Track before(V3D(-10, 0.2, 0.2), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(octahedron->interceptSurface(before), 1);
+
+    octahedron->translate(V3D(0, 5, 0));
+    Track missed(V3D(-10, 0.2, 0.2), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(octahedron->interceptSurface(missed), 0);
+    Track after(V3D(-10, 5.2, 0.2), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(octahedron->interceptSurface(after), 1);
+    TS_ASSERT_DELTA(octahedron->distance(after), 9.4, 1e-8);
+  }
 };
 
 // -----------------------------------------------------------------------------
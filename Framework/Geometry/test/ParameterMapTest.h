@@ -9,6 +9,7 @@
 #include "MantidBeamline/ComponentInfo.h"
 #include "MantidBeamline/DetectorInfo.h"
 #include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/Parameter.h"
 #include "MantidGeometry/Instrument/ParameterFactory.h"
@@ -231,6 +232,42 @@ public:
     TS_ASSERT_DELTA(finalValue, stored->value<double>(), DBL_EPSILON);
   }
 
+  void test_lookup_finds_parameters_by_component_index() {
+    ParameterMap pmap;
+    // no instrument to index the components
+    TS_ASSERT(!pmap.lookup("testDouble"));
+    pmap.setInstrument(m_testInstrument.get());
+    const auto &componentInfo = pmap.componentInfo();
+    const size_t detector(0), otherDetector(1);
+    const size_t bank = componentInfo.parent(detector);
+    pmap.addDouble(componentInfo.componentID(bank), "testDouble", 2.0);
+    pmap.addDouble(componentInfo.componentID(detector), "testDouble", 1.0);
+
+    const auto direct = pmap.lookup("TestDouble");
+    TS_ASSERT_EQUALS(direct->size(), componentInfo.size());
+    TS_ASSERT_EQUALS(direct->get(detector)->value<double>(), 1.0);
+    TS_ASSERT_EQUALS(direct->get(bank)->value<double>(), 2.0);
+    TS_ASSERT(!direct->get(otherDetector));
+    // the same lookup is returned until the map changes
+    TS_ASSERT_EQUALS(pmap.lookup("testDouble"), direct);
+
+    const auto recursive = pmap.lookup("testDouble", true);
+    for (size_t i = 0; i < componentInfo.size(); ++i) {
+      const auto expected = pmap.getRecursive(componentInfo.componentID(i), "testDouble");
+      TS_ASSERT_EQUALS(recursive->get(i), expected.get());
+    }
+    TS_ASSERT_EQUALS(recursive->get(otherDetector)->value<double>(), 2.0);
+    TS_ASSERT(!recursive->get(componentInfo.root()));
+
+    pmap.addDouble(componentInfo.componentID(otherDetector), "testDouble", 3.0);
+    // existing lookups are snapshots
+    TS_ASSERT(!direct->get(otherDetector));
+    TS_ASSERT_EQUALS(pmap.lookup("testDouble")->get(otherDetector)->value<double>(), 3.0);
+    TS_ASSERT_EQUALS(pmap.lookup("testDouble", true)->get(otherDetector)->value<double>(), 3.0);
+    pmap.clearParametersByName("testDouble");
+    TS_ASSERT(!pmap.lookup("testDouble")->get(detector));
+  }
+
   void test_Replacing_Existing_Parameter_On_A_Copy_Does_Not_Update_Original_Value_Using_Generic_Add() {
     using namespace Mantid::Kernel;
 
@@ -0,0 +1,100 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/RuleProgram.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <cxxtest/TestSuite.h>
+
+using Mantid::Geometry::CSGObject;
+using Mantid::Geometry::RuleProgram;
+using Mantid::Kernel::V3D;
+
+class RuleProgramTest : public CxxTest::TestSuite {
+public:
+  void test_null_rule_is_never_valid() {
+    RuleProgram program(nullptr);
+    TS_ASSERT(!program.isValid(V3D(0, 0, 0)));
+  }
+
+  void test_cuboid_matches_rules() {
+    checkMatchesRules(*ComponentCreationHelper::createCuboid(0.5, 0.3, 0.2));
+  }
+
+  void test_rotated_cuboid_matches_rules() {
+    checkMatchesRules(*ComponentCreationHelper::createCuboid(0.3, 0.5, 0.2, M_PI / 5., V3D(1, 1, 0)));
+  }
+
+  void test_capped_cylinder_matches_rules() {
+    checkMatchesRules(
+        *ComponentCreationHelper::createCappedCylinder(0.4, 1.0, V3D(0, -0.5, 0), V3D(0., 1.0, 0.), "cylinder"));
+  }
+
+  void test_hollow_shell_matches_rules() {
+    // complement of a group
+    checkMatchesRules(*ComponentCreationHelper::createHollowShell(0.5, 1.0));
+  }
+
+  void test_union_matches_rules() {
+    const std::string xml = ComponentCreationHelper::sphereXML(0.4, V3D(-0.4, 0, 0), "left") +
+                            ComponentCreationHelper::sphereXML(0.4, V3D(0.4, 0, 0), "right") +
+                            ComponentCreationHelper::cuboidXML(0.1, 0.6, 0.6, V3D(0, 0, 0), "middle") +
+                            "<algebra val=\"(left : right) middle\" />";
+    Mantid::Geometry::ShapeFactory shapeMaker;
+    checkMatchesRules(*shapeMaker.createShape(xml));
+  }
+
+  void test_batch_matches_single_points() {
+    auto shell = ComponentCreationHelper::createHollowShell(0.5, 1.0);
+    const RuleProgram program(shell->topRule());
+    const auto points = randomPoints(200);
+    std::vector<uint8_t> valid;
+    program.isValid(points, valid);
+    TS_ASSERT_EQUALS(valid.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      TS_ASSERT_EQUALS(valid[i] != 0, program.isValid(points[i]));
+    }
+  }
+
+private:
+  /// Random points in and around the shapes, and points on their surfaces
+  std::vector<V3D> randomPoints(const size_t n) {
+    Mantid::Kernel::MersenneTwister rng(345, -1.2, 1.2);
+    std::vector<V3D> points;
+    for (size_t i = 0; i < n; ++i) {
+      points.emplace_back(rng.nextValue(), rng.nextValue(), rng.nextValue());
+    }
+    for (const double x : {-1.0, -0.5, -0.4, -0.2, 0.0, 0.2, 0.4, 0.5, 1.0}) {
+      points.emplace_back(x, 0.0, 0.0);
+      points.emplace_back(0.0, x, 0.0);
+      points.emplace_back(0.0, 0.0, x);
+    }
+    return points;
+  }
+
+  void checkMatchesRules(const CSGObject &object) {
+    const auto *rule = object.topRule();
+    TS_ASSERT(rule);
+    const RuleProgram program(rule);
+    TS_ASSERT_LESS_THAN(0, program.size());
+    size_t nInside(0);
+    for (const auto &point : randomPoints(2000)) {
+      const bool expected = rule->isValid(point);
+      TS_ASSERT_EQUALS(program.isValid(point), expected);
+      TS_ASSERT_EQUALS(object.isValid(point), expected);
+      if (expected)
+        ++nInside;
+    }
+    // the points test both sides of the surfaces
+    TS_ASSERT_LESS_THAN(0, nInside);
+  }
+};
@@ -0,0 +1,70 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstdint>
+#include <string>
+
+namespace Mantid {
+namespace Kernel {
+
+/** MemoryMappedFile : maps the whole of a file into the address space of the
+  process, so that reading and writing it is done through the page cache of
+  the operating system rather than through explicit I/O calls.
+
+  Resizing the file remaps it, which invalidates any pointer previously
+  returned by data(). The class does no locking of its own: callers sharing a
+  file between threads must not access it while it is being resized.
+*/
+class MANTID_KERNEL_DLL MemoryMappedFile {
+public:
+  MemoryMappedFile(const std::string &filename, const bool readOnly);
+  ~MemoryMappedFile();
+  MemoryMappedFile(const MemoryMappedFile &) = delete;
+  MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+  void resize(const uint64_t size);
+  void flush();
+
+  /// Start of the mapped file, nullptr if the file is empty
+  char *data() { return m_data; }
+  /// Start of the mapped file, nullptr if the file is empty
+  const char *data() const { return m_data; }
+  /// Size of the file in bytes
+  uint64_t size() const { return m_size; }
+  /// True if the file can only be read
+  bool isReadOnly() const { return m_readOnly; }
+  /// Name of the file
+  const std::string &filename() const { return m_filename; }
+
+private:
+  void map();
+  void unmap();
+
+  /// Name of the file
+  const std::string m_filename;
+  /// True if the file was opened for reading only
+  const bool m_readOnly;
+  /// Size of the file in bytes
+  uint64_t m_size{0};
+  /// Start of the mapping
+  char *m_data{nullptr};
+#ifdef _WIN32
+  /// Handle to the open file
+  void *m_file{nullptr};
+  /// Handle to the file mapping object
+  void *m_mapping{nullptr};
+#else
+  /// Descriptor of the open file
+  int m_file{-1};
+#endif
+};
+
+} // namespace Kernel
+} // namespace Mantid
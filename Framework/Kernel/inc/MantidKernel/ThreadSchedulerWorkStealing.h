@@ -0,0 +1,74 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : a ThreadScheduler with one queue per worker
+ * thread instead of a single shared queue, so that threads popping and pushing
+ * many small tasks do not all wait for the same lock.
+ *
+ * - A task pushed while running another task of this scheduler goes to the
+ *   back of the queue of that worker. Other tasks go to the queue with the
+ *   lowest total Task::cost() waiting in it.
+ * - A worker takes its newest task first. When its queue is empty it steals
+ *   the oldest task of another queue, trying the queues from a random one.
+ * - Tasks whose Task::getMutex() is held by a running task are passed over
+ *   while other tasks are available, as in ThreadSchedulerMutexes.
+ */
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  ThreadSchedulerWorkStealing(size_t numQueues = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(std::shared_ptr<Task> newTask) override;
+  std::shared_ptr<Task> pop(size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+
+  /// Number of worker queues
+  size_t numQueues() const { return m_queues.size(); }
+
+private:
+  /// The tasks waiting for one worker
+  struct alignas(64) WorkerQueue {
+    /// Protects tasks and pushedCost
+    std::mutex mutex;
+    /// Tasks waiting, oldest first
+    std::deque<std::shared_ptr<Task>> tasks;
+    /// Cost of the waiting tasks. Read without the lock to place new tasks.
+    std::atomic<double> waitingCost{0.0};
+    /// Cost of all the tasks pushed since the queue was last cleared
+    double pushedCost{0.0};
+  };
+
+  void pushTo(WorkerQueue &queue, std::shared_ptr<Task> task);
+  std::shared_ptr<Task> takeFrom(WorkerQueue &queue, const bool newest, const bool skipBusy);
+  size_t leastLoadedQueue();
+
+  /// One queue per worker thread
+  std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+  /// Number of tasks waiting in all queues
+  std::atomic<size_t> m_size{0};
+  /// Queue to look at first when placing a task pushed from outside
+  std::atomic<size_t> m_nextQueue{0};
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -15,6 +15,7 @@
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
 #include <cstdint>
+#include <tuple>
 #include <utility>
 
 // Forward declare
@@ -312,6 +313,16 @@ private:
   bool isTimeFiltered(const Types::Core::DateAndTime &time) const;
   /// Time weighted mean and standard deviation
   std::pair<double, double> timeAverageValueAndStdDev() const;
+  /// Build the time and integral indexes of the sorted values if needed
+  void buildIndex() const;
+  /// Add the last value, appended in time order, to the indexes
+  void appendToIndex() const;
+  /// Discard the indexes after the values have changed
+  void invalidateIndex() const { m_indexValid = false; }
+  /// Integrals of (value - first value) and its square from the first time up to t
+  std::pair<double, double> integralsUpTo(int64_t t) const;
+  /// Total duration and integrals of (value - first value) and its square in a filter
+  std::tuple<double, double, double> integralsInFilter(const std::vector<SplittingInterval> &filter) const;
 
   /// Holds the time series data
   mutable std::vector<TimeValueUnit<TYPE>> m_values;
@@ -329,6 +340,15 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+
+  /// Times of the sorted values in nanoseconds, for binary searches
+  mutable std::vector<int64_t> m_timeIndex;
+  /// Running integral over time of (value - first value) at each time, numeric types only
+  mutable std::vector<double> m_valueIntegral;
+  /// Running integral over time of (value - first value)^2 at each time, numeric types only
+  mutable std::vector<double> m_squareIntegral;
+  /// True if the indexes above describe m_values
+  mutable bool m_indexValid;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
@@ -702,6 +702,20 @@ private:
 
 //=================================================================================================
 
+/** Convert values in place from one unit to another by way of time-of-flight,
+ * in a single pass. Both units must have been initialized. The common units
+ * (TOF, Wavelength, Energy, dSpacing, MomentumTransfer, QSquared, DeltaE and
+ * Momentum) have a loop compiled for each pair, in which the two conversions
+ * are inlined rather than called through the virtual singleToTOF() and
+ * singleFromTOF(). Other units fall back to the virtual calls.
+ */
+MANTID_KERNEL_DLL void convertViaTOF(const Unit &fromUnit, const Unit &toUnit, double *first, double *last);
+
+/// Convert all the values of a vector in place, see the pointer overload
+inline void convertViaTOF(const Unit &fromUnit, const Unit &toUnit, std::vector<double> &values) {
+  convertViaTOF(fromUnit, toUnit, values.data(), values.data() + values.size());
+}
+
 MANTID_KERNEL_DLL double timeConversionValue(const std::string &input_unit, const std::string &output_unit);
 
 template <typename T>
@@ -0,0 +1,161 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/MemoryMappedFile.h"
+#include "MantidKernel/Exception.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Mantid::Kernel {
+
+/** Open a file and map it into memory
+ * @param filename :: name of the file. It is created if it does not exist and
+ * readOnly is false.
+ * @param readOnly :: true to open the file for reading only
+ * @throws Exception::FileError if the file cannot be opened or mapped
+ */
+MemoryMappedFile::MemoryMappedFile(const std::string &filename, const bool readOnly)
+    : m_filename(filename), m_readOnly(readOnly) {
+#ifdef _WIN32
+  const DWORD access = readOnly ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+  const DWORD creation = readOnly ? OPEN_EXISTING : OPEN_ALWAYS;
+  HANDLE file =
+      CreateFileA(filename.c_str(), access, FILE_SHARE_READ, nullptr, creation, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    throw Exception::FileError("Unable to open file for memory mapping", filename);
+  m_file = file;
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize)) {
+    CloseHandle(file);
+    throw Exception::FileError("Unable to get the size of file", filename);
+  }
+  m_size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+  m_file = ::open(filename.c_str(), readOnly ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+  if (m_file < 0)
+    throw Exception::FileError("Unable to open file for memory mapping", filename);
+  struct stat status;
+  if (::fstat(m_file, &status) != 0) {
+    ::close(m_file);
+    throw Exception::FileError("Unable to get the size of file", filename);
+  }
+  m_size = static_cast<uint64_t>(status.st_size);
+#endif
+  try {
+    map();
+  } catch (...) {
+#ifdef _WIN32
+    CloseHandle(static_cast<HANDLE>(m_file));
+#else
+    ::close(m_file);
+#endif
+    throw;
+  }
+}
+
+/// Unmap and close the file. Changes reach the disk through the page cache.
+MemoryMappedFile::~MemoryMappedFile() {
+  unmap();
+#ifdef _WIN32
+  CloseHandle(static_cast<HANDLE>(m_file));
+#else
+  ::close(m_file);
+#endif
+}
+
+/** Change the size of the file and map it again. Pointers previously returned
+ * by data() are no longer valid. If the file cannot be resized it keeps its
+ * old size and mapping.
+ * @param size :: new size of the file in bytes
+ * @throws Exception::FileError if the file is read only or cannot be resized
+ */
+void MemoryMappedFile::resize(const uint64_t size) {
+  if (m_readOnly)
+    throw Exception::FileError("Cannot resize a file opened for reading only", m_filename);
+  if (size == m_size)
+    return;
+#ifdef _WIN32
+  // A mapped file cannot change size on Windows, so the old size is mapped
+  // again if resizing fails
+  unmap();
+  LARGE_INTEGER newSize;
+  newSize.QuadPart = static_cast<LONGLONG>(size);
+  if (!SetFilePointerEx(static_cast<HANDLE>(m_file), newSize, nullptr, FILE_BEGIN) ||
+      !SetEndOfFile(static_cast<HANDLE>(m_file))) {
+    map();
+    throw Exception::FileError("Unable to resize file", m_filename);
+  }
+  m_size = size;
+#else
+  // The mapping of the old size stays valid until the file has been resized
+  if (::ftruncate(m_file, static_cast<off_t>(size)) != 0)
+    throw Exception::FileError("Unable to resize file", m_filename);
+  unmap();
+  m_size = size;
+#endif
+  map();
+}
+
+/// Start writing modified pages to disk without waiting for them
+void MemoryMappedFile::flush() {
+  if (!m_data || m_readOnly)
+    return;
+#ifdef _WIN32
+  FlushViewOfFile(m_data, 0);
+#else
+  ::msync(m_data, static_cast<size_t>(m_size), MS_ASYNC);
+#endif
+}
+
+/// Map the whole file. Empty files are not mapped.
+void MemoryMappedFile::map() {
+  if (m_size == 0)
+    return;
+#ifdef _WIN32
+  const auto sizeHigh = static_cast<DWORD>(m_size >> 32);
+  const auto sizeLow = static_cast<DWORD>(m_size & 0xFFFFFFFF);
+  HANDLE mapping = CreateFileMappingA(static_cast<HANDLE>(m_file), nullptr, m_readOnly ? PAGE_READONLY : PAGE_READWRITE,
+                                      sizeHigh, sizeLow, nullptr);
+  if (!mapping)
+    throw Exception::FileError("Unable to memory map file", m_filename);
+  void *view = MapViewOfFile(mapping, m_readOnly ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, 0);
+  if (!view) {
+    CloseHandle(mapping);
+    throw Exception::FileError("Unable to memory map file", m_filename);
+  }
+  m_mapping = mapping;
+  m_data = static_cast<char *>(view);
+#else
+  void *view = ::mmap(nullptr, static_cast<size_t>(m_size), m_readOnly ? PROT_READ : PROT_READ | PROT_WRITE,
+                      MAP_SHARED, m_file, 0);
+  if (view == MAP_FAILED)
+    throw Exception::FileError("Unable to memory map file", m_filename);
+  m_data = static_cast<char *>(view);
+#endif
+}
+
+/// Remove the mapping, if any
+void MemoryMappedFile::unmap() {
+  if (!m_data)
+    return;
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(static_cast<HANDLE>(m_mapping));
+  m_mapping = nullptr;
+#else
+  ::munmap(m_data, static_cast<size_t>(m_size));
+#endif
+  m_data = nullptr;
+}
+
+} // namespace Mantid::Kernel
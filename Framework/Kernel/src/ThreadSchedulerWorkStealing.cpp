@@ -0,0 +1,193 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace Mantid::Kernel {
+
+namespace {
+/// Number of tasks looked at for one with a free mutex before giving up
+constexpr size_t MAX_TASKS_SCANNED = 8;
+
+/// The scheduler whose task the current thread is running, if any
+thread_local const ThreadSchedulerWorkStealing *currentScheduler = nullptr;
+/// The queue of the current thread in currentScheduler
+thread_local size_t currentQueue = 0;
+
+/// Random number generator of the current thread, used to pick victims
+std::minstd_rand &threadRandom() {
+  thread_local std::minstd_rand generator(
+      static_cast<std::minstd_rand::result_type>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+  return generator;
+}
+
+/// @return true if the mutex of the task is held by another task
+bool isBusy(Task &task) {
+  const auto mutex = task.getMutex();
+  if (!mutex)
+    return false;
+  if (!mutex->try_lock())
+    return true;
+  mutex->unlock();
+  return false;
+}
+} // namespace
+
+/** Constructor
+ * @param numQueues :: number of worker queues, normally the number of threads
+ * of the ThreadPool using the scheduler. Default 0 = one per physical core.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues) : ThreadScheduler() {
+  if (numQueues == 0)
+    numQueues = std::max(ThreadPool::getNumPhysicalCores(), size_t{1});
+  m_queues.reserve(numQueues);
+  for (size_t i = 0; i < numQueues; ++i)
+    m_queues.emplace_back(std::make_unique<WorkerQueue>());
+}
+
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+//-------------------------------------------------------------------------------
+/** Add a task to the queue of the worker running the current task, or to the
+ * least loaded queue if called from outside a task of this scheduler.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(std::shared_ptr<Task> newTask) {
+  const bool fromWorker = currentScheduler == this && currentQueue < m_queues.size();
+  const size_t index = fromWorker ? currentQueue : leastLoadedQueue();
+  pushTo(*m_queues[index], std::move(newTask));
+}
+
+//-------------------------------------------------------------------------------
+/** Retrieve the next task for a worker: its own newest task, or else the
+ * oldest task stolen from another queue.
+ * @param threadnum :: ID of the calling thread, which selects its queue
+ * @return the task to run, or nullptr if none is left
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const size_t own = threadnum % m_queues.size();
+  currentScheduler = this;
+  currentQueue = own;
+
+  const size_t nQueues = m_queues.size();
+  const size_t start = threadRandom()() % nQueues;
+  // First look for a task whose mutex is free, then take anything
+  for (const bool skipBusy : {true, false}) {
+    if (auto task = takeFrom(*m_queues[own], true, skipBusy))
+      return task;
+    for (size_t i = 0; i < nQueues && m_size > 0; ++i) {
+      const size_t victim = (start + i) % nQueues;
+      if (victim == own)
+        continue;
+      if (auto task = takeFrom(*m_queues[victim], false, skipBusy))
+        return task;
+    }
+    if (m_size == 0)
+      break;
+  }
+  return nullptr;
+}
+
+//-------------------------------------------------------------------------------
+/// @return the number of tasks waiting in all queues
+size_t ThreadSchedulerWorkStealing::size() { return m_size; }
+
+/// @return true if no task is waiting
+bool ThreadSchedulerWorkStealing::empty() { return m_size == 0; }
+
+//-------------------------------------------------------------------------------
+/// Empty all the queues
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    m_size -= queue->tasks.size();
+    queue->tasks.clear();
+    queue->waitingCost = 0.0;
+    queue->pushedCost = 0.0;
+  }
+  std::lock_guard<std::mutex> lock(m_queueLock);
+  m_cost = 0;
+  m_costExecuted = 0;
+}
+
+//-------------------------------------------------------------------------------
+/// @return the total cost of all tasks pushed since the queues were cleared
+double ThreadSchedulerWorkStealing::totalCost() {
+  double cost = 0.0;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    cost += queue->pushedCost;
+  }
+  return cost;
+}
+
+//-------------------------------------------------------------------------------
+/** Add a task to the back of a queue
+ * @param queue :: the queue
+ * @param task :: Task to add
+ */
+void ThreadSchedulerWorkStealing::pushTo(WorkerQueue &queue, std::shared_ptr<Task> task) {
+  const double cost = task->cost();
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  queue.tasks.emplace_back(std::move(task));
+  queue.pushedCost += cost;
+  queue.waitingCost = queue.waitingCost + cost;
+  ++m_size;
+}
+
+//-------------------------------------------------------------------------------
+/** Take a task out of a queue
+ * @param queue :: the queue
+ * @param newest :: take the newest task (owner) rather than the oldest (thief)
+ * @param skipBusy :: pass over tasks whose mutex is held by a running task
+ * @return the task, or nullptr if no suitable task was found
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::takeFrom(WorkerQueue &queue, const bool newest,
+                                                            const bool skipBusy) {
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  auto &tasks = queue.tasks;
+  const size_t nScanned = skipBusy ? std::min(tasks.size(), MAX_TASKS_SCANNED) : std::min(tasks.size(), size_t{1});
+  for (size_t i = 0; i < nScanned; ++i) {
+    const size_t index = newest ? tasks.size() - 1 - i : i;
+    if (skipBusy && isBusy(*tasks[index]))
+      continue;
+    auto task = std::move(tasks[index]);
+    tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(index));
+    queue.waitingCost = std::max(0.0, queue.waitingCost - task->cost());
+    --m_size;
+    return task;
+  }
+  return nullptr;
+}
+
+//-------------------------------------------------------------------------------
+/** Find the queue with the lowest cost of waiting tasks. Ties go to the queues
+ * in turn, so that tasks of equal cost are spread over all of them.
+ * @return the index of the queue
+ */
+size_t ThreadSchedulerWorkStealing::leastLoadedQueue() {
+  const size_t nQueues = m_queues.size();
+  const size_t start = m_nextQueue++ % nQueues;
+  size_t least = start;
+  double leastCost = m_queues[start]->waitingCost.load(std::memory_order_relaxed);
+  for (size_t i = 1; i < nQueues && leastCost > 0.0; ++i) {
+    const size_t index = (start + i) % nQueues;
+    const double cost = m_queues[index]->waitingCost.load(std::memory_order_relaxed);
+    if (cost < leastCost) {
+      least = index;
+      leastCost = cost;
+    }
+  }
+  return least;
+}
+
+} // namespace Mantid::Kernel
@@ -14,7 +14,9 @@
 #include <nexus/NeXusFile.hpp>
 
 #include <boost/regex.hpp>
+#include <algorithm>
 #include <numeric>
+#include <type_traits>
 
 namespace Mantid {
 using namespace Types::Core;
@@ -31,7 +33,7 @@ Logger g_log("TimeSeriesProperty");
 template <typename TYPE>
 TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name)
     : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_values(), m_size(), m_propSortedFlag(),
-      m_filterApplied() {}
+      m_filterApplied(), m_timeIndex(), m_valueIntegral(), m_squareIntegral(), m_indexValid(false) {}
 
 /**
  * Constructor
@@ -146,6 +148,7 @@ template <typename TYPE> TimeSeriesProperty<TYPE> &TimeSeriesProperty<TYPE>::ope
     if (this->operator!=(*rhs)) {
       m_values.insert(m_values.end(), rhs->m_values.begin(), rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      invalidateIndex();
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -286,6 +289,8 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Types::Core::DateAndTime &star
     if (useprefiltertime) {
       m_values[0].setTime(start);
     }
+    // The index of the times refers to the entries before the erase
+    invalidateIndex();
   } else {
     // "start time" is before/after time-series's starting time: do nothing
     ;
@@ -307,6 +312,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Types::Core::DateAndTime &star
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
+  invalidateIndex();
 }
 
 /**
@@ -380,6 +386,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(const std::vector<SplittingInterval
   mp_copy.clear();
 
   m_size = static_cast<int>(m_values.size());
+  invalidateIndex();
 }
 
 /**
@@ -421,6 +428,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &split
         myOutput->m_values.clear();
         myOutput->m_size = 0;
       }
+      myOutput->invalidateIndex();
     } else {
       outputs_tsp.emplace_back(nullptr);
     }
@@ -833,32 +841,11 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(const std::vector<Splittin
     return static_cast<double>(m_values.front().value());
   }
 
-  sortIfNecessary();
-
-  double numerator(0.0), totalTime(0.0);
-  // Loop through the filter ranges
-  for (const auto &time : filter) {
-    // Calculate the total time duration (in seconds) within by the filter
-    totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = getSingleValue(time.start(), index);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator += DateAndTime::secondsFromDuration(m_values[index].time() - startTime) * value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-    }
-
-    // Now close off with the end of the current filter range
-    numerator += DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
-  }
+  // Each filter range is integrated with two binary searches in the index
+  const auto integrals = integralsInFilter(filter);
 
   // 'Normalise' by the total time
-  return numerator / totalTime;
+  return static_cast<double>(m_values.front().value()) + std::get<1>(integrals) / std::get<0>(integrals);
 }
 
 /** Function specialization for TimeSeriesProperty<std::string>
@@ -895,33 +882,14 @@ TimeSeriesProperty<TYPE>::averageAndStdDevInFilter(const std::vector<SplittingIn
     return std::pair<double, double>{mean, std::numeric_limits<double>::quiet_NaN()};
   }
 
-  double numerator(0.0), totalTime(0.0);
-  // Loop through the filter ranges
-  for (const auto &time : filter) {
-    // Calculate the total time duration (in seconds) within by the filter
-    totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = getSingleValue(time.start(), index);
-    double valuestddev = (value - mean) * (value - mean);
-    DateAndTime startTime = time.start();
+  // With d = value - first value, the sum of (value - mean)^2 dt is
+  // sum(d^2 dt) - 2 (mean - first value) sum(d dt) + (mean - first value)^2 sum(dt)
+  const auto [totalTime, valueIntegral, squareIntegral] = integralsInFilter(filter);
+  const double offset = mean - static_cast<double>(m_values.front().value());
+  const double numerator = squareIntegral - 2. * offset * valueIntegral + offset * offset * totalTime;
 
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-
-      numerator += DateAndTime::secondsFromDuration(m_values[index].time() - startTime) * valuestddev;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-      valuestddev = (value - mean) * (value - mean);
-    }
-
-    // Now close off with the end of the current filter range
-    numerator += DateAndTime::secondsFromDuration(time.stop() - startTime) * valuestddev;
-  }
-
-  // Normalise by the total time
-  return std::pair<double, double>{mean, std::sqrt(numerator / totalTime)};
+  // Normalise by the total time. Rounding may leave a tiny negative numerator.
+  return std::pair<double, double>{mean, std::sqrt(std::max(numerator, 0.) / totalTime)};
 }
 
 /** Function specialization for TimeSeriesProperty<std::string>
@@ -1086,6 +1054,11 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time, co
   }
 
   m_filterApplied = false;
+  // Appending in time order extends the index instead of rebuilding it
+  if (m_indexValid && m_propSortedFlag == TimeSeriesSortStatus::TSSORTED && m_timeIndex.size() + 1 == m_values.size())
+    appendToIndex();
+  else
+    invalidateIndex();
 }
 
 /** Add a value to the map
@@ -1126,6 +1099,7 @@ void TimeSeriesProperty<TYPE>::addValues(const std::vector<Types::Core::DateAndT
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+  invalidateIndex();
 }
 
 /** replace vectors of values to the map. First we clear the vectors
@@ -1339,6 +1313,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
+  invalidateIndex();
 }
 
 /** Clears out all but the last value in the property.
@@ -1354,6 +1329,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clearOutdated() {
     clear();
     m_values.emplace_back(lastValue);
     m_size = 1;
+    invalidateIndex();
   }
 }
 
@@ -1415,6 +1391,7 @@ void TimeSeriesProperty<TYPE>::create(const std::vector<Types::Core::DateAndTime
 
   // reset the size
   m_size = static_cast<int>(m_values.size());
+  invalidateIndex();
 }
 
 /** Returns the value at a particular time
@@ -1910,6 +1887,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
   // update m_size
   countSize();
+  invalidateIndex();
 
   // 3. Finish
   g_log.warning() << "Log " << this->name() << " has " << numremoved << " entries removed due to duplicated time. "
@@ -1949,6 +1927,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::sortIfNecessary() const
     g_log.information("TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
     std::stable_sort(m_values.begin(), m_values.end());
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+    invalidateIndex();
   }
 }
 
@@ -1973,7 +1952,19 @@ template <typename TYPE> int TimeSeriesProperty<TYPE>::findIndex(Types::Core::Da
     return (int(m_values.size()));
   }
 
-  // 3. Find by lower_bound()
+  // 3. Find by lower_bound() in the time index if it is up to date. It is not
+  // rebuilt here, as that would cost a pass over the values for each lookup
+  // between values added out of order.
+  if (m_indexValid) {
+    const int64_t tns = t.totalNanoseconds();
+    const auto fid = std::lower_bound(m_timeIndex.cbegin(), m_timeIndex.cend(), tns);
+
+    int newindex = int(fid - m_timeIndex.cbegin());
+    if (*fid > tns)
+      newindex--;
+    return newindex;
+  }
+
   typename std::vector<TimeValueUnit<TYPE>>::const_iterator fid;
   TimeValueUnit<TYPE> temp(t, m_values[0].value());
   fid = std::lower_bound(m_values.begin(), m_values.end(), temp);
@@ -1985,6 +1976,109 @@ template <typename TYPE> int TimeSeriesProperty<TYPE>::findIndex(Types::Core::Da
   return newindex;
 }
 
+/** Build the index of the sorted values if it is out of date: the times in
+ * nanoseconds and, for numeric types, the running integrals over time of
+ * d = value - first value and of d^2 up to each time. The integrals are taken
+ * relative to the first value to avoid cancellation for logs with a large
+ * offset, e.g. temperatures in kelvin.
+ */
+template <typename TYPE> void TimeSeriesProperty<TYPE>::buildIndex() const {
+  sortIfNecessary();
+  if (m_indexValid)
+    return;
+
+  const size_t numValues = m_values.size();
+  m_timeIndex.resize(numValues);
+  std::transform(m_values.cbegin(), m_values.cend(), m_timeIndex.begin(),
+                 [](const auto &value) { return value.time().totalNanoseconds(); });
+
+  if constexpr (std::is_arithmetic_v<TYPE>) {
+    m_valueIntegral.resize(numValues);
+    m_squareIntegral.resize(numValues);
+    if (numValues > 0) {
+      const auto first = static_cast<double>(m_values.front().value());
+      m_valueIntegral[0] = 0.;
+      m_squareIntegral[0] = 0.;
+      for (size_t i = 1; i < numValues; ++i) {
+        const double dt = static_cast<double>(m_timeIndex[i] - m_timeIndex[i - 1]) * 1.e-9;
+        const double d = static_cast<double>(m_values[i - 1].value()) - first;
+        m_valueIntegral[i] = m_valueIntegral[i - 1] + d * dt;
+        m_squareIntegral[i] = m_squareIntegral[i - 1] + d * d * dt;
+      }
+    }
+  }
+  m_indexValid = true;
+}
+
+/** Extend a valid index with the last value, which must not be earlier than
+ * the value before it, instead of building the index again.
+ */
+template <typename TYPE> void TimeSeriesProperty<TYPE>::appendToIndex() const {
+  const size_t last = m_values.size() - 1;
+  m_timeIndex.emplace_back(m_values[last].time().totalNanoseconds());
+  if constexpr (std::is_arithmetic_v<TYPE>) {
+    if (last == 0) {
+      m_valueIntegral.emplace_back(0.);
+      m_squareIntegral.emplace_back(0.);
+    } else {
+      const double dt = static_cast<double>(m_timeIndex[last] - m_timeIndex[last - 1]) * 1.e-9;
+      const double d = static_cast<double>(m_values[last - 1].value()) - static_cast<double>(m_values.front().value());
+      m_valueIntegral.emplace_back(m_valueIntegral[last - 1] + d * dt);
+      m_squareIntegral.emplace_back(m_squareIntegral[last - 1] + d * d * dt);
+    }
+  }
+}
+
+/** Integrals over time of d = value - first value and of d^2, from the first
+ * time of the log up to t. Each value holds until the time of the next one;
+ * the first value is extended to times before the log starts, so that the
+ * integrals are negative there, and the last value holds forever.
+ * The index must have been built.
+ * @param t :: time in nanoseconds
+ * @return the integrals of d and d^2 in value*seconds
+ */
+template <typename TYPE> std::pair<double, double> TimeSeriesProperty<TYPE>::integralsUpTo(int64_t t) const {
+  // The last value at or before t, or the first value
+  auto index =
+      static_cast<size_t>(std::upper_bound(m_timeIndex.cbegin(), m_timeIndex.cend(), t) - m_timeIndex.cbegin());
+  if (index > 0)
+    --index;
+  const double dt = static_cast<double>(t - m_timeIndex[index]) * 1.e-9;
+  const double d = static_cast<double>(m_values[index].value()) - static_cast<double>(m_values.front().value());
+  return {m_valueIntegral[index] + d * dt, m_squareIntegral[index] + d * d * dt};
+}
+
+/** Function specialization for TimeSeriesProperty<std::string>
+ *  @throws Kernel::Exception::NotImplementedError always
+ */
+template <> std::pair<double, double> TimeSeriesProperty<std::string>::integralsUpTo(int64_t /*t*/) const {
+  throw Exception::NotImplementedError("TimeSeriesProperty::"
+                                       "integralsUpTo is not "
+                                       "implemented for string properties");
+}
+
+/** Integrate a numeric log over the ranges of a filter using the index, in
+ * O(log(n)) per range rather than visiting every value inside it.
+ * @param filter :: the ranges to integrate over
+ * @return the total duration of the filter in seconds, and the integrals of
+ * d = value - first value and of d^2 over the filter
+ */
+template <typename TYPE>
+std::tuple<double, double, double>
+TimeSeriesProperty<TYPE>::integralsInFilter(const std::vector<SplittingInterval> &filter) const {
+  buildIndex();
+  double totalTime(0.0), valueIntegral(0.0), squareIntegral(0.0);
+  for (const auto &time : filter) {
+    // Calculate the total time duration (in seconds) within by the filter
+    totalTime += time.duration();
+    const auto atStart = integralsUpTo(time.start().totalNanoseconds());
+    const auto atStop = integralsUpTo(time.stop().totalNanoseconds());
+    valueIntegral += atStop.first - atStart.first;
+    squareIntegral += atStop.second - atStart.second;
+  }
+  return {totalTime, valueIntegral, squareIntegral};
+}
+
 /** Find the upper_bound of time t in container.
  * Search range:  begin+istart to begin+iend
  * Return C[ir] == t or C[ir] > t and C[ir-1] < t
@@ -2189,6 +2283,7 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::setValueFromPrope
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
+  invalidateIndex();
   return "";
 }
 
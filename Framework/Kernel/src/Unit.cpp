@@ -12,9 +12,13 @@
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UnitLabelTypes.h"
+#include <algorithm>
 #include <cfloat>
 #include <limits>
 #include <sstream>
+#include <type_traits>
+#include <typeinfo>
+#include <variant>
 
 namespace Mantid::Kernel {
 
@@ -1461,6 +1465,69 @@ double timeConversionValue(const std::string &input_unit, const std::string &out
   return input_float / output_float;
 }
 
+namespace {
+/// One of the units with a dedicated conversion loop, or any other unit
+using ViaTOFUnit = std::variant<const TOF *, const Wavelength *, const Energy *, const dSpacing *,
+                                const MomentumTransfer *, const QSquared *, const DeltaE *, const Momentum *,
+                                const Unit *>;
+
+/// Set result to the unit as a U if it is exactly a U, not a class derived from it
+template <typename U> bool isExactly(const Unit &unit, ViaTOFUnit &result) {
+  if (typeid(unit) != typeid(U))
+    return false;
+  result = static_cast<const U *>(&unit);
+  return true;
+}
+
+ViaTOFUnit resolveUnit(const Unit &unit) {
+  ViaTOFUnit result = &unit;
+  isExactly<TOF>(unit, result) || isExactly<Wavelength>(unit, result) || isExactly<Energy>(unit, result) ||
+      isExactly<dSpacing>(unit, result) || isExactly<MomentumTransfer>(unit, result) ||
+      isExactly<QSquared>(unit, result) || isExactly<DeltaE>(unit, result) || isExactly<Momentum>(unit, result);
+  return result;
+}
+
+/// Call the conversion of the concrete class directly so that it can be inlined
+template <typename U> double toTOF(const U &unit, const double x) {
+  if constexpr (std::is_same_v<U, Unit>)
+    return unit.singleToTOF(x);
+  else
+    return unit.U::singleToTOF(x);
+}
+
+template <typename U> double fromTOF(const U &unit, const double tof) {
+  if constexpr (std::is_same_v<U, Unit>)
+    return unit.singleFromTOF(tof);
+  else
+    return unit.U::singleFromTOF(tof);
+}
+
+template <typename From, typename To>
+void convertEach(const From &fromUnit, const To &toUnit, double *first, double *last) {
+  std::transform(first, last, first, [&](const double x) { return fromTOF(toUnit, toTOF(fromUnit, x)); });
+}
+} // namespace
+
+void convertViaTOF(const Unit &fromUnit, const Unit &toUnit, double *first, double *last) {
+  if (!fromUnit.isInitialized() || !toUnit.isInitialized())
+    throw std::runtime_error("convertViaTOF(): the units must be initialized");
+  std::visit(
+      [first, last](const auto *from, const auto *to) {
+        using From = std::remove_cv_t<std::remove_pointer_t<decltype(from)>>;
+        using To = std::remove_cv_t<std::remove_pointer_t<decltype(to)>>;
+        if constexpr (std::is_abstract_v<From> || std::is_abstract_v<To>) {
+          convertEach(*from, *to, first, last);
+        } else {
+          // Local copies cannot alias the values, so their parameters stay in
+          // registers and the loop can be vectorised
+          const From localFrom(*from);
+          const To localTo(*to);
+          convertEach(localFrom, localTo, first, last);
+        }
+      },
+      resolveUnit(fromUnit), resolveUnit(toUnit));
+}
+
 } // namespace Units
 
 } // namespace Mantid::Kernel
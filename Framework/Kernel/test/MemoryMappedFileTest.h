@@ -0,0 +1,89 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/MemoryMappedFile.h"
+
+#include <Poco/TemporaryFile.h>
+#include <cxxtest/TestSuite.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+using Mantid::Kernel::MemoryMappedFile;
+
+class MemoryMappedFileTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MemoryMappedFileTest *createSuite() { return new MemoryMappedFileTest(); }
+  static void destroySuite(MemoryMappedFileTest *suite) { delete suite; }
+
+  void test_new_file_is_empty() {
+    Poco::TemporaryFile tmpFile;
+    MemoryMappedFile file(tmpFile.path(), false);
+    TS_ASSERT_EQUALS(file.size(), 0);
+    TS_ASSERT(!file.data());
+    TS_ASSERT(!file.isReadOnly());
+  }
+
+  void test_written_data_is_in_the_file() {
+    Poco::TemporaryFile tmpFile;
+    {
+      MemoryMappedFile file(tmpFile.path(), false);
+      file.resize(6);
+      TS_ASSERT_EQUALS(file.size(), 6);
+      std::memcpy(file.data(), "mapped", 6);
+      file.flush();
+    }
+    std::ifstream stream(tmpFile.path(), std::ios::binary);
+    std::string contents;
+    stream >> contents;
+    TS_ASSERT_EQUALS(contents, "mapped");
+  }
+
+  void test_resize_keeps_contents() {
+    Poco::TemporaryFile tmpFile;
+    MemoryMappedFile file(tmpFile.path(), false);
+    file.resize(4);
+    std::memcpy(file.data(), "abcd", 4);
+    file.resize(4096);
+    TS_ASSERT_EQUALS(std::string(file.data(), 4), "abcd");
+    file.resize(2);
+    TS_ASSERT_EQUALS(std::string(file.data(), 2), "ab");
+  }
+
+  void test_failed_resize_keeps_the_mapping() {
+    Poco::TemporaryFile tmpFile;
+    MemoryMappedFile file(tmpFile.path(), false);
+    file.resize(4);
+    std::memcpy(file.data(), "abcd", 4);
+    TS_ASSERT_THROWS(file.resize(std::numeric_limits<uint64_t>::max()), const Mantid::Kernel::Exception::FileError &);
+    TS_ASSERT_EQUALS(file.size(), 4);
+    TS_ASSERT(file.data());
+    TS_ASSERT_EQUALS(std::string(file.data(), 4), "abcd");
+  }
+
+  void test_read_only_file() {
+    Poco::TemporaryFile tmpFile;
+    {
+      std::ofstream stream(tmpFile.path(), std::ios::binary);
+      stream << "events";
+    }
+    MemoryMappedFile file(tmpFile.path(), true);
+    TS_ASSERT_EQUALS(file.size(), 6);
+    TS_ASSERT_EQUALS(std::string(file.data(), 6), "events");
+    TS_ASSERT_THROWS(file.resize(10), const Mantid::Kernel::Exception::FileError &);
+  }
+
+  void test_missing_read_only_file_throws() {
+    TS_ASSERT_THROWS(MemoryMappedFile("this_file_does_not_exist.events", true),
+                     const Mantid::Kernel::Exception::FileError &);
+  }
+};
@@ -0,0 +1,138 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <atomic>
+#include <memory>
+
+using namespace Mantid::Kernel;
+
+namespace {
+class TaskWithCost : public Task {
+public:
+  TaskWithCost(double cost, std::shared_ptr<std::mutex> mutex = nullptr) {
+    m_cost = cost;
+    m_mutex = std::move(mutex);
+  }
+  void run() override {}
+};
+} // namespace
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() { return new ThreadSchedulerWorkStealingTest(); }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) { delete suite; }
+
+  void test_push_and_clear() {
+    ThreadSchedulerWorkStealing sc(4);
+    TS_ASSERT_EQUALS(sc.numQueues(), 4);
+    TS_ASSERT(sc.empty());
+    sc.push(std::make_shared<TaskWithCost>(1.0));
+    sc.push(std::make_shared<TaskWithCost>(2.0));
+    TS_ASSERT_EQUALS(sc.size(), 2);
+    TS_ASSERT(!sc.empty());
+    TS_ASSERT_DELTA(sc.totalCost(), 3.0, 1e-12);
+    sc.clear();
+    TS_ASSERT_EQUALS(sc.size(), 0);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_DELTA(sc.totalCost(), 0.0, 1e-12);
+  }
+
+  void test_own_queue_is_last_in_first_out() {
+    ThreadSchedulerWorkStealing sc(1);
+    auto first = std::make_shared<TaskWithCost>(1.0);
+    auto second = std::make_shared<TaskWithCost>(1.0);
+    sc.push(first);
+    sc.push(second);
+    TS_ASSERT_EQUALS(sc.pop(0), second);
+    TS_ASSERT_EQUALS(sc.pop(0), first);
+    TS_ASSERT(!sc.pop(0));
+  }
+
+  void test_tasks_are_placed_on_the_least_loaded_queue_and_stolen_oldest_first() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto big = std::make_shared<TaskWithCost>(10.0);
+    auto small1 = std::make_shared<TaskWithCost>(1.0);
+    auto small2 = std::make_shared<TaskWithCost>(1.0);
+    // big lands on queue 0, then both small tasks on the less loaded queue 1
+    sc.push(big);
+    sc.push(small1);
+    sc.push(small2);
+    TS_ASSERT_EQUALS(sc.pop(0), big);
+    // Queue 0 is empty now, so thread 0 steals the oldest task of queue 1
+    TS_ASSERT_EQUALS(sc.pop(0), small1);
+    TS_ASSERT_EQUALS(sc.pop(1), small2);
+    TS_ASSERT(sc.empty());
+  }
+
+  void test_tasks_with_a_busy_mutex_are_passed_over() {
+    ThreadSchedulerWorkStealing sc(1);
+    auto mutex = std::make_shared<std::mutex>();
+    auto locked = std::make_shared<TaskWithCost>(1.0, mutex);
+    auto free = std::make_shared<TaskWithCost>(1.0);
+    sc.push(free);
+    sc.push(locked);
+
+    mutex->lock();
+    TS_ASSERT_EQUALS(sc.pop(0), free);
+    // Only the task with the busy mutex is left, so it is returned anyway
+    TS_ASSERT_EQUALS(sc.pop(0), locked);
+    mutex->unlock();
+  }
+
+  void test_tasks_pushed_by_a_running_task_stay_on_its_queue() {
+    auto sc = new ThreadSchedulerWorkStealing(2);
+    ThreadPool pool(sc, 2);
+    std::atomic<size_t> counter{0};
+    for (size_t i = 0; i < 10; ++i) {
+      pool.schedule(std::make_shared<FunctionTask>([sc, &counter] {
+        for (size_t j = 0; j < 100; ++j)
+          sc->push(std::make_shared<FunctionTask>([&counter] { ++counter; }));
+      }));
+    }
+    TS_ASSERT_THROWS_NOTHING(pool.joinAll());
+    TS_ASSERT_EQUALS(counter.load(), 1000);
+  }
+};
+
+class ThreadSchedulerWorkStealingTestPerformance : public CxxTest::TestSuite {
+public:
+  static ThreadSchedulerWorkStealingTestPerformance *createSuite() {
+    return new ThreadSchedulerWorkStealingTestPerformance();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTestPerformance *suite) { delete suite; }
+
+  void test_many_small_tasks_FIFO() { runSmallTasks(new ThreadSchedulerFIFO()); }
+
+  void test_many_small_tasks_LargestCost() { runSmallTasks(new ThreadSchedulerLargestCost()); }
+
+  void test_many_small_tasks_Mutexes() { runSmallTasks(new ThreadSchedulerMutexes()); }
+
+  void test_many_small_tasks_WorkStealing() { runSmallTasks(new ThreadSchedulerWorkStealing()); }
+
+private:
+  /// Schedule many tasks doing almost nothing, so that the time is spent
+  /// fighting over the scheduler
+  void runSmallTasks(ThreadScheduler *scheduler) {
+    const size_t numTasks = 1000000;
+    ThreadPool pool(scheduler, 0);
+    std::atomic<size_t> counter{0};
+    for (size_t i = 0; i < numTasks; ++i)
+      pool.schedule(std::make_shared<FunctionTask>([&counter] { ++counter; }, 1.0));
+    pool.joinAll();
+    TS_ASSERT_EQUALS(counter.load(), numTasks);
+  }
+};
@@ -372,6 +372,20 @@ public:
     delete log;
   }
 
+  void test_filterByTime_after_the_index_is_built() {
+    auto log = std::unique_ptr<TimeSeriesProperty<int>>(createIntegerTSP(6));
+    // builds the index of the times
+    log->timeAverageValue();
+
+    log->filterByTime(DateAndTime("2007-11-30T16:17:15"), DateAndTime("2007-11-30T16:17:40"));
+
+    TS_ASSERT_EQUALS(log->realSize(), 3);
+    const std::vector<DateAndTime> times{DateAndTime("2007-11-30T16:17:15"), DateAndTime("2007-11-30T16:17:20"),
+                                         DateAndTime("2007-11-30T16:17:30")};
+    TS_ASSERT_EQUALS(log->timesAsVector(), times);
+    TS_ASSERT_EQUALS(log->valuesAsVector(), std::vector<int>({2, 3, 4}));
+  }
+
   //-------------------------------------------------------------------------------
   void test_filterByTimes1() {
     TimeSeriesProperty<int> *log = createIntegerTSP(6);
@@ -648,6 +662,80 @@ public:
     TS_ASSERT_THROWS(sProp->averageAndStdDevInFilter(splitter), const Exception::NotImplementedError &);
   }
 
+  void test_averageValueInFilter_follows_values_added_after_a_call() {
+    auto dblLog = std::unique_ptr<TimeSeriesProperty<double>>(createDoubleTSP());
+    TimeSplitterType filter;
+    filter.emplace_back(SplittingInterval(DateAndTime("2007-11-30T16:17:05"), DateAndTime("2007-11-30T16:17:29")));
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), 7.308, 0.001);
+
+    // An earlier value makes the log unsorted and must not be missed
+    dblLog->addValue("2007-11-30T16:17:15", 1.0);
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), (5 * 9.99 + 5 * 7.55 + 5 * 1.0 + 9 * 5.55) / 24, 1e-10);
+
+    dblLog->replaceValues({DateAndTime("2007-11-30T16:17:00"), DateAndTime("2007-11-30T16:17:17")}, {2.0, 4.0});
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), (12 * 2.0 + 12 * 4.0) / 24, 1e-10);
+  }
+
+  void test_values_appended_in_order_after_a_call_extend_the_index() {
+    TimeSeriesProperty<double> log("doubleProp");
+    const DateAndTime start("2007-11-30T16:17:00");
+    log.addValue(start, 1.0);
+    TimeSplitterType filter;
+    filter.emplace_back(SplittingInterval(start, start + 40.0));
+    double integral = 0.;
+    for (int i = 1; i < 4; ++i) {
+      // value i holds from 10 * (i - 1) seconds to the end of the filter
+      TS_ASSERT_DELTA(log.averageValueInFilter(filter), (integral + (40. - 10. * (i - 1)) * i) / 40., 1e-10);
+      integral += 10. * i;
+      log.addValue(start + 10.0 * i, static_cast<double>(i + 1));
+      TS_ASSERT_EQUALS(log.getSingleValue(start + (10.0 * i - 5.0)), static_cast<double>(i));
+    }
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 2.5, 1e-10);
+    // An earlier value is not appended to the index
+    log.addValue(start + 15.0, 0.0);
+    TS_ASSERT_EQUALS(log.getSingleValue(start + 16.0), 0.0);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), (10 * 1.0 + 5 * 2.0 + 5 * 0.0 + 10 * 3.0 + 10 * 4.0) / 40.,
+                    1e-10);
+  }
+
+  void test_averageValueInFilter_uses_last_of_duplicated_times() {
+    TimeSeriesProperty<int> log("intProp");
+    log.addValue("2007-11-30T16:17:00", 1);
+    log.addValue("2007-11-30T16:17:10", 2);
+    log.addValue("2007-11-30T16:17:10", 3);
+    log.addValue("2007-11-30T16:17:20", 4);
+    TimeSplitterType filter;
+    filter.emplace_back(SplittingInterval(DateAndTime("2007-11-30T16:17:10"), DateAndTime("2007-11-30T16:17:30")));
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 3.5, 1e-10);
+  }
+
+  void test_averageAndStdDevInFilter() {
+    auto dblLog = std::unique_ptr<TimeSeriesProperty<double>>(createDoubleTSP());
+    TimeSplitterType filter;
+    filter.emplace_back(SplittingInterval(DateAndTime("2007-11-30T16:17:05"), DateAndTime("2007-11-30T16:17:15")));
+    filter.emplace_back(SplittingInterval(DateAndTime("2007-11-30T16:17:25"), DateAndTime("2007-11-30T16:17:45")));
+    const auto meanAndStdDev = dblLog->averageAndStdDevInFilter(filter);
+    const double mean = (5 * 9.99 + 5 * 7.55 + 5 * 5.55 + 15 * 10.55) / 30;
+    const double variance = (5 * (9.99 - mean) * (9.99 - mean) + 5 * (7.55 - mean) * (7.55 - mean) +
+                             5 * (5.55 - mean) * (5.55 - mean) + 15 * (10.55 - mean) * (10.55 - mean)) /
+                            30;
+    TS_ASSERT_DELTA(meanAndStdDev.first, mean, 1e-10);
+    TS_ASSERT_DELTA(meanAndStdDev.second, std::sqrt(variance), 1e-10);
+  }
+
+  void test_averageAndStdDevInFilter_with_large_offset() {
+    // A small spread on a large value must not be lost to rounding
+    TimeSeriesProperty<double> log("doubleProp");
+    const DateAndTime start("2007-11-30T16:17:00");
+    for (int i = 0; i < 1000; ++i)
+      log.addValue(start + static_cast<double>(i), 1.e9 + static_cast<double>(i % 2));
+    TimeSplitterType filter;
+    filter.emplace_back(SplittingInterval(start, start + 1000.));
+    const auto meanAndStdDev = log.averageAndStdDevInFilter(filter);
+    TS_ASSERT_DELTA(meanAndStdDev.first, 1.e9 + 0.5, 1e-6);
+    TS_ASSERT_DELTA(meanAndStdDev.second, 0.5, 1e-6);
+  }
+
   //----------------------------------------------------------------------------
   void test_splitByTime_and_getTotalValue() {
     TimeSeriesProperty<int> *log = createIntegerTSP(12);
@@ -12,6 +12,7 @@
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitLabelTypes.h"
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <cfloat>
 #include <limits>
 
@@ -1612,6 +1613,49 @@ public:
     TS_ASSERT(check_vector_conversion(vec, 1.0));
   }
 
+  //----------------------------------------------------------------------
+  // Conversion of arrays through TOF
+  //----------------------------------------------------------------------
+
+  void test_convertViaTOF_matches_single_conversions() {
+    const UnitParametersMap params{{UnitParams::l2, 2.0}, {UnitParams::twoTheta, 1.2}, {UnitParams::efixed, 50.0}};
+    // Includes units derived from ones with a compiled loop, which must not use it
+    Units::TOF tofUnit;
+    Units::Wavelength wavelength;
+    Units::Energy energyUnit;
+    Units::dSpacing dSpacing;
+    Units::MomentumTransfer momentumTransfer;
+    Units::QSquared qSquared;
+    Units::Momentum momentum;
+    Units::Energy_inWavenumber energyInWavenumber;
+    Units::SpinEchoLength spinEchoLength;
+    Units::SpinEchoTime spinEchoTime;
+    std::vector<Unit *> units{&tofUnit,  &wavelength, &energyUnit,         &dSpacing,       &momentumTransfer,
+                              &qSquared, &momentum,   &energyInWavenumber, &spinEchoLength, &spinEchoTime};
+    for (auto unit : units)
+      unit->initialize(10.0, 0, params);
+    const std::vector<double> tofs{1000., 2500., 7000., 12000., 19000.};
+    for (auto fromUnit : units) {
+      for (auto toUnit : units) {
+        std::vector<double> values(tofs.size());
+        std::transform(tofs.cbegin(), tofs.cend(), values.begin(),
+                       [fromUnit](const double x) { return fromUnit->singleFromTOF(x); });
+        std::vector<double> expected(values.size());
+        std::transform(values.cbegin(), values.cend(), expected.begin(),
+                       [&](const double x) { return toUnit->singleFromTOF(fromUnit->singleToTOF(x)); });
+        Units::convertViaTOF(*fromUnit, *toUnit, values);
+        TSM_ASSERT_EQUALS(fromUnit->unitID() + " to " + toUnit->unitID(), values, expected);
+      }
+    }
+  }
+
+  void test_convertViaTOF_throws_for_uninitialized_units() {
+    Units::TOF fromUnit;
+    Units::Wavelength toUnit;
+    std::vector<double> values{1000.};
+    TS_ASSERT_THROWS(Units::convertViaTOF(fromUnit, toUnit, values), const std::runtime_error &);
+  }
+
 private:
   Units::Label label;
   Units::TOF tof;
@@ -118,6 +118,17 @@ void LiveDataAlgorithm::initProps() {
   declareProperty(std::make_unique<FileProperty>("PostProcessingScriptFilename", "", FileProperty::OptionalLoad, "py"),
                   " Python script that will be run to process the accumulated data.");
 
+  std::vector<std::string> postProcessingOptions{"Full", "Incremental"};
+  declareProperty("PostProcessingMode", "Full", std::make_shared<StringListValidator>(postProcessingOptions),
+                  "How the accumulated data is post-processed on each update.\n"
+                  " - Full: the whole accumulation workspace is post-processed (default).\n"
+                  " - Incremental: when adding chunks, only the new chunk is post-processed, and "
+                  "the result is added to the previous output. This is only correct if post-processing "
+                  "the sum of the chunks gives the sum of the post-processed chunks, e.g. Rebin, "
+                  "SumSpectra or ConvertUnits of histograms, but not a normalisation. The whole "
+                  "accumulation workspace is post-processed again when the post-processing settings "
+                  "change or the data is reset.");
+
   std::vector<std::string> runOptions{"Restart", "Stop", "Rename"};
   declareProperty("RunTransitionBehavior", "Restart", std::make_shared<StringListValidator>(runOptions),
                   "What to do at run start/end boundaries?\n"
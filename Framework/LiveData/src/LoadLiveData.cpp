@@ -6,6 +6,8 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidLiveData/LoadLiveData.h"
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/IMDEventWorkspace.h"
+#include "MantidAPI/Run.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataObjects/EventWorkspace.h"
@@ -15,6 +17,7 @@
 #include "MantidLiveData/Exception.h"
 
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <utility>
 
 #include <Poco/Thread.h>
@@ -28,6 +31,35 @@ namespace Mantid::LiveData {
 
 namespace {
 
+/// Name of the log recording the post-processing settings of the output
+const std::string POST_PROCESSING_LOG = "LiveData_PostProcessing";
+
+/**
+ * Find the runs of the workspaces that addChunk can add to
+ *
+ * @param workspace : a matrix or MD event workspace, or a group of them
+ * @return the runs of the workspaces, or an empty list if the workspace or any
+ *member of the group cannot be added to
+ */
+std::vector<API::Run *> addableRuns(API::Workspace *workspace) {
+  if (auto *group = dynamic_cast<API::WorkspaceGroup *>(workspace)) {
+    std::vector<API::Run *> runs;
+    for (size_t index = 0; index < group->size(); ++index) {
+      auto *item = dynamic_cast<API::MatrixWorkspace *>(group->getItem(index).get());
+      if (!item)
+        return {};
+      runs.emplace_back(&item->mutableRun());
+    }
+    return runs;
+  } else if (auto *matrixWS = dynamic_cast<API::MatrixWorkspace *>(workspace)) {
+    return {&matrixWS->mutableRun()};
+  } else if (auto *mdWS = dynamic_cast<API::IMDEventWorkspace *>(workspace)) {
+    if (mdWS->getNumExperimentInfo() > 0)
+      return {&mdWS->getExperimentInfo(0)->mutableRun()};
+  }
+  return {};
+}
+
 /**
  * Copy the Instrument from source workspace to target workspace if possible
  *
@@ -89,10 +121,13 @@ void LoadLiveData::init() { this->initProps(); }
  *
  * @param inputWS :: workspace being processed
  * @param PostProcess :: flag, TRUE if doing the post-processing
+ * @param IsChunk :: flag, TRUE if inputWS is a chunk rather than the
+ *AccumulationWorkspace
  * @return the processed workspace. Will point to inputWS if no processing is to
  *do
  */
-Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS, bool PostProcess) {
+Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS, bool PostProcess,
+                                                        bool IsChunk) {
   if (!inputWS)
     throw std::runtime_error("LoadLiveData::runProcessing() called for an empty input workspace.");
   // Prevent others writing to the workspace while we run.
@@ -114,8 +149,9 @@ Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_s
     // Transform the chunk in-place
     std::string outputName = inputName;
 
-    // Except, no need for anonymous names with the post-processing
-    if (PostProcess) {
+    // Except, no need for anonymous names with the post-processing of the
+    // accumulated data
+    if (!IsChunk) {
       inputName = this->getPropertyValue("AccumulationWorkspace");
       outputName = this->getPropertyValue("OutputWorkspace");
     }
@@ -167,7 +203,7 @@ Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_s
                                " Algorithm's OutputWorkspace property is not a WorkspaceProperty!");
     Workspace_sptr temp = wsProp->getWorkspace();
 
-    if (!PostProcess) {
+    if (IsChunk) {
       if (!temp) {
         // a group workspace cannot be returned by wsProp
         temp = AnalysisDataService::Instance().retrieve(inputName);
@@ -194,7 +230,7 @@ Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_s
  */
 Mantid::API::Workspace_sptr LoadLiveData::processChunk(Mantid::API::Workspace_sptr chunkWS) {
   try {
-    return runProcessing(std::move(chunkWS), false);
+    return runProcessing(std::move(chunkWS), false, true);
   } catch (...) {
     g_log.error("While processing chunk:");
     throw;
@@ -208,28 +244,80 @@ Mantid::API::Workspace_sptr LoadLiveData::processChunk(Mantid::API::Workspace_sp
  */
 void LoadLiveData::runPostProcessing() {
   try {
-    m_outputWS = runProcessing(m_accumWS, true);
+    m_outputWS = runProcessing(m_accumWS, true, false);
   } catch (...) {
     g_log.error("While post processing:");
     throw;
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Perform the PostProcessing steps on the new chunk only, and add the result
+ * to the previous output workspace. See canPostProcessIncrementally.
+ * Sets the m_outputWS member to the sum.
+ *
+ * @param chunkWS :: processed live data chunk workspace, already added to the
+ *accumulation workspace
+ */
+void LoadLiveData::runIncrementalPostProcessing(const Mantid::API::Workspace_sptr &chunkWS) {
+  Workspace_sptr postProcessedChunk;
+  try {
+    postProcessedChunk = runProcessing(chunkWS, true, true);
+  } catch (...) {
+    g_log.error("While post processing the chunk:");
+    throw;
+  }
+  this->addChunk(m_outputWS, postProcessedChunk);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Can the post-processing of this update be applied to the new chunk only?
+ *
+ * That is the case if the incremental mode is requested, the chunk is added
+ * to the accumulated data, and the previous output was post-processed with the
+ * same settings.
+ *
+ * @param accumulationMethod :: how the chunk is accumulated in this update
+ * @return true if runIncrementalPostProcessing can be used
+ */
+bool LoadLiveData::canPostProcessIncrementally(const std::string &accumulationMethod) const {
+  if (this->getPropertyValue("PostProcessingMode") != "Incremental" || accumulationMethod != "Add" || !m_outputWS)
+    return false;
+  const auto runs = addableRuns(m_outputWS.get());
+  const auto settings = this->postProcessingSettings();
+  return !runs.empty() && std::all_of(runs.cbegin(), runs.cend(), [&settings](const API::Run *run) {
+    return run->hasProperty(POST_PROCESSING_LOG) &&
+           run->getPropertyValueAsType<std::string>(POST_PROCESSING_LOG) == settings;
+  });
+}
+
+//----------------------------------------------------------------------------------------------
+/// @return the properties that determine the result of the post-processing
+std::string LoadLiveData::postProcessingSettings() const {
+  std::string settings;
+  for (const auto &name : {"PostProcessingAlgorithm", "PostProcessingProperties", "PostProcessingScript",
+                           "PostProcessingScriptFilename", "AccumulationWorkspace"}) {
+    settings.append(name).append("=").append(this->getPropertyValue(name)).append("\n");
+  }
+  return settings;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by adding (summing) to the output workspace.
  * Calls the Plus algorithm
- * Sets m_accumWS.
  *
+ * @param accumWS :: workspace to add to, m_accumWS or the post-processed
+ *m_outputWS. Replaced by the sum for MD workspaces.
  * @param chunkWS :: processed live data chunk workspace
  */
-void LoadLiveData::addChunk(const Mantid::API::Workspace_sptr &chunkWS) {
+void LoadLiveData::addChunk(API::Workspace_sptr &accumWS, const Mantid::API::Workspace_sptr &chunkWS) {
   // Acquire locks on the workspaces we use
-  WriteLock _lock1(*m_accumWS);
+  WriteLock _lock1(*accumWS);
   ReadLock _lock2(*chunkWS);
 
   // ISIS multi-period data come in workspace groups
   if (WorkspaceGroup_sptr gws = std::dynamic_pointer_cast<WorkspaceGroup>(chunkWS)) {
-    WorkspaceGroup_sptr accum_gws = std::dynamic_pointer_cast<WorkspaceGroup>(m_accumWS);
+    WorkspaceGroup_sptr accum_gws = std::dynamic_pointer_cast<WorkspaceGroup>(accumWS);
     if (!accum_gws) {
       throw std::runtime_error("Two workspace groups are expected.");
     }
@@ -244,10 +332,10 @@ void LoadLiveData::addChunk(const Mantid::API::Workspace_sptr &chunkWS) {
     }
   } else if (MatrixWorkspace_sptr mws = std::dynamic_pointer_cast<MatrixWorkspace>(chunkWS)) {
     // If workspace is a Matrix workspace just add the chunk
-    addMatrixWSChunk(m_accumWS, chunkWS);
+    addMatrixWSChunk(accumWS, chunkWS);
   } else {
     // Assume MD Workspace
-    addMDWSChunk(m_accumWS, chunkWS);
+    addMDWSChunk(accumWS, chunkWS);
   }
 }
 
@@ -549,7 +637,7 @@ void LoadLiveData::exec() {
     this->appendChunk(processed);
   } else {
     // Default to Add.
-    this->addChunk(processed);
+    this->addChunk(m_accumWS, processed);
 
     // When adding events, the default bin boundaries may need to be updated.
     // The function itself checks to see if it is appropriate
@@ -562,7 +650,17 @@ void LoadLiveData::exec() {
 
   if (this->hasPostProcessing()) {
     // ----------- Run post-processing -------------
-    this->runPostProcessing();
+    if (this->canPostProcessIncrementally(accum)) {
+      g_log.notice() << "Post-processing the new chunk only.\n";
+      this->runIncrementalPostProcessing(processed);
+    } else {
+      this->runPostProcessing();
+    }
+    // Record the settings used, so that the next update can tell if it may
+    // post-process its chunk only
+    const auto settings = this->postProcessingSettings();
+    for (auto *run : addableRuns(m_outputWS.get()))
+      run->addProperty(POST_PROCESSING_LOG, settings, true);
     // Set both output workspaces
     this->setProperty("AccumulationWorkspace", m_accumWS);
     this->setProperty("OutputWorkspace", m_outputWS);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/LiveListenerFactory.h"
 #include "MantidAPI/Run.h"
@@ -83,7 +84,8 @@ public:
                                const std::string &ProcessingProperties = "",
                                const std::string &PostProcessingAlgorithm = "",
                                const std::string &PostProcessingProperties = "", bool PreserveEvents = true,
-                               const ILiveListener_sptr &listener = ILiveListener_sptr(), bool makeThrow = false) {
+                               const ILiveListener_sptr &listener = ILiveListener_sptr(), bool makeThrow = false,
+                               const std::string &PostProcessingMode = "Full") {
     FacilityHelper::ScopedFacilities loadTESTFacility("unit_testing/UnitTestFacilities.xml", "TEST");
 
     LoadLiveData alg;
@@ -95,6 +97,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("ProcessingProperties", ProcessingProperties));
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("PostProcessingAlgorithm", PostProcessingAlgorithm));
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("PostProcessingProperties", PostProcessingProperties));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("PostProcessingMode", PostProcessingMode));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("PreserveEvents", PreserveEvents));
     if (!PostProcessingAlgorithm.empty())
       TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AccumulationWorkspace", "fake_accum"));
@@ -319,6 +322,39 @@ public:
     TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(), 2);
   }
 
+  //--------------------------------------------------------------------------------------------
+  /** Incremental PostProcessing of the new chunk only */
+  void test_Incremental_PostProcessing_Adds_To_Previous_Output() {
+    auto ws1 = doExec<Workspace2D>("Add", "Rebin", "Params=40e3, 1e3, 60e3", "Rebin", "Params=40e3, 2e3, 60e3", false,
+                                   ILiveListener_sptr(), false, "Incremental");
+    auto ws2 = doExec<Workspace2D>("Add", "Rebin", "Params=40e3, 1e3, 60e3", "Rebin", "Params=40e3, 2e3, 60e3", false,
+                                   ILiveListener_sptr(), false, "Incremental");
+    TSM_ASSERT("The post-processed chunk was added to the previous output", ws1 == ws2);
+    TS_ASSERT_EQUALS(ws2->blocksize(), 10);
+    checkSameAsPostProcessedAccumulation(*ws2, "Params=40e3, 2e3, 60e3");
+    AnalysisDataService::Instance().clear();
+  }
+
+  void test_Incremental_PostProcessing_Reprocesses_All_When_Settings_Change() {
+    doExec<Workspace2D>("Add", "Rebin", "Params=40e3, 1e3, 60e3", "Rebin", "Params=40e3, 2e3, 60e3", false,
+                        ILiveListener_sptr(), false, "Incremental");
+    doExec<Workspace2D>("Add", "Rebin", "Params=40e3, 1e3, 60e3", "Rebin", "Params=40e3, 2e3, 60e3", false,
+                        ILiveListener_sptr(), false, "Incremental");
+    auto ws = doExec<Workspace2D>("Add", "Rebin", "Params=40e3, 1e3, 60e3", "Rebin", "Params=40e3, 4e3, 60e3", false,
+                                  ILiveListener_sptr(), false, "Incremental");
+    TS_ASSERT_EQUALS(ws->blocksize(), 5);
+    checkSameAsPostProcessedAccumulation(*ws, "Params=40e3, 4e3, 60e3");
+    AnalysisDataService::Instance().clear();
+  }
+
+  void test_Full_PostProcessing_Reprocesses_All() {
+    auto ws1 = doExec<Workspace2D>("Add", "Rebin", "Params=40e3, 1e3, 60e3", "Rebin", "Params=40e3, 2e3, 60e3", false);
+    auto ws2 = doExec<Workspace2D>("Add", "Rebin", "Params=40e3, 1e3, 60e3", "Rebin", "Params=40e3, 2e3, 60e3", false);
+    TSM_ASSERT("The output was post-processed again", ws1 != ws2);
+    checkSameAsPostProcessedAccumulation(*ws2, "Params=40e3, 2e3, 60e3");
+    AnalysisDataService::Instance().clear();
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Do some processing that converts to a different type of workspace */
   void test_ProcessToMDWorkspace_and_Add() {
@@ -491,4 +527,26 @@ public:
     TS_ASSERT_EQUALS(std::accumulate(mws->readY(1).begin(), mws->readY(1).end(), 0.0, std::plus<double>()), 16.0);
     AnalysisDataService::Instance().clear();
   }
+
+private:
+  /// Check that the output is the same as rebinning the whole accumulation
+  /// workspace
+  void checkSameAsPostProcessedAccumulation(const MatrixWorkspace &ws, const std::string &params) {
+    auto rebin = AlgorithmManager::Instance().createUnmanaged("Rebin");
+    rebin->initialize();
+    rebin->setChild(true);
+    rebin->setPropertyValue("InputWorkspace", "fake_accum");
+    rebin->setPropertyValue("Params", params);
+    rebin->setPropertyValue("OutputWorkspace", "unused");
+    rebin->execute();
+    MatrixWorkspace_sptr expected = rebin->getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(ws.getNumberHistograms(), expected->getNumberHistograms());
+    TS_ASSERT_EQUALS(ws.blocksize(), expected->blocksize());
+    for (size_t i = 0; i < expected->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < expected->blocksize(); ++j) {
+        TS_ASSERT_DELTA(ws.y(i)[j], expected->y(i)[j], 1e-10);
+        TS_ASSERT_DELTA(ws.e(i)[j], expected->e(i)[j], 1e-10);
+      }
+    }
+  }
 };
@@ -62,9 +62,27 @@ private:
   /// Helper method
   template <typename MDE, size_t nd> void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  /// Helper method binning all the cuts in one pass over the boxes
+  template <typename MDE, size_t nd> void binCutsByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+
   /// Method to bin a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax);
+  /// Add the cached signal of a box that lies within a single bin
+  template <typename MDE, size_t nd>
+  bool binWholeBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax);
+  /// Bin the events of a box
+  template <typename MDE>
+  void binEvents(const std::vector<MDE> &events, const size_t *const chunkMin, const size_t *const chunkMax);
+
+  /// Create the transform and the empty output workspace of a cut
+  void createOutputWorkspace();
+  /// Create the cuts given in AdditionalCuts
+  void createAdditionalCuts(const API::IMDWorkspace_sptr &inputWS);
+  /// Cache the output arrays of a cut
+  void cacheOutputArrays();
+  /// Copy the information of the input workspace to the output of a cut
+  void finaliseOutputWorkspace();
 
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
@@ -79,6 +97,8 @@ private:
   signal_t *errors;
   signal_t *numEvents;
   bool m_accumulate{false};
+  /// The cuts given in AdditionalCuts, with the names of their outputs
+  std::vector<std::pair<std::string, std::shared_ptr<BinMD>>> m_additionalCuts;
 };
 
 } // namespace MDAlgorithms
@@ -6,8 +6,8 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include "MantidDataObjects/MDEventTreeBuilder.h"
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
-#include "MantidMDAlgorithms/MDEventTreeBuilder.h"
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -156,32 +156,18 @@ std::vector<MDEventType<ND>> ConvToMDEventsWSIndexing::convertEvents() {
 }
 
 template <typename EventType, size_t ND, template <size_t> class MDEventType>
-void ConvToMDEventsWSIndexing::appendEvents(API::Progress *pProgress, const API::BoxController_sptr &bc) {
-  bc->clearBoxesCounter(1);
-  bc->clearGridBoxesCounter(0);
+void ConvToMDEventsWSIndexing::appendEvents(API::Progress *pProgress, const API::BoxController_sptr & /*bc*/) {
   pProgress->resetNumSteps(2, 0, 1);
 
   std::vector<MDEventType<ND>> mdEvents = convertEvents<EventType, ND, MDEventType>();
 
-  morton_index::MDSpaceBounds<ND> space;
-  const auto &pws = m_OutWSWrapper->pWorkspace();
-  for (size_t ax = 0; ax < ND; ++ax) {
-    space(ax, 0) = pws->getDimension(ax)->getMinimum();
-    space(ax, 1) = pws->getDimension(ax)->getMaximum();
-  }
-
   pProgress->report(0);
 
-  auto nThreads = numWorkers();
-  using EventDistributor = MDEventTreeBuilder<ND, MDEventType, typename std::vector<MDEventType<ND>>::iterator>;
-  EventDistributor distributor(nThreads, mdEvents.size() / nThreads / 10, bc, space);
-
-  auto rootAndErr = distributor.distribute(mdEvents);
-  m_OutWSWrapper->pWorkspace()->setBox(rootAndErr.root);
-  rootAndErr.root->calculateGridCaches();
+  auto &ws = dynamic_cast<DataObjects::MDEventWorkspace<MDEventType<ND>, ND> &>(*m_OutWSWrapper->pWorkspace());
+  const auto err = DataObjects::buildMDEventTree(ws, mdEvents, numWorkers());
 
   std::stringstream ss;
-  ss << rootAndErr.err;
+  ss << err;
   g_Log.information("Error with using Morton indexes is:\n" + ss.str());
   pProgress->report(1);
 }
@@ -10,6 +10,7 @@
 #include "MantidAPI/IFileLoader.h"
 #include "MantidAPI/IMDEventWorkspace_fwd.h"
 #include "MantidAPI/NexusFileLoader.h"
+#include "MantidAPI/Progress.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidKernel/NexusDescriptor.h"
 #include "MantidKernel/System.h"
@@ -12,6 +12,8 @@
 #include "MantidMDAlgorithms/DllConfig.h"
 #include "MantidMDAlgorithms/SlicingAlgorithm.h"
 
+class MDNormTest;
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -30,6 +32,9 @@ public:
   }
 
 private:
+  /// checks the intersections and the detector values without a workspace
+  friend class ::MDNormTest;
+
   void init() override;
   void exec() override;
   void validateBinningForTemporaryDataWorkspace(const std::map<std::string, std::string> &,
@@ -58,10 +63,12 @@ private:
   std::vector<coord_t> getValuesFromOtherDimensions(bool &skipNormalization, uint16_t expInfoIndex = 0) const;
 
   void cacheDimensionXValues();
+  void cacheDetectorValues(const API::ExperimentInfo_const_sptr &exptInfo);
   void calculateNormalization(const std::vector<coord_t> &otherValues, const Geometry::SymmetryOperation &so,
                               uint16_t expInfoIndex, size_t soIndex);
 
-  void calculateIntersections(std::vector<std::array<double, 4>> &intersections, const double theta, const double phi,
+  void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
+                              std::vector<std::array<double, 4>> &buffer, const Kernel::V3D &direction,
                               const Kernel::DblMatrix &transform, double lowvalue, double highvalue);
 
   void calcIntegralsForIntersections(const std::vector<double> &xValues, const API::MatrixWorkspace &integrFlux,
@@ -125,6 +132,22 @@ private:
   Kernel::V3D m_beamDir;
   /// ki-kf for Inelastic convention; kf-ki for Crystallography convention
   std::string convention;
+
+  /// Values of the spectra that only depend on the instrument, reused for all
+  /// the symmetry operations and the runs with equivalent detectors
+  struct DetectorValues {
+    /// The experiment info the values were calculated for
+    API::ExperimentInfo_const_sptr exptInfo;
+    /// Indices of the spectra contributing to the normalization
+    std::vector<size_t> spectra;
+    /// Direction of the scattered neutrons in the lab frame, per spectrum
+    std::vector<Kernel::V3D> directions;
+    /// Solid angle factor, per spectrum. 1 without a solid angle workspace
+    std::vector<double> solidAngles;
+    /// Workspace index in the flux workspace, per spectrum. Diffraction only
+    std::vector<size_t> fluxIndices;
+  };
+  DetectorValues m_detectorValues;
 };
 
 } // namespace MDAlgorithms
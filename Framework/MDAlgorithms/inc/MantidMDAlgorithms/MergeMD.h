@@ -34,6 +34,8 @@ private:
   void createOutputWorkspace(std::vector<std::string> &inputs);
 
   template <typename MDE, size_t nd> void doPlus(typename Mantid::DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+  template <typename MDE, size_t nd>
+  void buildBoxTree(typename Mantid::DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
   /// Vector of input MDWorkspaces
   std::vector<Mantid::API::IMDEventWorkspace_sptr> m_workspaces;
@@ -43,6 +45,10 @@ private:
 
   /// Output MDEventWorkspace
   Mantid::API::IMDEventWorkspace_sptr out;
+
+  /// Build the box tree of the output once all events are added, instead of
+  /// splitting boxes after each input workspace
+  bool m_buildTreeOnce{false};
 };
 
 } // namespace MDAlgorithms
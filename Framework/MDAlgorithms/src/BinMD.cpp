@@ -18,10 +18,13 @@
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/PropertyManager.h"
+#include "MantidKernel/PropertyManagerProperty.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
+#include <unordered_map>
 
 namespace Mantid::MDAlgorithms {
 
@@ -79,6 +82,12 @@ void BinMD::init() {
 
   declareProperty(std::make_unique<WorkspaceProperty<Workspace>>("OutputWorkspace", "", Direction::Output),
                   "A name for the output MDHistoWorkspace.");
+
+  declareProperty(std::make_unique<PropertyManagerProperty>("AdditionalCuts", Direction::Input),
+                  "A dictionary of further cuts of the InputWorkspace to bin in the same pass over its events. "
+                  "Each key is the name of an output MDHistoWorkspace and each value a dictionary of the "
+                  "slicing properties and ImplicitFunctionXML of that cut.");
+  setPropertyGroup("AdditionalCuts", grp);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -92,84 +101,117 @@ void BinMD::init() {
  */
 template <typename MDE, size_t nd>
 inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax) {
+  // Add the CACHED signal if the entire box is in the same bin, and don't
+  // bother looking at each event. This may save lots of time loading from disk.
+  if (binWholeBox(box, chunkMin, chunkMax))
+    return;
+
+  // If you get here, you could not determine that the entire box was in the
+  // same bin.
+  // So you need to iterate through events.
+  binEvents(box->getConstEvents(), chunkMin, chunkMax);
+  // Done with the events list
+  box->releaseEvents();
+}
+
+//----------------------------------------------------------------------------------------------
+/** Add the cached signal of a MDBox if all its vertexes are in the same bin
+ *
+ * @param box :: pointer to the MDBox to bin
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @return true if the signal of the box was added
+ */
+template <typename MDE, size_t nd>
+inline bool BinMD::binWholeBox(MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax) {
+  // There is a check that the number of events is enough for it to make sense
+  // to do all this processing.
+  if (box->getNPoints() <= (1 << nd) * 2)
+    return false;
+
   // An array to hold the rotated/transformed coordinates
   auto outCenter = std::vector<coord_t>(m_outD);
 
-  // Evaluate whether the entire box is in the same bin
-  if (box->getNPoints() > (1 << nd) * 2) {
-    // There is a check that the number of events is enough for it to make sense
-    // to do all this processing.
-    size_t numVertexes = 0;
-    auto vertexes = box->getVertexesArray(numVertexes);
-
-    // All vertexes have to be within THE SAME BIN = have the same linear index.
-    size_t lastLinearIndex = 0;
-    bool badOne = false;
+  size_t numVertexes = 0;
+  auto vertexes = box->getVertexesArray(numVertexes);
 
-    for (size_t i = 0; i < numVertexes; i++) {
-      // Cache the center of the event (again for speed)
-      const coord_t *inCenter = vertexes.get() + i * nd;
+  // All vertexes have to be within THE SAME BIN = have the same linear index.
+  size_t lastLinearIndex = 0;
+  bool badOne = false;
 
-      // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter.data());
+  for (size_t i = 0; i < numVertexes; i++) {
+    // Cache the center of the event (again for speed)
+    const coord_t *inCenter = vertexes.get() + i * nd;
 
-      // To build up the linear index
-      size_t linearIndex = 0;
-      // To mark VERTEXES outside range
-      badOne = false;
+    // Now transform to the output dimensions
+    m_transform->apply(inCenter, outCenter.data());
 
-      /// Loop through the dimensions on which we bin
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // What is the bin index in that dimension
-        coord_t x = outCenter[bd];
-        auto ix = size_t(x);
-        // Within range (for this chunk)?
-        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-          // Build up the linear index
-          linearIndex += indexMultiplier[bd] * ix;
-        } else {
-          // Outside the range
-          badOne = true;
-          break;
-        }
-      } // (for each dim in MDHisto)
+    // To build up the linear index
+    size_t linearIndex = 0;
+    // To mark VERTEXES outside range
+    badOne = false;
 
-      // Is the vertex at the same place as the last one?
-      if (!badOne) {
-        if ((i > 0) && (linearIndex != lastLinearIndex)) {
-          // Change of index
-          badOne = true;
-          break;
-        }
-        lastLinearIndex = linearIndex;
+    /// Loop through the dimensions on which we bin
+    for (size_t bd = 0; bd < m_outD; bd++) {
+      // What is the bin index in that dimension
+      coord_t x = outCenter[bd];
+      auto ix = size_t(x);
+      // Within range (for this chunk)?
+      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
+        // Build up the linear index
+        linearIndex += indexMultiplier[bd] * ix;
+      } else {
+        // Outside the range
+        badOne = true;
+        break;
       }
+    } // (for each dim in MDHisto)
 
-      // Was the vertex completely outside the range?
-      if (badOne)
+    // Is the vertex at the same place as the last one?
+    if (!badOne) {
+      if ((i > 0) && (linearIndex != lastLinearIndex)) {
+        // Change of index
+        badOne = true;
         break;
-    } // (for each vertex)
+      }
+      lastLinearIndex = linearIndex;
+    }
 
-    if (!badOne) {
-      // Yes, the entire box is within a single bin
-      //        std::cout << "Box at " << box->getExtentsStr() << " is within a
-      //        single bin.\n";
-      // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+    // Was the vertex completely outside the range?
+    if (badOne)
+      break;
+  } // (for each vertex)
+
+  if (badOne)
+    return false;
+
+  // Yes, the entire box is within a single bin
+  // Add the CACHED signal from the entire box
+  signals[lastLinearIndex] += box->getSignal();
+  errors[lastLinearIndex] += box->getErrorSquared();
+  // TODO: If DataObjects get a weight, this would need to get the summed
+  // weight.
+  numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+  return true;
+}
 
-      // And don't bother looking at each event. This may save lots of time
-      // loading from disk.
-      return;
-    }
-  }
+//----------------------------------------------------------------------------------------------
+/** Bin the events of a MDBox
+ *
+ * @param events :: the events of the box
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ */
+template <typename MDE>
+inline void BinMD::binEvents(const std::vector<MDE> &events, const size_t *const chunkMin,
+                             const size_t *const chunkMax) {
+  // An array to hold the rotated/transformed coordinates
+  auto outCenter = std::vector<coord_t>(m_outD);
 
-  // If you get here, you could not determine that the entire box was in the
-  // same bin.
-  // So you need to iterate through events.
-  const std::vector<MDE> &events = box->getConstEvents();
   for (auto it = events.begin(); it != events.end(); ++it) {
     // Cache the center of the event (again for speed)
     const coord_t *inCenter = it->getCenter();
@@ -207,25 +249,13 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin, c
       numEvents[linearIndex] += 1.0;
     }
   }
-  // Done with the events list
-  box->releaseEvents();
 }
 
 //----------------------------------------------------------------------------------------------
-/** Perform binning by iterating through every event and placing them in the
- *output workspace
- *
- * @param ws :: MDEventWorkspace of the given type.
+/** Cache the index multipliers and the arrays of the output workspace, and
+ * clear them unless accumulating into a TemporaryDataWorkspace
  */
-template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
-  BoxController_sptr bc = ws->getBoxController();
-  // store exisiting write buffer size for the future
-  // uint64_t writeBufSize =bc->getDiskBuffer().getWriteBufferSize();
-  // and disable write buffer (if any) for input MD Events for this algorithm
-  // purposes;
-  // bc->setCacheParameters(1,0);
-
-  // Cache some data to speed up accessing them a bit
+void BinMD::cacheOutputArrays() {
   indexMultiplier.resize(m_outD);
   for (size_t d = 0; d < m_outD; d++) {
     if (d > 0)
@@ -241,6 +271,24 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
     // Start with signal/error/numEvents at 0.0
     outWS->setTo(0.0, 0.0, 0.0);
   }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Perform binning by iterating through every event and placing them in the
+ *output workspace
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ */
+template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  BoxController_sptr bc = ws->getBoxController();
+  // store exisiting write buffer size for the future
+  // uint64_t writeBufSize =bc->getDiskBuffer().getWriteBufferSize();
+  // and disable write buffer (if any) for input MD Events for this algorithm
+  // purposes;
+  // bc->setCacheParameters(1,0);
+
+  // Cache some data to speed up accessing them a bit
+  cacheOutputArrays();
 
   // The dimension (in the output workspace) along which we chunk for parallel
   // processing
@@ -340,11 +388,103 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
 }
 
 //----------------------------------------------------------------------------------------------
-/** Execute the algorithm.
+/** Bin this cut and the additional cuts in one pass over the boxes, so that
+ * the events of each box are read once for all the cuts
+ *
+ * @param ws :: MDEventWorkspace of the given type.
  */
-void BinMD::exec() {
-  // Input MDEventWorkspace/MDHistoWorkspace
-  m_inWS = getProperty("InputWorkspace");
+template <typename MDE, size_t nd> void BinMD::binCutsByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  BoxController_sptr bc = ws->getBoxController();
+
+  std::vector<BinMD *> cuts{this};
+  for (const auto &cut : m_additionalCuts)
+    cuts.emplace_back(cut.second.get());
+
+  // The whole output of each cut is one chunk
+  std::vector<std::vector<size_t>> chunkMin(cuts.size());
+  std::vector<std::vector<size_t>> chunkMax(cuts.size());
+  // The leaf boxes within the implicit functions of any cut, and the cuts of
+  // each of them
+  std::vector<API::IMDNode *> boxes;
+  std::unordered_map<API::IMDNode *, std::vector<size_t>> boxCuts;
+  for (size_t c = 0; c < cuts.size(); ++c) {
+    BinMD *cut = cuts[c];
+    cut->cacheOutputArrays();
+    chunkMin[c].assign(cut->m_outD, 0);
+    for (size_t bd = 0; bd < cut->m_outD; bd++)
+      chunkMax[c].emplace_back(cut->m_binDimensions[bd]->getNBins());
+
+    auto function = cut->getImplicitFunctionForChunk(chunkMin[c].data(), chunkMax[c].data());
+    std::vector<API::IMDNode *> cutBoxes;
+    // Leaf-only; no depth limit; with the implicit function passed to it.
+    ws->getBox()->getBoxes(cutBoxes, 1000, true, function.get());
+    for (auto *box : cutBoxes) {
+      auto &cutsOfBox = boxCuts[box];
+      if (cutsOfBox.empty())
+        boxes.emplace_back(box);
+      cutsOfBox.emplace_back(c);
+    }
+  }
+
+  // Sort boxes by file position IF file backed. This reduces seeking time,
+  // hopefully.
+  if (bc->isFileBacked())
+    API::IMDNode::sortObjByID(boxes);
+  g_log.debug() << "Found " << boxes.size() << " boxes within the implicit functions of " << cuts.size()
+                << " cuts.\n";
+
+  // The events of a box are loaded before its cuts are binned, and each cut
+  // writes to its own output, so the cuts can be binned in parallel even for
+  // file-backed workspaces
+  const bool doParallel = getProperty("Parallel");
+
+  if (prog) {
+    prog->setNotifyStep(0.1);
+    prog->resetNumSteps(static_cast<int64_t>(boxes.size()), 0.00, 1.0);
+  }
+
+  std::vector<size_t> eventCuts;
+  for (auto *node : boxes) {
+    auto *box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (box && !box->getIsMasked()) {
+      // The cuts that do not take the box as a whole need its events
+      eventCuts.clear();
+      for (const size_t c : boxCuts[node]) {
+        if (!cuts[c]->binWholeBox(box, chunkMin[c].data(), chunkMax[c].data()))
+          eventCuts.emplace_back(c);
+      }
+      if (!eventCuts.empty()) {
+        const std::vector<MDE> &events = box->getConstEvents();
+        PARALLEL_FOR_IF(doParallel && eventCuts.size() > 1)
+        for (int i = 0; i < static_cast<int>(eventCuts.size()); ++i) {
+          const size_t c = eventCuts[i];
+          cuts[c]->binEvents(events, chunkMin[c].data(), chunkMax[c].data());
+        }
+        box->releaseEvents();
+      }
+    }
+
+    // Progress reporting
+    if (prog)
+      prog->report();
+    // For early cancelling of the loop
+    if (this->m_cancel)
+      break;
+  }
+
+  // Now the implicit functions
+  signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+  for (BinMD *cut : cuts) {
+    if (cut->implicitFunction)
+      cut->outWS->applyImplicitFunction(cut->implicitFunction.get(), nan, nan);
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Create the transform from the slicing properties, the implicit function and
+ * the empty output workspace, or the TemporaryDataWorkspace to accumulate into
+ */
+void BinMD::createOutputWorkspace() {
   // Look at properties, create either axis-aligned or general transform.
   // This (can) change m_inWS
   this->createTransform();
@@ -356,9 +496,6 @@ void BinMD::exec() {
     implicitFunction = std::unique_ptr<MDImplicitFunction>(
         Mantid::API::ImplicitFunctionFactory::Instance().createUnwrapped(ImplicitFunctionXML));
 
-  // This gets deleted by the thread pool; don't delete it in here.
-  prog = std::make_unique<Progress>(this, 0.0, 1.0, 1);
-
   // Create the dense histogram. This allocates the memory
   std::shared_ptr<IMDHistoWorkspace> tmp = this->getProperty("TemporaryDataWorkspace");
   outWS = std::dynamic_pointer_cast<MDHistoWorkspace>(tmp);
@@ -382,6 +519,79 @@ void BinMD::exec() {
     outWS->setTransformFromOriginal(m_transformFromIntermediate.release(), 1);
     outWS->setTransformToOriginal(m_transformToIntermediate.release(), 1);
   }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Create a BinMD for each cut in AdditionalCuts, which holds the transform
+ * and output workspace of the cut. They are not executed; their cuts are
+ * binned with this one.
+ *
+ * @param inputWS :: the InputWorkspace, which all the cuts bin
+ */
+void BinMD::createAdditionalCuts(const IMDWorkspace_sptr &inputWS) {
+  m_additionalCuts.clear();
+  const PropertyManager_const_sptr cutsArgs = getProperty("AdditionalCuts");
+  if (!cutsArgs)
+    return;
+
+  for (const auto *cutProperty : cutsArgs->getProperties()) {
+    const auto *cutArgs = dynamic_cast<const PropertyManagerProperty *>(cutProperty);
+    if (!cutArgs)
+      throw std::invalid_argument("AdditionalCuts: the value for " + cutProperty->name() +
+                                  " must be a dictionary of the properties of the cut.");
+
+    auto cut = std::make_shared<BinMD>();
+    cut->initialize();
+    cut->setChild(true);
+    cut->setProperty("InputWorkspace", inputWS);
+    for (const auto *arg : (*cutArgs)()->getProperties()) {
+      const std::string &argName = arg->name();
+      if (argName == "InputWorkspace" || argName == "OutputWorkspace" || argName == "AdditionalCuts")
+        throw std::invalid_argument("AdditionalCuts: " + argName + " cannot be set for the cut " +
+                                    cutProperty->name() + ".");
+      cut->setPropertyValue(argName, arg->value());
+    }
+    cut->m_inWS = inputWS;
+    cut->createOutputWorkspace();
+    m_additionalCuts.emplace_back(cutProperty->name(), std::move(cut));
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Copy the coordinate system, experiment infos and display normalization of
+ * the input workspace to the output workspace
+ */
+void BinMD::finaliseOutputWorkspace() {
+  // Copy the coordinate system & experiment infos to the output
+  IMDEventWorkspace_sptr inEWS = std::dynamic_pointer_cast<IMDEventWorkspace>(m_inWS);
+  if (inEWS) {
+    outWS->setCoordinateSystem(inEWS->getSpecialCoordinateSystem());
+    try {
+      outWS->copyExperimentInfos(*inEWS);
+    } catch (std::runtime_error &) {
+      g_log.warning() << this->name() << " was not able to copy experiment info to output workspace "
+                      << outWS->getName() << '\n';
+    }
+  }
+
+  // Pass on the display normalization from the input workspace
+  outWS->setDisplayNormalization(m_inWS->displayNormalizationHisto());
+
+  outWS->updateSum();
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void BinMD::exec() {
+  // Input MDEventWorkspace/MDHistoWorkspace
+  IMDWorkspace_sptr inputWS = getProperty("InputWorkspace");
+  m_inWS = inputWS;
+  createOutputWorkspace();
+  createAdditionalCuts(inputWS);
+
+  // This gets deleted by the thread pool; don't delete it in here.
+  prog = std::make_unique<Progress>(this, 0.0, 1.0, 1);
 
   // Wrapper to cast to MDEventWorkspace then call the function
   bool IterateEvents = getProperty("IterateEvents");
@@ -404,24 +614,22 @@ void BinMD::exec() {
                              "Reprocess the input so that it contains full MDEvents.");
   }
 
-  CALL_MDEVENT_FUNCTION(this->binByIterating, m_inWS);
-
-  // Copy the coordinate system & experiment infos to the output
-  IMDEventWorkspace_sptr inEWS = std::dynamic_pointer_cast<IMDEventWorkspace>(m_inWS);
-  if (inEWS) {
-    outWS->setCoordinateSystem(inEWS->getSpecialCoordinateSystem());
-    try {
-      outWS->copyExperimentInfos(*inEWS);
-    } catch (std::runtime_error &) {
-      g_log.warning() << this->name() << " was not able to copy experiment info to output workspace "
-                      << outWS->getName() << '\n';
-    }
+  if (m_additionalCuts.empty()) {
+    CALL_MDEVENT_FUNCTION(this->binByIterating, m_inWS);
+  } else {
+    CALL_MDEVENT_FUNCTION(this->binCutsByIterating, m_inWS);
   }
 
-  // Pass on the display normalization from the input workspace
-  outWS->setDisplayNormalization(m_inWS->displayNormalizationHisto());
+  finaliseOutputWorkspace();
+  for (const auto &cut : m_additionalCuts) {
+    cut.second->finaliseOutputWorkspace();
+    const std::string propName = "OutputWorkspace_" + cut.first;
+    if (!existsProperty(propName))
+      declareProperty(std::make_unique<WorkspaceProperty<Workspace>>(propName, cut.first, Direction::Output));
+    setProperty(propName, std::dynamic_pointer_cast<Workspace>(cut.second->outWS));
+  }
+  m_additionalCuts.clear();
 
-  outWS->updateSum();
   // Save the output
   setProperty("OutputWorkspace", std::dynamic_pointer_cast<Workspace>(outWS));
 }
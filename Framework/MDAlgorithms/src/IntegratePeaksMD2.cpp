@@ -22,6 +22,7 @@
 #include "MantidDataObjects/LeanElasticPeaksWorkspace.h"
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDSphereIntegrator.h"
 #include "MantidDataObjects/Peak.h"
 #include "MantidDataObjects/PeakShapeEllipsoid.h"
 #include "MantidDataObjects/PeakShapeSpherical.h"
@@ -470,6 +471,59 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
   Progress progress(this, 0., 1., nPeaks);
+
+  // Check for overlaps and save the intensity of an integrated peak
+  auto savePeakIntensity = [&](int i, const V3D &pos, const double edgeDist, const signal_t signal,
+                               const signal_t errorSquared, const signal_t bgSignal, const signal_t bgErrorSquared,
+                               const double background_total) {
+    IPeak &p = peakWS->getPeak(i);
+    checkOverlap(i, peakWS, CoordinatesToUse, 2.0 * std::max(PeakRadiusVector[i], BackgroundOuterRadiusVector[i]));
+    // Save it back in the peak object.
+    if (signal != 0. || replaceIntensity) {
+      double edgeMultiplier = 1.0;
+      double peakMultiplier = 1.0;
+      if (correctEdge) {
+        if (edgeDist < BackgroundOuterRadius[0]) {
+          double e1 = BackgroundOuterRadius[0] - edgeDist;
+          // volume of cap of sphere with h = edge
+          double f1 = M_PI * std::pow(e1, 2) / 3 * (3 * BackgroundOuterRadius[0] - e1);
+          edgeMultiplier = volumeBkg / (volumeBkg - f1);
+        }
+        if (edgeDist < PeakRadius[0]) {
+          double sigma = PeakRadius[0] / 3.0;
+          // assume gaussian peak
+          double e1 = std::exp(-std::pow(edgeDist, 2) / (2 * sigma * sigma)) * PeakRadius[0];
+          // volume of cap of sphere with h = edge
+          double f1 = M_PI * std::pow(e1, 2) / 3 * (3 * PeakRadius[0] - e1);
+          peakMultiplier = volumeRadius / (volumeRadius - f1);
+        }
+      }
+
+      p.setIntensity(peakMultiplier * signal - edgeMultiplier * (ratio * background_total + bgSignal));
+      p.setSigmaIntensity(sqrt(peakMultiplier * errorSquared +
+                               edgeMultiplier * (ratio * ratio * std::fabs(background_total) + bgErrorSquared)));
+    }
+
+    g_log.information() << "Peak " << i << " at " << pos << ": signal " << signal << " (sig^2 " << errorSquared
+                        << "), with background " << bgSignal + ratio * background_total << " (sig^2 "
+                        << bgErrorSquared + ratio * ratio * std::fabs(background_total) << ") subtracted.\n";
+  };
+
+  // Spheres are integrated after the loop, together with one traversal of the
+  // box tree, rather than searching the tree for each peak
+  const bool integrateSpheresTogether = !cylinderBool && !isEllipse;
+  MDSphereIntegrator<MDE, nd> sphereIntegrator;
+  struct SpherePeak {
+    int index;
+    V3D pos;
+    double edgeDist;
+    size_t peakSphere;
+    bool hasBackground;
+    size_t backgroundSphere;
+    double scaleFactor;
+  };
+  std::vector<SpherePeak> spherePeaks;
+
   for (int i = 0; i < nPeaks; ++i) {
     if (this->getCancel())
       break; // User cancellation
@@ -551,6 +605,18 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
       p.setPeakShape(sphereShape);
       const double scaleFactor = pow(PeakRadiusVector[i], 3) /
                                  (pow(BackgroundOuterRadiusVector[i], 3) - pow(BackgroundInnerRadiusVector[i], 3));
+      if (integrateSpheresTogether) {
+        SpherePeak spherePeak{i, pos, edgeDist, 0, false, 0, scaleFactor};
+        spherePeak.peakSphere = sphereIntegrator.addSphere(center, PeakRadiusVector[i]);
+        if (BackgroundOuterRadius[0] > PeakRadius[0]) {
+          spherePeak.hasBackground = true;
+          spherePeak.backgroundSphere =
+              sphereIntegrator.addSphere(center, BackgroundOuterRadiusVector[i], BackgroundInnerRadiusVector[i],
+                                         useOnePercentBackgroundCorrection);
+        }
+        spherePeaks.emplace_back(spherePeak);
+        continue;
+      }
       // Integrate spherical background shell if specified
       if (BackgroundOuterRadius[0] > PeakRadius[0]) {
         // Get the total signal inside background shell
@@ -861,36 +927,24 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
         }
       }
     }
-    checkOverlap(i, peakWS, CoordinatesToUse, 2.0 * std::max(PeakRadiusVector[i], BackgroundOuterRadiusVector[i]));
-    // Save it back in the peak object.
-    if (signal != 0. || replaceIntensity) {
-      double edgeMultiplier = 1.0;
-      double peakMultiplier = 1.0;
-      if (correctEdge) {
-        if (edgeDist < BackgroundOuterRadius[0]) {
-          double e1 = BackgroundOuterRadius[0] - edgeDist;
-          // volume of cap of sphere with h = edge
-          double f1 = M_PI * std::pow(e1, 2) / 3 * (3 * BackgroundOuterRadius[0] - e1);
-          edgeMultiplier = volumeBkg / (volumeBkg - f1);
-        }
-        if (edgeDist < PeakRadius[0]) {
-          double sigma = PeakRadius[0] / 3.0;
-          // assume gaussian peak
-          double e1 = std::exp(-std::pow(edgeDist, 2) / (2 * sigma * sigma)) * PeakRadius[0];
-          // volume of cap of sphere with h = edge
-          double f1 = M_PI * std::pow(e1, 2) / 3 * (3 * PeakRadius[0] - e1);
-          peakMultiplier = volumeRadius / (volumeRadius - f1);
-        }
-      }
+    savePeakIntensity(i, pos, edgeDist, signal, errorSquared, bgSignal, bgErrorSquared, background_total);
+  }
 
-      p.setIntensity(peakMultiplier * signal - edgeMultiplier * (ratio * background_total + bgSignal));
-      p.setSigmaIntensity(sqrt(peakMultiplier * errorSquared +
-                               edgeMultiplier * (ratio * ratio * std::fabs(background_total) + bgErrorSquared)));
+  if (!spherePeaks.empty() && !this->getCancel()) {
+    sphereIntegrator.integrate(*ws->getBox());
+    for (const auto &spherePeak : spherePeaks) {
+      signal_t bgSignal = 0;
+      signal_t bgErrorSquared = 0;
+      if (spherePeak.hasBackground) {
+        // correct bg signal by Vpeak/Vshell
+        bgSignal = sphereIntegrator.signal(spherePeak.backgroundSphere) * spherePeak.scaleFactor;
+        bgErrorSquared = sphereIntegrator.errorSquared(spherePeak.backgroundSphere) * spherePeak.scaleFactor *
+                         spherePeak.scaleFactor;
+      }
+      savePeakIntensity(spherePeak.index, spherePeak.pos, spherePeak.edgeDist,
+                        sphereIntegrator.signal(spherePeak.peakSphere),
+                        sphereIntegrator.errorSquared(spherePeak.peakSphere), bgSignal, bgErrorSquared, 0.0);
     }
-
-    g_log.information() << "Peak " << i << " at " << pos << ": signal " << signal << " (sig^2 " << errorSquared
-                        << "), with background " << bgSignal + ratio * background_total << " (sig^2 "
-                        << bgErrorSquared + ratio * ratio * std::fabs(background_total) << ") subtracted.\n";
   }
   // This flag is used by the PeaksWorkspace to evaluate whether it has
   // been integrated.
@@ -11,6 +11,7 @@
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/RegisterFileLoader.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataObjects/BoxControllerMmapIO.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
@@ -31,6 +32,7 @@
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/System.h"
 #include "MantidMDAlgorithms/SetMDFrame.h"
+#include <Poco/TemporaryFile.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
 #include <nexus/NeXusException.hpp>
@@ -100,6 +102,13 @@ void LoadMD::init() {
                   "If not specified, a default of 40% of free physical memory is used.");
   setPropertySettings("Memory", std::make_unique<EnabledWhenProperty>("FileBackEnd", IS_EQUAL_TO, "1"));
 
+  declareProperty(std::make_unique<PropertyWithValue<bool>>("MemoryMappedBackEnd", false),
+                  "For FileBackEnd only: keep the events saved by the workspace in a memory-mapped "
+                  "scratch file in the temporary directory instead of in the NeXus file, which is "
+                  "only read. Boxes are then saved without waiting for each other, and the "
+                  "operating system caches the file. The scratch file is removed with the workspace.");
+  setPropertySettings("MemoryMappedBackEnd", std::make_unique<EnabledWhenProperty>("FileBackEnd", IS_EQUAL_TO, "1"));
+
   declareProperty("LoadHistory", true, "If true, the workspace history will be loaded");
 
   declareProperty(std::make_unique<WorkspaceProperty<IMDWorkspace>>("OutputWorkspace", "", Direction::Output),
@@ -508,9 +517,25 @@ template <typename MDE, size_t nd> void LoadMD::doLoad(typename MDEventWorkspace
   // ---------------------------------------- DEAL WITH BOXES
   // ------------------------------------
   if (fileBackEnd) { // TODO:: call to the file format factory
-    auto loader = std::shared_ptr<DataObjects::BoxControllerNeXusIO>(new DataObjects::BoxControllerNeXusIO(bc.get()));
-    loader->setDataType(sizeof(coord_t), MDE::getTypeName());
-    bc->setFileBacked(loader, m_filename);
+    const bool memoryMapped = getProperty("MemoryMappedBackEnd");
+    std::shared_ptr<API::IBoxControllerIO> loader;
+    if (memoryMapped) {
+      // the boxes are read from the NeXus file until they are saved to the
+      // scratch file, a new file so that it is removed when closed
+      auto source = std::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
+      source->setDataType(sizeof(coord_t), MDE::getTypeName());
+      source->openFile(m_filename, "r");
+      auto scratch = std::make_shared<DataObjects::BoxControllerMmapIO>(bc.get());
+      scratch->setDataType(sizeof(coord_t), MDE::getTypeName());
+      scratch->openFile(Poco::TemporaryFile::tempName(), "w");
+      scratch->setSourceFile(source);
+      loader = scratch;
+      bc->setFileBacked(loader, loader->getFileName());
+    } else {
+      loader = std::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
+      loader->setDataType(sizeof(coord_t), MDE::getTypeName());
+      bc->setFileBacked(loader, m_filename);
+    }
     // boxes have been already made file-backed when restoring the boxTree;
     // How much memory for the cache?
     {
@@ -518,9 +543,10 @@ template <typename MDE, size_t nd> void LoadMD::doLoad(typename MDEventWorkspace
       double mb = getProperty("Memory");
 
       // Defaults have changed, default disk buffer size should be 10 data
-      // chunks TODO: find optimal, 100 may be better.
+      // chunks TODO: find optimal, 100 may be better. The operating system
+      // caches a memory-mapped file, so one chunk is enough for it.
       if (mb <= 0)
-        mb = double(10 * loader->getDataChunk() * sizeof(MDE)) / double(1024 * 1024);
+        mb = double((memoryMapped ? 1 : 10) * loader->getDataChunk() * sizeof(MDE)) / double(1024 * 1024);
 
       // Express the cache memory in units of number of events.
       uint64_t cacheMemory = static_cast<uint64_t>((mb * 1024. * 1024.) / sizeof(MDE)) + 1;
@@ -17,6 +17,7 @@
 #include "MantidGeometry/Crystal/SpaceGroupFactory.h"
 #include "MantidGeometry/Crystal/SymmetryOperationFactory.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidGeometry/MDGeometry/HKL.h"
 #include "MantidGeometry/MDGeometry/MDFrameFactory.h"
 #include "MantidGeometry/MDGeometry/QSample.h"
@@ -30,6 +31,7 @@
 #include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/VisibleWhenProperty.h"
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <iostream>
 
 namespace Mantid::MDAlgorithms {
@@ -41,8 +43,61 @@ using namespace Mantid::DataObjects;
 
 namespace {
 using VectorDoubleProperty = Kernel::PropertyWithValue<std::vector<double>>;
-// function to  compare two intersections (h,k,l,Momentum) by Momentum
-bool compareMomentum(const std::array<double, 4> &v1, const std::array<double, 4> &v2) { return (v1[3] < v2[3]); }
+using Intersection = std::array<double, 4>;
+
+// maximum number of runs of intersections sorted by momentum: planes
+// perpendicular to h, k, l, dE and the two endpoints
+constexpr size_t maxSortedRuns = 6;
+
+/**
+ * Merge runs of intersections (h,k,l,Momentum), each sorted by momentum, into
+ * one list sorted by momentum. Intersections with equal momenta keep their
+ * order, as with std::stable_sort of the runs one after the other.
+ * @param intersections :: the runs, replaced by the merged list
+ * @param runEnds :: the end index of each run
+ * @param nRuns :: the number of runs
+ * @param buffer :: space for the merged list
+ */
+void mergeByMomentum(std::vector<Intersection> &intersections, const std::array<size_t, maxSortedRuns> &runEnds,
+                     const size_t nRuns, std::vector<Intersection> &buffer) {
+  std::array<size_t, maxSortedRuns> heads;
+  size_t nonEmpty(0);
+  for (size_t run = 0; run < nRuns; ++run) {
+    heads[run] = (run == 0) ? 0 : runEnds[run - 1];
+    if (heads[run] < runEnds[run])
+      ++nonEmpty;
+  }
+  if (nonEmpty < 2)
+    return;
+  buffer.resize(intersections.size());
+  for (auto &merged : buffer) {
+    size_t next = nRuns;
+    for (size_t run = 0; run < nRuns; ++run) {
+      if (heads[run] < runEnds[run] &&
+          (next == nRuns || intersections[heads[run]][3] < intersections[heads[next]][3]))
+        next = run;
+    }
+    merged = intersections[heads[next]++];
+  }
+  intersections.swap(buffer);
+}
+
+/**
+ * Reverse a run of intersections that was found in order of descending
+ * momentum, keeping intersections with equal momenta in the order they were
+ * found
+ * @param first :: the start of the run
+ * @param last :: the end of the run
+ */
+void reverseByMomentum(std::vector<Intersection>::iterator first, const std::vector<Intersection>::iterator last) {
+  std::reverse(first, last);
+  while (first != last) {
+    const auto equalEnd =
+        std::find_if(first, last, [first](const Intersection &other) { return other[3] != (*first)[3]; });
+    std::reverse(first, equalEnd);
+    first = equalEnd;
+  }
+}
 
 // k=sqrt(energyToK * E)
 constexpr double energyToK = 8.0 * M_PI * M_PI * PhysicalConstants::NeutronMass * PhysicalConstants::meV * 1e-20 /
@@ -513,6 +568,7 @@ void MDNorm::exec() {
   }
 
   m_numExptInfos = outputDataWS->getNumExperimentInfo();
+  m_detectorValues = DetectorValues();
   // loop over all experiment infos
   for (uint16_t expInfoIndex = 0; expInfoIndex < m_numExptInfos; expInfoIndex++) {
     // Check for other dimensions if we could measure anything in the original
@@ -523,6 +579,7 @@ void MDNorm::exec() {
     cacheDimensionXValues();
 
     if (!skipNormalization) {
+      cacheDetectorValues(m_inputWS->getExperimentInfo(expInfoIndex));
       size_t symmOpsIndex = 0;
       for (const auto &so : symmetryOps) {
         calculateNormalization(otherValues, so, expInfoIndex, symmOpsIndex);
@@ -1320,6 +1377,80 @@ void MDNorm::cacheDimensionXValues() {
   }
 }
 
+/**
+ * Stores the values of the spectra that do not depend on the goniometer, UB
+ * matrix or symmetry operation, unless they are already stored for an
+ * equivalent instrument
+ * @param exptInfo :: the experiment info to normalize next
+ */
+void MDNorm::cacheDetectorValues(const API::ExperimentInfo_const_sptr &exptInfo) {
+  const auto &spectrumInfo = exptInfo->spectrumInfo();
+  if (m_detectorValues.exptInfo) {
+    const auto &cachedInfo = *m_detectorValues.exptInfo;
+    if (cachedInfo.detectorInfo().isEquivalent(exptInfo->detectorInfo()) &&
+        cachedInfo.detectorInfo().detectorIDs() == exptInfo->detectorInfo().detectorIDs() &&
+        *cachedInfo.spectrumInfo().sharedSpectrumDefinitions() == *spectrumInfo.sharedSpectrumDefinitions())
+      return;
+  }
+
+  API::MatrixWorkspace_const_sptr solidAngleWS = getProperty("SolidAngleWorkspace");
+  API::MatrixWorkspace_const_sptr integrFlux = getProperty("FluxWorkspace");
+  const detid2index_map solidAngDetToIdx =
+      (solidAngleWS) ? solidAngleWS->getDetectorIDToWorkspaceIndexMap() : detid2index_map();
+  const detid2index_map fluxDetToIdx =
+      (m_diffraction) ? integrFlux->getDetectorIDToWorkspaceIndexMap() : detid2index_map();
+
+  const auto ndets = static_cast<int64_t>(spectrumInfo.size());
+  m_detectorValues.exptInfo = exptInfo;
+  m_detectorValues.directions.assign(ndets, V3D());
+  m_detectorValues.solidAngles.assign(ndets, 1.);
+  m_detectorValues.fluxIndices.assign(ndets, 0);
+  std::vector<char> used(ndets, 0);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < ndets; i++) {
+    PARALLEL_START_INTERUPT_REGION
+    // Skip: non-existing detector, monitor and masked detector
+    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) || spectrumInfo.isMasked(i)) {
+      continue;
+    }
+
+    const auto &detector = spectrumInfo.detector(i);
+    // If the detector is a group, this should be the ID of the first detector
+    const auto detID = detector.getID();
+
+    // get the flux spectrum number: this is for diffraction only!
+    if (m_diffraction) {
+      auto index = fluxDetToIdx.find(detID);
+      if (index == fluxDetToIdx.end()) {
+        // masked detector in flux, but not in input workspace
+        continue;
+      }
+      m_detectorValues.fluxIndices[i] = index->second;
+    }
+    if (solidAngleWS) {
+      auto index = solidAngDetToIdx.find(detID);
+      if (index == solidAngDetToIdx.end()) {
+        continue;
+      }
+      m_detectorValues.solidAngles[i] = solidAngleWS->y(index->second)[0];
+    }
+
+    const double theta = detector.getTwoTheta(m_samplePos, m_beamDir);
+    const double phi = detector.getPhi();
+    m_detectorValues.directions[i] = V3D(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+    used[i] = 1;
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  m_detectorValues.spectra.clear();
+  for (size_t i = 0; i < used.size(); ++i) {
+    if (used[i])
+      m_detectorValues.spectra.emplace_back(i);
+  }
+}
+
 /**
  * Calculate QTransform = (R * UB * SymmetryOperation * m_W)^-1
  * @param currentExpInfo
@@ -1483,20 +1614,14 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, con
   const double protonChargeBkgd =
       (m_backgroundWS != nullptr) ? m_backgroundWS->getExperimentInfo(0)->run().getProtonCharge() : 0;
 
-  const auto &spectrumInfo = currentExptInfo.spectrumInfo();
-
-  // Mappings: solid angle and flux workspaces' detector to ws_index map
-  const auto ndets = static_cast<int64_t>(spectrumInfo.size());
-  bool haveSA = false;
-  API::MatrixWorkspace_const_sptr solidAngleWS = getProperty("SolidAngleWorkspace");
-  if (solidAngleWS != nullptr) {
-    haveSA = true;
-  }
+  // Values of the spectra that are the same for all runs and symmetry
+  // operations, see cacheDetectorValues
+  const auto &spectra = m_detectorValues.spectra;
+  const auto &directions = m_detectorValues.directions;
+  const auto &solidAngles = m_detectorValues.solidAngles;
+  const auto &fluxIndices = m_detectorValues.fluxIndices;
+  const auto nspectra = static_cast<int64_t>(spectra.size());
   API::MatrixWorkspace_const_sptr integrFlux = getProperty("FluxWorkspace");
-  const detid2index_map solidAngDetToIdx =
-      (haveSA) ? solidAngleWS->getDetectorIDToWorkspaceIndexMap() : detid2index_map();
-  const detid2index_map fluxDetToIdx =
-      (m_diffraction) ? integrFlux->getDetectorIDToWorkspaceIndexMap() : detid2index_map();
 
   // Define dimension, signal array
   const size_t vmdDims = (m_diffraction) ? 3 : 4;
@@ -1508,7 +1633,7 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, con
   }
   std::vector<std::atomic<signal_t>> bkgdSignalArray(numNPoints);
 
-  std::vector<std::array<double, 4>> intersections;
+  std::vector<std::array<double, 4>> intersections, buffer;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
 
@@ -1516,61 +1641,34 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, con
   double progStep = 0.7 / static_cast<double>(m_numExptInfos * m_numSymmOps);
   auto progIndex = static_cast<double>(soIndex + expInfoIndex * m_numSymmOps);
   auto prog =
-      std::make_unique<API::Progress>(this, 0.3 + progStep * progIndex, 0.3 + progStep * (1. + progIndex), ndets);
+      std::make_unique<API::Progress>(this, 0.3 + progStep * progIndex, 0.3 + progStep * (1. + progIndex), nspectra);
   // muliple threading
   bool safe = true;
   if (m_diffraction) {
     safe = Kernel::threadSafe(*integrFlux);
   }
 
-PRAGMA_OMP(parallel for private(intersections, xValues, yValues, pos, posNew) if (safe))
-for (int64_t i = 0; i < ndets; i++) {
+PRAGMA_OMP(parallel for private(intersections, buffer, xValues, yValues, pos, posNew) if (safe))
+for (int64_t spectrumIndex = 0; spectrumIndex < nspectra; spectrumIndex++) {
   PARALLEL_START_INTERUPT_REGION
 
-  // Skip: non-existing detector, monitor and masked detector
-  if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) || spectrumInfo.isMasked(i)) {
-    continue;
-  }
-
-  const auto &detector = spectrumInfo.detector(i);
-  double theta = detector.getTwoTheta(m_samplePos, m_beamDir);
-  double phi = detector.getPhi();
-  // If the dtefctor is a group, this should be the ID of the first detector
-  const auto detID = detector.getID();
-
-  // get the flux spectrum number: this is for diffraction only!
-  size_t wsIdx = 0;
-  if (m_diffraction) {
-    auto index = fluxDetToIdx.find(detID);
-    if (index != fluxDetToIdx.end()) {
-      wsIdx = index->second;
-    } else { // masked detector in flux, but not in input workspace
-      continue;
-    }
-  }
+  const size_t i = spectra[spectrumIndex];
 
   // Intersections for sample and background if present
-  this->calculateIntersections(intersections, theta, phi, Qtransform, lowValues[i], highValues[i]);
+  this->calculateIntersections(intersections, buffer, directions[i], Qtransform, lowValues[i], highValues[i]);
 
   // No need to do normalization calculation if there is no intersection
   if (intersections.empty())
     continue;
 
   // Get solid angle for this contribution
-  double solid = protonCharge;
+  const double solid = solidAngles[i] * protonCharge;
   // [Task 89]
-  double bkgdSolid = protonChargeBkgd;
-  if (haveSA) {
-    double solid_angle_factor = solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0];
-    //  solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0]
-    solid = solid_angle_factor * protonCharge;
-    // [Task 89]
-    bkgdSolid = solid_angle_factor * protonChargeBkgd;
-  }
+  const double bkgdSolid = solidAngles[i] * protonChargeBkgd;
 
   if (m_diffraction) {
     // -- calculate integrals for the intersection --
-    calcDiffractionIntersectionIntegral(intersections, xValues, yValues, *integrFlux, wsIdx);
+    calcDiffractionIntersectionIntegral(intersections, xValues, yValues, *integrFlux, fluxIndices[i]);
   }
 
   // Compute final position in HKL
@@ -1609,19 +1707,16 @@ m_accumulate = true;
  * Calculate the points of intersection for the given detector with cuboid
  * surrounding the detector position in HKL
  * @param intersections A list of intersections in HKL space
- * @param theta Polar angle withd detector
- * @param phi Azimuthal angle with detector
+ * @param buffer Space for sorting the intersections
+ * @param direction Direction of the scattered neutrons in the lab frame
  * @param transform Matrix to convert frm Q_lab to HKL (2Pi*R *UB*W*SO)^{-1}
  * @param lowvalue The lowest momentum or energy transfer for the trajectory
  * @param highvalue The highest momentum or energy transfer for the trajectory
  */
-void MDNorm::calculateIntersections(std::vector<std::array<double, 4>> &intersections, const double theta,
-                                    const double phi, const Kernel::DblMatrix &transform, double lowvalue,
-                                    double highvalue) {
-  V3D qout(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta)), qin(0., 0., 1);
-
-  qout = transform * qout;
-  qin = transform * qin;
+void MDNorm::calculateIntersections(std::vector<std::array<double, 4>> &intersections,
+                                    std::vector<std::array<double, 4>> &buffer, const Kernel::V3D &direction,
+                                    const Kernel::DblMatrix &transform, double lowvalue, double highvalue) {
+  V3D qout = transform * direction, qin = transform * V3D(0., 0., 1);
   if (convention == "Crystallography") {
     qout *= -1;
     qin *= -1;
@@ -1651,45 +1746,63 @@ void MDNorm::calculateIntersections(std::vector<std::array<double, 4>> &intersec
   intersections.clear();
   intersections.reserve(hNBins + kNBins + lNBins + eNBins + 2);
 
+  // The intersections with each family of planes are found in order of
+  // momentum, so they only need merging rather than sorting. Only the planes
+  // strictly between the start and end of the trajectory are visited.
+  std::array<size_t, maxSortedRuns> runEnds;
+  size_t nRuns = 0;
+  const auto planesBetween = [](const std::vector<double> &planes, const double start, const double end) {
+    const auto first = std::upper_bound(planes.cbegin(), planes.cend(), std::min(start, end));
+    const auto last = std::lower_bound(first, planes.cend(), std::max(start, end));
+    return std::make_pair(static_cast<size_t>(first - planes.cbegin()), static_cast<size_t>(last - planes.cbegin()));
+  };
+  const auto endRun = [&](const bool descendingMomentum, const size_t runStart) {
+    if (descendingMomentum)
+      reverseByMomentum(intersections.begin() + runStart, intersections.end());
+    runEnds[nRuns++] = intersections.size();
+  };
+
   // calculate intersections with planes perpendicular to h
   if (fabs(hStart - hEnd) > eps) {
     double fmom = (kfmax - kfmin) / (hEnd - hStart);
     double fk = (kEnd - kStart) / (hEnd - hStart);
     double fl = (lEnd - lStart) / (hEnd - hStart);
-    for (size_t i = 0; i < hNBins; i++) {
+    const auto planes = planesBetween(m_hX, hStart, hEnd);
+    const size_t runStart = intersections.size();
+    for (size_t i = planes.first; i < planes.second; i++) {
+      // hi is between hStart and hEnd, then ki and li will be between
+      // kStart, kEnd and lStart, lEnd and momi will be between kfmin and
+      // kfmax
       double hi = m_hX[i];
-      if (((hStart - hi) * (hEnd - hi) < 0)) {
-        // if hi is between hStart and hEnd, then ki and li will be between
-        // kStart, kEnd and lStart, lEnd and momi will be between kfmin and
-        // kfmax
-        double ki = fk * (hi - hStart) + kStart;
-        double li = fl * (hi - hStart) + lStart;
-        if ((ki >= m_kX[0]) && (ki <= m_kX[kNBins - 1]) && (li >= m_lX[0]) && (li <= m_lX[lNBins - 1])) {
-          double momi = fmom * (hi - hStart) + kfmin;
-          intersections.push_back({{hi, ki, li, momi}});
-        }
+      double ki = fk * (hi - hStart) + kStart;
+      double li = fl * (hi - hStart) + lStart;
+      if ((ki >= m_kX[0]) && (ki <= m_kX[kNBins - 1]) && (li >= m_lX[0]) && (li <= m_lX[lNBins - 1])) {
+        double momi = fmom * (hi - hStart) + kfmin;
+        intersections.push_back({{hi, ki, li, momi}});
       }
     }
+    endRun(fmom < 0, runStart);
   }
   // calculate intersections with planes perpendicular to k
   if (fabs(kStart - kEnd) > eps) {
     double fmom = (kfmax - kfmin) / (kEnd - kStart);
     double fh = (hEnd - hStart) / (kEnd - kStart);
     double fl = (lEnd - lStart) / (kEnd - kStart);
-    for (size_t i = 0; i < kNBins; i++) {
+    const auto planes = planesBetween(m_kX, kStart, kEnd);
+    const size_t runStart = intersections.size();
+    for (size_t i = planes.first; i < planes.second; i++) {
+      // ki is between kStart and kEnd, then hi and li will be between
+      // hStart, hEnd and lStart, lEnd and momi will be between kfmin and
+      // kfmax
       double ki = m_kX[i];
-      if (((kStart - ki) * (kEnd - ki) < 0)) {
-        // if ki is between kStart and kEnd, then hi and li will be between
-        // hStart, hEnd and lStart, lEnd and momi will be between kfmin and
-        // kfmax
-        double hi = fh * (ki - kStart) + hStart;
-        double li = fl * (ki - kStart) + lStart;
-        if ((hi >= m_hX[0]) && (hi <= m_hX[hNBins - 1]) && (li >= m_lX[0]) && (li <= m_lX[lNBins - 1])) {
-          double momi = fmom * (ki - kStart) + kfmin;
-          intersections.push_back({{hi, ki, li, momi}});
-        }
+      double hi = fh * (ki - kStart) + hStart;
+      double li = fl * (ki - kStart) + lStart;
+      if ((hi >= m_hX[0]) && (hi <= m_hX[hNBins - 1]) && (li >= m_lX[0]) && (li <= m_lX[lNBins - 1])) {
+        double momi = fmom * (ki - kStart) + kfmin;
+        intersections.push_back({{hi, ki, li, momi}});
       }
     }
+    endRun(fmom < 0, runStart);
   }
 
   // calculate intersections with planes perpendicular to l
@@ -1697,33 +1810,35 @@ void MDNorm::calculateIntersections(std::vector<std::array<double, 4>> &intersec
     double fmom = (kfmax - kfmin) / (lEnd - lStart);
     double fh = (hEnd - hStart) / (lEnd - lStart);
     double fk = (kEnd - kStart) / (lEnd - lStart);
-
-    for (size_t i = 0; i < lNBins; i++) {
+    const auto planes = planesBetween(m_lX, lStart, lEnd);
+    const size_t runStart = intersections.size();
+    for (size_t i = planes.first; i < planes.second; i++) {
       double li = m_lX[i];
-      if (((lStart - li) * (lEnd - li) < 0)) {
-        double hi = fh * (li - lStart) + hStart;
-        double ki = fk * (li - lStart) + kStart;
-        if ((hi >= m_hX[0]) && (hi <= m_hX[hNBins - 1]) && (ki >= m_kX[0]) && (ki <= m_kX[kNBins - 1])) {
-          double momi = fmom * (li - lStart) + kfmin;
-          intersections.push_back({{hi, ki, li, momi}});
-        }
+      double hi = fh * (li - lStart) + hStart;
+      double ki = fk * (li - lStart) + kStart;
+      if ((hi >= m_hX[0]) && (hi <= m_hX[hNBins - 1]) && (ki >= m_kX[0]) && (ki <= m_kX[kNBins - 1])) {
+        double momi = fmom * (li - lStart) + kfmin;
+        intersections.push_back({{hi, ki, li, momi}});
       }
     }
+    endRun(fmom < 0, runStart);
   }
-  // intersections with dE
+  // intersections with dE, where the final momenta are in descending order
   if (!m_dEIntegrated) {
-    for (size_t i = 0; i < eNBins; i++) {
-      double kfi = m_eX[i];
-      if ((kfi - kfmin) * (kfi - kfmax) <= 0) {
-        double h = qin.X() * kimin - qout.X() * kfi;
-        double k = qin.Y() * kimin - qout.Y() * kfi;
-        double l = qin.Z() * kimin - qout.Z() * kfi;
-        if ((h >= m_hX[0]) && (h <= m_hX[hNBins - 1]) && (k >= m_kX[0]) && (k <= m_kX[kNBins - 1]) && (l >= m_lX[0]) &&
-            (l <= m_lX[lNBins - 1])) {
-          intersections.push_back({{h, k, l, kfi}});
-        }
+    const auto first = std::lower_bound(m_eX.cbegin(), m_eX.cend(), std::max(kfmin, kfmax), std::greater<double>());
+    const auto last = std::upper_bound(first, m_eX.cend(), std::min(kfmin, kfmax), std::greater<double>());
+    const size_t runStart = intersections.size();
+    for (auto kf = first; kf != last; ++kf) {
+      double kfi = *kf;
+      double h = qin.X() * kimin - qout.X() * kfi;
+      double k = qin.Y() * kimin - qout.Y() * kfi;
+      double l = qin.Z() * kimin - qout.Z() * kfi;
+      if ((h >= m_hX[0]) && (h <= m_hX[hNBins - 1]) && (k >= m_kX[0]) && (k <= m_kX[kNBins - 1]) && (l >= m_lX[0]) &&
+          (l <= m_lX[lNBins - 1])) {
+        intersections.push_back({{h, k, l, kfi}});
       }
     }
+    endRun(true, runStart);
   }
 
   // endpoints
@@ -1731,13 +1846,15 @@ void MDNorm::calculateIntersections(std::vector<std::array<double, 4>> &intersec
       (lStart >= m_lX[0]) && (lStart <= m_lX[lNBins - 1])) {
     intersections.push_back({{hStart, kStart, lStart, kfmin}});
   }
+  runEnds[nRuns++] = intersections.size();
   if ((hEnd >= m_hX[0]) && (hEnd <= m_hX[hNBins - 1]) && (kEnd >= m_kX[0]) && (kEnd <= m_kX[kNBins - 1]) &&
       (lEnd >= m_lX[0]) && (lEnd <= m_lX[lNBins - 1])) {
     intersections.push_back({{hEnd, kEnd, lEnd, kfmax}});
   }
+  runEnds[nRuns++] = intersections.size();
 
   // sort intersections by final momentum
-  std::stable_sort(intersections.begin(), intersections.end(), compareMomentum);
+  mergeByMomentum(intersections, runEnds, nRuns, buffer);
 }
 
 /**
@@ -1785,7 +1902,10 @@ void MDNorm::calcIntegralsForIntersections(const std::vector<double> &xValues, c
     yValues[i] = yMin;
     i++;
   }
-  size_t j = 0;
+  // the xValues are sorted: start from the first point of the spectrum that
+  // is not below them rather than from the beginning
+  auto j = static_cast<size_t>(std::lower_bound(xData.begin(), xData.begin() + (spSize - 1), xValues[i]) -
+                               xData.begin());
   for (; i < nData; i++) {
     // integrals above xEnd must be equal tp yMax
     if (j >= spSize - 1) {
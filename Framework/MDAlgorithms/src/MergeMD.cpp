@@ -8,6 +8,7 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDEventTreeBuilder.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/MandatoryValidator.h"
@@ -239,13 +240,15 @@ template <typename MDE, size_t nd> void MergeMD::doPlus(typename MDEventWorkspac
     }
     PARALLEL_CHECK_INTERUPT_REGION
 
-    // Progress * prog2 = new Progress(this, 0.4, 0.9, 100);
-    Progress *prog2 = nullptr;
-    ThreadScheduler *ts = new ThreadSchedulerFIFO();
-    ThreadPool tp(ts, 0, prog2);
-    ws1->splitAllIfNeeded(ts);
-    // prog2->resetNumSteps( ts->size(), 0.4, 0.6);
-    tp.joinAll();
+    if (!m_buildTreeOnce) {
+      // Progress * prog2 = new Progress(this, 0.4, 0.9, 100);
+      Progress *prog2 = nullptr;
+      ThreadScheduler *ts = new ThreadSchedulerFIFO();
+      ThreadPool tp(ts, 0, prog2);
+      ws1->splitAllIfNeeded(ts);
+      // prog2->resetNumSteps( ts->size(), 0.4, 0.6);
+      tp.joinAll();
+    }
 
     // Set a marker that the file-back-end needs updating if the # of events
     // changed.
@@ -255,6 +258,17 @@ template <typename MDE, size_t nd> void MergeMD::doPlus(typename MDEventWorkspac
     // std::cout << tim << " to add workspace " << ws2->name() << '\n';
 }
 
+//----------------------------------------------------------------------------------------------
+/** Build the box tree of the output workspace in one pass from all the events
+ * added to it. Only used when m_buildTreeOnce is set.
+ *
+ * @param ws ::  the output MDEventWorkspace
+ */
+template <typename MDE, size_t nd> void MergeMD::buildBoxTree(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  if constexpr (isMDEventTreeBuildable<nd>())
+    rebuildMDEventTree(*ws, PARALLEL_GET_MAX_THREADS);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Execute the algorithm.
  */
@@ -284,6 +298,11 @@ void MergeMD::exec() {
   // Create a blank output workspace
   this->createOutputWorkspace(inputs);
 
+  // Workspaces held in memory with a regular power of 2 splitting get their
+  // box tree built once from Morton ordered events
+  m_buildTreeOnce = out->getNumDims() >= 2 && out->getNumDims() <= 8 && !out->isFileBacked() &&
+                    canBuildMDEventTree(*out->getBoxController());
+
   // Run PlusMD on each of the input workspaces, in order.
   double progStep = 1.0 / double(m_workspaces.size());
   for (size_t i = 0; i < m_workspaces.size(); i++) {
@@ -292,6 +311,11 @@ void MergeMD::exec() {
     CALL_MDEVENT_FUNCTION(doPlus, m_workspaces[i]);
   }
 
+  if (m_buildTreeOnce) {
+    this->progress(0.9, "Building box tree");
+    CALL_MDEVENT_FUNCTION(buildBoxTree, out);
+  }
+
   this->progress(0.95, "Refreshing cache");
   out->refreshCache();
 
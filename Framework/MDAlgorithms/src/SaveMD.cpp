@@ -10,6 +10,7 @@
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/Progress.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataObjects/BoxControllerMmapIO.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
@@ -89,18 +90,26 @@ template <typename MDE, size_t nd> void SaveMD::doSaveEvents(typename MDEventWor
   bool wsIsFileBacked = ws->isFileBacked();
   std::string filename = getPropertyValue("Filename");
   BoxController_sptr bc = ws->getBoxController();
-  auto copyFile = wsIsFileBacked && !filename.empty() && filename != bc->getFilename();
+  // The events of a workspace loaded with MemoryMappedBackEnd are in a scratch
+  // file, which is neither a NeXus file to update nor one to copy
+  const bool eventsInScratchFile =
+      wsIsFileBacked && dynamic_cast<BoxControllerMmapIO *>(bc->getFileIO()) != nullptr;
+  auto copyFile = wsIsFileBacked && !eventsInScratchFile && !filename.empty() && filename != bc->getFilename();
   if (wsIsFileBacked) {
     if (makeFileBackend) {
       throw std::runtime_error("MakeFileBacked selected but workspace is already file backed.");
     }
+    if (updateFileBackend && eventsInScratchFile) {
+      throw std::runtime_error("UpdateFileBackEnd selected but the events of the workspace are in a memory-mapped "
+                               "scratch file. Give a Filename to save to instead.");
+    }
   } else {
     if (updateFileBackend) {
       throw std::runtime_error("UpdateFileBackEnd selected but workspace is not file backed.");
     }
   }
 
-  if (!wsIsFileBacked) {
+  if (!wsIsFileBacked || eventsInScratchFile) {
     Poco::File oldFile(filename);
     if (oldFile.exists())
       oldFile.remove();
@@ -193,7 +202,17 @@ template <typename MDE, size_t nd> void SaveMD::doSaveEvents(typename MDEventWor
       for (size_t i = 0; i < boxes.size(); i++) {
         if (eventIndex[2 * i + 1] == 0 || boxes[i]->getIsMasked())
           continue;
-        boxes[i]->saveAt(Saver.get(), eventIndex[2 * i]);
+        if (eventsInScratchFile) {
+          // bring the events of the box back from the scratch file first
+          auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+          if (box) {
+            box->getConstEvents();
+            box->saveAt(Saver.get(), eventIndex[2 * i]);
+            box->releaseEvents();
+          }
+        } else {
+          boxes[i]->saveAt(Saver.get(), eventIndex[2 * i]);
+        }
         prog->report("Saving Box");
       }
       Saver->closeFile();
@@ -363,6 +363,73 @@ public:
                  6 * 6 * 6 /*# of bins*/, true /*IterateEvents*/);
   }
 
+  void test_exec_with_additional_cuts() {
+    IMDEventWorkspace_sptr in_ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 1);
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+
+    BinMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("InputWorkspace", "BinMDTest_ws"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AlignedDim0", "Axis0,2.0,8.0, 6"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AlignedDim1", "Axis1,2.0,8.0, 6"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AlignedDim2", "Axis2,2.0,8.0, 6"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue(
+        "AdditionalCuts", R"({"BinMDTest_cut2D": {"AlignedDim0": "Axis0,2.0,8.0, 3", "AlignedDim1": "Axis1,2.0,8.0, 3"},
+                              "BinMDTest_cut1D": {"AxisAligned": false, "BasisVector0": "OutZ,m,0,0,1",
+                                                  "OutputExtents": "2,8", "OutputBins": "6"}})"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", "BinMDTest_out"));
+    TS_ASSERT_THROWS_NOTHING(alg.execute();)
+    TS_ASSERT(alg.isExecuted());
+
+    // Every cut matches the same cut binned on its own
+    auto &ads = AnalysisDataService::Instance();
+    MDHistoWorkspace_sptr out = ads.retrieveWS<MDHistoWorkspace>("BinMDTest_out");
+    TS_ASSERT(out);
+    MDHistoWorkspace_sptr cut2D = ads.retrieveWS<MDHistoWorkspace>("BinMDTest_cut2D");
+    TS_ASSERT(cut2D);
+    MDHistoWorkspace_sptr cut1D = ads.retrieveWS<MDHistoWorkspace>("BinMDTest_cut1D");
+    TS_ASSERT(cut1D);
+    if (!out || !cut2D || !cut1D)
+      return;
+    checkSignal(*out, 6 * 6 * 6, 1.0);
+    checkSignal(*cut2D, 3 * 3, 4.0 * 10.0);
+    checkSignal(*cut1D, 6, 100.0);
+    TS_ASSERT_EQUALS(cut1D->getBasisVector(0), VMD(0, 0, 1));
+    TS_ASSERT_EQUALS(cut2D->getNumExperimentInfo(), in_ws->getNumExperimentInfo());
+
+    ads.remove("BinMDTest_ws");
+    ads.remove("BinMDTest_out");
+    ads.remove("BinMDTest_cut2D");
+    ads.remove("BinMDTest_cut1D");
+  }
+
+  void test_additional_cut_cannot_set_output_workspace() {
+    IMDEventWorkspace_sptr in_ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 1);
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+
+    BinMD alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setPropertyValue("InputWorkspace", "BinMDTest_ws");
+    alg.setPropertyValue("AlignedDim0", "Axis0,2.0,8.0, 6");
+    alg.setPropertyValue("AdditionalCuts",
+                         R"({"BinMDTest_cut": {"AlignedDim0": "Axis1,2.0,8.0, 3", "OutputWorkspace": "other"}})");
+    alg.setPropertyValue("OutputWorkspace", "BinMDTest_out");
+    TS_ASSERT_THROWS(alg.execute(), const std::invalid_argument &);
+
+    AnalysisDataService::Instance().remove("BinMDTest_ws");
+  }
+
+  /// Check the number of bins and that every bin has the same signal
+  void checkSignal(const MDHistoWorkspace &ws, const size_t expectedNumBins, const double expectedSignal) {
+    TS_ASSERT_EQUALS(ws.getNPoints(), expectedNumBins);
+    for (size_t i = 0; i < ws.getNPoints(); i++) {
+      TS_ASSERT_DELTA(ws.getSignalAt(i), expectedSignal, 1e-5);
+      TS_ASSERT_DELTA(ws.getNumEventsAt(i), expectedSignal, 1e-5);
+      TS_ASSERT_DELTA(ws.getErrorAt(i), sqrt(expectedSignal), 1e-5);
+    }
+  }
+
   /** Test the algorithm, with a coordinate transformation.
    *
    * @param binsX : # of bins in the output
@@ -192,7 +192,7 @@ class ConvToMDEventsWSIndexingTest : public CxxTest::TestSuite {
   using MDNode = Mantid::API::IMDNode;
   using MDEventStore = std::vector<MDEvent>;
   using MDEventIterator = MDEventStore ::iterator;
-  using TreeBuilder = Mantid::MDAlgorithms::MDEventTreeBuilder<ND, MDEventTml, MDEventIterator>;
+  using TreeBuilder = Mantid::DataObjects::MDEventTreeBuilder<ND, MDEventTml, MDEventIterator>;
 
   const std::array<double, 3> lowerLeft = {{0, 0, 0}};
   const std::array<double, 3> upperRight = {{8, 8, 8}};
@@ -12,6 +12,7 @@
 #include "MantidAPI/ExperimentInfo.h"
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataObjects/BoxControllerMmapIO.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDEventFactory.h"
@@ -165,7 +166,8 @@ public:
 
   //=================================================================================================================
   template <size_t nd>
-  void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true, double memory = 0, bool BoxStructureOnly = false) {
+  void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true, double memory = 0, bool BoxStructureOnly = false,
+                    bool memoryMapped = false) {
     using MDE = MDLeanEvent<nd>;
 
     //------ Start by creating the file
@@ -212,6 +214,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filename", filename));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("FileBackEnd", FileBackEnd));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("Memory", memory));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("MemoryMappedBackEnd", memoryMapped));
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", outWSName));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("MetadataOnly", false));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("BoxStructureOnly", BoxStructureOnly));
@@ -387,6 +390,63 @@ public:
     do_test_UpdateFileBackEnd<3>();
   }
 
+  /** Keep the events in a memory-mapped scratch file, then save them to a
+   * new file and reload that into memory.
+   */
+  void test_exec_3D_with_MemoryMappedBackEnd_then_save() {
+    do_test_exec<3>(true, false, 0.0, false, true);
+    std::string outWSName("LoadMDTest_OutputWS");
+    auto ws = std::dynamic_pointer_cast<MDEventWorkspace<MDLeanEvent<3>, 3>>(
+        AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(outWSName));
+    TS_ASSERT(ws);
+    if (!ws)
+      return;
+    auto scratch = dynamic_cast<BoxControllerMmapIO *>(ws->getBoxController()->getFileIO());
+    TS_ASSERT(scratch);
+    if (!scratch)
+      return;
+    const std::string scratchName = scratch->getFileName();
+    TS_ASSERT(Poco::File(scratchName).exists());
+
+    // The scratch file is not a NeXus file to update
+    SaveMD updater;
+    updater.initialize();
+    updater.setPropertyValue("InputWorkspace", outWSName);
+    updater.setPropertyValue("Filename", "");
+    updater.setProperty("UpdateFileBackEnd", true);
+    updater.execute();
+    TS_ASSERT(!updater.isExecuted());
+
+    SaveMD2 saver;
+    TS_ASSERT_THROWS_NOTHING(saver.initialize())
+    TS_ASSERT_THROWS_NOTHING(saver.setPropertyValue("InputWorkspace", outWSName));
+    TS_ASSERT_THROWS_NOTHING(saver.setPropertyValue("Filename", "LoadMDTest_MemoryMapped.nxs"));
+    TS_ASSERT_THROWS_NOTHING(saver.execute(););
+    TS_ASSERT(saver.isExecuted());
+    std::string filename = saver.getPropertyValue("Filename");
+
+    LoadMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filename", filename));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("FileBackEnd", false));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", "LoadMDTest_reloaded"));
+    TS_ASSERT_THROWS_NOTHING(alg.execute(););
+    TS_ASSERT(alg.isExecuted());
+    auto reloaded = std::dynamic_pointer_cast<MDEventWorkspace<MDLeanEvent<3>, 3>>(
+        AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>("LoadMDTest_reloaded"));
+    TS_ASSERT(reloaded);
+    if (reloaded)
+      do_compare_MDEW(ws, reloaded);
+
+    // Dropping the file back end removes the scratch file
+    ws->clearFileBacked(false);
+    TS_ASSERT(!Poco::File(scratchName).exists());
+    AnalysisDataService::Instance().remove(outWSName);
+    AnalysisDataService::Instance().remove("LoadMDTest_reloaded");
+    if (Poco::File(filename).exists())
+      Poco::File(filename).remove();
+  }
+
   /// Only load the box structure, no events
   void test_exec_3D_BoxStructureOnly() { do_test_exec<3>(false, true, 0.0, true); }
 
@@ -0,0 +1,286 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/Goniometer.h"
+#include "MantidKernel/PhysicalConstants.h"
+#include "MantidMDAlgorithms/MDNorm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using Mantid::MDAlgorithms::MDNorm;
+using Mantid::Kernel::DblMatrix;
+using Mantid::Kernel::V3D;
+using Intersections = std::vector<std::array<double, 4>>;
+
+class MDNormTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDNormTest *createSuite() { return new MDNormTest(); }
+  static void destroySuite(MDNormTest *suite) { delete suite; }
+
+  void test_Init() {
+    MDNorm alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_intersections_of_descending_trajectories_are_sorted_by_momentum() {
+    // Positive x and y components: h and k fall as the final momentum rises,
+    // so the intersections with the h and k planes are found in reverse
+    MDNorm alg;
+    setGrid(alg, false);
+    const DblMatrix identity(3, 3, true);
+    for (const auto &direction : {V3D(1., 1., 1.), V3D(2., 0.5, 0.5), V3D(0.3, 1., 0.2)}) {
+      const auto trajectory = normalize(direction);
+      checkSameIntersections(alg, trajectory, identity, -4., 4.);
+      Intersections intersections, buffer;
+      alg.calculateIntersections(intersections, buffer, trajectory, identity, -4., 4.);
+      TS_ASSERT(intersections.size() > 2);
+      TS_ASSERT(std::is_sorted(intersections.cbegin(), intersections.cend(), compareMomentum));
+    }
+  }
+
+  void test_intersections_with_equal_momenta_keep_the_order_of_a_stable_sort() {
+    // h and k are equal along the trajectory and the h and k planes are at the
+    // same values, so each h plane is crossed at the momentum of a k plane
+    MDNorm alg;
+    setGrid(alg, true);
+    const DblMatrix identity(3, 3, true);
+    for (const auto &direction : {V3D(-1., -1., 1.), V3D(1., 1., 0.5)}) {
+      const auto trajectory = normalize(direction);
+      Intersections intersections, buffer;
+      alg.calculateIntersections(intersections, buffer, trajectory, identity, 1., 5.);
+      size_t ties(0);
+      for (size_t i = 1; i < intersections.size(); ++i) {
+        if (intersections[i][3] == intersections[i - 1][3])
+          ++ties;
+      }
+      TS_ASSERT(ties > 0);
+      checkSameIntersections(alg, trajectory, identity, 1., 5.);
+    }
+  }
+
+  void test_intersections_of_random_trajectories_match_sorting() {
+    std::mt19937 generator(13);
+    std::normal_distribution<double> component;
+    for (const bool diffraction : {true, false}) {
+      MDNorm alg;
+      setGrid(alg, diffraction);
+      for (size_t i = 0; i < 500; ++i) {
+        const auto trajectory = normalize(V3D(component(generator), component(generator), component(generator)));
+        DblMatrix transform(3, 3);
+        for (size_t row = 0; row < 3; ++row) {
+          for (size_t column = 0; column < 3; ++column)
+            transform[row][column] = component(generator);
+        }
+        if (diffraction)
+          checkSameIntersections(alg, trajectory, transform, 1., 5.);
+        else
+          checkSameIntersections(alg, trajectory, transform, -4., 4.);
+      }
+    }
+  }
+
+  void test_detector_values_are_reused_for_another_goniometer() {
+    auto first = WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(9, 10, false, true);
+    Mantid::API::MatrixWorkspace_sptr second = first->clone();
+    Mantid::Geometry::Goniometer goniometer;
+    goniometer.pushAxis("omega", 0., 1., 0., 30.);
+    second->mutableRun().setGoniometer(goniometer, false);
+
+    MDNorm alg;
+    alg.initialize();
+    setGrid(alg, false);
+    alg.m_samplePos = first->getInstrument()->getSample()->getPos();
+    alg.m_beamDir = normalize(alg.m_samplePos - first->getInstrument()->getSource()->getPos());
+    alg.cacheDetectorValues(first);
+    alg.cacheDetectorValues(second);
+    TS_ASSERT(alg.m_detectorValues.exptInfo == first);
+    TS_ASSERT_EQUALS(alg.m_detectorValues.spectra.size(), 9);
+
+    // The cached directions give the intersections of the detectors of the
+    // second run, as the old calculation from the angles of each detector did
+    auto transform = second->run().getGoniometerMatrix();
+    transform.Invert();
+    const auto &spectrumInfo = second->spectrumInfo();
+    size_t moved(0);
+    for (const size_t i : alg.m_detectorValues.spectra) {
+      const auto &detector = spectrumInfo.detector(i);
+      const double theta = detector.getTwoTheta(alg.m_samplePos, alg.m_beamDir);
+      const double phi = detector.getPhi();
+      const V3D direction(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+      const auto expected = oldIntersections(alg, direction, transform, -4., 4.);
+      Intersections intersections, buffer;
+      alg.calculateIntersections(intersections, buffer, alg.m_detectorValues.directions[i], transform, -4., 4.);
+      checkEqual(intersections, expected);
+
+      Intersections unrotated;
+      alg.calculateIntersections(unrotated, buffer, direction, DblMatrix(3, 3, true), -4., 4.);
+      if (unrotated != intersections)
+        ++moved;
+    }
+    TS_ASSERT(moved > 0);
+
+    // Masking a detector changes the detector info, so the values are
+    // calculated again
+    Mantid::API::MatrixWorkspace_sptr masked = second->clone();
+    masked->mutableDetectorInfo().setMasked(0, true);
+    alg.cacheDetectorValues(masked);
+    TS_ASSERT(alg.m_detectorValues.exptInfo == masked);
+    TS_ASSERT_EQUALS(alg.m_detectorValues.spectra.size(), 8);
+  }
+
+private:
+  static bool compareMomentum(const std::array<double, 4> &v1, const std::array<double, 4> &v2) {
+    return (v1[3] < v2[3]);
+  }
+
+  static V3D normalize(const V3D &v) { return v / v.norm(); }
+
+  /// Set the bin boundaries of the output grid: the h, k and l planes are at
+  /// the same values, and the dE planes are given as final momenta
+  void setGrid(MDNorm &alg, const bool diffraction) {
+    std::vector<double> planes;
+    for (int i = -12; i <= 12; ++i)
+      planes.emplace_back(0.25 * i);
+    alg.m_hX = planes;
+    alg.m_kX = planes;
+    alg.m_lX = planes;
+    alg.m_diffraction = diffraction;
+    alg.m_dEIntegrated = diffraction;
+    alg.convention = "Inelastic";
+    alg.m_Ei = 10.;
+    alg.m_eX.clear();
+    if (!diffraction) {
+      for (int i = -8; i <= 8; ++i)
+        alg.m_eX.emplace_back(std::sqrt(energyToK * (alg.m_Ei - 0.5 * i)));
+    }
+  }
+
+  /// The intersections as calculated before they were merged: all the planes
+  /// are checked and the intersections are stable sorted by momentum
+  Intersections oldIntersections(const MDNorm &alg, const V3D &direction, const DblMatrix &transform,
+                                 const double lowvalue, const double highvalue) {
+    V3D qout = transform * direction, qin = transform * V3D(0., 0., 1);
+    if (alg.convention == "Crystallography") {
+      qout *= -1;
+      qin *= -1;
+    }
+    double kfmin, kfmax, kimin, kimax;
+    if (alg.m_diffraction) {
+      kimin = lowvalue;
+      kimax = highvalue;
+      kfmin = kimin;
+      kfmax = kimax;
+    } else {
+      kimin = std::sqrt(energyToK * alg.m_Ei);
+      kimax = kimin;
+      kfmin = std::sqrt(energyToK * (alg.m_Ei - highvalue));
+      kfmax = std::sqrt(energyToK * (alg.m_Ei - lowvalue));
+    }
+    const double hStart = qin.X() * kimin - qout.X() * kfmin, hEnd = qin.X() * kimax - qout.X() * kfmax;
+    const double kStart = qin.Y() * kimin - qout.Y() * kfmin, kEnd = qin.Y() * kimax - qout.Y() * kfmax;
+    const double lStart = qin.Z() * kimin - qout.Z() * kfmin, lEnd = qin.Z() * kimax - qout.Z() * kfmax;
+    const auto &hX = alg.m_hX, &kX = alg.m_kX, &lX = alg.m_lX;
+    const auto inH = [&hX](const double h) { return h >= hX.front() && h <= hX.back(); };
+    const auto inK = [&kX](const double k) { return k >= kX.front() && k <= kX.back(); };
+    const auto inL = [&lX](const double l) { return l >= lX.front() && l <= lX.back(); };
+
+    const double eps = 1e-10;
+    Intersections intersections;
+    if (fabs(hStart - hEnd) > eps) {
+      const double fmom = (kfmax - kfmin) / (hEnd - hStart);
+      const double fk = (kEnd - kStart) / (hEnd - hStart);
+      const double fl = (lEnd - lStart) / (hEnd - hStart);
+      for (const double hi : hX) {
+        if ((hStart - hi) * (hEnd - hi) < 0) {
+          const double ki = fk * (hi - hStart) + kStart;
+          const double li = fl * (hi - hStart) + lStart;
+          if (inK(ki) && inL(li))
+            intersections.push_back({{hi, ki, li, fmom * (hi - hStart) + kfmin}});
+        }
+      }
+    }
+    if (fabs(kStart - kEnd) > eps) {
+      const double fmom = (kfmax - kfmin) / (kEnd - kStart);
+      const double fh = (hEnd - hStart) / (kEnd - kStart);
+      const double fl = (lEnd - lStart) / (kEnd - kStart);
+      for (const double ki : kX) {
+        if ((kStart - ki) * (kEnd - ki) < 0) {
+          const double hi = fh * (ki - kStart) + hStart;
+          const double li = fl * (ki - kStart) + lStart;
+          if (inH(hi) && inL(li))
+            intersections.push_back({{hi, ki, li, fmom * (ki - kStart) + kfmin}});
+        }
+      }
+    }
+    if (fabs(lStart - lEnd) > eps) {
+      const double fmom = (kfmax - kfmin) / (lEnd - lStart);
+      const double fh = (hEnd - hStart) / (lEnd - lStart);
+      const double fk = (kEnd - kStart) / (lEnd - lStart);
+      for (const double li : lX) {
+        if ((lStart - li) * (lEnd - li) < 0) {
+          const double hi = fh * (li - lStart) + hStart;
+          const double ki = fk * (li - lStart) + kStart;
+          if (inH(hi) && inK(ki))
+            intersections.push_back({{hi, ki, li, fmom * (li - lStart) + kfmin}});
+        }
+      }
+    }
+    if (!alg.m_dEIntegrated) {
+      for (const double kfi : alg.m_eX) {
+        if ((kfi - kfmin) * (kfi - kfmax) <= 0) {
+          const double h = qin.X() * kimin - qout.X() * kfi;
+          const double k = qin.Y() * kimin - qout.Y() * kfi;
+          const double l = qin.Z() * kimin - qout.Z() * kfi;
+          if (inH(h) && inK(k) && inL(l))
+            intersections.push_back({{h, k, l, kfi}});
+        }
+      }
+    }
+    if (inH(hStart) && inK(kStart) && inL(lStart))
+      intersections.push_back({{hStart, kStart, lStart, kfmin}});
+    if (inH(hEnd) && inK(kEnd) && inL(lEnd))
+      intersections.push_back({{hEnd, kEnd, lEnd, kfmax}});
+    std::stable_sort(intersections.begin(), intersections.end(), compareMomentum);
+    return intersections;
+  }
+
+  void checkSameIntersections(MDNorm &alg, const V3D &direction, const DblMatrix &transform, const double lowvalue,
+                              const double highvalue) {
+    Intersections intersections, buffer;
+    alg.calculateIntersections(intersections, buffer, direction, transform, lowvalue, highvalue);
+    checkEqual(intersections, oldIntersections(alg, direction, transform, lowvalue, highvalue));
+  }
+
+  void checkEqual(const Intersections &actual, const Intersections &expected) {
+    TS_ASSERT_EQUALS(actual.size(), expected.size());
+    if (actual.size() != expected.size())
+      return;
+    for (size_t i = 0; i < actual.size(); ++i) {
+      for (size_t j = 0; j < 4; ++j)
+        TS_ASSERT_EQUALS(actual[i][j], expected[i][j]);
+    }
+  }
+
+  // k=sqrt(energyToK * E), as in MDNorm
+  static constexpr double energyToK = 8.0 * M_PI * M_PI * Mantid::PhysicalConstants::NeutronMass *
+                                      Mantid::PhysicalConstants::meV * 1e-20 /
+                                      (Mantid::PhysicalConstants::h * Mantid::PhysicalConstants::h);
+};
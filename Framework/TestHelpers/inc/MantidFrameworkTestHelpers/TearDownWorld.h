@@ -8,6 +8,8 @@
 
 #include <cxxtest/GlobalFixture.h>
 
+#include <string>
+
 // This file defines a set of CxxTest::GlobalFixture classes that
 // are used to control various aspects of the global test setUp and tearDown
 // process
@@ -39,3 +41,18 @@ class ClearADS : public CxxTest::GlobalFixture {
 class ClearPropertyManagerDataService : public CxxTest::GlobalFixture {
   bool tearDownWorld() override;
 };
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Defines a CxxTest::GlobalFixture that makes the instrument snapshots go to
+ * a temporary directory rather than the geometry cache of the user. The
+ * directory is removed when its tearDownWorld() method is called.
+ */
+class TemporaryInstrumentSnapshots : public CxxTest::GlobalFixture {
+  bool setUpWorld() override;
+  bool tearDownWorld() override;
+
+  /// The directory the snapshots are written to
+  std::string m_directory;
+};
@@ -10,8 +10,13 @@
 #include "MantidFrameworkTestHelpers/TearDownWorld.h"
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/PropertyManagerDataService.h"
 
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+
 // On MSVC all workspaces must be deleted by the time main() exits as the
 // Workspace destruction can call to an OpenMP loop which is not allowed
 // on MSVC after main() exits.
@@ -24,6 +29,8 @@ ClearAlgorithmManager clearAlgManager;
 ClearADS clearADS;
 /// Definition of single ClearPropertyManagerDataService object
 ClearPropertyManagerDataService clearPropSvc;
+/// Definition of single TemporaryInstrumentSnapshots object
+TemporaryInstrumentSnapshots temporarySnapshots;
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -54,3 +61,28 @@ bool ClearPropertyManagerDataService::tearDownWorld() {
   Mantid::Kernel::PropertyManagerDataService::Instance().clear();
   return true;
 }
+
+//-----------------------------------------------------------------------------
+// TemporaryInstrumentSnapshots
+//-----------------------------------------------------------------------------
+
+/// @return True to indicate success of the set up process
+bool TemporaryInstrumentSnapshots::setUpWorld() {
+  Poco::Path path(Poco::Path::temp());
+  path.pushDirectory("MantidInstrumentSnapshots_" + std::to_string(Poco::Process::id()));
+  m_directory = path.toString();
+  Mantid::Kernel::ConfigService::Instance().setString("instrumentDefinition.snapshot.directory", m_directory);
+  return true;
+}
+
+/// @return True to indicate success of the tear down process
+bool TemporaryInstrumentSnapshots::tearDownWorld() {
+  try {
+    Poco::File directory(m_directory);
+    if (directory.exists())
+      directory.remove(true);
+  } catch (std::exception &) {
+    // a snapshot left behind in the temporary directory does no harm
+  }
+  return true;
+}